@@ -0,0 +1,183 @@
+#include "isobus/isobus/can_control_function.hpp"
+#include "isobus/isobus/can_message.hpp"
+#include "isobus/isobus/nmea2000_fast_packet_protocol.hpp"
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace isobus;
+
+/// @brief The settings of the benchmark, which can be changed from the command line
+struct BenchmarkSettings
+{
+	std::uint32_t numberOfSources = 24; ///< The number of sources sending fast packet messages at the same time
+	std::uint32_t messagesPerSource = 200; ///< The number of messages each source sends
+	std::uint32_t messageLength = 43; ///< The length of each message in bytes
+};
+
+/// @brief The PGN the benchmark receives, GNSS Position Data
+constexpr std::uint32_t PGN_TO_RECEIVE = 0x1F805;
+
+/// @brief The number of messages the fast packet protocol reassembles at the same time, more sources would evict each other's messages
+constexpr std::uint32_t MAX_NUMBER_OF_SOURCES = 32;
+
+/// @brief Splits a payload into the frames of a fast packet message
+/// @param[in] sequenceNumber The sequence counter of the message
+/// @param[in] payload The payload of the message
+/// @returns The frames of the message
+std::vector<std::array<std::uint8_t, CAN_DATA_LENGTH>> create_fast_packet_frames(std::uint8_t sequenceNumber, const std::vector<std::uint8_t> &payload)
+{
+	std::vector<std::array<std::uint8_t, CAN_DATA_LENGTH>> frames;
+	std::size_t payloadIndex = 0;
+	while (payloadIndex < payload.size())
+	{
+		std::array<std::uint8_t, CAN_DATA_LENGTH> frame;
+		frame.fill(0xFF);
+		frame[0] = static_cast<std::uint8_t>((sequenceNumber << 5) | frames.size());
+		std::size_t frameIndex = 1;
+		if (frames.empty())
+		{
+			frame[frameIndex++] = static_cast<std::uint8_t>(payload.size());
+		}
+		while ((frameIndex < CAN_DATA_LENGTH) && (payloadIndex < payload.size()))
+		{
+			frame[frameIndex++] = payload[payloadIndex++];
+		}
+		frames.push_back(frame);
+	}
+	return frames;
+}
+
+/// @brief Counts the received messages that have the expected payload
+struct ReceiveRecord
+{
+	const std::vector<std::uint8_t> *expectedPayload = nullptr; ///< The payload every message should have
+	std::uint32_t messagesReceived = 0; ///< The number of messages received
+	std::uint32_t messagesCorrupted = 0; ///< The number of messages received with a different payload
+};
+
+void on_message_received(const CANMessage &message, void *parent)
+{
+	auto record = static_cast<ReceiveRecord *>(parent);
+	record->messagesReceived++;
+	if (message.get_data() != *record->expectedPayload)
+	{
+		record->messagesCorrupted++;
+	}
+}
+
+void print_usage()
+{
+	std::cerr << "Usage: FastPacketBenchmarkTarget [options]" << std::endl
+	          << "  --sources <n>         Number of sources sending at the same time, 1-32 (default 24)" << std::endl
+	          << "  --messages <n>        Number of messages each source sends (default 200)" << std::endl
+	          << "  --length <n>          Length of each message in bytes, 9-223 (default 43)" << std::endl;
+}
+
+bool parse_arguments(int argc, char **argv, BenchmarkSettings &settings)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		std::string argument = argv[i];
+		bool hasValue = (i + 1 < argc);
+
+		if (("--sources" == argument) && hasValue)
+		{
+			settings.numberOfSources = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+		}
+		else if (("--messages" == argument) && hasValue)
+		{
+			settings.messagesPerSource = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+		}
+		else if (("--length" == argument) && hasValue)
+		{
+			settings.messageLength = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+		}
+		else
+		{
+			return false;
+		}
+	}
+	return (settings.numberOfSources > 0) &&
+	  (settings.numberOfSources <= MAX_NUMBER_OF_SOURCES) &&
+	  (settings.messagesPerSource > 0) &&
+	  (settings.messageLength > CAN_DATA_LENGTH) &&
+	  (settings.messageLength <= 223);
+}
+
+// The benchmark reassembles fast packet messages that a number of sources send at the same time,
+// so that the frames of all sources are interleaved on the bus, the way a busy NMEA 2000 network looks
+int main(int argc, char **argv)
+{
+	BenchmarkSettings settings;
+	if (!parse_arguments(argc, argv, settings))
+	{
+		print_usage();
+		return -1;
+	}
+
+	std::vector<std::uint8_t> payload(settings.messageLength);
+	for (std::size_t i = 0; i < payload.size(); i++)
+	{
+		payload[i] = static_cast<std::uint8_t>(i * 5);
+	}
+
+	std::vector<std::shared_ptr<ControlFunction>> sources;
+	for (std::uint32_t i = 0; i < settings.numberOfSources; i++)
+	{
+		sources.push_back(std::make_shared<ControlFunction>(NAME(0), static_cast<std::uint8_t>(i), 0));
+	}
+
+	// The frames are created up front so that only reassembling them is measured
+	std::vector<CANMessage> bus;
+	for (std::uint32_t message = 0; message < settings.messagesPerSource; message++)
+	{
+		auto frames = create_fast_packet_frames(static_cast<std::uint8_t>(message % 8), payload);
+		for (const auto &frame : frames)
+		{
+			for (const auto &source : sources)
+			{
+				CANIdentifier identifier(CANIdentifier::Type::Extended,
+				                         PGN_TO_RECEIVE,
+				                         CANIdentifier::CANPriority::PriorityDefault6,
+				                         CANIdentifier::GLOBAL_ADDRESS,
+				                         source->get_address());
+				bus.emplace_back(CANMessage::Type::Receive, identifier, frame.data(), static_cast<std::uint32_t>(frame.size()), source, nullptr, 0);
+			}
+		}
+	}
+
+	ReceiveRecord record;
+	record.expectedPayload = &payload;
+	FastPacketProtocol protocol([](std::uint32_t, CANDataSpan, std::shared_ptr<InternalControlFunction>, std::shared_ptr<ControlFunction>, CANIdentifier::CANPriority) { return true; });
+	protocol.register_multipacket_message_callback(PGN_TO_RECEIVE, on_message_received, &record);
+
+	const auto start = std::chrono::steady_clock::now();
+	for (const auto &frame : bus)
+	{
+		protocol.process_message(frame);
+	}
+	const auto duration = std::chrono::steady_clock::now() - start;
+
+	const std::uint32_t messagesSent = settings.numberOfSources * settings.messagesPerSource;
+	if ((messagesSent != record.messagesReceived) || (0 != record.messagesCorrupted))
+	{
+		std::cerr << "Received " << record.messagesReceived << " of " << messagesSent << " messages, " << record.messagesCorrupted << " of them corrupted" << std::endl;
+		return -2;
+	}
+
+	const auto durationNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+	std::cout << "sources,messages,length,frames,total_us,frames_per_second,ns_per_frame" << std::endl
+	          << settings.numberOfSources << ','
+	          << settings.messagesPerSource << ','
+	          << settings.messageLength << ','
+	          << bus.size() << ','
+	          << std::chrono::duration_cast<std::chrono::microseconds>(duration).count() << ','
+	          << ((0 != durationNanoseconds) ? (static_cast<double>(bus.size()) * 1e9 / static_cast<double>(durationNanoseconds)) : 0.0) << ','
+	          << (static_cast<double>(durationNanoseconds) / static_cast<double>(bus.size())) << std::endl;
+	return 0;
+}
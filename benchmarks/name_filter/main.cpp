@@ -0,0 +1,150 @@
+#include "isobus/isobus/can_NAME_filter.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace isobus;
+
+/// @brief The settings of the benchmark, which can be changed from the command line
+struct BenchmarkSettings
+{
+	std::uint32_t numberOfNAMEs = 1000; ///< The number of NAMEs to match against every partner's filters
+	std::uint32_t numberOfPartners = 32; ///< The number of partners, each with its own filters
+	std::uint32_t rounds = 20; ///< How many times every NAME is matched against every partner
+};
+
+/// @brief Generates NAMEs with a few fields kept in a small range, so that some of them match the partners' filters
+/// @param[in] numberOfNAMEs The number of NAMEs to generate
+/// @returns The generated NAMEs
+std::vector<NAME> generate_names(std::uint32_t numberOfNAMEs)
+{
+	std::vector<NAME> retVal;
+	std::uint64_t randomState = 0x9E3779B97F4A7C15ULL;
+
+	for (std::uint32_t i = 0; i < numberOfNAMEs; i++)
+	{
+		randomState = (randomState * 6364136223846793005ULL) + 1442695040888963407ULL;
+		NAME candidate(randomState);
+		candidate.set_function_code(static_cast<std::uint8_t>(i % 8));
+		candidate.set_function_instance(static_cast<std::uint8_t>(i % 2));
+		candidate.set_industry_group(2);
+		retVal.push_back(candidate);
+	}
+	return retVal;
+}
+
+void print_usage()
+{
+	std::cerr << "Usage: NAMEFilterBenchmarkTarget [options]" << std::endl
+	          << "  --names <n>           Number of NAMEs to match (default 1000)" << std::endl
+	          << "  --partners <n>        Number of partners, each with three filters (default 32)" << std::endl
+	          << "  --rounds <n>          Number of times every NAME is matched against every partner (default 20)" << std::endl;
+}
+
+bool parse_arguments(int argc, char **argv, BenchmarkSettings &settings)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		std::string argument = argv[i];
+		bool hasValue = (i + 1 < argc);
+
+		if (("--names" == argument) && hasValue)
+		{
+			settings.numberOfNAMEs = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+		}
+		else if (("--partners" == argument) && hasValue)
+		{
+			settings.numberOfPartners = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+		}
+		else if (("--rounds" == argument) && hasValue)
+		{
+			settings.rounds = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+		}
+		else
+		{
+			return false;
+		}
+	}
+	return (settings.numberOfNAMEs > 0) && (settings.numberOfPartners > 0) && (settings.rounds > 0);
+}
+
+// The benchmark matches NAMEs against the filters of a number of partners, the way the network manager does when
+// an address claim arrives, once by checking each NAMEFilter and once with a CompiledNAMEFilter per partner
+int main(int argc, char **argv)
+{
+	BenchmarkSettings settings;
+	if (!parse_arguments(argc, argv, settings))
+	{
+		print_usage();
+		return -1;
+	}
+
+	const std::vector<NAME> candidates = generate_names(settings.numberOfNAMEs);
+	std::vector<std::vector<NAMEFilter>> partnerFilters;
+	std::vector<CompiledNAMEFilter> compiledFilters;
+
+	for (std::uint32_t i = 0; i < settings.numberOfPartners; i++)
+	{
+		partnerFilters.push_back({ NAMEFilter(NAME::NAMEParameters::IndustryGroup, 2),
+		                           NAMEFilter(NAME::NAMEParameters::FunctionCode, i % 8),
+		                           NAMEFilter(NAME::NAMEParameters::FunctionInstance, i % 2) });
+		compiledFilters.emplace_back(partnerFilters.back());
+	}
+
+	std::uint64_t perFieldMatches = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (std::uint32_t round = 0; round < settings.rounds; round++)
+	{
+		for (const auto &candidate : candidates)
+		{
+			for (const auto &filters : partnerFilters)
+			{
+				bool matches = true;
+				for (const auto &filter : filters)
+				{
+					if (!filter.check_name_matches_filter(candidate))
+					{
+						matches = false;
+						break;
+					}
+				}
+				perFieldMatches += matches ? 1 : 0;
+			}
+		}
+	}
+	const auto perFieldDuration = std::chrono::steady_clock::now() - start;
+
+	std::uint64_t compiledMatches = 0;
+	start = std::chrono::steady_clock::now();
+	for (std::uint32_t round = 0; round < settings.rounds; round++)
+	{
+		for (const auto &candidate : candidates)
+		{
+			for (const auto &filter : compiledFilters)
+			{
+				compiledMatches += filter.check_name_matches(candidate) ? 1 : 0;
+			}
+		}
+	}
+	const auto compiledDuration = std::chrono::steady_clock::now() - start;
+
+	if (perFieldMatches != compiledMatches)
+	{
+		std::cerr << "The compiled filters matched " << compiledMatches << " times, but the per field filters " << perFieldMatches << " times" << std::endl;
+		return -2;
+	}
+
+	const double numberOfChecks = static_cast<double>(settings.numberOfNAMEs) * settings.numberOfPartners * settings.rounds;
+	std::cout << "names,partners,rounds,matches,per_field_us,compiled_us,per_field_ns_per_check,compiled_ns_per_check" << std::endl
+	          << settings.numberOfNAMEs << ','
+	          << settings.numberOfPartners << ','
+	          << settings.rounds << ','
+	          << compiledMatches << ','
+	          << std::chrono::duration_cast<std::chrono::microseconds>(perFieldDuration).count() << ','
+	          << std::chrono::duration_cast<std::chrono::microseconds>(compiledDuration).count() << ','
+	          << (static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(perFieldDuration).count()) / numberOfChecks) << ','
+	          << (static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(compiledDuration).count()) / numberOfChecks) << std::endl;
+	return 0;
+}
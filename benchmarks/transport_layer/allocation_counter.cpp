@@ -0,0 +1,49 @@
+#include "allocation_counter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Kept in its own translation unit, so the compiler doesn't pair these replacements with inlined standard library code
+static std::atomic<std::uint64_t> allocationCount = { 0 };
+
+std::uint64_t get_allocation_count()
+{
+	return allocationCount;
+}
+
+void *operator new(std::size_t size)
+{
+	allocationCount++;
+	void *pointer = std::malloc((size > 0) ? size : 1);
+	if (nullptr == pointer)
+	{
+		throw std::bad_alloc();
+	}
+	return pointer;
+}
+
+void *operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void *pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept
+{
+	std::free(pointer);
+}
@@ -0,0 +1,12 @@
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
+
+#include <cstdint>
+
+/// @brief Returns the number of heap allocations made by the whole process so far
+/// @details The global operator new is replaced in allocation_counter.cpp to count every allocation,
+/// so the count includes the allocations of the stack's own threads.
+/// @returns The number of heap allocations since the process started
+std::uint64_t get_allocation_count();
+
+#endif // ALLOCATION_COUNTER_HPP
@@ -0,0 +1,640 @@
+#include "isobus/hardware_integration/can_hardware_interface.hpp"
+#include "isobus/hardware_integration/virtual_can_plugin.hpp"
+#include "isobus/isobus/can_network_manager.hpp"
+#include "isobus/isobus/can_partnered_control_function.hpp"
+#include "isobus/isobus/nmea2000_fast_packet_protocol.hpp"
+#include "isobus/utility/system_timing.hpp"
+
+#include "allocation_counter.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <ctime>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace isobus;
+
+static constexpr std::uint32_t PARAMETER_GROUP_NUMBER = 0xEF00; ///< The parameter group number used for the TP and ETP messages
+static constexpr std::uint32_t FAST_PACKET_PARAMETER_GROUP_NUMBER = 0x1F805; ///< The parameter group number used for the fast packet messages
+static constexpr std::uint32_t MAX_FAST_PACKET_MESSAGE_SIZE_BYTES = 223; ///< The max number of bytes the fast packet protocol can handle
+static constexpr std::uint32_t MAX_TP_MESSAGE_SIZE_BYTES = 1785; ///< The max number of bytes the Transport Protocol can handle
+static constexpr std::uint32_t MAX_ETP_MESSAGE_SIZE_BYTES = 117440505; ///< The max number of bytes the Extended Transport Protocol can handle
+static constexpr std::uint8_t FIRST_ORIGINATOR_ADDRESS = 0x80; ///< The preferred address of the first sending control function
+static constexpr std::uint8_t FIRST_RECIPIENT_ADDRESS = 0xA0; ///< The preferred address of the first receiving control function
+static std::atomic_bool running = { true };
+
+/// @brief The ways a message can be transferred in the benchmark
+enum class TransferMode
+{
+	DestinationSpecific, ///< A TP or ETP connection mode session, or a single frame for 8 bytes or less
+	SharedSource, ///< TP or ETP connection mode sessions that are all sent by the same control function, each to a different destination
+	Broadcast, ///< A TP broadcast (BAM) session
+	FastPacket ///< A NMEA2000 fast packet session
+};
+
+/// @brief The settings of the benchmark, which can be changed from the command line
+struct BenchmarkSettings
+{
+	std::vector<std::uint32_t> payloadSizes = { 8, 64, 223, 512, 1785, 16384, 262144, 1048576, 16777216 }; ///< The message sizes to test
+	std::vector<std::uint32_t> sessionCounts = { 1, 4 }; ///< The numbers of concurrent sessions to test
+	std::vector<std::uint32_t> windowSizes = { 16, 255 }; ///< The CTS/DPO window sizes to test for destination specific messages
+	std::vector<std::uint32_t> pipeliningModes = { 0, 1 }; ///< If ETP window pipelining is tested off (0) and/or on (1)
+	std::uint32_t repetitions = 3; ///< How many times each combination is run
+	std::uint32_t timeout_ms = 120000; ///< How long a single run may take before it's reported as a timeout
+	std::uint32_t broadcastFrameGap_ms = 10; ///< The time between BAM frames, the minimum allowed by the stack by default
+	std::string outputPath; ///< If not empty, the results are also written to this file
+	std::string objectPoolPath; ///< If not empty, this file is sent as a payload, for example an IOP object pool
+	bool lowLatency = true; ///< If the hardware interface runs in low latency mode
+};
+
+/// @brief The results of a single run of the benchmark
+struct BenchmarkResult
+{
+	std::string status; ///< "ok", "timeout", "rejected" or "corrupt"
+	std::uint64_t elapsed_us = 0; ///< The time from the first send until the last message was received
+	std::uint64_t totalLatency_us = 0; ///< The sum of the latencies of all messages
+	std::uint64_t maximumLatency_us = 0; ///< The largest latency of all messages
+	std::uint64_t frames = 0; ///< The number of frames sent on the bus during the run
+	double cpuTime_s = 0.0; ///< The process CPU time used during the run
+	std::uint64_t allocations = 0; ///< The number of heap allocations during the run
+};
+
+/// @brief The shared state between a run and the receive callbacks
+struct RunContext
+{
+	std::mutex mutex; ///< Protects the members below, as callbacks are called from the stack's thread
+	std::vector<std::uint8_t> sessionAddresses; ///< The address that tells the sessions apart, the sender's or for shared source runs the receiver's
+	bool sessionsByDestination = false; ///< If the sessions are told apart by the address of the receiving control function
+	std::vector<std::uint64_t> sendTimestamps_us; ///< When each message was sent
+	std::vector<std::uint64_t> receiveTimestamps_us; ///< When each message was received, zero if not yet
+	std::uint32_t expectedLength = 0; ///< The length of the messages of this run
+	std::uint32_t numberReceived = 0; ///< The number of messages received
+	bool corrupt = false; ///< Set if a message with a wrong length or content was received
+	bool active = false; ///< Set while a run is in progress
+};
+
+static RunContext runContext;
+static std::atomic<std::uint64_t> frameCount = { 0 };
+static std::vector<std::uint8_t> sendBuffer;
+
+void signal_handler(int)
+{
+	running = false;
+}
+
+const char *get_mode_name(TransferMode mode)
+{
+	switch (mode)
+	{
+		case TransferMode::DestinationSpecific:
+			return "destination_specific";
+
+		case TransferMode::SharedSource:
+			return "shared_source";
+
+		case TransferMode::Broadcast:
+			return "broadcast";
+
+		case TransferMode::FastPacket:
+			return "fast_packet";
+	}
+	return "unknown";
+}
+
+const char *get_protocol_name(TransferMode mode, std::uint32_t payloadSize)
+{
+	if (TransferMode::FastPacket == mode)
+	{
+		return "FP";
+	}
+	else if (payloadSize <= CAN_DATA_LENGTH)
+	{
+		return "CAN";
+	}
+	else if (payloadSize <= MAX_TP_MESSAGE_SIZE_BYTES)
+	{
+		return "TP";
+	}
+	return "ETP";
+}
+
+void on_message_received(const CANMessage &message, void *)
+{
+	std::uint64_t now_us = SystemTiming::get_timestamp_us();
+	const std::lock_guard<std::mutex> lock(runContext.mutex);
+	if (!runContext.active)
+	{
+		return;
+	}
+
+	const std::uint8_t sessionAddress = runContext.sessionsByDestination ? message.get_identifier().get_destination_address() : message.get_identifier().get_source_address();
+	auto session = std::find(runContext.sessionAddresses.begin(), runContext.sessionAddresses.end(), sessionAddress);
+	if (session == runContext.sessionAddresses.end())
+	{
+		return;
+	}
+
+	// Only the ends of the message are checked, to keep the check from dominating the CPU time of large messages
+	const auto &data = message.get_data();
+	if ((data.size() != runContext.expectedLength) ||
+	    (data.front() != sendBuffer.front()) ||
+	    (data.back() != sendBuffer[runContext.expectedLength - 1]))
+	{
+		runContext.corrupt = true;
+	}
+
+	std::size_t index = static_cast<std::size_t>(std::distance(runContext.sessionAddresses.begin(), session));
+	if (0 == runContext.receiveTimestamps_us[index])
+	{
+		runContext.receiveTimestamps_us[index] = now_us;
+		runContext.numberReceived++;
+	}
+}
+
+bool send_message(TransferMode mode,
+                  std::uint32_t payloadSize,
+                  const std::shared_ptr<InternalControlFunction> &originator,
+                  const std::shared_ptr<PartneredControlFunction> &recipient)
+{
+	switch (mode)
+	{
+		case TransferMode::DestinationSpecific:
+		case TransferMode::SharedSource:
+			return CANNetworkManager::CANNetwork.send_can_message(PARAMETER_GROUP_NUMBER, sendBuffer.data(), payloadSize, originator, recipient);
+
+		case TransferMode::Broadcast:
+			return CANNetworkManager::CANNetwork.send_can_message(PARAMETER_GROUP_NUMBER, sendBuffer.data(), payloadSize, originator);
+
+		case TransferMode::FastPacket:
+			return CANNetworkManager::CANNetwork.get_fast_packet_protocol(0)->send_multipacket_message(FAST_PACKET_PARAMETER_GROUP_NUMBER,
+			                                                                                           sendBuffer.data(),
+			                                                                                           static_cast<std::uint8_t>(payloadSize),
+			                                                                                           originator,
+			                                                                                           nullptr);
+	}
+	return false;
+}
+
+void wait_for_idle_bus()
+{
+	std::uint32_t startTime = SystemTiming::get_timestamp_ms();
+	while (running &&
+	       ((!CANNetworkManager::CANNetwork.get_active_transport_protocol_sessions(0).empty()) ||
+	        (!CANNetworkManager::CANNetwork.get_active_transport_protocol_sessions(1).empty())) &&
+	       (!SystemTiming::time_expired_ms(startTime, 5000)))
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+}
+
+BenchmarkResult run_benchmark(TransferMode mode,
+                              std::uint32_t payloadSize,
+                              std::uint32_t sessionCount,
+                              const BenchmarkSettings &settings,
+                              const std::vector<std::shared_ptr<InternalControlFunction>> &originators,
+                              const std::vector<std::shared_ptr<PartneredControlFunction>> &recipients,
+                              const std::vector<std::shared_ptr<InternalControlFunction>> &recipientECUs)
+{
+	BenchmarkResult result;
+	const bool sharedSource = (TransferMode::SharedSource == mode);
+	wait_for_idle_bus();
+
+	{
+		const std::lock_guard<std::mutex> lock(runContext.mutex);
+		runContext.sessionAddresses.clear();
+		runContext.sessionsByDestination = sharedSource;
+		for (std::uint32_t i = 0; i < sessionCount; i++)
+		{
+			runContext.sessionAddresses.push_back(sharedSource ? recipientECUs.at(i)->get_address() : originators.at(i)->get_address());
+		}
+		runContext.sendTimestamps_us.assign(sessionCount, 0);
+		runContext.receiveTimestamps_us.assign(sessionCount, 0);
+		runContext.expectedLength = payloadSize;
+		runContext.numberReceived = 0;
+		runContext.corrupt = false;
+		runContext.active = true;
+	}
+
+	std::uint64_t startFrameCount = frameCount;
+	std::uint64_t startAllocationCount = get_allocation_count();
+	std::clock_t startCpuTime = std::clock();
+	std::uint64_t startTime_us = SystemTiming::get_timestamp_us();
+
+	bool allSent = true;
+	for (std::uint32_t i = 0; i < sessionCount; i++)
+	{
+		std::uint64_t sendTime_us = SystemTiming::get_timestamp_us();
+		if (send_message(mode, payloadSize, originators.at(sharedSource ? 0 : i), recipients.at(i)))
+		{
+			const std::lock_guard<std::mutex> lock(runContext.mutex);
+			runContext.sendTimestamps_us[i] = sendTime_us;
+		}
+		else
+		{
+			allSent = false;
+		}
+	}
+
+	bool finished = false;
+	while (running && allSent && (!finished) && (!SystemTiming::time_expired_us(startTime_us, static_cast<std::uint64_t>(settings.timeout_ms) * 1000)))
+	{
+		{
+			const std::lock_guard<std::mutex> lock(runContext.mutex);
+			finished = (runContext.numberReceived == sessionCount);
+		}
+		if (!finished)
+		{
+			std::this_thread::sleep_for(std::chrono::microseconds(200));
+		}
+	}
+
+	result.cpuTime_s = static_cast<double>(std::clock() - startCpuTime) / CLOCKS_PER_SEC;
+	result.allocations = get_allocation_count() - startAllocationCount;
+	result.frames = frameCount - startFrameCount;
+
+	const std::lock_guard<std::mutex> lock(runContext.mutex);
+	runContext.active = false;
+	for (std::uint32_t i = 0; i < sessionCount; i++)
+	{
+		if (0 != runContext.receiveTimestamps_us[i])
+		{
+			std::uint64_t latency_us = runContext.receiveTimestamps_us[i] - runContext.sendTimestamps_us[i];
+			result.totalLatency_us += latency_us;
+			result.maximumLatency_us = std::max(result.maximumLatency_us, latency_us);
+			result.elapsed_us = std::max(result.elapsed_us, runContext.receiveTimestamps_us[i] - startTime_us);
+		}
+	}
+
+	if (!allSent)
+	{
+		result.status = "rejected";
+	}
+	else if (!finished)
+	{
+		result.status = "timeout";
+		result.elapsed_us = SystemTiming::get_time_elapsed_us(startTime_us);
+	}
+	else if (runContext.corrupt)
+	{
+		result.status = "corrupt";
+	}
+	else
+	{
+		result.status = "ok";
+	}
+	return result;
+}
+
+std::vector<std::uint32_t> parse_list(const std::string &text)
+{
+	std::vector<std::uint32_t> values;
+	std::stringstream stream(text);
+	std::string item;
+	while (std::getline(stream, item, ','))
+	{
+		if (!item.empty())
+		{
+			values.push_back(static_cast<std::uint32_t>(std::stoul(item)));
+		}
+	}
+	return values;
+}
+
+void print_usage()
+{
+	std::cerr << "Usage: TransportLayerBenchmarkTarget [options]" << std::endl
+	          << "  --sizes <list>        Comma separated payload sizes in bytes (default 8,64,223,512,1785,16384,262144,1048576,16777216)" << std::endl
+	          << "  --sessions <list>     Comma separated numbers of concurrent sessions (default 1,4)" << std::endl
+	          << "  --windows <list>      Comma separated CTS/DPO window sizes in packets, 1 to 255 (default 16,255)" << std::endl
+	          << "  --repetitions <n>     Number of runs per combination (default 3)" << std::endl
+	          << "  --timeout <ms>        Max duration of a single run (default 120000)" << std::endl
+	          << "  --pipelining <list>   ETP window pipelining modes to test, 0 = off and 1 = on (default 0,1)" << std::endl
+	          << "  --iop <file>          Also send the contents of a file, for example an object pool, as a payload" << std::endl
+	          << "  --bam-gap <ms>        Time between BAM frames, 10 to 200 (default 10)" << std::endl
+	          << "  --output <file>       Also write the CSV results to a file" << std::endl
+	          << "  --no-low-latency      Process received frames on the periodic update only" << std::endl;
+}
+
+bool parse_arguments(int argc, char **argv, BenchmarkSettings &settings)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		std::string argument = argv[i];
+		bool hasValue = (i + 1 < argc);
+
+		if (("--sizes" == argument) && hasValue)
+		{
+			settings.payloadSizes = parse_list(argv[++i]);
+		}
+		else if (("--sessions" == argument) && hasValue)
+		{
+			settings.sessionCounts = parse_list(argv[++i]);
+		}
+		else if (("--windows" == argument) && hasValue)
+		{
+			settings.windowSizes = parse_list(argv[++i]);
+		}
+		else if (("--repetitions" == argument) && hasValue)
+		{
+			settings.repetitions = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+		}
+		else if (("--timeout" == argument) && hasValue)
+		{
+			settings.timeout_ms = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+		}
+		else if (("--pipelining" == argument) && hasValue)
+		{
+			settings.pipeliningModes = parse_list(argv[++i]);
+		}
+		else if (("--iop" == argument) && hasValue)
+		{
+			settings.objectPoolPath = argv[++i];
+		}
+		else if (("--bam-gap" == argument) && hasValue)
+		{
+			settings.broadcastFrameGap_ms = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+		}
+		else if (("--output" == argument) && hasValue)
+		{
+			settings.outputPath = argv[++i];
+		}
+		else if ("--no-low-latency" == argument)
+		{
+			settings.lowLatency = false;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	for (auto window : settings.windowSizes)
+	{
+		if ((0 == window) || (window > 255))
+		{
+			return false;
+		}
+	}
+	for (auto pipelining : settings.pipeliningModes)
+	{
+		if (pipelining > 1)
+		{
+			return false;
+		}
+	}
+	return (!settings.payloadSizes.empty()) && (!settings.sessionCounts.empty()) && (!settings.windowSizes.empty()) && (!settings.pipeliningModes.empty());
+}
+
+NAME create_benchmark_name(std::uint32_t identityNumber)
+{
+	NAME name(0);
+	name.set_arbitrary_address_capable(true);
+	name.set_industry_group(1);
+	name.set_device_class(0);
+	name.set_function_code(static_cast<std::uint8_t>(NAME::Function::SteeringControl));
+	name.set_identity_number(identityNumber);
+	name.set_ecu_instance(0);
+	name.set_function_instance(0);
+	name.set_device_class_instance(0);
+	name.set_manufacturer_code(1407);
+	return name;
+}
+
+void set_pipelining_partner(CANNetworkConfiguration &configuration, NAME partnerNAME, bool pipelining)
+{
+	if (pipelining)
+	{
+		configuration.add_extended_transport_protocol_pipelining_partner(partnerNAME);
+	}
+	else
+	{
+		configuration.remove_extended_transport_protocol_pipelining_partner(partnerNAME);
+	}
+}
+
+// The benchmark sends messages of every combination of mode, size, session count and window size between two
+// virtual CAN channels, and prints one CSV line per run
+int main(int argc, char **argv)
+{
+	std::signal(SIGINT, signal_handler);
+
+	BenchmarkSettings settings;
+	if (!parse_arguments(argc, argv, settings))
+	{
+		print_usage();
+		return -1;
+	}
+
+	std::vector<std::uint8_t> objectPool;
+	if (!settings.objectPoolPath.empty())
+	{
+		std::ifstream objectPoolFile(settings.objectPoolPath, std::ios::binary);
+		if (!objectPoolFile.is_open())
+		{
+			std::cerr << "Failed to open " << settings.objectPoolPath << std::endl;
+			return -1;
+		}
+		objectPool.assign(std::istreambuf_iterator<char>(objectPoolFile), std::istreambuf_iterator<char>());
+		if (objectPool.empty())
+		{
+			std::cerr << settings.objectPoolPath << " is empty." << std::endl;
+			return -1;
+		}
+		auto objectPoolSize = static_cast<std::uint32_t>(objectPool.size());
+		if (settings.payloadSizes.end() == std::find(settings.payloadSizes.begin(), settings.payloadSizes.end(), objectPoolSize))
+		{
+			settings.payloadSizes.push_back(objectPoolSize);
+		}
+	}
+
+#ifndef ISOBUS_VIRTUALCAN_AVAILABLE
+	std::cerr << "This benchmark requires the VirtualCAN plugin to be available. If using CMake, set the `-DCAN_DRIVER=VirtualCAN`." << std::endl;
+	return -2;
+#else
+	std::uint32_t maxSessions = *std::max_element(settings.sessionCounts.begin(), settings.sessionCounts.end());
+	std::uint32_t maxPayloadSize = *std::max_element(settings.payloadSizes.begin(), settings.payloadSizes.end());
+	if ((0 == maxSessions) || (maxSessions > 16) || (0 == maxPayloadSize) || (maxPayloadSize > MAX_ETP_MESSAGE_SIZE_BYTES))
+	{
+		std::cerr << "Session counts must be between 1 and 16, payload sizes between 1 and " << MAX_ETP_MESSAGE_SIZE_BYTES << " bytes." << std::endl;
+		return -1;
+	}
+
+	std::shared_ptr<CANHardwarePlugin> originatorDriver = std::make_shared<VirtualCANPlugin>("benchmark-channel");
+	std::shared_ptr<CANHardwarePlugin> recipientDriver = std::make_shared<VirtualCANPlugin>("benchmark-channel");
+
+	CANHardwareInterface::set_number_of_can_channels(2, 1000);
+	CANHardwareInterface::assign_can_channel_frame_handler(0, originatorDriver);
+	CANHardwareInterface::assign_can_channel_frame_handler(1, recipientDriver);
+	CANHardwareInterface::set_low_latency_mode(settings.lowLatency);
+	CANHardwareInterface::get_can_frame_transmitted_event_dispatcher().add_listener([](const CANMessageFrame &) { frameCount++; });
+
+	if ((!CANHardwareInterface::start()) || (!originatorDriver->get_is_valid()) || (!recipientDriver->get_is_valid()))
+	{
+		std::cerr << "Failed to start hardware interface. The CAN driver might be invalid." << std::endl;
+		return -3;
+	}
+
+	CANNetworkConfiguration &configuration = CANNetworkManager::CANNetwork.get_configuration();
+	configuration.set_max_number_transport_protocol_sessions(4 * maxSessions);
+	configuration.set_minimum_time_between_transport_protocol_bam_frames(settings.broadcastFrameGap_ms);
+
+	// Each session gets its own pair of control functions, as only one session can run between two control functions at a time
+	std::vector<std::shared_ptr<InternalControlFunction>> originators;
+	std::vector<std::shared_ptr<PartneredControlFunction>> recipients;
+	std::vector<std::shared_ptr<InternalControlFunction>> recipientECUs;
+	std::vector<std::shared_ptr<PartneredControlFunction>> originatorPartners;
+	for (std::uint32_t i = 0; i < maxSessions; i++)
+	{
+		const NAMEFilter filterOriginator(NAME::NAMEParameters::IdentityNumber, 100 + i);
+		const NAMEFilter filterRecipient(NAME::NAMEParameters::IdentityNumber, 200 + i);
+		originators.push_back(CANNetworkManager::CANNetwork.create_internal_control_function(create_benchmark_name(100 + i), 0, static_cast<std::uint8_t>(FIRST_ORIGINATOR_ADDRESS + i)));
+		recipients.push_back(CANNetworkManager::CANNetwork.create_partnered_control_function(0, { filterRecipient }));
+		recipientECUs.push_back(CANNetworkManager::CANNetwork.create_internal_control_function(create_benchmark_name(200 + i), 1, static_cast<std::uint8_t>(FIRST_RECIPIENT_ADDRESS + i)));
+		originatorPartners.push_back(CANNetworkManager::CANNetwork.create_partnered_control_function(1, { filterOriginator }));
+	}
+
+	// We want to make sure address claiming is successful before continuing
+	auto addressClaimedFuture = std::async(std::launch::async, [&originators, &recipients, &recipientECUs, &originatorPartners]() {
+		auto addressValid = [](const std::shared_ptr<ControlFunction> &controlFunction) { return controlFunction->get_address_valid(); };
+		while ((!std::all_of(originators.begin(), originators.end(), addressValid)) ||
+		       (!std::all_of(recipients.begin(), recipients.end(), addressValid)) ||
+		       (!std::all_of(recipientECUs.begin(), recipientECUs.end(), addressValid)) ||
+		       (!std::all_of(originatorPartners.begin(), originatorPartners.end(), addressValid)))
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		}
+	});
+	if (addressClaimedFuture.wait_for(std::chrono::seconds(5)) == std::future_status::timeout)
+	{
+		std::cerr << "Address claiming failed. Please make sure that your internal control function can claim a valid address." << std::endl;
+		CANHardwareInterface::stop();
+		return -4;
+	}
+
+	// The object pool, if any, goes at the start of the buffer so a run of exactly its size sends the real pool
+	sendBuffer.reserve(maxPayloadSize);
+	sendBuffer.insert(sendBuffer.end(), objectPool.begin(), objectPool.end());
+	for (std::uint32_t i = static_cast<std::uint32_t>(sendBuffer.size()); i < maxPayloadSize; i++)
+	{
+		sendBuffer.push_back(static_cast<std::uint8_t>(i % 0xFF));
+	}
+
+	CANNetworkManager::CANNetwork.add_any_control_function_parameter_group_number_callback(PARAMETER_GROUP_NUMBER, on_message_received, nullptr);
+	CANNetworkManager::CANNetwork.get_fast_packet_protocol(1)->register_multipacket_message_callback(FAST_PACKET_PARAMETER_GROUP_NUMBER, on_message_received, nullptr);
+
+	std::ofstream outputFile;
+	if (!settings.outputPath.empty())
+	{
+		outputFile.open(settings.outputPath);
+	}
+
+	std::stringstream header;
+	header << "mode,protocol,payload_bytes,sessions,window_packets,pipelined,repetition,status,elapsed_us,throughput_bytes_per_s,"
+	       << "latency_avg_us,latency_max_us,frames,cpu_ns_per_byte,allocations_per_message";
+	std::cout << header.str() << std::endl;
+	if (outputFile.is_open())
+	{
+		outputFile << header.str() << std::endl;
+	}
+
+	const std::vector<TransferMode> modes = { TransferMode::DestinationSpecific, TransferMode::SharedSource, TransferMode::Broadcast, TransferMode::FastPacket };
+	for (auto mode : modes)
+	{
+		const bool connectionMode = (TransferMode::DestinationSpecific == mode) || (TransferMode::SharedSource == mode);
+
+		for (auto payloadSize : settings.payloadSizes)
+		{
+			// Only destination specific runs send single frames, the other modes only handle messages that don't fit in one, up to their own maximum size
+			if ((TransferMode::DestinationSpecific != mode) && (payloadSize <= CAN_DATA_LENGTH))
+			{
+				continue;
+			}
+			if (((TransferMode::FastPacket == mode) && (payloadSize > MAX_FAST_PACKET_MESSAGE_SIZE_BYTES)) ||
+			    ((TransferMode::Broadcast == mode) && (payloadSize > MAX_TP_MESSAGE_SIZE_BYTES)))
+			{
+				continue;
+			}
+
+			// Only connection mode sessions have a window, the other modes run once with the window reported as 0
+			std::vector<std::uint32_t> windows = { 0 };
+			if (connectionMode && (payloadSize > CAN_DATA_LENGTH))
+			{
+				windows = settings.windowSizes;
+			}
+
+			// Window pipelining only applies to extended transport protocol sessions, the others run once with it reported as 0
+			std::vector<std::uint32_t> pipeliningModes = { 0 };
+			if (connectionMode && (payloadSize > MAX_TP_MESSAGE_SIZE_BYTES))
+			{
+				pipeliningModes = settings.pipeliningModes;
+			}
+
+			for (auto window : windows)
+			{
+				if (0 != window)
+				{
+					configuration.set_number_of_packets_per_cts_message(static_cast<std::uint8_t>(window));
+					configuration.set_number_of_packets_per_dpo_message(static_cast<std::uint8_t>(window));
+				}
+
+				for (auto pipelining : pipeliningModes)
+				{
+					// Every control function in the benchmark uses this stack, so all of them can pipeline with each other
+					for (const auto &controlFunction : originators)
+					{
+						set_pipelining_partner(configuration, controlFunction->get_NAME(), 0 != pipelining);
+					}
+					for (const auto &controlFunction : recipientECUs)
+					{
+						set_pipelining_partner(configuration, controlFunction->get_NAME(), 0 != pipelining);
+					}
+
+					for (auto sessionCount : settings.sessionCounts)
+					{
+						for (std::uint32_t repetition = 0; (repetition < settings.repetitions) && running; repetition++)
+						{
+							std::cerr << "Running " << get_mode_name(mode) << " " << payloadSize << " bytes, " << sessionCount << " session(s), window " << window << ", pipelining " << pipelining << ", repetition " << repetition << std::endl;
+							BenchmarkResult result = run_benchmark(mode, payloadSize, sessionCount, settings, originators, recipients, recipientECUs);
+
+							std::uint64_t totalBytes = static_cast<std::uint64_t>(payloadSize) * sessionCount;
+							std::stringstream line;
+							line << get_mode_name(mode) << ','
+							     << get_protocol_name(mode, payloadSize) << ','
+							     << payloadSize << ','
+							     << sessionCount << ','
+							     << window << ','
+							     << pipelining << ','
+							     << repetition << ','
+							     << result.status << ','
+							     << result.elapsed_us << ','
+							     << ((result.elapsed_us > 0) ? (totalBytes * 1000000 / result.elapsed_us) : 0) << ','
+							     << (result.totalLatency_us / sessionCount) << ','
+							     << result.maximumLatency_us << ','
+							     << result.frames << ','
+							     << (result.cpuTime_s * 1e9 / static_cast<double>(totalBytes)) << ','
+							     << (static_cast<double>(result.allocations) / sessionCount);
+							std::cout << line.str() << std::endl;
+							if (outputFile.is_open())
+							{
+								outputFile << line.str() << std::endl;
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+#endif
+	CANHardwareInterface::stop();
+	return 0;
+}
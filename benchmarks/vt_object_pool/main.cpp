@@ -0,0 +1,301 @@
+#include "isobus/isobus/isobus_virtual_terminal_object_pool_snapshot.hpp"
+#include "isobus/isobus/isobus_virtual_terminal_objects.hpp"
+#include "isobus/isobus/isobus_virtual_terminal_server_managed_working_set.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace isobus;
+
+/// @brief The settings of the benchmark, which can be changed from the command line
+struct BenchmarkSettings
+{
+	std::uint32_t numberOfObjects = 5000; ///< The number of objects in the generated pool
+	std::uint32_t repetitions = 100; ///< How many times the whole pool is validated
+	std::string objectPoolPath; ///< If not empty, this IOP file is validated instead of a generated pool
+	bool measureLoading = false; ///< Measure loading the IOP file as a stored version, with and without a snapshot, instead of validating it
+};
+
+/// @brief The results of validating a pool
+struct BenchmarkResult
+{
+	std::uint64_t elapsed_ns = 0; ///< The time it took to validate every object in the pool for all repetitions
+	std::uint32_t numberOfObjects = 0; ///< The number of objects in the pool
+	std::uint32_t invalidObjects = 0; ///< The number of objects that failed validation
+};
+
+/// @brief Generates a pool of data masks filled with output fields that reference variables and a shared font
+/// @param[in] numberOfObjects The number of objects to generate
+/// @param[out] objects The table to add the generated objects to
+void generate_object_pool(std::uint32_t numberOfObjects, VTObjectTable &objects)
+{
+	constexpr std::uint16_t WORKING_SET_ID = 0;
+	constexpr std::uint16_t FONT_ATTRIBUTES_ID = 1;
+	constexpr std::uint32_t CHILDREN_PER_MASK = 32;
+
+	auto workingSet = std::make_shared<WorkingSet>();
+	workingSet->set_id(WORKING_SET_ID);
+	objects[WORKING_SET_ID] = workingSet;
+
+	auto fontAttributes = std::make_shared<FontAttributes>();
+	fontAttributes->set_id(FONT_ATTRIBUTES_ID);
+	objects[FONT_ATTRIBUTES_ID] = fontAttributes;
+
+	std::uint32_t objectCount = 2;
+	std::uint16_t nextID = 1000;
+	std::shared_ptr<DataMask> currentMask;
+
+	while (objectCount < numberOfObjects)
+	{
+		if ((nullptr == currentMask) || (currentMask->get_number_children() >= CHILDREN_PER_MASK))
+		{
+			currentMask = std::make_shared<DataMask>();
+			currentMask->set_id(nextID++);
+			objects[currentMask->get_id()] = currentMask;
+			objectCount++;
+			if (NULL_OBJECT_ID == workingSet->get_active_mask())
+			{
+				workingSet->set_active_mask(currentMask->get_id());
+			}
+			continue;
+		}
+
+		// Alternate between string and number fields, each with its own variable
+		if (0 == (objectCount % 4))
+		{
+			auto variable = std::make_shared<NumberVariable>();
+			variable->set_id(nextID++);
+			objects[variable->get_id()] = variable;
+
+			auto field = std::make_shared<OutputNumber>();
+			field->set_id(nextID++);
+			field->set_font_attributes(FONT_ATTRIBUTES_ID);
+			field->set_variable_reference(variable->get_id());
+			objects[field->get_id()] = field;
+			currentMask->add_child(field->get_id(), 0, 0);
+		}
+		else
+		{
+			auto variable = std::make_shared<StringVariable>();
+			variable->set_id(nextID++);
+			objects[variable->get_id()] = variable;
+
+			auto field = std::make_shared<OutputString>();
+			field->set_id(nextID++);
+			field->set_font_attributes(FONT_ATTRIBUTES_ID);
+			field->set_variable_reference(variable->get_id());
+			objects[field->get_id()] = field;
+			currentMask->add_child(field->get_id(), 0, 0);
+		}
+		objectCount += 2;
+	}
+}
+
+/// @brief Validates every object in a pool a number of times
+/// @param[in] objects The pool to validate
+/// @param[in] repetitions How many times to validate the whole pool
+/// @returns The time it took and the number of invalid objects
+BenchmarkResult validate_object_pool(const VTObjectTable &objects, std::uint32_t repetitions)
+{
+	BenchmarkResult result;
+	std::vector<VTObject *> objectList;
+	for (const auto &object : objects)
+	{
+		objectList.push_back(object.get());
+	}
+	result.numberOfObjects = static_cast<std::uint32_t>(objectList.size());
+
+	auto start = std::chrono::steady_clock::now();
+	for (std::uint32_t repetition = 0; repetition < repetitions; repetition++)
+	{
+		std::uint32_t invalidObjects = 0;
+		for (const auto object : objectList)
+		{
+			if (!object->get_is_valid(objects))
+			{
+				invalidObjects++;
+			}
+		}
+		result.invalidObjects = invalidObjects;
+	}
+	result.elapsed_ns = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+	return result;
+}
+
+/// @brief The results of loading an IOP file as a stored version
+struct LoadBenchmarkResult
+{
+	std::uint64_t fullParse_ns = 0; ///< The time it took to decode and validate the pool for all repetitions
+	std::uint64_t snapshotLoad_ns = 0; ///< The time it took to check the snapshot and decode the pool from it for all repetitions
+	std::size_t numberOfObjects = 0; ///< The number of objects in the pool
+	std::size_t snapshotLength = 0; ///< The size of the snapshot in bytes
+	bool success = false; ///< Stores if every load succeeded
+};
+
+/// @brief Loads an object pool a number of times the way a VT server loads a stored version, once by parsing
+/// and validating the whole pool and once from a snapshot of it
+/// @param[in] objectPool The object pool to load
+/// @param[in] repetitions How many times to load the pool each way
+/// @returns The time each way of loading the pool took
+LoadBenchmarkResult load_object_pool(const std::vector<std::uint8_t> &objectPool, std::uint32_t repetitions)
+{
+	LoadBenchmarkResult result;
+	std::uint32_t invalidObjects = 0;
+	result.success = true;
+
+	auto start = std::chrono::steady_clock::now();
+	for (std::uint32_t repetition = 0; (repetition < repetitions) && result.success; repetition++)
+	{
+		VirtualTerminalServerManagedWorkingSet workingSet;
+		std::vector<std::uint8_t> storedVersion = objectPool;
+		result.success = workingSet.parse_iop_into_objects(storedVersion.data(), static_cast<std::uint32_t>(storedVersion.size()));
+
+		invalidObjects = 0;
+		for (const auto &object : workingSet.get_object_tree())
+		{
+			if (!object->get_is_valid(workingSet.get_object_tree()))
+			{
+				invalidObjects++;
+			}
+		}
+		result.numberOfObjects = workingSet.get_object_tree().size();
+	}
+	result.fullParse_ns = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+
+	// The snapshot is created from a parsed pool, the way a server creates one when a version is stored
+	VirtualTerminalServerManagedWorkingSet parsedWorkingSet;
+	std::vector<std::uint8_t> parsedPool = objectPool;
+	result.success = result.success && parsedWorkingSet.parse_iop_into_objects(parsedPool.data(), static_cast<std::uint32_t>(parsedPool.size()));
+	const std::uint16_t workingSetID = (nullptr != parsedWorkingSet.get_working_set_object()) ? parsedWorkingSet.get_working_set_object()->get_id() : NULL_OBJECT_ID;
+	const std::vector<std::uint8_t> snapshotData = VirtualTerminalObjectPoolSnapshot::create({ objectPool }, parsedWorkingSet.get_object_tree(), workingSetID, invalidObjects);
+	result.snapshotLength = snapshotData.size();
+	result.success = result.success && (!snapshotData.empty());
+
+	start = std::chrono::steady_clock::now();
+	for (std::uint32_t repetition = 0; (repetition < repetitions) && result.success; repetition++)
+	{
+		VirtualTerminalServerManagedWorkingSet workingSet;
+		std::vector<std::uint8_t> storedVersion = objectPool;
+		const VirtualTerminalObjectPoolSnapshot snapshot(snapshotData.data(), snapshotData.size());
+		result.success = workingSet.parse_iop_into_objects(snapshot, storedVersion.data(), static_cast<std::uint32_t>(storedVersion.size())) &&
+		  (workingSet.get_object_tree().size() == result.numberOfObjects);
+	}
+	result.snapshotLoad_ns = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+	return result;
+}
+
+void print_usage()
+{
+	std::cerr << "Usage: VTObjectPoolBenchmarkTarget [options]" << std::endl
+	          << "  --objects <n>         Number of objects in the generated pool (default 5000)" << std::endl
+	          << "  --repetitions <n>     Number of times the whole pool is validated (default 100)" << std::endl
+	          << "  --iop <file>          Validate the objects of an IOP file instead of a generated pool" << std::endl
+	          << "  --load                Measure loading the IOP file as a stored version, with and without a snapshot" << std::endl;
+}
+
+bool parse_arguments(int argc, char **argv, BenchmarkSettings &settings)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		std::string argument = argv[i];
+		bool hasValue = (i + 1 < argc);
+
+		if (("--objects" == argument) && hasValue)
+		{
+			settings.numberOfObjects = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+		}
+		else if (("--repetitions" == argument) && hasValue)
+		{
+			settings.repetitions = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+		}
+		else if (("--iop" == argument) && hasValue)
+		{
+			settings.objectPoolPath = argv[++i];
+		}
+		else if ("--load" == argument)
+		{
+			settings.measureLoading = true;
+		}
+		else
+		{
+			return false;
+		}
+	}
+	return (settings.numberOfObjects > 0) &&
+	  (settings.numberOfObjects < NULL_OBJECT_ID - 1000) &&
+	  (settings.repetitions > 0) &&
+	  ((!settings.measureLoading) || (!settings.objectPoolPath.empty()));
+}
+
+// The benchmark validates every object of a VT object pool against the rest of the pool, the way a VT server
+// checks a pool after it has been uploaded, and prints the result as CSV
+int main(int argc, char **argv)
+{
+	BenchmarkSettings settings;
+	if (!parse_arguments(argc, argv, settings))
+	{
+		print_usage();
+		return -1;
+	}
+
+	VirtualTerminalServerManagedWorkingSet workingSet;
+	VTObjectTable generatedObjects;
+	const VTObjectTable *objects = &generatedObjects;
+	std::string poolName = "generated";
+
+	if (!settings.objectPoolPath.empty())
+	{
+		std::ifstream objectPoolFile(settings.objectPoolPath, std::ios::binary);
+		std::vector<std::uint8_t> objectPool((std::istreambuf_iterator<char>(objectPoolFile)), std::istreambuf_iterator<char>());
+
+		if (objectPool.empty() || (!workingSet.parse_iop_into_objects(objectPool.data(), static_cast<std::uint32_t>(objectPool.size()))))
+		{
+			std::cerr << "Failed to parse " << settings.objectPoolPath << std::endl;
+			return -2;
+		}
+		objects = &workingSet.get_object_tree();
+		poolName = settings.objectPoolPath;
+
+		if (settings.measureLoading)
+		{
+			LoadBenchmarkResult loadResult = load_object_pool(objectPool, settings.repetitions);
+
+			if (!loadResult.success)
+			{
+				std::cerr << "Failed to load " << settings.objectPoolPath << " from a snapshot" << std::endl;
+				return -3;
+			}
+			std::cout << "pool,objects,pool_bytes,snapshot_bytes,repetitions,full_parse_us_per_load,snapshot_load_us_per_load" << std::endl
+			          << poolName << ','
+			          << loadResult.numberOfObjects << ','
+			          << objectPool.size() << ','
+			          << loadResult.snapshotLength << ','
+			          << settings.repetitions << ','
+			          << (static_cast<double>(loadResult.fullParse_ns) / (1000.0 * settings.repetitions)) << ','
+			          << (static_cast<double>(loadResult.snapshotLoad_ns) / (1000.0 * settings.repetitions)) << std::endl;
+			return 0;
+		}
+	}
+	else
+	{
+		generate_object_pool(settings.numberOfObjects, generatedObjects);
+	}
+
+	BenchmarkResult result = validate_object_pool(*objects, settings.repetitions);
+	std::uint64_t validations = static_cast<std::uint64_t>(result.numberOfObjects) * settings.repetitions;
+
+	std::cout << "pool,objects,repetitions,elapsed_us,validation_ns_per_object,invalid_objects" << std::endl
+	          << poolName << ','
+	          << result.numberOfObjects << ','
+	          << settings.repetitions << ','
+	          << (result.elapsed_ns / 1000) << ','
+	          << ((validations > 0) ? (static_cast<double>(result.elapsed_ns) / static_cast<double>(validations)) : 0.0) << ','
+	          << result.invalidObjects << std::endl;
+	return 0;
+}
@@ -48,13 +48,13 @@ bool collect_masks(std::uint8_t *pool, std::uint32_t size)
 	{
 		using ObjType = isobus::VirtualTerminalObjectType;
 
-		if (obj.second->get_object_type() == ObjType::DataMask || obj.second->get_object_type() == ObjType::AlarmMask)
+		if (obj->get_object_type() == ObjType::DataMask || obj->get_object_type() == ObjType::AlarmMask)
 		{
-			availableMasks.push_back({ obj.first, obj.second->get_object_type() == ObjType::AlarmMask });
+			availableMasks.push_back({ obj->get_id(), obj->get_object_type() == ObjType::AlarmMask });
 		}
-		else if (obj.second->get_object_type() == ObjType::WorkingSet)
+		else if (obj->get_object_type() == ObjType::WorkingSet)
 		{
-			wsID = obj.first;
+			wsID = obj->get_id();
 		}
 	}
 	return true;
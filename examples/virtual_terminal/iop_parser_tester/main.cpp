@@ -39,5 +39,11 @@ int main(int argc, char *argv[])
 	                                        static_cast<std::uint32_t>(buffer.size()));
 
 	std::cout << "IOP parse result: " << std::boolalpha << result << "\n";
+
+	const auto &arena = vt.get_object_arena();
+	std::cout << "Objects: " << vt.get_object_tree().size() << "\n"
+	          << "Allocations served by the object arena: " << arena.get_number_of_allocations() << "\n"
+	          << "Heap allocations made by the object arena: " << arena.get_number_of_blocks() << "\n"
+	          << "Object arena bytes used: " << arena.get_bytes_used() << " of " << arena.get_bytes_reserved() << "\n";
 	return 0;
 }
@@ -15,6 +15,7 @@
 #include "isobus/isobus/can_message_frame.hpp"
 #include "isobus/utility/event_dispatcher.hpp"
 
+#include <array>
 #include <atomic>
 #include <cstdint>
 #include <cstring>
@@ -36,6 +37,27 @@ namespace isobus
 	class CANHardwareInterface
 	{
 	public:
+		/// @brief The number of CAN priority levels, each channel has a transmit queue for each of them
+		static constexpr std::uint8_t NUMBER_OF_TRANSMIT_PRIORITIES = 8;
+
+		/// @brief Statistics about the transmit queues of a single CAN channel, indexed by CAN priority (0 is the highest)
+		struct TransmitQueueStatistics
+		{
+			std::array<std::size_t, NUMBER_OF_TRANSMIT_PRIORITIES> queueDepth = {}; ///< The number of frames currently waiting in each queue
+			std::array<std::size_t, NUMBER_OF_TRANSMIT_PRIORITIES> maxQueueDepth = {}; ///< The highest number of frames seen waiting in each queue
+			std::uint64_t numberOfStarvationOverrides = 0; ///< The number of times lower priority frames were sent ahead of higher priority ones to avoid starvation
+		};
+
+		/// @brief Statistics about how long received frames take to reach the stack, for a single CAN channel
+		/// @details The latency of a frame is measured from the moment it was read from the driver,
+		/// until the network manager update that processed it (and invoked its callbacks) returned.
+		struct ReceiveLatencyStatistics
+		{
+			std::uint64_t numberOfFrames = 0; ///< The number of frames that were measured
+			std::uint64_t totalLatency_us = 0; ///< The sum of the latency of all measured frames, in microseconds
+			std::uint64_t maxLatency_us = 0; ///< The highest latency of a single frame, in microseconds
+		};
+
 		/// @brief Returns the number of configured CAN channels that the class is managing
 		/// @returns The number of configured CAN channels that the class is managing
 		static std::uint8_t get_number_of_can_channels();
@@ -46,7 +68,7 @@ namespace isobus
 		/// already configured, it will delete the unneeded `CanHardware` objects.
 		/// @note The function will fail if the channel is already assigned to a driver or the interface is already started
 		/// @param value The number of CAN channels to manage
-		/// @param queueCapacity The capacity of the transmit and receive queues
+		/// @param queueCapacity The capacity of the receive queue, and of each of the per-priority transmit queues
 		/// @returns `true` if the channel count was set, otherwise `false`.
 		static bool set_number_of_can_channels(std::uint8_t value, std::size_t queueCapacity = 40);
 
@@ -81,6 +103,9 @@ namespace isobus
 		static bool is_running();
 
 		/// @brief Called externally, adds a message to a CAN channel's Tx queue
+		/// @details Each channel has a Tx queue per CAN priority, and frames in higher priority queues
+		/// are sent first. Frames of the same priority are sent in the order they were added, but a frame
+		/// may be sent before lower priority frames that were added earlier, just like it would win arbitration on the bus.
 		/// @param[in] frame The frame to add to the Tx queue
 		/// @returns `true` if the frame was accepted, otherwise `false` (maybe wrong channel assigned)
 		static bool transmit_can_frame(const CANMessageFrame &frame);
@@ -109,13 +134,76 @@ namespace isobus
 		/// @returns The interval between update calls in milliseconds
 		static std::uint32_t get_periodic_update_interval();
 
+		/// @brief Enables or disables low latency mode (disabled by default)
+		/// @details Normally, received frames are handed to the network manager right away, but the network manager
+		/// only processes them in its next periodic update, which can take up to a full update interval.
+		/// In low latency mode, the network manager is also updated as soon as frames are received,
+		/// which means callbacks are invoked without waiting for the periodic update, at the cost of more CPU time.
+		/// The periodic update event is still only invoked on the update interval.
+		/// @param[in] enabled `true` to enable low latency mode, `false` to disable it
+		static void set_low_latency_mode(bool enabled);
+
+		/// @brief Returns if low latency mode is enabled
+		/// @returns `true` if low latency mode is enabled, otherwise `false`
+		static bool get_low_latency_mode();
+
+		/// @brief Returns the receive latency statistics of a CAN channel
+		/// @param[in] channelIndex The channel to get the statistics for
+		/// @returns The receive latency statistics of the channel, or empty statistics if the channel does not exist
+		static ReceiveLatencyStatistics get_receive_latency_statistics(std::uint8_t channelIndex);
+
+		/// @brief Resets the receive latency statistics of a CAN channel
+		/// @param[in] channelIndex The channel to reset the statistics for
+		static void reset_receive_latency_statistics(std::uint8_t channelIndex);
+
+		/// @brief Sets how many frames may be sent from higher priority Tx queues while lower priority frames are waiting
+		/// @details Once this many frames were sent in a row while lower priority frames were waiting, every waiting
+		/// lower priority queue gets to send one frame, so that a steady stream of high priority traffic
+		/// can never completely block the rest. The default is 32, set it to 0 to always send in strict priority order.
+		/// @param[in] numberOfFrames The max number of higher priority frames to send in a row
+		static void set_transmit_starvation_limit(std::uint32_t numberOfFrames);
+
+		/// @brief Returns how many frames may be sent from higher priority Tx queues while lower priority frames are waiting
+		/// @returns The max number of higher priority frames to send in a row, or 0 if starvation protection is disabled
+		static std::uint32_t get_transmit_starvation_limit();
+
+		/// @brief Returns the transmit queue statistics of a CAN channel
+		/// @param[in] channelIndex The channel to get the statistics for
+		/// @returns The transmit queue statistics of the channel, or empty statistics if the channel does not exist
+		static TransmitQueueStatistics get_transmit_queue_statistics(std::uint8_t channelIndex);
+
+		/// @brief Resets the max queue depths and starvation override count of a CAN channel
+		/// @param[in] channelIndex The channel to reset the statistics for
+		static void reset_transmit_queue_statistics(std::uint8_t channelIndex);
+
 	private:
+		/// @brief The max number of frames to read from a driver in one go
+		static constexpr std::size_t RECEIVE_BATCH_SIZE = 32;
+
+		/// @brief The max number of frames to hand to a driver in one go
+		static constexpr std::size_t TRANSMIT_BATCH_SIZE = 32;
+
+		/// @brief A frame in a channel's receive queue, along with the time it was read from the driver
+		struct ReceivedFrame
+		{
+			CANMessageFrame frame; ///< The frame that was received
+			std::uint64_t receivedTimestamp_us; ///< The time the frame was read from the driver, in microseconds
+		};
+
+		/// @brief Scheduling information about a frame in a channel's transmit buffer
+		struct TransmitBufferInfo
+		{
+			std::uint32_t starvationCount; ///< The number of higher priority frames sent in a row while lower priority frames were waiting, once this frame is sent
+			std::uint8_t priority; ///< The transmit queue the frame came from
+			bool starvationOverride; ///< If this frame was the first one let through by starvation protection
+		};
+
 		/// @brief Stores the data for a single CAN channel
 		class CANHardware
 		{
 		public:
 			/// @brief Constructor for the CANHardware
-			/// @param[in] queueCapacity The capacity of the transmit and receive queues
+			/// @param[in] queueCapacity The capacity of the receive queue, and of each of the per-priority transmit queues
 			explicit CANHardware(std::size_t queueCapacity);
 
 			/// @brief Destructor for the CANHardware
@@ -129,14 +217,23 @@ namespace isobus
 			/// @returns `true` if the channel was stopped, otherwise `false`
 			bool stop();
 
-			/// @brief Try to transmit the frame to the hardware
-			/// @param[in] frame The frame to transmit
-			/// @returns `true` if the frame was transmitted, otherwise `false`
-			bool transmit_can_frame(const CANMessageFrame &frame) const;
+			/// @brief Try to transmit the frames at the start of the transmit buffer to the hardware
+			/// @param[in] numberOfFrames The number of frames in the transmit buffer to transmit
+			/// @returns The number of frames, counted from the start of the buffer, that the hardware accepted
+			std::size_t transmit_can_frames(std::size_t numberOfFrames) const;
+
+			/// @brief Copies the next frames to send from the transmit queues into the transmit buffer, highest priority first
+			/// @details Frames stay in their queues until pop_transmitted_frames() is called for them
+			/// @returns The number of frames in the transmit buffer
+			std::size_t fill_transmit_buffer();
+
+			/// @brief Removes frames from the start of the transmit buffer from their transmit queues
+			/// @param[in] numberOfFrames The number of frames at the start of the transmit buffer that were transmitted
+			void pop_transmitted_frames(std::size_t numberOfFrames);
 
-			/// @brief Receives a frame from the hardware and adds it to the receive queue
-			/// @returns `true` if a frame was received, otherwise `false`
-			bool receive_can_frame();
+			/// @brief Receives a batch of frames from the hardware and adds them to the receive queue
+			/// @returns `true` if at least one frame was received, otherwise `false`
+			bool receive_can_frames();
 
 #if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
 			/// @brief Starts the receiving thread for this CAN channel
@@ -154,8 +251,17 @@ namespace isobus
 
 			std::shared_ptr<CANHardwarePlugin> frameHandler; ///< The CAN driver to use for a CAN channel
 
-			LockFreeQueue<CANMessageFrame> messagesToBeTransmittedQueue; ///< Transmit message queue for a CAN channel
-			LockFreeQueue<CANMessageFrame> receivedMessagesQueue; ///< Receive message queue for a CAN channel
+			std::array<std::unique_ptr<LockFreeMultiProducerQueue<CANMessageFrame>>, NUMBER_OF_TRANSMIT_PRIORITIES> messagesToBeTransmittedQueues; ///< Transmit message queues for a CAN channel, indexed by priority. Any thread may add frames to them
+			LockFreeQueue<ReceivedFrame> receivedMessagesQueue; ///< Receive message queue for a CAN channel
+			std::array<CANMessageFrame, RECEIVE_BATCH_SIZE> receiveBuffer; ///< Scratch buffer for reading a batch of frames from the driver
+			std::array<CANMessageFrame, TRANSMIT_BATCH_SIZE> transmitBuffer; ///< Scratch buffer for writing a batch of frames to the driver
+			std::array<TransmitBufferInfo, TRANSMIT_BATCH_SIZE> transmitBufferInfo; ///< Scheduling information about each frame in the transmit buffer
+			TransmitQueueStatistics transmitStatistics; ///< The transmit queue statistics for this channel
+			std::uint32_t framesSentWhileLowerPriorityWaiting = 0; ///< Higher priority frames sent in a row while lower priority frames were waiting
+			ReceiveLatencyStatistics latencyStatistics; ///< The receive latency statistics for this channel
+			std::uint64_t numberOfPendingFrames = 0; ///< Frames handed to the network manager since its last update
+			std::uint64_t pendingReceivedTimestampSum_us = 0; ///< The sum of the received timestamps of the pending frames
+			std::uint64_t oldestPendingReceivedTimestamp_us = 0; ///< The received timestamp of the oldest pending frame
 		};
 
 		/// @brief Singleton instance of the CANHardwareInterface class
@@ -172,6 +278,9 @@ namespace isobus
 		/// @brief The main thread loop for updating the stack
 		static void update_thread_function();
 
+		/// @brief Wakes up the update thread, even if it is currently busy and not waiting yet
+		static void wake_update_thread();
+
 		/// @brief Starts all threads related to the hardware interface
 		static void start_threads();
 
@@ -180,7 +289,11 @@ namespace isobus
 
 		static std::unique_ptr<std::thread> updateThread; ///< The main thread
 		static std::condition_variable updateThreadWakeupCondition; ///< A condition variable to allow for signaling the `updateThread` to wakeup
+		static std::atomic_bool updateThreadWakeupRequested; ///< Set when the `updateThread` should run again right after its current update
 #endif
+		/// @brief Adds the latency of all frames that were pending in the network manager to the channel statistics
+		static void update_receive_latency_statistics();
+
 		static std::uint32_t lastUpdateTimestamp; ///< The last time the network manager was updated
 		static std::uint32_t periodicUpdateInterval; ///< The period between calls to the network manager update function in milliseconds
 		static EventDispatcher<const CANMessageFrame &> frameReceivedEventDispatcher; ///< The event dispatcher for when a CAN message frame is received from hardware event
@@ -191,6 +304,8 @@ namespace isobus
 		static Mutex hardwareChannelsMutex; ///< Mutex to protect `hardwareChannels`
 		static Mutex updateMutex; ///< A mutex for the main thread
 		static std::atomic_bool started; ///< Stores if the threads have been started
+		static std::atomic_bool lowLatencyMode; ///< Stores if the network manager is updated as soon as frames are received
+		static std::uint32_t transmitStarvationLimit; ///< The max number of higher priority frames to send in a row while lower priority frames are waiting
 	};
 }
 #endif // CAN_HARDWARE_INTERFACE_HPP
@@ -9,8 +9,10 @@
 #ifndef CAN_HARDEWARE_PLUGIN_HPP
 #define CAN_HARDEWARE_PLUGIN_HPP
 
+#include <cstddef>
 #include <string>
 #include "isobus/isobus/can_message_frame.hpp"
+#include "isobus/utility/data_span.hpp"
 
 namespace isobus
 {
@@ -47,10 +49,44 @@ namespace isobus
 		/// @returns `true` if a CAN frame was read, otherwise `false`
 		virtual bool read_frame(isobus::CANMessageFrame &canFrame) = 0;
 
+		/// @brief Reads as many frames as are available from the bus, up to the size of the buffer supplied
+		/// @details Drivers that can fetch multiple frames from the hardware or OS in one go should override this
+		/// to reduce the per-frame overhead. The default implementation reads a single frame with read_frame().
+		/// Like read_frame(), this may block until at least one frame is available or the driver's timeout expires.
+		/// @param[in, out] canFrames The buffer to read the frames into
+		/// @returns The number of frames that were read into the start of the buffer
+		virtual std::size_t read_frames(DataSpan<isobus::CANMessageFrame> canFrames)
+		{
+			std::size_t retVal = 0;
+
+			if ((0 != canFrames.size()) && read_frame(canFrames[0]))
+			{
+				retVal = 1;
+			}
+			return retVal;
+		}
+
 		/// @brief Writes a frame to the bus (synchronous)
 		/// @param[in] canFrame The frame to write to the bus
 		/// @returns `true` if the frame was written, otherwise `false`
 		virtual bool write_frame(const isobus::CANMessageFrame &canFrame) = 0;
+
+		/// @brief Writes a batch of frames to the bus (synchronous)
+		/// @details Frames are written in order, and writing stops at the first frame that is not accepted.
+		/// The default implementation calls write_frame for each frame,
+		/// plugins that can hand several frames to their driver at once should override this.
+		/// @param[in] canFrames The frames to write to the bus
+		/// @returns The number of frames, counted from the start of the span, that were written
+		virtual std::size_t write_frames(DataSpan<const isobus::CANMessageFrame> canFrames)
+		{
+			std::size_t retVal = 0;
+
+			while ((retVal < canFrames.size()) && write_frame(canFrames[retVal]))
+			{
+				retVal++;
+			}
+			return retVal;
+		}
 	};
 }
 #endif // CAN_HARDEWARE_PLUGIN_HPP
@@ -58,17 +58,33 @@ namespace isobus
 		/// @returns `true` if a CAN frame was read, otherwise `false`
 		bool read_frame(isobus::CANMessageFrame &canFrame) override;
 
+		/// @brief Reads all frames that are waiting in the socket, up to the size of the buffer, with a single system call.
+		/// Waits up to 100 ms for the first frame to arrive. Hardware timestamps are kept for each frame.
+		/// @param[in, out] canFrames The buffer to read the frames into
+		/// @returns The number of frames that were read into the start of the buffer
+		std::size_t read_frames(DataSpan<isobus::CANMessageFrame> canFrames) override;
+
 		/// @brief Writes a frame to the bus (synchronous)
 		/// @param[in] canFrame The frame to write to the bus
 		/// @returns `true` if the frame was written, otherwise `false`
 		bool write_frame(const isobus::CANMessageFrame &canFrame) override;
 
+		/// @brief Writes a batch of frames to the bus with a single system call per 32 frames
+		/// @details Writing stops early if the socket's send buffer fills up, the rest of the
+		/// frames can be retried later.
+		/// @param[in] canFrames The frames to write to the bus
+		/// @returns The number of frames, counted from the start of the span, that were written
+		std::size_t write_frames(DataSpan<const isobus::CANMessageFrame> canFrames) override;
+
 		/// @brief Changes the name of the device to use, which only works if the device is not open
 		/// @param[in] newName The new name for the device (such as "can0" or "vcan0")
 		/// @returns `true` if the name was changed, otherwise `false` (if the device is open this will return false)
 		bool set_name(const std::string &newName);
 
 	private:
+		static constexpr std::size_t MAX_FRAMES_PER_READ = 32; ///< The max number of frames fetched from the socket per system call
+		static constexpr std::size_t MAX_FRAMES_PER_WRITE = 32; ///< The max number of frames handed to the socket per system call
+
 		struct sockaddr_can *pCANDevice; ///< The structure for CAN sockets
 		std::string name; ///< The device name
 		int fileDescriptor; ///< File descriptor for the socket
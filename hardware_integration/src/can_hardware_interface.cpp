@@ -8,6 +8,7 @@
 /// @copyright 2024 The Open-Agriculture Developers
 //================================================================================================
 #include "isobus/hardware_integration/can_hardware_interface.hpp"
+#include "isobus/isobus/can_identifier.hpp"
 #include "isobus/isobus/can_stack_logger.hpp"
 #include "isobus/utility/system_timing.hpp"
 #include "isobus/utility/to_string.hpp"
@@ -20,6 +21,7 @@ namespace isobus
 #if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
 	std::unique_ptr<std::thread> CANHardwareInterface::updateThread;
 	std::condition_variable CANHardwareInterface::updateThreadWakeupCondition;
+	std::atomic_bool CANHardwareInterface::updateThreadWakeupRequested = { false };
 #endif
 	std::uint32_t CANHardwareInterface::periodicUpdateInterval = PERIODIC_UPDATE_INTERVAL;
 	std::uint32_t CANHardwareInterface::lastUpdateTimestamp;
@@ -32,12 +34,30 @@ namespace isobus
 	Mutex CANHardwareInterface::hardwareChannelsMutex;
 	Mutex CANHardwareInterface::updateMutex;
 	std::atomic_bool CANHardwareInterface::started = { false };
+	std::atomic_bool CANHardwareInterface::lowLatencyMode = { false };
+	std::uint32_t CANHardwareInterface::transmitStarvationLimit = 32;
 
 	CANHardwareInterface CANHardwareInterface::SINGLETON;
 
+	/// @brief Returns the index of the transmit queue a frame belongs in
+	/// @param[in] frame The frame to get the transmit queue for
+	/// @returns The CAN priority of the frame, where 0 is the highest
+	static std::uint8_t get_transmit_priority(const CANMessageFrame &frame)
+	{
+		if (frame.isExtendedFrame)
+		{
+			return static_cast<std::uint8_t>(CANIdentifier(frame.identifier).get_priority());
+		}
+		return static_cast<std::uint8_t>(CANIdentifier::CANPriority::PriorityHighest0);
+	}
+
 	CANHardwareInterface::CANHardware::CANHardware(std::size_t queueCapacity) :
-	  messagesToBeTransmittedQueue(queueCapacity), receivedMessagesQueue(queueCapacity)
+	  receivedMessagesQueue(queueCapacity)
 	{
+		for (auto &queue : messagesToBeTransmittedQueues)
+		{
+			queue.reset(new LockFreeMultiProducerQueue<CANMessageFrame>(queueCapacity));
+		}
 	}
 
 	CANHardwareInterface::CANHardware::~CANHardware()
@@ -73,30 +93,151 @@ namespace isobus
 		{
 			frameHandler = nullptr;
 		}
-		messagesToBeTransmittedQueue.clear();
+		for (auto &queue : messagesToBeTransmittedQueues)
+		{
+			queue->clear();
+		}
+		framesSentWhileLowerPriorityWaiting = 0;
 		receivedMessagesQueue.clear();
+		numberOfPendingFrames = 0;
+		pendingReceivedTimestampSum_us = 0;
 		return false;
 	}
 
-	bool CANHardwareInterface::CANHardware::transmit_can_frame(const CANMessageFrame &frame) const
+	std::size_t CANHardwareInterface::CANHardware::transmit_can_frames(std::size_t numberOfFrames) const
 	{
-		if ((nullptr != frameHandler) && frameHandler->get_is_valid() && frameHandler->write_frame(frame))
+		if ((nullptr != frameHandler) && frameHandler->get_is_valid() && (0 != numberOfFrames))
 		{
-			return true;
+			return frameHandler->write_frames(DataSpan<const CANMessageFrame>(transmitBuffer.data(), numberOfFrames));
+		}
+		return 0;
+	}
+
+	std::size_t CANHardwareInterface::CANHardware::fill_transmit_buffer()
+	{
+		std::array<std::size_t, NUMBER_OF_TRANSMIT_PRIORITIES> numberOfFramesWaiting;
+		std::array<bool, NUMBER_OF_TRANSMIT_PRIORITIES> queueUsed = {};
+		std::uint32_t starvationCount = framesSentWhileLowerPriorityWaiting;
+		std::size_t numberOfFrames = 0;
+
+		for (std::uint8_t priority = 0; priority < NUMBER_OF_TRANSMIT_PRIORITIES; priority++)
+		{
+			numberOfFramesWaiting[priority] = messagesToBeTransmittedQueues[priority]->size();
+			transmitStatistics.maxQueueDepth[priority] = std::max(transmitStatistics.maxQueueDepth[priority], numberOfFramesWaiting[priority]);
+		}
+
+		// Each queue contributes at most one run of frames per batch, so that the batch can be popped per queue afterwards.
+		// The batch ends as soon as the highest priority queue with frames left has already contributed its run.
+		while (numberOfFrames < transmitBuffer.size())
+		{
+			std::uint8_t priority = 0;
+			while ((priority < NUMBER_OF_TRANSMIT_PRIORITIES) && (0 == numberOfFramesWaiting[priority]))
+			{
+				priority++;
+			}
+			if ((priority >= NUMBER_OF_TRANSMIT_PRIORITIES) || queueUsed[priority])
+			{
+				break;
+			}
+
+			bool lowerPriorityWaiting = false;
+			for (std::uint8_t i = priority + 1; i < NUMBER_OF_TRANSMIT_PRIORITIES; i++)
+			{
+				lowerPriorityWaiting = lowerPriorityWaiting || (0 != numberOfFramesWaiting[i]);
+			}
+
+			std::size_t maxNumberOfFrames = transmitBuffer.size() - numberOfFrames;
+			const std::uint32_t starvationLimit = transmitStarvationLimit;
+			if (lowerPriorityWaiting && (0 != starvationLimit))
+			{
+				if (starvationCount >= starvationLimit)
+				{
+					// Let every waiting lower priority queue send one frame before continuing in priority order
+					bool firstFrameOfOverride = true;
+					for (std::uint8_t i = priority + 1; (i < NUMBER_OF_TRANSMIT_PRIORITIES) && (numberOfFrames < transmitBuffer.size()); i++)
+					{
+						if ((!queueUsed[i]) && (1 == messagesToBeTransmittedQueues[i]->peek_batch(&transmitBuffer[numberOfFrames], 1)))
+						{
+							transmitBufferInfo[numberOfFrames].priority = i;
+							transmitBufferInfo[numberOfFrames].starvationCount = 0;
+							transmitBufferInfo[numberOfFrames].starvationOverride = firstFrameOfOverride;
+							firstFrameOfOverride = false;
+							numberOfFrames++;
+							numberOfFramesWaiting[i]--;
+							queueUsed[i] = true;
+						}
+					}
+					starvationCount = 0;
+					continue;
+				}
+				maxNumberOfFrames = std::min<std::size_t>(maxNumberOfFrames, starvationLimit - starvationCount);
+			}
+
+			const std::size_t numberOfFramesInRun = messagesToBeTransmittedQueues[priority]->peek_batch(&transmitBuffer[numberOfFrames], maxNumberOfFrames);
+			for (std::size_t i = 0; i < numberOfFramesInRun; i++)
+			{
+				starvationCount = lowerPriorityWaiting ? (starvationCount + 1) : 0;
+				transmitBufferInfo[numberOfFrames].priority = priority;
+				transmitBufferInfo[numberOfFrames].starvationCount = starvationCount;
+				transmitBufferInfo[numberOfFrames].starvationOverride = false;
+				numberOfFrames++;
+			}
+			queueUsed[priority] = true;
+
+			if (0 == numberOfFramesInRun)
+			{
+				// The frames counted in the queue are still being written by their producer
+				numberOfFramesWaiting[priority] = 0;
+			}
+			else
+			{
+				numberOfFramesWaiting[priority] -= numberOfFramesInRun;
+			}
+		}
+		return numberOfFrames;
+	}
+
+	void CANHardwareInterface::CANHardware::pop_transmitted_frames(std::size_t numberOfFrames)
+	{
+		std::array<std::size_t, NUMBER_OF_TRANSMIT_PRIORITIES> numberOfFramesPerQueue = {};
+
+		for (std::size_t i = 0; i < numberOfFrames; i++)
+		{
+			numberOfFramesPerQueue[transmitBufferInfo[i].priority]++;
+
+			if (transmitBufferInfo[i].starvationOverride)
+			{
+				transmitStatistics.numberOfStarvationOverrides++;
+			}
+		}
+		for (std::uint8_t priority = 0; priority < NUMBER_OF_TRANSMIT_PRIORITIES; priority++)
+		{
+			messagesToBeTransmittedQueues[priority]->pop_batch(numberOfFramesPerQueue[priority]);
+		}
+
+		// Only frames that were actually sent count towards starvation protection
+		if (0 != numberOfFrames)
+		{
+			framesSentWhileLowerPriorityWaiting = transmitBufferInfo[numberOfFrames - 1].starvationCount;
 		}
-		return false;
 	}
 
-	bool CANHardwareInterface::CANHardware::receive_can_frame()
+	bool CANHardwareInterface::CANHardware::receive_can_frames()
 	{
 		if ((nullptr != frameHandler) && frameHandler->get_is_valid() && (!receivedMessagesQueue.is_full()))
 		{
-			CANMessageFrame frame;
-			if (frameHandler->read_frame(frame))
+			// Never read more than we can queue, so that no frame gets lost
+			const std::size_t maxNumberOfFrames = std::min(receiveBuffer.size(), receivedMessagesQueue.max_size() - receivedMessagesQueue.size());
+			const std::size_t numberOfFrames = frameHandler->read_frames(DataSpan<CANMessageFrame>(receiveBuffer.data(), maxNumberOfFrames));
+			ReceivedFrame receivedFrame;
+			receivedFrame.receivedTimestamp_us = SystemTiming::get_timestamp_us();
+
+			for (std::size_t i = 0; i < numberOfFrames; i++)
 			{
-				receivedMessagesQueue.push(frame);
-				return true; // Indicate that a frame was read
+				receivedFrame.frame = receiveBuffer[i];
+				receivedMessagesQueue.push(receivedFrame);
 			}
+			return (0 != numberOfFrames); // Indicate that at least one frame was read
 		}
 		return false;
 	}
@@ -135,14 +276,14 @@ namespace isobus
 		{
 			if ((nullptr != frameHandler) && frameHandler->get_is_valid())
 			{
-				if (!receive_can_frame())
+				if (!receive_can_frames())
 				{
 					// There was no frame to receive, so if any other thread wants to do something, let it.
 					std::this_thread::yield();
 				}
 				else
 				{
-					CANHardwareInterface::updateThreadWakeupCondition.notify_all();
+					CANHardwareInterface::wake_update_thread();
 				}
 			}
 			else
@@ -317,10 +458,10 @@ namespace isobus
 		}
 
 		if ((channel->frameHandler->get_is_valid()) &&
-		    (channel->messagesToBeTransmittedQueue.push(frame)))
+		    (channel->messagesToBeTransmittedQueues[get_transmit_priority(frame)]->push(frame)))
 		{
 #if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
-			updateThreadWakeupCondition.notify_all();
+			wake_update_thread();
 #endif
 			return true;
 		}
@@ -352,10 +493,102 @@ namespace isobus
 		return periodicUpdateInterval;
 	}
 
+	void CANHardwareInterface::set_low_latency_mode(bool enabled)
+	{
+		lowLatencyMode = enabled;
+	}
+
+	bool CANHardwareInterface::get_low_latency_mode()
+	{
+		return lowLatencyMode;
+	}
+
+	CANHardwareInterface::ReceiveLatencyStatistics CANHardwareInterface::get_receive_latency_statistics(std::uint8_t channelIndex)
+	{
+		LOCK_GUARD(Mutex, hardwareChannelsMutex);
+		ReceiveLatencyStatistics retVal;
+
+		if (channelIndex < hardwareChannels.size())
+		{
+			retVal = hardwareChannels[channelIndex]->latencyStatistics;
+		}
+		return retVal;
+	}
+
+	void CANHardwareInterface::reset_receive_latency_statistics(std::uint8_t channelIndex)
+	{
+		LOCK_GUARD(Mutex, hardwareChannelsMutex);
+
+		if (channelIndex < hardwareChannels.size())
+		{
+			hardwareChannels[channelIndex]->latencyStatistics = ReceiveLatencyStatistics();
+		}
+	}
+
+	void CANHardwareInterface::set_transmit_starvation_limit(std::uint32_t numberOfFrames)
+	{
+		transmitStarvationLimit = numberOfFrames;
+	}
+
+	std::uint32_t CANHardwareInterface::get_transmit_starvation_limit()
+	{
+		return transmitStarvationLimit;
+	}
+
+	CANHardwareInterface::TransmitQueueStatistics CANHardwareInterface::get_transmit_queue_statistics(std::uint8_t channelIndex)
+	{
+		LOCK_GUARD(Mutex, hardwareChannelsMutex);
+		TransmitQueueStatistics retVal;
+
+		if (channelIndex < hardwareChannels.size())
+		{
+			const std::unique_ptr<CANHardware> &channel = hardwareChannels[channelIndex];
+			retVal = channel->transmitStatistics;
+
+			for (std::uint8_t priority = 0; priority < NUMBER_OF_TRANSMIT_PRIORITIES; priority++)
+			{
+				retVal.queueDepth[priority] = channel->messagesToBeTransmittedQueues[priority]->size();
+				retVal.maxQueueDepth[priority] = std::max(retVal.maxQueueDepth[priority], retVal.queueDepth[priority]);
+			}
+		}
+		return retVal;
+	}
+
+	void CANHardwareInterface::reset_transmit_queue_statistics(std::uint8_t channelIndex)
+	{
+		LOCK_GUARD(Mutex, hardwareChannelsMutex);
+
+		if (channelIndex < hardwareChannels.size())
+		{
+			hardwareChannels[channelIndex]->transmitStatistics = TransmitQueueStatistics();
+		}
+	}
+
+	void CANHardwareInterface::update_receive_latency_statistics()
+	{
+		LOCK_GUARD(Mutex, hardwareChannelsMutex);
+		const std::uint64_t currentTimestamp_us = SystemTiming::get_timestamp_us();
+
+		for (const auto &channel : hardwareChannels)
+		{
+			if (0 != channel->numberOfPendingFrames)
+			{
+				// The sum of (now - received) over all pending frames, without having to store each timestamp
+				ReceiveLatencyStatistics &statistics = channel->latencyStatistics;
+				statistics.numberOfFrames += channel->numberOfPendingFrames;
+				statistics.totalLatency_us += (channel->numberOfPendingFrames * currentTimestamp_us) - channel->pendingReceivedTimestampSum_us;
+				statistics.maxLatency_us = std::max(statistics.maxLatency_us, currentTimestamp_us - channel->oldestPendingReceivedTimestamp_us);
+				channel->numberOfPendingFrames = 0;
+				channel->pendingReceivedTimestampSum_us = 0;
+			}
+		}
+	}
+
 	void CANHardwareInterface::update()
 	{
 		if (started)
 		{
+			bool framesReceived = false;
 			{
 				// Stage 1 - Receiving messages from hardware
 				LOCK_GUARD(Mutex, hardwareChannelsMutex);
@@ -363,16 +596,25 @@ namespace isobus
 				{
 #if defined CAN_STACK_DISABLE_THREADS || defined ARDUINO
 					// If we don't have threads, we need to poll the hardware for messages here
-					hardwareChannels[i]->receive_can_frame();
+					hardwareChannels[i]->receive_can_frames();
 #endif
 
-					isobus::CANMessageFrame frame;
-					while (hardwareChannels[i]->receivedMessagesQueue.peek(frame))
+					const std::unique_ptr<CANHardware> &channel = hardwareChannels[i];
+					ReceivedFrame receivedFrame;
+					while (channel->receivedMessagesQueue.peek(receivedFrame))
 					{
-						frame.channel = i;
-						frameReceivedEventDispatcher.invoke(frame);
-						receive_can_message_frame_from_hardware(frame);
-						hardwareChannels[i]->receivedMessagesQueue.pop();
+						receivedFrame.frame.channel = i;
+						frameReceivedEventDispatcher.invoke(receivedFrame.frame);
+						receive_can_message_frame_from_hardware(receivedFrame.frame);
+						channel->receivedMessagesQueue.pop();
+
+						if (0 == channel->numberOfPendingFrames)
+						{
+							channel->oldestPendingReceivedTimestamp_us = receivedFrame.receivedTimestamp_us;
+						}
+						channel->numberOfPendingFrames++;
+						channel->pendingReceivedTimestampSum_us += receivedFrame.receivedTimestamp_us;
+						framesReceived = true;
 					}
 				}
 			}
@@ -383,26 +625,34 @@ namespace isobus
 				periodicUpdateEventDispatcher.invoke();
 				periodic_update_from_hardware();
 				lastUpdateTimestamp = SystemTiming::get_timestamp_ms();
+				update_receive_latency_statistics();
+			}
+			else if (framesReceived && lowLatencyMode)
+			{
+				// Don't make the received frames wait for the next periodic update
+				periodic_update_from_hardware();
+				update_receive_latency_statistics();
 			}
 
 			// Stage 3 - Transmitting messages to hardware
 			{
 				LOCK_GUARD(Mutex, hardwareChannelsMutex);
 				std::for_each(hardwareChannels.begin(), hardwareChannels.end(), [](const std::unique_ptr<CANHardware> &channel) {
-					isobus::CANMessageFrame frame;
-					while (channel->messagesToBeTransmittedQueue.peek(frame))
+					// Hand the queued frames to the driver in batches, until it stops accepting them
+					std::size_t numberOfFrames;
+					std::size_t numberOfFramesAccepted;
+					do
 					{
-						if (channel->transmit_can_frame(frame))
-						{
-							frameTransmittedEventDispatcher.invoke(frame);
-							on_transmit_can_message_frame_from_hardware(frame);
-							channel->messagesToBeTransmittedQueue.pop();
-						}
-						else
+						numberOfFrames = channel->fill_transmit_buffer();
+						numberOfFramesAccepted = channel->transmit_can_frames(numberOfFrames);
+
+						for (std::size_t i = 0; i < numberOfFramesAccepted; i++)
 						{
-							break;
+							frameTransmittedEventDispatcher.invoke(channel->transmitBuffer[i]);
+							on_transmit_can_message_frame_from_hardware(channel->transmitBuffer[i]);
 						}
-					}
+						channel->pop_transmitted_frames(numberOfFramesAccepted);
+					} while ((0 != numberOfFrames) && (numberOfFramesAccepted == numberOfFrames));
 				});
 			}
 		}
@@ -418,11 +668,18 @@ namespace isobus
 		while (started)
 		{
 			std::unique_lock<std::mutex> threadLock(updateMutex);
-			updateThreadWakeupCondition.wait_for(threadLock, std::chrono::milliseconds(periodicUpdateInterval)); // Update with at least the periodic interval
+			updateThreadWakeupCondition.wait_for(threadLock, std::chrono::milliseconds(periodicUpdateInterval), []() { return updateThreadWakeupRequested.exchange(false); }); // Update with at least the periodic interval
 			update();
 		}
 	}
 
+	void CANHardwareInterface::wake_update_thread()
+	{
+		// The flag makes sure a wakeup isn't lost if the update thread was busy rather than waiting
+		updateThreadWakeupRequested = true;
+		updateThreadWakeupCondition.notify_all();
+	}
+
 	void CANHardwareInterface::start_threads()
 	{
 		started = true;
@@ -439,7 +696,7 @@ namespace isobus
 		{
 			if (updateThread->joinable())
 			{
-				updateThreadWakeupCondition.notify_all();
+				wake_update_thread();
 				updateThread->join();
 			}
 			updateThread = nullptr;
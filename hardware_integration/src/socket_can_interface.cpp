@@ -25,6 +25,76 @@
 
 namespace isobus
 {
+	/// @brief Converts a frame received from socket CAN, and its timestamp control messages, into a stack frame
+	/// @param[in] message The message header the frame was received with
+	/// @param[in] rxFrame The socket CAN frame that was received
+	/// @param[out] canFrame The stack frame to populate
+	/// @returns `true` if the frame was converted, `false` if it was an error frame
+	static bool parse_received_frame(struct msghdr &message, const struct can_frame &rxFrame, isobus::CANMessageFrame &canFrame)
+	{
+		bool retVal = false;
+
+		if (0 == (rxFrame.can_id & CAN_ERR_FLAG))
+		{
+			canFrame.timestamp_us = std::numeric_limits<std::uint64_t>::max();
+
+			if (0 != (rxFrame.can_id & CAN_EFF_FLAG))
+			{
+				canFrame.identifier = (rxFrame.can_id & CAN_EFF_MASK);
+				canFrame.isExtendedFrame = true;
+			}
+			else
+			{
+				canFrame.identifier = (rxFrame.can_id & CAN_SFF_MASK);
+				canFrame.isExtendedFrame = false;
+			}
+			canFrame.dataLength = rxFrame.can_dlc;
+			memset(canFrame.data, 0, sizeof(canFrame.data));
+			memcpy(canFrame.data, rxFrame.data, canFrame.dataLength);
+
+			for (struct cmsghdr *pControlMessage = CMSG_FIRSTHDR(&message); (nullptr != pControlMessage) && (SOL_SOCKET == pControlMessage->cmsg_level); pControlMessage = CMSG_NXTHDR(&message, pControlMessage))
+			{
+				switch (pControlMessage->cmsg_type)
+				{
+					case SO_TIMESTAMP:
+					{
+						struct timeval *time = (struct timeval *)CMSG_DATA(pControlMessage);
+
+						if (std::numeric_limits<std::uint64_t>::max() == canFrame.timestamp_us)
+						{
+							canFrame.timestamp_us = static_cast<std::uint64_t>(time->tv_usec) + (static_cast<std::uint64_t>(time->tv_sec) * 1000000);
+						}
+					}
+					break;
+
+					case SO_TIMESTAMPING:
+					{
+						struct timespec *time = (struct timespec *)(CMSG_DATA(pControlMessage));
+						canFrame.timestamp_us = (static_cast<std::uint64_t>(time[2].tv_nsec) / 1000) + (static_cast<std::uint64_t>(time[2].tv_sec) * 1000000);
+					}
+					break;
+				}
+			}
+			retVal = true;
+		}
+		return retVal;
+	}
+
+	/// @brief Converts a stack frame into a socket CAN frame
+	/// @param[in] canFrame The frame to convert
+	/// @param[out] txFrame The socket CAN frame to populate
+	static void populate_transmit_frame(const isobus::CANMessageFrame &canFrame, struct can_frame &txFrame)
+	{
+		txFrame.can_id = canFrame.identifier;
+		txFrame.can_dlc = canFrame.dataLength;
+		memcpy(txFrame.data, canFrame.data, canFrame.dataLength);
+
+		if (canFrame.isExtendedFrame)
+		{
+			txFrame.can_id |= CAN_EFF_FLAG;
+		}
+	}
+
 	SocketCANInterface::SocketCANInterface(const std::string deviceName) :
 	  pCANDevice(new sockaddr_can),
 	  name(deviceName),
@@ -112,75 +182,49 @@ namespace isobus
 	}
 
 	bool SocketCANInterface::read_frame(isobus::CANMessageFrame &canFrame)
+	{
+		return (1 == read_frames(DataSpan<isobus::CANMessageFrame>(&canFrame, 1)));
+	}
+
+	std::size_t SocketCANInterface::read_frames(DataSpan<isobus::CANMessageFrame> canFrames)
 	{
 		struct pollfd pollingFileDescriptor;
-		bool retVal = false;
+		std::size_t retVal = 0;
 
 		pollingFileDescriptor.fd = fileDescriptor;
 		pollingFileDescriptor.events = POLLIN;
 		pollingFileDescriptor.revents = 0;
 
-		if (1 == poll(&pollingFileDescriptor, 1, 100))
+		if ((0 != canFrames.size()) && (1 == poll(&pollingFileDescriptor, 1, 100)))
 		{
-			canFrame.timestamp_us = std::numeric_limits<std::uint64_t>::max();
-			struct can_frame txFrame;
-			struct msghdr message;
-			struct iovec segment;
-
-			char lControlMessage[CMSG_SPACE(sizeof(struct timeval) + (3 * sizeof(struct timespec)) + sizeof(std::uint32_t))];
-
-			segment.iov_base = &txFrame;
-			segment.iov_len = sizeof(struct can_frame);
-			message.msg_iov = &segment;
-			message.msg_iovlen = 1;
-			message.msg_control = &lControlMessage;
-			message.msg_controllen = sizeof(lControlMessage);
-			message.msg_name = pCANDevice;
-			message.msg_namelen = sizeof(struct sockaddr_can);
-			message.msg_flags = 0;
-
-			if (recvmsg(fileDescriptor, &message, 0) > 0)
+			const unsigned int numberOfFramesToRead = static_cast<unsigned int>(std::min(canFrames.size(), static_cast<std::size_t>(MAX_FRAMES_PER_READ)));
+			struct can_frame rxFrames[MAX_FRAMES_PER_READ];
+			struct mmsghdr messages[MAX_FRAMES_PER_READ];
+			struct iovec segments[MAX_FRAMES_PER_READ];
+			char controlMessages[MAX_FRAMES_PER_READ][CMSG_SPACE(sizeof(struct timeval) + (3 * sizeof(struct timespec)) + sizeof(std::uint32_t))];
+
+			memset(messages, 0, sizeof(messages));
+			for (unsigned int i = 0; i < numberOfFramesToRead; i++)
 			{
-				if (0 == (txFrame.can_id & CAN_ERR_FLAG))
-				{
-					if (0 != (txFrame.can_id & CAN_EFF_FLAG))
-					{
-						canFrame.identifier = (txFrame.can_id & CAN_EFF_MASK);
-						canFrame.isExtendedFrame = true;
-					}
-					else
-					{
-						canFrame.identifier = (txFrame.can_id & CAN_SFF_MASK);
-						canFrame.isExtendedFrame = false;
-					}
-					canFrame.dataLength = txFrame.can_dlc;
-					memset(canFrame.data, 0, sizeof(canFrame.data));
-					memcpy(canFrame.data, txFrame.data, canFrame.dataLength);
+				segments[i].iov_base = &rxFrames[i];
+				segments[i].iov_len = sizeof(struct can_frame);
+				messages[i].msg_hdr.msg_iov = &segments[i];
+				messages[i].msg_hdr.msg_iovlen = 1;
+				messages[i].msg_hdr.msg_control = controlMessages[i];
+				messages[i].msg_hdr.msg_controllen = sizeof(controlMessages[i]);
+			}
+
+			// The poll guarantees at least one frame, the rest are only taken if they are already waiting in the socket
+			const int numberOfMessagesReceived = recvmmsg(fileDescriptor, messages, numberOfFramesToRead, MSG_DONTWAIT, nullptr);
 
-					for (struct cmsghdr *pControlMessage = CMSG_FIRSTHDR(&message); (nullptr != pControlMessage) && (SOL_SOCKET == pControlMessage->cmsg_level); pControlMessage = CMSG_NXTHDR(&message, pControlMessage))
+			if (numberOfMessagesReceived > 0)
+			{
+				for (int i = 0; i < numberOfMessagesReceived; i++)
+				{
+					if (parse_received_frame(messages[i].msg_hdr, rxFrames[i], canFrames[retVal]))
 					{
-						switch (pControlMessage->cmsg_type)
-						{
-							case SO_TIMESTAMP:
-							{
-								struct timeval *time = (struct timeval *)CMSG_DATA(pControlMessage);
-
-								if (std::numeric_limits<std::uint64_t>::max() == canFrame.timestamp_us)
-								{
-									canFrame.timestamp_us = static_cast<std::uint64_t>(time->tv_usec) + (static_cast<std::uint64_t>(time->tv_sec) * 1000000);
-								}
-							}
-							break;
-
-							case SO_TIMESTAMPING:
-							{
-								struct timespec *time = (struct timespec *)(CMSG_DATA(pControlMessage));
-								canFrame.timestamp_us = (static_cast<std::uint64_t>(time[2].tv_nsec) / 1000) + (static_cast<std::uint64_t>(time[2].tv_sec) * 1000000);
-							}
-							break;
-						}
+						retVal++;
 					}
-					retVal = true;
 				}
 			}
 			else if (errno == ENETDOWN)
@@ -201,14 +245,7 @@ namespace isobus
 		struct can_frame txFrame;
 		bool retVal = false;
 
-		txFrame.can_id = canFrame.identifier;
-		txFrame.can_dlc = canFrame.dataLength;
-		memcpy(txFrame.data, canFrame.data, canFrame.dataLength);
-
-		if (canFrame.isExtendedFrame)
-		{
-			txFrame.can_id |= CAN_EFF_FLAG;
-		}
+		populate_transmit_frame(canFrame, txFrame);
 
 		if (write(fileDescriptor, &txFrame, sizeof(struct can_frame)) > 0)
 		{
@@ -222,6 +259,51 @@ namespace isobus
 		return retVal;
 	}
 
+	std::size_t SocketCANInterface::write_frames(DataSpan<const isobus::CANMessageFrame> canFrames)
+	{
+		std::size_t retVal = 0;
+
+		while (retVal < canFrames.size())
+		{
+			const unsigned int numberOfFramesToWrite = static_cast<unsigned int>(std::min(canFrames.size() - retVal, static_cast<std::size_t>(MAX_FRAMES_PER_WRITE)));
+			struct can_frame txFrames[MAX_FRAMES_PER_WRITE];
+			struct mmsghdr messages[MAX_FRAMES_PER_WRITE];
+			struct iovec segments[MAX_FRAMES_PER_WRITE];
+
+			memset(messages, 0, sizeof(messages));
+			for (unsigned int i = 0; i < numberOfFramesToWrite; i++)
+			{
+				populate_transmit_frame(canFrames[retVal + i], txFrames[i]);
+				segments[i].iov_base = &txFrames[i];
+				segments[i].iov_len = sizeof(struct can_frame);
+				messages[i].msg_hdr.msg_iov = &segments[i];
+				messages[i].msg_hdr.msg_iovlen = 1;
+			}
+
+			const int numberOfMessagesSent = sendmmsg(fileDescriptor, messages, numberOfFramesToWrite, 0);
+
+			if (numberOfMessagesSent > 0)
+			{
+				retVal += static_cast<std::size_t>(numberOfMessagesSent);
+
+				if (static_cast<unsigned int>(numberOfMessagesSent) < numberOfFramesToWrite)
+				{
+					break; // The socket buffer is full, try the rest later
+				}
+			}
+			else
+			{
+				if (errno == ENETDOWN)
+				{
+					LOG_CRITICAL("[SocketCAN] " + get_device_name() + " interface is down.");
+					close();
+				}
+				break;
+			}
+		}
+		return retVal;
+	}
+
 	bool SocketCANInterface::set_name(const std::string &newName)
 	{
 		bool retVal = false;
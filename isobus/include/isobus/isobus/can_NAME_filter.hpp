@@ -13,6 +13,8 @@
 
 #include "isobus/isobus/can_NAME.hpp"
 
+#include <vector>
+
 namespace isobus
 {
 	//================================================================================================
@@ -43,11 +45,62 @@ namespace isobus
 		/// @returns true if a NAME matches this filter class's components
 		bool check_name_matches_filter(const NAME &nameToCompare) const;
 
+		/// @brief Converts this filter into a mask and value over the raw 64 bit NAME
+		/// @details A NAME matches the filter when `(NAME & mask) == maskedValue`.
+		/// @param[out] mask The bits of the raw NAME that this filter checks
+		/// @param[out] maskedValue The value those bits must have for the NAME to match
+		/// @returns true if the filter can match any NAME, false if its value does not fit in the NAME component
+		bool get_raw_mask_and_value(std::uint64_t &mask, std::uint64_t &maskedValue) const;
+
 	private:
 		NAME::NAMEParameters parameter; ///< The NAME component to filter against
 		std::uint32_t value; ///< The value of the data associated with the filter component
 	};
 
+	//================================================================================================
+	/// @class CompiledNAMEFilter
+	///
+	/// @brief A list of NAME filters folded into a single mask and value over the raw 64 bit NAME
+	/// @details All filters in the list must match, so they combine into one mask/value pair and
+	/// matching a NAME becomes a single AND and compare. Filters that contradict each other, or
+	/// an empty list, compile into a filter that matches nothing.
+	//================================================================================================
+	class CompiledNAMEFilter
+	{
+	public:
+		/// @brief Constructs a compiled filter that matches nothing
+		CompiledNAMEFilter() = default;
+
+		/// @brief Compiles a list of NAME filters
+		/// @param[in] filters The filters that all need to match a NAME
+		explicit CompiledNAMEFilter(const std::vector<NAMEFilter> &filters);
+
+		/// @brief Returns true if a NAME matches all of the compiled filters
+		/// @param[in] nameToCompare A NAME to compare against the compiled filters
+		/// @returns true if a NAME matches all of the compiled filters
+		bool check_name_matches(const NAME &nameToCompare) const
+		{
+			return canMatch && ((nameToCompare.get_full_name() & mask) == maskedValue);
+		}
+
+		/// @brief Returns the bits of the raw NAME that are checked
+		/// @returns The bits of the raw NAME that are checked
+		std::uint64_t get_mask() const;
+
+		/// @brief Returns the value the checked bits must have
+		/// @returns The value the checked bits must have
+		std::uint64_t get_value() const;
+
+		/// @brief Returns if any NAME can match the compiled filters
+		/// @returns true if any NAME can match the compiled filters, otherwise false
+		bool get_can_match() const;
+
+	private:
+		std::uint64_t mask = 0; ///< The bits of the raw NAME that are checked
+		std::uint64_t maskedValue = 0; ///< The value the checked bits must have
+		bool canMatch = false; ///< False if the filters are empty or contradict each other
+	};
+
 } // namespace isobus
 
 #endif // CAN_NAME_FILTER_HPP
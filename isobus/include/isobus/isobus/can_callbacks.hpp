@@ -11,13 +11,21 @@
 #define CAN_CALLBACKS_HPP
 
 #include <functional>
+#include <memory>
+#include <vector>
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+#include <condition_variable>
+#include <thread>
+#endif
 #include "isobus/isobus/can_message.hpp"
+#include "isobus/utility/thread_synchronization.hpp"
 
 namespace isobus
 {
 	// Forward declare some classes
 	class InternalControlFunction;
 	class ControlFunction;
+	class CANMessageReceiveSink;
 
 	/// @brief The types of acknowledgement that can be sent in the Ack PGN
 	enum class AcknowledgementType : std::uint8_t
@@ -53,6 +61,13 @@ namespace isobus
 	                                   std::uint32_t numberOfBytesNeeded,
 	                                   std::uint8_t *chunkBuffer,
 	                                   void *parentPointer);
+	/// @brief A callback that can supply a sink for a multi-frame message that is about to be received
+	/// @returns A sink to receive the message's data into, or nullptr to have the stack reassemble the message as usual
+	using ReceiveSinkCallback = std::unique_ptr<CANMessageReceiveSink> (*)(std::uint32_t parameterGroupNumber,
+	                                                                       std::uint32_t totalMessageSize,
+	                                                                       std::shared_ptr<ControlFunction> sourceControlFunction,
+	                                                                       std::shared_ptr<ControlFunction> destinationControlFunction,
+	                                                                       void *parentPointer);
 	/// @brief A callback for when a transmit is completed by the stack
 	using TransmitCompleteCallback = void (*)(std::uint32_t parameterGroupNumber,
 	                                          std::uint32_t dataLength,
@@ -111,6 +126,102 @@ namespace isobus
 		void *parent; ///< A generic variable that can provide context to which object the callback was meant for
 		std::shared_ptr<InternalControlFunction> internalControlFunctionFilter; ///< An optional way to filter callbacks based on the destination of messages from the partner
 	};
+
+	/// @brief A PGN indexed table of callbacks that can be dispatched to without holding the table's mutex.
+	/// @details Registered callbacks are kept in a snapshot sorted by PGN, which is rebuilt
+	/// (copy-on-write) every time a callback is added or removed. Dispatching a message only
+	/// has to look up the range of callbacks for its PGN in the current snapshot, so the cost of dispatch
+	/// is proportional to the number of matching callbacks rather than the total number of callbacks.
+	/// Callbacks with the same PGN are called in the order they were added.
+	/// Adding or removing a callback never blocks on a dispatch in progress, except that removing waits
+	/// for dispatches on other threads to finish before returning, so a callback's parent can be destroyed once it's removed.
+	class ParameterGroupNumberCallbackTable
+	{
+	public:
+		/// @brief Constructs an empty callback table
+		ParameterGroupNumberCallbackTable();
+
+		/// @brief Adds a callback to the table
+		/// @param[in] callbackData The callback to add
+		/// @param[in] allowDuplicates If false, the callback is not added when an identical one is already registered
+		/// @returns `true` if the callback was added, otherwise `false`
+		bool add_callback(const ParameterGroupNumberCallbackData &callbackData, bool allowDuplicates);
+
+		/// @brief Removes the first callback that is identical to the one supplied
+		/// @details Once this returns, the callback will not be called again, because this waits for every dispatch
+		/// on another thread that started before the callback was removed to finish. When called from within a callback of this table,
+		/// the dispatches in progress on the calling thread can't be waited for, so the rest of those dispatches may still call it.
+		/// The same goes for dispatches on other threads that are themselves waiting in this function at the same time,
+		/// since waiting for each other would never finish.
+		/// @param[in] callbackData The callback to remove
+		/// @returns `true` if a callback was removed, otherwise `false`
+		bool remove_callback(const ParameterGroupNumberCallbackData &callbackData);
+
+		/// @brief Calls every callback registered for the PGN of the message
+		/// @param[in] message The message to pass to the callbacks
+		void dispatch(const CANMessage &message) const;
+
+		/// @brief Returns the number of callbacks in the table
+		/// @returns The number of callbacks in the table
+		std::size_t size() const;
+
+	private:
+		/// @brief Rebuilds the sorted snapshot from the registered callbacks and publishes it to readers
+		void rebuild_snapshot();
+
+		using Snapshot = std::vector<ParameterGroupNumberCallbackData>; ///< A list of callbacks sorted by PGN
+
+		std::vector<ParameterGroupNumberCallbackData> registeredCallbacks; ///< The callbacks in order of registration
+		std::shared_ptr<const Snapshot> snapshot; ///< The sorted callbacks used by readers
+		mutable Mutex writeMutex; ///< Serializes modifications to the table
+
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+		/// @brief A dispatch in progress, linked into the table's list of dispatches for as long as it's in scope
+		class DispatchScope
+		{
+		public:
+			/// @brief Loads the current snapshot and records that the current thread is dispatching from it
+			/// @param[in] parentTable The table being dispatched from
+			explicit DispatchScope(const ParameterGroupNumberCallbackTable &parentTable);
+
+			/// @brief Records that the dispatch is done, and wakes up any removal waiting for it
+			~DispatchScope();
+
+			/// @brief Returns the snapshot being dispatched from
+			/// @returns The snapshot being dispatched from
+			const Snapshot &get_snapshot() const;
+
+		private:
+			friend class ParameterGroupNumberCallbackTable;
+
+			const ParameterGroupNumberCallbackTable &table; ///< The table being dispatched from
+			std::shared_ptr<const Snapshot> snapshot; ///< The snapshot being dispatched from
+			std::uint64_t epoch; ///< The epoch of the snapshot being dispatched from
+			std::thread::id threadID; ///< The thread the dispatch is running on
+			bool threadIsRemoving = false; ///< Set while the dispatch's thread is waiting in remove_callback
+			DispatchScope *next = nullptr; ///< The next dispatch in progress on this table, or nullptr
+		};
+
+		/// @brief Checks if a removal still has to wait for a dispatch on another thread
+		/// @details A dispatch has to be waited for if it started before the removal's snapshot was published.
+		/// Dispatches on threads that are themselves waiting in remove_callback are skipped, otherwise
+		/// two threads removing callbacks from within callbacks would wait for each other forever.
+		/// Must be called with the dispatch mutex held.
+		/// @param[in] removalEpoch The epoch of the first snapshot without the removed callback
+		/// @returns `true` if there is a dispatch to wait for, otherwise `false`
+		bool has_dispatch_to_wait_for(std::uint64_t removalEpoch) const;
+
+		/// @brief Marks the dispatches in progress on the current thread as waiting in remove_callback or not
+		/// @details Must be called with the dispatch mutex held.
+		/// @param[in] removing `true` if the current thread is starting to wait, `false` if it's done waiting
+		void set_current_thread_removing(bool removing);
+
+		mutable std::mutex dispatchMutex; ///< Protects the snapshot, its epoch and the dispatches in progress, never held while calling callbacks
+		mutable std::condition_variable dispatchStateChanged; ///< Notified when a dispatch ends or a thread starts or stops waiting in remove_callback
+		mutable DispatchScope *dispatchesInProgress = nullptr; ///< The dispatches in progress on this table, on all threads
+		std::uint64_t snapshotEpoch = 0; ///< Incremented every time a new snapshot is published
+#endif
+	};
 } // namespace isobus
 
 #endif // CAN_CALLBACKS_HPP
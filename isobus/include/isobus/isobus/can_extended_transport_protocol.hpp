@@ -15,6 +15,9 @@
 #include "isobus/isobus/can_message_frame.hpp"
 #include "isobus/isobus/can_network_configuration.hpp"
 #include "isobus/isobus/can_transport_protocol_base.hpp"
+#include "isobus/isobus/can_transport_protocol_session_table.hpp"
+
+#include <vector>
 
 namespace isobus
 {
@@ -74,6 +77,12 @@ namespace isobus
 			/// @return The number of bytes that have been sent or received
 			std::uint32_t get_total_bytes_transferred() const override;
 
+			/// @brief Get the goodput of the session, which is the rate at which message data was transferred
+			/// @details This is measured from the start of the session until it closed, or until now if it is still active,
+			/// so it includes the time spent on connection management and waiting on the other side.
+			/// @return The goodput of the session in bytes per second
+			std::uint32_t get_goodput() const;
+
 		protected:
 			friend class ExtendedTransportProtocolManager; ///< Allows the ETP manager full access
 
@@ -133,6 +142,14 @@ namespace isobus
 			/// @return The total number of packets that will be sent or received in this session
 			std::uint32_t get_total_number_of_packets() const;
 
+			/// @brief Get the minimum time to wait between data packets when sending
+			/// @return The minimum time between data packets in milliseconds, 0 if not paced
+			std::uint8_t get_packet_pacing() const;
+
+			/// @brief Set the minimum time to wait between data packets when sending
+			/// @param[in] value The minimum time between data packets in milliseconds, 0 to not pace
+			void set_packet_pacing(std::uint8_t value);
+
 		private:
 			StateMachineState state = StateMachineState::None; ///< The state machine state for this session
 
@@ -141,6 +158,14 @@ namespace isobus
 			std::uint8_t lastSequenceNumber = 0; ///< The last processed sequence number for this set of packets
 			std::uint8_t dataPacketOffsetPacketCount = 0; ///< The number of packets that will be sent with the current DPO
 			std::uint8_t clearToSendPacketCountLimit = 0xFF; ///< The max packets that can be sent per DPO as indicated by the CTS message
+			std::uint8_t packetPacing_ms = 0; ///< The minimum time between data packets when sending, used by adaptive flow control
+			bool dataStallObserved = false; ///< Whether the sender stalled during the current window, used by adaptive flow control
+			bool pipeliningAllowed = false; ///< Whether the other end of the session is allowed to pipeline windows, see CANNetworkConfiguration
+			bool pipelinedClearToSendSent = false; ///< Whether a receiving session already sent the CTS for the window after the current one
+			std::uint8_t pendingClearToSendPacketCount = 0; ///< The number of packets of a CTS received while still sending the current window
+			std::uint32_t pendingClearToSendPacketNumber = 0; ///< The next packet number of a CTS received while still sending the current window, zero if none
+			std::uint32_t startTimestamp_ms = 0; ///< The time the session was started, used to calculate the goodput
+			std::uint32_t endTimestamp_ms = 0; ///< The time the session was closed, or zero if still active
 		};
 
 		static constexpr std::uint32_t REQUEST_TO_SEND_MULTIPLEXOR = 0x14; ///< (20) ETP.CM_RTS Multiplexor
@@ -155,6 +180,12 @@ namespace isobus
 		static constexpr std::uint8_t TR_TIMEOUT_MS = 200; ///< The Tr Timeout as defined by the standard
 		static constexpr std::uint8_t SEQUENCE_NUMBER_DATA_INDEX = 0; ///< The index of the sequence number in a frame
 		static constexpr std::uint8_t PROTOCOL_BYTES_PER_FRAME = 7; ///< The number of payload bytes per frame minus overhead of sequence number
+		static constexpr float ADAPTIVE_HIGH_BUSLOAD_PERCENT = 70.0f; ///< Above this bus load, adaptive flow control backs off
+		static constexpr float ADAPTIVE_LOW_BUSLOAD_PERCENT = 40.0f; ///< Below this bus load, adaptive flow control speeds up
+		static constexpr std::uint8_t ADAPTIVE_MINIMUM_WINDOW = 2; ///< The smallest CTS window adaptive flow control will shrink to
+		static constexpr std::uint8_t ADAPTIVE_WINDOW_INCREMENT = 16; ///< The number of packets the CTS window grows by after a clean window
+		static constexpr std::uint8_t ADAPTIVE_MAXIMUM_PACKET_PACING_MS = 64; ///< The longest delay adaptive flow control puts between data packets
+		static constexpr std::uint16_t ADAPTIVE_STALL_TIME_MS = T1_TIMEOUT_MS / 4; ///< A gap between data packets this long counts as a stalled sender
 
 		/// @brief The constructor for the ExtendedTransportProtocolManager, for advanced use only.
 		/// In most cases, you should use the CANNetworkManager::send_can_message() function to transmit messages.
@@ -165,9 +196,29 @@ namespace isobus
 		                                 const CANMessageCallback &canMessageReceivedCallback,
 		                                 const CANNetworkConfiguration *configuration);
 
-		/// @brief Updates all sessions managed by this protocol manager instance.
+		/// @brief Updates the sessions managed by this protocol manager instance that are due.
+		/// @details A session is due when it has frames to send, received a message since the last update,
+		/// or one of its timers expired. Sessions that are just waiting are not touched.
 		void update();
 
+		/// @brief Returns how long it is until a session managed by this instance needs to be updated
+		/// @returns The time until the next session is due in milliseconds, zero if one is due now,
+		/// or the max value of std::uint32_t if there are no sessions
+		std::uint32_t get_time_until_next_update() const;
+
+		/// @brief Sets a callback that is asked for a sink each time a new message starts being received
+		/// @details When the callback returns a sink, the data of the message is written straight into it instead
+		/// of being reassembled into a CANMessage. The callback is called before the session is accepted.
+		/// @param[in] callback The callback to ask for a sink, or nullptr to always reassemble messages
+		/// @param[in] parent A generic context variable that is passed to the callback
+		void set_receive_sink_callback(ReceiveSinkCallback callback, void *parent);
+
+		/// @brief Sets the bus load that adaptive flow control uses to size the CTS window and pace data packets
+		/// @details The network manager sets this from CANNetworkManager::get_estimated_busload() each update when
+		/// adaptive flow control is enabled in the configuration.
+		/// @param[in] busloadPercent The estimated bus load in percent
+		void set_estimated_busload(float busloadPercent);
+
 		/// @brief Checks if the source and destination control function have an active session/connection.
 		/// @param[in] source The source control function for the session
 		/// @param[in] destination The destination control function for the session
@@ -177,7 +228,7 @@ namespace isobus
 		/// @brief Gets all the active transport protocol sessions that are currently active
 		/// @note The list returns pointers to the transport protocol sessions, but they can disappear at any time
 		/// @returns A list of all the active transport protocol sessions
-		const std::vector<std::shared_ptr<ExtendedTransportProtocolSession>> &get_sessions() const;
+		std::vector<std::shared_ptr<ExtendedTransportProtocolSession>> get_sessions() const;
 
 		/// @brief A generic way for a protocol to process a received message
 		/// @param[in] message A received CAN message
@@ -216,6 +267,11 @@ namespace isobus
 		                std::uint32_t parameterGroupNumber,
 		                ConnectionAbortReason reason) const;
 
+		/// @brief Gives an accepted receive session the storage its data is received into,
+		/// either a sink from the receive sink callback or the session's own buffer
+		/// @param[in] session The receive session that was just accepted
+		void prepare_receive_data(const std::shared_ptr<ExtendedTransportProtocolSession> &session) const;
+
 		/// @brief Gracefully closes a session to prepare for a new session
 		/// @param[in] session The session to close
 		/// @param[in] successful Denotes if the session was successful
@@ -227,10 +283,17 @@ namespace isobus
 		bool send_request_to_send(const std::shared_ptr<ExtendedTransportProtocolSession> &session) const;
 
 		/// @brief Sends the "clear to send" message
+		/// @details The CTS asks for the packets after the current window, so it can be sent before the window is complete
 		/// @param[in] session The session for which we're sending the CTS
 		/// @returns true if the CTS was sent, false if sending was not successful
 		bool send_clear_to_send(const std::shared_ptr<ExtendedTransportProtocolSession> &session) const;
 
+		/// @brief Applies a CTS to a transmitting session, so it continues with the DPO for the requested packets
+		/// @param[in] session The transmitting session
+		/// @param[in] packetsToBeSent The number of packets the receiver asked for
+		/// @param[in] nextPacketNumber The packet number the receiver asked to start from
+		void accept_clear_to_send(const std::shared_ptr<ExtendedTransportProtocolSession> &session, std::uint8_t packetsToBeSent, std::uint32_t nextPacketNumber) const;
+
 		/// @brief Sends the "data packet offset" message for the provided session
 		/// @param[in] session The session for which we're sending the DPO
 		/// @returns true if the DPO was sent, false if sending was not successful
@@ -296,14 +359,55 @@ namespace isobus
 		/// @returns a matching session, or nullptr if no session matched the supplied parameters
 		std::shared_ptr<ExtendedTransportProtocolSession> get_session(std::shared_ptr<ControlFunction> source, std::shared_ptr<ControlFunction> destination);
 
+		/// @brief Get the number of active sessions.
+		/// @return The number of active sessions
+		std::size_t get_sessions_count() const;
+
+		/// @brief Grows or shrinks the CTS window of a receiving session before the next CTS is sent
+		/// @param[in] session The session to adapt
+		void adapt_clear_to_send_window(const std::shared_ptr<ExtendedTransportProtocolSession> &session) const;
+
+		/// @brief Lengthens or shortens the delay between data packets of a transmitting session when a CTS is received
+		/// @param[in] session The session to adapt
+		/// @param[in] retransmitRequested Whether the receiver asked for packets that were already sent
+		void adapt_packet_pacing(const std::shared_ptr<ExtendedTransportProtocolSession> &session, bool retransmitRequested) const;
+
+		/// @brief Returns the CTS window that adaptive flow control starts new receiving sessions from a sender with
+		/// @param[in] sender The control function sending the session
+		/// @returns The window the last session from the sender left off with, or zero if there was none
+		std::uint8_t get_adaptive_initial_window(const std::shared_ptr<ControlFunction> &sender) const;
+
+		/// @brief Sets the CTS window that adaptive flow control starts new receiving sessions from a sender with
+		/// @param[in] sender The control function sending the session
+		/// @param[in] window The window to start the sender's next session with
+		void set_adaptive_initial_window(const std::shared_ptr<ControlFunction> &sender, std::uint8_t window);
+
 		/// @brief Update the state machine for the passed in session
 		/// @param[in] session The session to update
 		void update_state_machine(std::shared_ptr<ExtendedTransportProtocolSession> &session);
 
-		std::vector<std::shared_ptr<ExtendedTransportProtocolSession>> activeSessions; ///< A list of all active ETP sessions
+		/// @brief Calculates when a session next needs to be updated, based on its state and its timers
+		/// @param[in] session The session to calculate the deadline for
+		/// @param[in] now The current timestamp in milliseconds
+		/// @returns The timestamp in milliseconds at which the session is due
+		std::uint32_t get_session_deadline(const std::shared_ptr<ExtendedTransportProtocolSession> &session, std::uint32_t now) const;
+
+		/// @brief Makes the sessions between two control functions, in either direction, due on the next update
+		/// @param[in] source The source control function of a received message
+		/// @param[in] destination The destination control function of a received message
+		void schedule_session_update(const std::shared_ptr<ControlFunction> &source, const std::shared_ptr<ControlFunction> &destination);
+
+		mutable Mutex activeSessionsMutex; ///< Synchronizes access to @ref activeSessions
+		Mutex updateMutex; ///< Serializes calls to @ref update, which share the scratch list of due sessions
+		TransportProtocolSessionTable<ExtendedTransportProtocolSession> activeSessions; ///< All active ETP sessions, indexed by source and destination
+		std::vector<std::shared_ptr<ExtendedTransportProtocolSession>> dueSessions; ///< Scratch list of sessions that are due in the current update
 		const CANMessageFrameCallback sendCANFrameCallback; ///< A callback for sending a CAN frame
 		const CANMessageCallback canMessageReceivedCallback; ///< A callback for when a complete CAN message is received using the ETP protocol
 		const CANNetworkConfiguration *configuration; ///< The configuration to use for this protocol
+		ReceiveSinkCallback receiveSinkCallback = nullptr; ///< A callback that can supply a sink for the data of new receive sessions
+		void *receiveSinkParent = nullptr; ///< The context variable passed to the receive sink callback
+		float estimatedBusload = 0.0f; ///< The estimated bus load in percent, used by adaptive flow control
+		std::vector<std::pair<std::weak_ptr<ControlFunction>, std::uint8_t>> adaptiveInitialWindows; ///< The CTS window new receiving sessions start with, for each sender that had one adapted
 	};
 
 } // namespace isobus
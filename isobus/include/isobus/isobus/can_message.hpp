@@ -256,6 +256,8 @@ namespace isobus
 		std::uint64_t get_data_custom_length(const std::uint32_t startBitIndex, const std::uint32_t length, const ByteFormat format = ByteFormat::LittleEndian) const;
 
 	private:
+		friend class CANMessagePool; ///< Allows the message pool to re-use messages without re-allocating their data buffer
+
 		Type messageType; ///< The internal message type associated with the message
 		CANIdentifier identifier; ///< The CAN ID of the message
 		std::vector<std::uint8_t> data; ///< A data buffer for the message, used when not using data chunk callbacks
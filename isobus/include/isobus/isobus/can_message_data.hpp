@@ -37,6 +37,14 @@ namespace isobus
 		/// @return The byte at the given index.
 		virtual std::uint8_t get_byte(std::size_t index) = 0;
 
+		/// @brief Copy a range of bytes into a buffer.
+		/// @details The default implementation calls get_byte for each byte, derived classes
+		/// that have faster access to their data should override it.
+		/// @param[in] offset The index of the first byte to copy.
+		/// @param[in] destination The buffer to copy the bytes into.
+		/// @return The number of bytes copied, which is less than the size of the destination if the data ends before it.
+		virtual std::size_t copy_bytes(std::size_t offset, DataSpan<std::uint8_t> destination);
+
 		/// @brief If the data isn't owned by this class, make a copy of the data.
 		/// @param[in] self A pointer to this object.
 		/// @return A copy of the data if it isn't owned by this class, otherwise a moved pointer.
@@ -70,6 +78,12 @@ namespace isobus
 		/// @return The byte at the given index.
 		std::uint8_t get_byte(std::size_t index) override;
 
+		/// @brief Copy a range of bytes into a buffer.
+		/// @param[in] offset The index of the first byte to copy.
+		/// @param[in] destination The buffer to copy the bytes into.
+		/// @return The number of bytes copied, which is less than the size of the destination if the data ends before it.
+		std::size_t copy_bytes(std::size_t offset, DataSpan<std::uint8_t> destination) override;
+
 		/// @brief Set the byte at the given index.
 		/// @param[in] index The index of the byte to set.
 		/// @param[in] value The value to set the byte to.
@@ -105,6 +119,12 @@ namespace isobus
 		/// @return The byte at the given index.
 		std::uint8_t get_byte(std::size_t index) override;
 
+		/// @brief Copy a range of bytes into a buffer.
+		/// @param[in] offset The index of the first byte to copy.
+		/// @param[in] destination The buffer to copy the bytes into.
+		/// @return The number of bytes copied, which is less than the size of the destination if the data ends before it.
+		std::size_t copy_bytes(std::size_t offset, DataSpan<std::uint8_t> destination) override;
+
 		/// @brief Get the data span.
 		/// @return The data span.
 		CANDataSpan data() const;
@@ -138,6 +158,12 @@ namespace isobus
 		/// @return The byte at the given index.
 		std::uint8_t get_byte(std::size_t index) override;
 
+		/// @brief Copy a range of bytes into a buffer.
+		/// @param[in] offset The index of the first byte to copy.
+		/// @param[in] destination The buffer to copy the bytes into.
+		/// @return The number of bytes copied, which is less than the size of the destination if the data ends before it.
+		std::size_t copy_bytes(std::size_t offset, DataSpan<std::uint8_t> destination) override;
+
 		/// @brief If the data isn't owned by this class, make a copy of the data.
 		/// @param[in] self A pointer to this object.
 		/// @return A copy of the data if it isn't owned by this class, otherwise it returns itself.
@@ -152,6 +178,28 @@ namespace isobus
 		std::size_t dataOffset = 0; ///< The offset of the data in the buffer.
 		bool initialized = false; ///< Whether the buffer has been initialized.
 	};
+
+	/// @brief An interface for consumers that want a received multi-frame message to be written
+	/// directly into their own storage, instead of having the transport protocol reassemble it into
+	/// a CANMessage first.
+	/// @details A sink is supplied for a single session by a ReceiveSinkCallback when the session starts.
+	/// Data is written in order as the packets arrive, and the sink is told once when the session ends.
+	/// No CANMessage is dispatched for a message that was received into a sink.
+	class CANMessageReceiveSink
+	{
+	public:
+		/// @brief Default destructor.
+		virtual ~CANMessageReceiveSink() = default;
+
+		/// @brief Stores a chunk of the message as it is received.
+		/// @param[in] offset The index in the message of the first byte of the chunk.
+		/// @param[in] chunk The bytes that were received.
+		virtual void write_bytes(std::size_t offset, CANDataSpan chunk) = 0;
+
+		/// @brief Called once when the session ends, either because the message was completely received or because it was aborted.
+		/// @param[in] successful True if the whole message was received, false if the session was aborted or timed out.
+		virtual void on_session_closed(bool successful) = 0;
+	};
 } // namespace isobus
 
 #endif // CAN_MESSAGE_DATA_HPP
@@ -0,0 +1,140 @@
+//================================================================================================
+/// @file can_message_pool.hpp
+///
+/// @brief A fixed capacity pool of CAN messages used by the network manager to avoid
+/// heap allocations when processing single frame messages.
+/// @author Adrian Del Grosso
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+
+#ifndef CAN_MESSAGE_POOL_HPP
+#define CAN_MESSAGE_POOL_HPP
+
+#include "isobus/isobus/can_message.hpp"
+#include "isobus/utility/thread_synchronization.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace isobus
+{
+	//================================================================================================
+	/// @class CANMessagePool
+	///
+	/// @brief A fixed capacity pool of pre-constructed CAN messages.
+	/// @details Each slot in the pool reserves room for a full classical CAN frame payload up front,
+	/// so re-using a slot for a message of 8 bytes or less never touches the heap.
+	/// If the pool is exhausted, messages are allocated on the heap instead so that no message
+	/// is ever dropped. Those are tracked by the overflow counter, which is a good indication that
+	/// the pool capacity should be increased.
+	//================================================================================================
+	class CANMessagePool
+	{
+	public:
+		/// @brief Constructs an empty pool, call resize() to give it some capacity
+		CANMessagePool() = default;
+
+		/// @brief Deleted copy constructor, the pool hands out raw pointers into its storage
+		CANMessagePool(const CANMessagePool &) = delete;
+
+		/// @brief Deleted copy assignment operator, the pool hands out raw pointers into its storage
+		/// @returns Nothing, this function is deleted
+		CANMessagePool &operator=(const CANMessagePool &) = delete;
+
+		/// @brief Sets the number of messages the pool can hold without falling back to the heap.
+		/// @attention All messages acquired from the pool must have been released before calling this,
+		/// otherwise the pool will not be resized.
+		/// @param[in] capacity The number of messages to pre-allocate
+		/// @returns `true` if the pool was resized, otherwise `false`
+		bool resize(std::size_t capacity);
+
+		/// @brief Takes a message out of the pool and populates it with the parameters supplied
+		/// @param[in] type The type of the CAN message
+		/// @param[in] identifier The CAN ID of the message
+		/// @param[in] dataBuffer The start of the data payload
+		/// @param[in] length The length of the data payload in bytes
+		/// @param[in] source The source control function of the message
+		/// @param[in] destination The destination control function of the message
+		/// @param[in] CANPort The CAN channel index associated with the message
+		/// @returns A message that must be returned to the pool with release()
+		CANMessage *acquire(CANMessage::Type type,
+		                    const CANIdentifier &identifier,
+		                    const std::uint8_t *dataBuffer,
+		                    std::uint32_t length,
+		                    std::shared_ptr<ControlFunction> source,
+		                    std::shared_ptr<ControlFunction> destination,
+		                    std::uint8_t CANPort);
+
+		/// @brief Returns a message to the pool (or frees it if it was allocated on overflow)
+		/// @param[in] message The message to release, previously obtained with acquire()
+		void release(CANMessage *message);
+
+		/// @brief Returns the number of messages the pool can hold without allocating
+		/// @returns The capacity of the pool
+		std::size_t get_capacity() const;
+
+		/// @brief Returns the number of pooled messages currently handed out
+		/// @returns The number of pooled messages in use
+		std::size_t get_number_in_use() const;
+
+		/// @brief Returns the highest number of pooled messages that were in use at the same time
+		/// @returns The high-water mark of the pool
+		std::size_t get_high_water_mark() const;
+
+		/// @brief Returns the number of messages that had to be allocated on the heap because the pool was exhausted
+		/// @returns The number of times the pool overflowed
+		std::size_t get_overflow_count() const;
+
+		/// @brief Resets the high-water mark and the overflow counter
+		void reset_statistics();
+
+	private:
+		/// @brief Checks if a message lives inside of the pool's storage
+		/// @param[in] message The message to check
+		/// @returns `true` if the message belongs to the pool, otherwise `false`
+		bool owns(const CANMessage *message) const;
+
+		std::vector<CANMessage> storage; ///< The pre-constructed messages
+		std::vector<CANMessage *> freeMessages; ///< Stack of messages in storage that are not in use
+		mutable Mutex poolMutex; ///< Protects the free list and statistics
+		std::size_t highWaterMark = 0; ///< The highest number of pooled messages that were in use at once
+		std::size_t overflowCount = 0; ///< The number of heap allocations that happened because the pool was exhausted
+	};
+
+	//================================================================================================
+	/// @class CANMessageQueue
+	///
+	/// @brief A thread safe FIFO of messages acquired from a CANMessagePool.
+	/// @details Backed by a ring buffer that only grows when it is full, so once it has
+	/// reached its working size, pushing and popping no longer allocate.
+	//================================================================================================
+	class CANMessageQueue
+	{
+	public:
+		/// @brief Constructs a queue with an initial ring buffer size
+		/// @param[in] initialCapacity The initial number of messages the queue can hold before growing
+		explicit CANMessageQueue(std::size_t initialCapacity = 16);
+
+		/// @brief Adds a message to the back of the queue
+		/// @param[in] message The message to add
+		void push(CANMessage *message);
+
+		/// @brief Removes the message at the front of the queue
+		/// @param[out] message The message that was removed
+		/// @returns `true` if a message was removed, `false` if the queue was empty
+		bool pop(CANMessage **message);
+
+		/// @brief Returns the number of messages in the queue
+		/// @returns The number of messages in the queue
+		std::size_t size() const;
+
+	private:
+		std::vector<CANMessage *> ring; ///< The ring buffer
+		std::size_t head = 0; ///< Index of the front of the queue
+		std::size_t count = 0; ///< Number of messages in the queue
+		mutable Mutex queueMutex; ///< Protects the ring buffer
+	};
+} // namespace isobus
+
+#endif // CAN_MESSAGE_POOL_HPP
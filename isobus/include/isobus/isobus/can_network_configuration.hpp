@@ -10,7 +10,10 @@
 #ifndef CAN_NETWORK_CONFIGURATION_HPP
 #define CAN_NETWORK_CONFIGURATION_HPP
 
+#include "isobus/isobus/can_NAME.hpp"
+
 #include <cstdint>
+#include <vector>
 
 namespace isobus
 {
@@ -84,14 +87,74 @@ namespace isobus
 		/// @returns The number of packets per CTS packet for TP sessions.
 		std::uint8_t get_number_of_packets_per_cts_message() const;
 
+		/// @brief Sets the max number of concurrent destination specific TP transmit sessions that one
+		/// internal control function can have open to different destinations. The default is 255.
+		/// @details Data frames of concurrent transmit sessions are interleaved one frame at a time,
+		/// so large messages to several partners, like a VT and a TC, are sent side by side instead of one after the other.
+		/// @param[in] value The max number of concurrent TP transmit sessions per source control function
+		void set_max_number_transport_protocol_transmit_sessions_per_source(std::uint32_t value);
+
+		/// @brief Returns the max number of concurrent destination specific TP transmit sessions per source control function
+		/// @returns The max number of concurrent TP transmit sessions per source control function
+		std::uint32_t get_max_number_transport_protocol_transmit_sessions_per_source() const;
+
+		/// @brief Sets the number of single frame messages the network manager pre-allocates for
+		/// its receive and transmit pipelines. The default is 64.
+		/// @details The pool is sized when CANNetworkManager::initialize() runs, so this must be set before that.
+		/// If more messages than this are waiting to be processed at the same time, the extra messages
+		/// are allocated on the heap, which can be monitored with CANNetworkManager::get_message_pool().
+		/// @param[in] numberMessages The number of messages to pre-allocate
+		void set_message_pool_capacity(std::uint32_t numberMessages);
+
+		/// @brief Returns the number of single frame messages the network manager pre-allocates
+		/// @returns The number of messages in the network manager's message pool
+		std::uint32_t get_message_pool_capacity() const;
+
+		/// @brief Enables or disables adaptive flow control for ETP sessions. The default is disabled.
+		/// @details When enabled, receiving sessions start with the window the last session from the same sender
+		/// ended with (the configured number of packets per DPO for a new sender) and grow or shrink the window
+		/// requested in each CTS based on the estimated bus load and on stalls seen while waiting for data.
+		/// Transmitting sessions send packets again when the receiver asks for them, add a delay between data packets
+		/// when the bus is busy or packets had to be sent again, and send as many packets per DPO as the receiver
+		/// allows instead of capping them at the configured number.
+		/// @param[in] enabled true to adapt the ETP window and packet pacing, false to use fixed values
+		void set_extended_transport_protocol_adaptive_flow_control(bool enabled);
+
+		/// @brief Returns if adaptive flow control is enabled for ETP sessions
+		/// @returns true if ETP sessions adapt their window and packet pacing, otherwise false
+		bool get_extended_transport_protocol_adaptive_flow_control() const;
+
+		/// @brief Allows pipelining of ETP windows in sessions with a control function. No control function is allowed by default.
+		/// @details When allowed, receiving sessions from the control function send the CTS for the next window once half of the
+		/// current window has been received, instead of waiting for the window to complete. Transmitting sessions to it
+		/// accept such a CTS while they are still sending, and send the next window's DPO as soon as the current window is done.
+		/// Whether a session pipelines is decided when it is created.
+		/// @attention ISO 11783-3 has a sender abort when it receives a CTS during a data transfer,
+		/// so only add control functions that are known to support pipelining, like ones that also use this stack.
+		/// @param[in] partnerNAME The NAME of the control function to pipeline ETP windows with
+		void add_extended_transport_protocol_pipelining_partner(NAME partnerNAME);
+
+		/// @brief Stops pipelining ETP windows in new sessions with a control function
+		/// @param[in] partnerNAME The NAME of the control function to no longer pipeline ETP windows with
+		void remove_extended_transport_protocol_pipelining_partner(NAME partnerNAME);
+
+		/// @brief Returns if pipelining of ETP windows is allowed in sessions with a control function
+		/// @param[in] partnerNAME The NAME of the control function on the other end of the session
+		/// @returns true if ETP sessions with the control function overlap the CTS/DPO handshake with the data transfer, otherwise false
+		bool get_extended_transport_protocol_pipelining(NAME partnerNAME) const;
+
 	private:
 		static constexpr std::uint8_t DEFAULT_BAM_PACKET_DELAY_TIME_MS = 50; ///< The default time between BAM frames, as defined by J1939
 
+		std::vector<NAME> extendedTransportProtocolPipeliningPartners; ///< The control functions whose ETP sessions overlap the CTS/DPO handshake with the data transfer
 		std::uint32_t maxNumberTransportProtocolSessions = 4; ///< The max number of TP sessions allowed
+		std::uint32_t maxNumberTransportProtocolTransmitSessionsPerSource = 0xFF; ///< The max number of concurrent TP transmit sessions from one source
 		std::uint32_t minimumTimeBetweenTransportProtocolBAMFrames = DEFAULT_BAM_PACKET_DELAY_TIME_MS; ///< The configurable time between BAM frames
+		std::uint32_t messagePoolCapacity = 64; ///< The number of pre-allocated messages in the network manager's message pool
 		std::uint8_t networkManagerMaxFramesToSendPerUpdate = 0xFF; ///< Used to control the max number of transport layer frames added to the driver queue per network manager update
 		std::uint8_t numberOfPacketsPerDPOMessage = 16; ///< The number of packets per DPO message for ETP sessions
 		std::uint8_t numberOfPacketsPerCTSMessage = 16; ///< The number of packets per CTS message for TP sessions
+		bool extendedTransportProtocolAdaptiveFlowControl = false; ///< Whether ETP sessions adapt their window and packet pacing
 	};
 } // namespace isobus
 
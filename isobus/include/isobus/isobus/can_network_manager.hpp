@@ -21,6 +21,7 @@
 #include "isobus/isobus/can_internal_control_function.hpp"
 #include "isobus/isobus/can_message.hpp"
 #include "isobus/isobus/can_message_frame.hpp"
+#include "isobus/isobus/can_message_pool.hpp"
 #include "isobus/isobus/can_network_configuration.hpp"
 #include "isobus/isobus/can_partnered_control_function.hpp"
 #include "isobus/isobus/can_transport_protocol.hpp"
@@ -34,6 +35,8 @@
 #include <list>
 #include <memory>
 #include <queue>
+#include <unordered_map>
+#include <vector>
 
 /// @brief This namespace encompasses all of the ISO11783 stack's functionality to reduce global namespace pollution
 namespace isobus
@@ -51,6 +54,8 @@ namespace isobus
 		static CANNetworkManager CANNetwork; ///< Static singleton of the one network manager. Use this to access stack functionality.
 
 		/// @brief Initializer function for the network manager
+		/// @details Clears the message queues and sizes the message pool based on
+		/// CANNetworkConfiguration::get_message_pool_capacity().
 		void initialize();
 
 		/// @brief The factory function to construct an internal control function, also automatically initializes it to be functional
@@ -101,11 +106,28 @@ namespace isobus
 		void add_any_control_function_parameter_group_number_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parent);
 
 		/// @brief This is how you remove a callback added with add_any_control_function_parameter_group_number_callback
+		/// @details Waits for any call of the callback in progress on another thread, so the parent can be destroyed once this returns
 		/// @param[in] parameterGroupNumber The PGN of the callback to remove
 		/// @param[in] callback The callback that will be removed
 		/// @param[in] parent A generic context variable that helps identify what object the callback was destined for
 		void remove_any_control_function_parameter_group_number_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parent);
 
+		/// @brief Registers a callback that can supply a sink for multi-frame messages with the associated PGN
+		/// @details The callback is asked for a sink when a TP or ETP session for the PGN is about to be accepted.
+		/// If it returns a sink, the data is written straight into it as it is received, and no message is passed to
+		/// the PGN callbacks for that session. This lets large transfers, like object pools, land directly in their final storage.
+		/// If several callbacks are registered for a PGN, the first one to return a sink is used.
+		/// @param[in] parameterGroupNumber The PGN you want to supply sinks for
+		/// @param[in] callback The callback that will be asked for a sink
+		/// @param[in] parent A generic context variable that helps identify what object the callback is destined for. Can be nullptr if you don't want to use it.
+		void add_receive_sink_callback(std::uint32_t parameterGroupNumber, ReceiveSinkCallback callback, void *parent);
+
+		/// @brief This is how you remove a callback added with add_receive_sink_callback
+		/// @param[in] parameterGroupNumber The PGN of the callback to remove
+		/// @param[in] callback The callback that will be removed
+		/// @param[in] parent A generic context variable that helps identify what object the callback was destined for
+		void remove_receive_sink_callback(std::uint32_t parameterGroupNumber, ReceiveSinkCallback callback, void *parent);
+
 		/// @brief Returns the network manager's event dispatcher for notifying consumers whenever a
 		/// message is transmitted by our application
 		/// @returns An event dispatcher which can be used to get notified about transmitted messages
@@ -125,6 +147,14 @@ namespace isobus
 		/// @returns Estimated busload over the last 1 second
 		float get_estimated_busload(std::uint8_t canChannel);
 
+		/// @brief Returns how long it is until a transport layer session on any channel needs to be updated
+		/// @details The transport protocols only update sessions that have something to send or whose timer expired,
+		/// so when this is non-zero, the thread calling update() can sleep this long without delaying any session.
+		/// Other parts of the stack, like address claiming, still need update() to be called periodically.
+		/// @returns The time until the next transport layer session is due in milliseconds, zero if one is due now,
+		/// or the max value of std::uint32_t if there are no sessions
+		std::uint32_t get_time_until_next_transport_protocol_update() const;
+
 		/// @brief This is the main way to send a CAN message of any length.
 		/// @details This function will automatically choose an appropriate transport protocol if needed.
 		/// If you don't specify a destination (or use nullptr) you message will be sent as a broadcast
@@ -204,6 +234,11 @@ namespace isobus
 		/// @returns The configuration class for this network manager
 		CANNetworkConfiguration &get_configuration();
 
+		/// @brief Returns the pool of messages used to process single frame messages without allocating.
+		/// Useful for checking its high-water mark to tune CANNetworkConfiguration::set_message_pool_capacity()
+		/// @returns The network manager's message pool
+		const CANMessagePool &get_message_pool() const;
+
 		/// @brief Returns the network manager's event dispatcher for notifying consumers whenever an
 		/// address violation occurs involving an internal control function.
 		/// @returns An event dispatcher which can be used to get notified about address violations
@@ -234,6 +269,7 @@ namespace isobus
 		bool add_protocol_parameter_group_number_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parentPointer);
 
 		/// @brief Removes a PGN callback for a protocol class
+		/// @details Waits for any call of the callback in progress on another thread, so the parent can be destroyed once this returns
 		/// @param[in] parameterGroupNumber The PGN to register for
 		/// @param[in] callback The callback to call when the PGN is received
 		/// @param[in] parentPointer A generic context variable that helps identify what object the callback was destined for
@@ -263,6 +299,14 @@ namespace isobus
 		void protocol_message_callback(const CANMessage &message);
 
 	private:
+		/// @brief Stores a callback added with add_receive_sink_callback
+		struct ReceiveSinkCallbackData
+		{
+			std::uint32_t parameterGroupNumber; ///< The PGN the callback supplies sinks for
+			ReceiveSinkCallback callback; ///< The callback to ask for a sink
+			void *parent; ///< The context variable passed to the callback
+		};
+
 		/// @brief Constructor for the network manager. Sets default values for members
 		CANNetworkManager();
 
@@ -277,6 +321,29 @@ namespace isobus
 		/// @param[in] controlFunction The control function to remove
 		void deactivate_control_function(std::shared_ptr<ControlFunction> controlFunction);
 
+		/// @brief Finds a control function the network manager knows about (active or inactive) by its NAME
+		/// @details Every control function is added to the NAME index when it is put in the address table,
+		/// so only the index is searched. Call with the control functions mutex held.
+		/// @param[in] channelIndex The CAN channel index to search on
+		/// @param[in] NAMEValue The full NAME to search for
+		/// @returns The control function with the NAME, or `nullptr` if there is none
+		std::shared_ptr<ControlFunction> find_control_function_by_NAME(std::uint8_t channelIndex, std::uint64_t NAMEValue);
+
+		/// @brief Checks if a control function from the NAME index is still in the address table or the inactive list
+		/// @param[in] controlFunction The control function to check
+		/// @param[in] channelIndex The CAN channel index the control function was indexed on
+		/// @param[in] NAMEValue The NAME the control function was indexed with
+		/// @returns `true` if the control function is still known with that NAME, otherwise `false`
+		bool get_is_indexed_control_function_valid(const std::shared_ptr<ControlFunction> &controlFunction, std::uint8_t channelIndex, std::uint64_t NAMEValue) const;
+
+		/// @brief Moves a control function to the inactive list, unless it is already in it
+		/// @param[in] controlFunction The control function to add to the inactive list
+		void add_inactive_control_function(std::shared_ptr<ControlFunction> controlFunction);
+
+		/// @brief Removes a partner from the list of partners waiting to be matched to a NAME
+		/// @param[in] partner The partner to remove
+		void remove_unbound_partner(const std::shared_ptr<PartneredControlFunction> &partner);
+
 		/// @brief Updates the internal address table based on a received CAN message
 		/// @param[in] message A message being received by the stack
 		void update_address_table(const CANMessage &message);
@@ -320,6 +387,30 @@ namespace isobus
 		                                const void *data,
 		                                std::uint32_t size) const;
 
+		/// @brief Asks the callbacks added with add_receive_sink_callback for a sink for a new receive session, used by the transport protocols
+		/// @param[in] parameterGroupNumber The PGN of the message that is about to be received
+		/// @param[in] totalMessageSize The size of the message in bytes
+		/// @param[in] source The control function sending the message
+		/// @param[in] destination The control function the message is sent to, or nullptr if it's broadcast
+		/// @param[in] parent A pointer to the network manager
+		/// @returns A sink for the message, or nullptr if no callback supplied one
+		static std::unique_ptr<CANMessageReceiveSink> get_receive_sink(std::uint32_t parameterGroupNumber,
+		                                                               std::uint32_t totalMessageSize,
+		                                                               std::shared_ptr<ControlFunction> source,
+		                                                               std::shared_ptr<ControlFunction> destination,
+		                                                               void *parent);
+
+		/// @brief Finds the first callback added with add_receive_sink_callback that supplies a sink for a new receive session
+		/// @param[in] parameterGroupNumber The PGN of the message that is about to be received
+		/// @param[in] totalMessageSize The size of the message in bytes
+		/// @param[in] source The control function sending the message
+		/// @param[in] destination The control function the message is sent to, or nullptr if it's broadcast
+		/// @returns A sink for the message, or nullptr if no callback supplied one
+		std::unique_ptr<CANMessageReceiveSink> find_receive_sink(std::uint32_t parameterGroupNumber,
+		                                                         std::uint32_t totalMessageSize,
+		                                                         std::shared_ptr<ControlFunction> source,
+		                                                         std::shared_ptr<ControlFunction> destination);
+
 		/// @brief Processes a can message for callbacks added with add_any_control_function_parameter_group_number_callback
 		/// @param[in] currentMessage The message to process
 		void process_any_control_function_pgn_callbacks(const CANMessage &currentMessage);
@@ -389,19 +480,22 @@ namespace isobus
 		std::list<std::shared_ptr<ControlFunction>> inactiveControlFunctions; ///< A list of the control function that currently don't have a valid address
 		std::list<std::shared_ptr<InternalControlFunction>> internalControlFunctions; ///< A list of the internal control functions
 		std::list<std::shared_ptr<PartneredControlFunction>> partneredControlFunctions; ///< A list of the partnered control functions
+		std::array<std::unordered_map<std::uint64_t, std::weak_ptr<ControlFunction>>, CAN_PORT_MAXIMUM> controlFunctionNAMEIndex; ///< Maps NAMEs to known control functions on each channel, entries are validated on lookup
+		std::array<std::vector<std::shared_ptr<PartneredControlFunction>>, CAN_PORT_MAXIMUM> unboundPartneredControlFunctions; ///< Partners on each channel that have not been matched to a NAME yet, in creation order
+		std::vector<std::shared_ptr<PartneredControlFunction>> newPartneredControlFunctions; ///< Partners that still need to be matched against the existing control functions
 		mutable Mutex controlFunctionsMutex; ///< Mutex to protect access to controlFunctionTable, internalControlFunctions, and partneredControlFunctions.
 
-		std::list<ParameterGroupNumberCallbackData> protocolPGNCallbacks; ///< A list of PGN callback registered by CAN protocols
-		Queue<std::shared_ptr<CANMessage>> receivedMessageQueue; ///< A queue of received messages to process
-		Queue<std::shared_ptr<CANMessage>> transmittedMessageQueue; ///< A queue of transmitted messages to process (already sent, so changes to the message won't affect the bus)
+		ParameterGroupNumberCallbackTable protocolPGNCallbacks; ///< PGN callbacks registered by CAN protocols
+		CANMessagePool messagePool; ///< Pre-allocated messages for the receive and transmit queues
+		CANMessageQueue receivedMessageQueue; ///< A queue of received messages to process, acquired from messagePool
+		CANMessageQueue transmittedMessageQueue; ///< A queue of transmitted messages to process (already sent, so changes to the message won't affect the bus), acquired from messagePool
 		std::list<ControlFunctionStateCallback> controlFunctionStateCallbacks; ///< List of all control function state callbacks
-		std::vector<ParameterGroupNumberCallbackData> globalParameterGroupNumberCallbacks; ///< A list of all global PGN callbacks
-		std::vector<ParameterGroupNumberCallbackData> anyControlFunctionParameterGroupNumberCallbacks; ///< A list of all global PGN callbacks
+		ParameterGroupNumberCallbackTable globalParameterGroupNumberCallbacks; ///< All global PGN callbacks
+		ParameterGroupNumberCallbackTable anyControlFunctionParameterGroupNumberCallbacks; ///< All "any CF" PGN callbacks
 		EventDispatcher<CANMessage> messageTransmittedEventDispatcher; ///< An event dispatcher for notifying consumers about transmitted messages by our application
 		EventDispatcher<std::shared_ptr<InternalControlFunction>> addressViolationEventDispatcher; ///< An event dispatcher for notifying consumers about address violations
-		Mutex protocolPGNCallbacksMutex; ///< A mutex for PGN callback thread safety
-		mutable Mutex globalPGNCallbacksMutex; ///< Mutex to protect the global PGN callbacks
-		Mutex anyControlFunctionCallbacksMutex; ///< Mutex to protect the "any CF" callbacks
+		std::vector<ReceiveSinkCallbackData> receiveSinkCallbacks; ///< All callbacks that can supply sinks for received multi-frame messages
+		Mutex receiveSinkCallbacksMutex; ///< A mutex that protects access to the receive sink callbacks
 		Mutex busloadUpdateMutex; ///< A mutex that protects the busload metrics since we calculate it on our own thread
 		Mutex controlFunctionStatusCallbacksMutex; ///< A Mutex that protects access to the control function status callback list
 		std::uint32_t busloadUpdateTimestamp_ms = 0; ///< Tracks a time window for determining approximate busload
@@ -92,6 +92,7 @@ namespace isobus
 		friend class CANNetworkManager; ///< Allows the network manager to use get_parameter_group_number_callback
 
 		const std::vector<NAMEFilter> NAMEFilterList; ///< A list of NAME parameters that describe this control function's identity
+		const CompiledNAMEFilter compiledNAMEFilter; ///< The NAME filter list compiled to a mask and value, used for matching
 		std::vector<ParameterGroupNumberCallbackData> parameterGroupNumberCallbacks; ///< A list of all parameter group number callbacks associated with this control function
 		Mutex parameterGroupNumberCallbacksMutex; ///< Mutex to protect access to the parameter group number callbacks
 		bool initialized = false; ///< A way to track if the network manager has processed this CF against existing CFs
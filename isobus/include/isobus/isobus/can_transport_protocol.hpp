@@ -12,11 +12,13 @@
 #ifndef CAN_TRANSPORT_PROTOCOL_HPP
 #define CAN_TRANSPORT_PROTOCOL_HPP
 
+#include <array>
 #include <list>
 
 #include "isobus/isobus/can_message_frame.hpp"
 #include "isobus/isobus/can_network_configuration.hpp"
 #include "isobus/isobus/can_transport_protocol_base.hpp"
+#include "isobus/isobus/can_transport_protocol_session_table.hpp"
 
 namespace isobus
 {
@@ -157,6 +159,58 @@ namespace isobus
 			std::uint8_t lastAcknowledgedPacketNumber = 0; ///< The last acknowledged packet number by the receiver
 			std::uint8_t clearToSendPacketCount = 0; ///< The number of packets to be sent in response to one CTS
 			std::uint8_t clearToSendPacketCountMax = 0xFF; ///< The max packets that can be sent per CTS as indicated by the RTS message
+			std::uint64_t lastBroadcastFrameTimestamp_us = 0; ///< When the last frame of a broadcast tx session was sent, in microseconds
+			std::uint64_t nextBroadcastFrameTimestamp_us = 0; ///< When the next data frame of a broadcast tx session is scheduled, in microseconds
+		};
+
+		/// @brief A histogram of the achieved timing between the data frames of transmitted broadcast (BAM) sessions
+		/// @details Each sample is the jitter of one data frame, which is how much later than scheduled it was sent.
+		/// The jitter is sorted into buckets with a fixed upper bound, the last bucket holds everything larger.
+		class BroadcastPacingStatistics
+		{
+		public:
+			static constexpr std::size_t NUMBER_OF_JITTER_BUCKETS = 8; ///< The number of buckets in the jitter histogram
+
+			/// @brief Adds the timing of one sent data frame to the statistics
+			/// @param[in] interFrameTime_us The achieved time since the previous frame of the session, in microseconds
+			/// @param[in] targetInterFrameTime_us The time the frame was scheduled after the previous frame, in microseconds
+			void add_sample(std::uint64_t interFrameTime_us, std::uint64_t targetInterFrameTime_us);
+
+			/// @brief Clears all samples
+			void reset();
+
+			/// @brief Get the number of frames that were sampled
+			/// @return The number of frames that were sampled
+			std::uint32_t get_number_of_samples() const;
+
+			/// @brief Get the number of frames whose jitter fell in a bucket of the histogram
+			/// @param[in] bucket The index of the bucket, less than NUMBER_OF_JITTER_BUCKETS
+			/// @return The number of frames in the bucket, or zero if the bucket is out of range
+			std::uint32_t get_jitter_bucket_count(std::size_t bucket) const;
+
+			/// @brief Get the largest jitter a frame in a bucket can have
+			/// @param[in] bucket The index of the bucket, less than NUMBER_OF_JITTER_BUCKETS
+			/// @return The inclusive upper bound of the bucket in microseconds, the max value of std::uint64_t for the last bucket
+			static std::uint64_t get_jitter_bucket_upper_bound_us(std::size_t bucket);
+
+			/// @brief Get the average jitter of all sampled frames
+			/// @return The average jitter in microseconds
+			std::uint64_t get_average_jitter_us() const;
+
+			/// @brief Get the largest jitter of all sampled frames
+			/// @return The largest jitter in microseconds
+			std::uint64_t get_maximum_jitter_us() const;
+
+			/// @brief Get the number of frames that were sent after more than the maximum time between BAM frames allowed by J1939
+			/// @return The number of frames that were sent too late
+			std::uint32_t get_number_of_late_frames() const;
+
+		private:
+			std::array<std::uint32_t, NUMBER_OF_JITTER_BUCKETS> jitterBuckets = { 0 }; ///< The number of samples per jitter bucket
+			std::uint64_t totalJitter_us = 0; ///< The sum of the jitter of all samples
+			std::uint64_t maximumJitter_us = 0; ///< The largest jitter of all samples
+			std::uint32_t numberOfSamples = 0; ///< The number of samples
+			std::uint32_t numberOfLateFrames = 0; ///< The number of samples above the maximum time between BAM frames
 		};
 
 		static constexpr std::uint32_t REQUEST_TO_SEND_MULTIPLEXOR = 0x10; ///< (16) TP.CM_RTS Multiplexor
@@ -169,6 +223,7 @@ namespace isobus
 		static constexpr std::uint16_t T2_T3_TIMEOUT_MS = 1250; ///< The t2/t3 timeouts as defined by the standard
 		static constexpr std::uint16_t T4_TIMEOUT_MS = 1050; ///< The t4 timeout as defined by the standard
 		static constexpr std::uint8_t R_TIMEOUT_MS = 200; ///< The Tr Timeout as defined by the standard
+		static constexpr std::uint8_t MAX_BAM_FRAME_DELAY_MS = 200; ///< The maximum time between the frames of a broadcast session as defined by J1939
 		static constexpr std::uint8_t SEQUENCE_NUMBER_DATA_INDEX = 0; ///< The index of the sequence number in a frame
 		static constexpr std::uint8_t PROTOCOL_BYTES_PER_FRAME = 7; ///< The number of payload bytes per frame minus overhead of sequence number
 
@@ -181,9 +236,30 @@ namespace isobus
 		                         const CANMessageCallback &canMessageReceivedCallback,
 		                         const CANNetworkConfiguration *configuration);
 
-		/// @brief Updates all sessions managed by this protocol manager instance.
+		/// @brief Updates the sessions managed by this protocol manager instance that are due.
+		/// @details A session is due when it has frames to send, received a message since the last update,
+		/// or one of its timers expired. Sessions that are just waiting are not touched.
 		void update();
 
+		/// @brief Returns how long it is until a session managed by this instance needs to be updated
+		/// @returns The time until the next session is due in milliseconds, zero if one is due now,
+		/// or the max value of std::uint32_t if there are no sessions
+		std::uint32_t get_time_until_next_update() const;
+
+		/// @brief Returns the achieved timing between the data frames of the broadcast sessions sent by this instance
+		/// @returns A copy of the broadcast pacing statistics
+		BroadcastPacingStatistics get_broadcast_pacing_statistics() const;
+
+		/// @brief Clears the broadcast pacing statistics
+		void reset_broadcast_pacing_statistics();
+
+		/// @brief Sets a callback that is asked for a sink each time a new message starts being received
+		/// @details When the callback returns a sink, the data of the message is written straight into it instead
+		/// of being reassembled into a CANMessage. The callback is called before the session is accepted.
+		/// @param[in] callback The callback to ask for a sink, or nullptr to always reassemble messages
+		/// @param[in] parent A generic context variable that is passed to the callback
+		void set_receive_sink_callback(ReceiveSinkCallback callback, void *parent);
+
 		/// @brief Checks if the source and destination control function have an active session/connection.
 		/// @param[in] source The source control function for the session
 		/// @param[in] destination The destination control function for the session
@@ -232,6 +308,11 @@ namespace isobus
 		                std::uint32_t parameterGroupNumber,
 		                ConnectionAbortReason reason) const;
 
+		/// @brief Gives an accepted receive session the storage its data is received into,
+		/// either a sink from the receive sink callback or the session's own buffer
+		/// @param[in] session The receive session that was just accepted
+		void prepare_receive_data(const std::shared_ptr<TransportProtocolSession> &session) const;
+
 		/// @brief Gracefully closes a session to prepare for a new session
 		/// @param[in] session The session to close
 		/// @param[in] successful Denotes if the session was successful
@@ -259,7 +340,18 @@ namespace isobus
 
 		///@brief Sends data transfer packets for the specified TransportProtocolSession.
 		/// @param[in] session The TransportProtocolSession for which to send data transfer packets.
-		void send_data_transfer_packets(const std::shared_ptr<TransportProtocolSession> &session);
+		/// @param[in] maxFramesToSend The max number of frames to send, the session's CTS window also limits this
+		/// @returns The number of frames that were sent
+		std::uint8_t send_data_transfer_packets(const std::shared_ptr<TransportProtocolSession> &session, std::uint8_t maxFramesToSend);
+
+		/// @brief Sends the data frames of all destination specific transmit sessions that are allowed to send,
+		/// one frame per session at a time, so that concurrent sessions share the bus fairly.
+		void send_data_transfer_packets_round_robin();
+
+		/// @brief Counts the destination specific transmit sessions of a source control function
+		/// @param[in] source The source control function
+		/// @returns The number of destination specific transmit sessions from the source
+		std::size_t get_number_of_transmit_sessions_from_source(const std::shared_ptr<ControlFunction> &source) const;
 
 		/// @brief Processes a broadcast announce message.
 		/// @param[in] source The source control function that sent the broadcast announce message.
@@ -320,12 +412,36 @@ namespace isobus
 		/// @param[in] session The session to update
 		void update_state_machine(std::shared_ptr<TransportProtocolSession> &session);
 
+		/// @brief Calculates when a session next needs to be updated, based on its state and its timers
+		/// @param[in] session The session to calculate the deadline for
+		/// @param[in] now The current timestamp in milliseconds
+		/// @returns The timestamp in milliseconds at which the session is due
+		std::uint32_t get_session_deadline(const std::shared_ptr<TransportProtocolSession> &session, std::uint32_t now) const;
+
+		/// @brief Sends the next data frame of a broadcast tx session if its scheduled time has come,
+		/// and schedules the frame after it against the microsecond clock
+		/// @param[in] session The broadcast tx session to pace
+		void send_paced_broadcast_data_frame(const std::shared_ptr<TransportProtocolSession> &session);
+
+		/// @brief Makes the sessions between two control functions, in either direction, due on the next update
+		/// @param[in] source The source control function of a received message
+		/// @param[in] destination The destination control function of a received message
+		void schedule_session_update(const std::shared_ptr<ControlFunction> &source, const std::shared_ptr<ControlFunction> &destination);
+
 		mutable Mutex activeSessionsMutex; ///< Synchronizes access to @ref activeSessions
-		std::list<std::shared_ptr<TransportProtocolSession>> activeSessions; ///< A list of all active TP sessions
+		Mutex updateMutex; ///< Serializes calls to @ref update, which share the scratch lists below
+		TransportProtocolSessionTable<TransportProtocolSession> activeSessions; ///< All active TP sessions, indexed by source and destination
+		std::vector<std::shared_ptr<TransportProtocolSession>> dueSessions; ///< Scratch list of sessions that are due in the current update
+		std::vector<std::shared_ptr<TransportProtocolSession>> roundRobinSessions; ///< Scratch list of sessions taking part in the current round robin pass
+		std::size_t roundRobinOffset = 0; ///< Rotates which session sends the first frame of each round robin pass
+		mutable Mutex pacingStatisticsMutex; ///< Synchronizes access to @ref pacingStatistics
+		BroadcastPacingStatistics pacingStatistics; ///< The achieved timing between data frames of broadcast tx sessions
 
 		const CANMessageFrameCallback sendCANFrameCallback; ///< A callback for sending a CAN frame
 		const CANMessageCallback canMessageReceivedCallback; ///< A callback for when a complete CAN message is received using the TP protocol
 		const CANNetworkConfiguration *configuration; ///< The configuration to use for this protocol
+		ReceiveSinkCallback receiveSinkCallback = nullptr; ///< A callback that can supply a sink for the data of new receive sessions
+		void *receiveSinkParent = nullptr; ///< The context variable passed to the receive sink callback
 	};
 
 } // namespace isobus
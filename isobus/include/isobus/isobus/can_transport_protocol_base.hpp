@@ -16,6 +16,9 @@
 
 namespace isobus
 {
+	template<typename SessionType>
+	class TransportProtocolSessionTable;
+
 	/// @brief An object to keep track of session information internally
 	class TransportProtocolSessionBase
 	{
@@ -112,13 +115,26 @@ namespace isobus
 		std::uint32_t get_time_since_last_update() const;
 
 		/// @brief Complete the session
+		/// @details For receive sessions with a sink, the sink is told that the session was closed and then released.
 		/// @param[in] success True if the session was successful, false otherwise
-		void complete(bool success) const;
+		void complete(bool success);
+
+		/// @brief Hand the data of a receive session to a consumer's sink instead of the session's own buffer
+		/// @param[in] sink The sink to write the received data into
+		void set_receive_sink(std::unique_ptr<CANMessageReceiveSink> sink);
+
+		/// @brief Get the sink that the received data is written into, if the consumer supplied one
+		/// @return The sink of the session, or nullptr if the data is reassembled into the session's buffer
+		CANMessageReceiveSink *get_receive_sink() const;
 
 	private:
+		template<typename SessionType>
+		friend class TransportProtocolSessionTable; ///< Allows the session table to keep track of when the session is due
+
 		Direction direction; ///< The direction of the session
 		std::uint32_t parameterGroupNumber; ///< The PGN of the message
 		std::unique_ptr<CANMessageData> data; ///< The data buffer for the message
+		std::unique_ptr<CANMessageReceiveSink> receiveSink; ///< A consumer supplied destination for received data, which replaces the data buffer when set
 		std::shared_ptr<ControlFunction> source; ///< The source control function
 		std::shared_ptr<ControlFunction> destination; ///< The destination control function
 		std::uint32_t timestamp_ms = 0; ///< A timestamp used to track session timeouts
@@ -127,6 +143,9 @@ namespace isobus
 
 		TransmitCompleteCallback sessionCompleteCallback = nullptr; ///< A callback that is to be called when the session is completed
 		void *parent = nullptr; ///< A generic context variable that helps identify what object callbacks are destined for. Can be nullptr
+		std::uint32_t scheduledDeadline_ms = 0; ///< The time the session is due to be updated, only valid if deadlineScheduled is set
+		std::uint32_t sessionTableOrder = 0; ///< The order in which the session was added to its session table
+		bool deadlineScheduled = false; ///< Whether the session is waiting in the deadline queue of its session table
 	};
 } // namespace isobus
 
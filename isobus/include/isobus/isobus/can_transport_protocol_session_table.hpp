@@ -0,0 +1,365 @@
+//================================================================================================
+/// @file can_transport_protocol_session_table.hpp
+///
+/// @brief A container for the active sessions of a transport protocol manager, indexed by
+/// source, destination and optionally the parameter group number, with a queue of when
+/// each session is next due to be updated.
+/// @author Adrian Del Grosso
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+
+#ifndef CAN_TRANSPORT_PROTOCOL_SESSION_TABLE_HPP
+#define CAN_TRANSPORT_PROTOCOL_SESSION_TABLE_HPP
+
+#include "isobus/isobus/can_control_function.hpp"
+#include "isobus/isobus/can_transport_protocol_base.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace isobus
+{
+	//================================================================================================
+	/// @class TransportProtocolSessionTable
+	///
+	/// @brief Stores the active sessions of a transport protocol manager.
+	/// @details Sessions are kept in a contiguous list in the order they were added, so they can be
+	/// iterated by index without copying the list, and in an open addressing hash index keyed on the
+	/// source and destination control functions (and the PGN, if enabled) for constant time lookup.
+	/// Both are sized up front by reserve(), so adding, finding and removing sessions does not touch
+	/// the heap until the reserved capacity is exceeded.
+	///
+	/// The table also keeps a min-heap of deadlines, so the owner only has to update the sessions whose
+	/// timer expired or that have work to do, instead of polling every session on every update.
+	/// A session has at most one live deadline, stale entries are skipped when they come up.
+	/// The table is not thread safe, the owner is responsible for locking.
+	/// @tparam SessionType The session type, must derive from TransportProtocolSessionBase
+	//================================================================================================
+	template<typename SessionType>
+	class TransportProtocolSessionTable
+	{
+	public:
+		/// @brief Constructs an empty session table
+		/// @param[in] keyOnParameterGroupNumber If true, sessions with the same source and destination but a different PGN are told apart
+		explicit TransportProtocolSessionTable(bool keyOnParameterGroupNumber = false) :
+		  keyOnParameterGroupNumber(keyOnParameterGroupNumber)
+		{
+		}
+
+		/// @brief Pre-allocates room for a number of sessions
+		/// @param[in] capacity The number of sessions the table can hold without allocating
+		void reserve(std::size_t capacity)
+		{
+			sessions.reserve(capacity);
+			deadlines.reserve(2 * capacity);
+			if ((2 * capacity) > index.size())
+			{
+				rebuild_index(2 * capacity);
+			}
+		}
+
+		/// @brief Adds a session to the table
+		/// @param[in] session The session to add
+		void insert(std::shared_ptr<SessionType> session)
+		{
+			if ((2 * (sessions.size() + 1)) > index.size())
+			{
+				// Keep the load factor of the index at or below one half
+				rebuild_index(2 * (sessions.size() + 1));
+			}
+			insert_into_index(session);
+			TransportProtocolSessionBase &base = *session;
+			base.sessionTableOrder = nextSessionTableOrder++;
+			base.deadlineScheduled = false;
+			sessions.push_back(std::move(session));
+		}
+
+		/// @brief Removes a session from the table
+		/// @param[in] session The session to remove
+		/// @returns true if the session was in the table, otherwise false
+		bool erase(const std::shared_ptr<SessionType> &session)
+		{
+			bool retVal = false;
+			auto sessionLocation = std::find(sessions.begin(), sessions.end(), session);
+
+			if (sessions.end() != sessionLocation)
+			{
+				sessions.erase(sessionLocation);
+				erase_from_index(session);
+				static_cast<TransportProtocolSessionBase &>(*session).deadlineScheduled = false;
+				retVal = true;
+			}
+			return retVal;
+		}
+
+		/// @brief Finds a session by its source and destination
+		/// @param[in] source The source control function of the session
+		/// @param[in] destination The destination control function of the session, or nullptr for broadcast sessions
+		/// @param[in] parameterGroupNumber The PGN of the session, only used if the table is keyed on the PGN
+		/// @returns The session, or nullptr if there is no matching session
+		std::shared_ptr<SessionType> find(const std::shared_ptr<ControlFunction> &source,
+		                                  const std::shared_ptr<ControlFunction> &destination,
+		                                  std::uint32_t parameterGroupNumber = 0) const
+		{
+			std::shared_ptr<SessionType> retVal = nullptr;
+
+			if (!index.empty())
+			{
+				const Key key = make_key(source.get(), destination.get(), parameterGroupNumber);
+				for (std::size_t slot = get_home_slot(key); nullptr != index[slot]; slot = next_slot(slot))
+				{
+					if (get_key(index[slot]) == key)
+					{
+						retVal = index[slot];
+						break;
+					}
+				}
+			}
+			return retVal;
+		}
+
+		/// @brief Schedules a session to be updated once a point in time is reached
+		/// @details If the session is already scheduled for an earlier time, the earlier time is kept.
+		/// The owner is expected to schedule the session again each time it is updated.
+		/// @param[in] session The session to schedule, must be in the table
+		/// @param[in] deadline_ms The timestamp in milliseconds at which the session is due
+		void schedule(const std::shared_ptr<SessionType> &session, std::uint32_t deadline_ms)
+		{
+			TransportProtocolSessionBase &base = *session;
+			if ((!base.deadlineScheduled) || is_before(deadline_ms, base.scheduledDeadline_ms))
+			{
+				base.deadlineScheduled = true;
+				base.scheduledDeadline_ms = deadline_ms;
+				deadlines.push_back(Deadline{ deadline_ms, session });
+				std::push_heap(deadlines.begin(), deadlines.end(), is_later_deadline);
+			}
+		}
+
+		/// @brief Takes the sessions that are due out of the deadline queue
+		/// @details The due sessions are no longer scheduled afterwards, and are added to the output in
+		/// the reverse order they were added to the table, so closing one doesn't affect the others.
+		/// @param[in] now_ms The current timestamp in milliseconds
+		/// @param[out] dueSessions The list to add the due sessions to
+		void take_due_sessions(std::uint32_t now_ms, std::vector<std::shared_ptr<SessionType>> &dueSessions)
+		{
+			const std::size_t firstDueSession = dueSessions.size();
+
+			while ((!deadlines.empty()) && (!is_before(now_ms, deadlines.front().deadline_ms)))
+			{
+				std::pop_heap(deadlines.begin(), deadlines.end(), is_later_deadline);
+				Deadline deadline = std::move(deadlines.back());
+				deadlines.pop_back();
+
+				auto session = deadline.session.lock();
+				if (nullptr != session)
+				{
+					TransportProtocolSessionBase &base = *session;
+					if (base.deadlineScheduled && (base.scheduledDeadline_ms == deadline.deadline_ms))
+					{
+						base.deadlineScheduled = false;
+						dueSessions.push_back(std::move(session));
+					}
+				}
+			}
+
+			std::sort(dueSessions.begin() + firstDueSession, dueSessions.end(), [](const std::shared_ptr<SessionType> &first, const std::shared_ptr<SessionType> &second) {
+				return static_cast<const TransportProtocolSessionBase &>(*first).sessionTableOrder > static_cast<const TransportProtocolSessionBase &>(*second).sessionTableOrder;
+			});
+		}
+
+		/// @brief Returns if any session is waiting in the deadline queue
+		/// @returns true if there is a deadline, otherwise false
+		bool has_deadline() const
+		{
+			return !deadlines.empty();
+		}
+
+		/// @brief Returns the time until the earliest deadline in the queue. This can be earlier than needed if the
+		/// session was rescheduled or removed since, which only means the owner checks it once for nothing.
+		/// @param[in] now_ms The current timestamp in milliseconds
+		/// @returns The time until the earliest deadline in milliseconds, zero if it already passed,
+		/// or the max value of std::uint32_t if there is no deadline
+		std::uint32_t get_time_until_next_deadline(std::uint32_t now_ms) const
+		{
+			std::uint32_t retVal = std::numeric_limits<std::uint32_t>::max();
+
+			if (!deadlines.empty())
+			{
+				retVal = is_before(now_ms, deadlines.front().deadline_ms) ? (deadlines.front().deadline_ms - now_ms) : 0;
+			}
+			return retVal;
+		}
+
+		/// @brief Returns the number of sessions in the table
+		/// @returns The number of sessions in the table
+		std::size_t size() const
+		{
+			return sessions.size();
+		}
+
+		/// @brief Returns a session by its position in the table, sessions are kept in the order they were added
+		/// @param[in] position The position of the session
+		/// @returns The session at the position
+		const std::shared_ptr<SessionType> &at(std::size_t position) const
+		{
+			return sessions.at(position);
+		}
+
+		/// @brief Returns all sessions in the order they were added
+		/// @returns All sessions in the table
+		const std::vector<std::shared_ptr<SessionType>> &get_sessions() const
+		{
+			return sessions;
+		}
+
+	private:
+		/// @brief An entry in the deadline queue
+		struct Deadline
+		{
+			std::uint32_t deadline_ms; ///< The timestamp at which the session is due
+			std::weak_ptr<SessionType> session; ///< The session, weak so the queue never keeps a closed session alive
+		};
+
+		/// @brief Compares two timestamps, taking the wrap around of the millisecond timer into account
+		/// @param[in] first The first timestamp
+		/// @param[in] second The second timestamp
+		/// @returns true if the first timestamp is before the second one
+		static bool is_before(std::uint32_t first, std::uint32_t second)
+		{
+			return static_cast<std::int32_t>(first - second) < 0;
+		}
+
+		/// @brief Orders the deadline queue as a min-heap
+		/// @param[in] first The first deadline
+		/// @param[in] second The second deadline
+		/// @returns true if the first deadline is later than the second one
+		static bool is_later_deadline(const Deadline &first, const Deadline &second)
+		{
+			return is_before(second.deadline_ms, first.deadline_ms);
+		}
+
+		/// @brief The values a session is looked up by
+		struct Key
+		{
+			const ControlFunction *source; ///< The source control function
+			const ControlFunction *destination; ///< The destination control function, nullptr for broadcast
+			std::uint32_t parameterGroupNumber; ///< The PGN, zero if the table is not keyed on the PGN
+
+			/// @brief Compares two keys
+			/// @param[in] other The key to compare with
+			/// @returns true if the keys are equal
+			bool operator==(const Key &other) const
+			{
+				return (source == other.source) && (destination == other.destination) && (parameterGroupNumber == other.parameterGroupNumber);
+			}
+		};
+
+		/// @brief Creates a key, ignoring the PGN if the table is not keyed on it
+		/// @param[in] source The source control function
+		/// @param[in] destination The destination control function
+		/// @param[in] parameterGroupNumber The PGN
+		/// @returns The key
+		Key make_key(const ControlFunction *source, const ControlFunction *destination, std::uint32_t parameterGroupNumber) const
+		{
+			return Key{ source, destination, keyOnParameterGroupNumber ? parameterGroupNumber : 0 };
+		}
+
+		/// @brief Returns the key of a session
+		/// @param[in] session The session
+		/// @returns The key of the session
+		Key get_key(const std::shared_ptr<SessionType> &session) const
+		{
+			return make_key(session->get_source().get(), session->get_destination().get(), session->get_parameter_group_number());
+		}
+
+		/// @brief Returns the slot in the index where the search for a key starts
+		/// @param[in] key The key
+		/// @returns The first slot to probe for the key
+		std::size_t get_home_slot(const Key &key) const
+		{
+			std::uint64_t hash = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(key.source)) * 0x9E3779B97F4A7C15ULL;
+			hash ^= (static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(key.destination)) + key.parameterGroupNumber) * 0xC2B2AE3D27D4EB4FULL;
+			hash ^= (hash >> 29);
+			return static_cast<std::size_t>(hash) & (index.size() - 1);
+		}
+
+		/// @brief Returns the slot after a slot, wrapping around at the end of the index
+		/// @param[in] slot The current slot
+		/// @returns The next slot
+		std::size_t next_slot(std::size_t slot) const
+		{
+			return (slot + 1) & (index.size() - 1);
+		}
+
+		/// @brief Adds a session to the index, the index must have a free slot
+		/// @param[in] session The session to add
+		void insert_into_index(const std::shared_ptr<SessionType> &session)
+		{
+			std::size_t slot = get_home_slot(get_key(session));
+			while (nullptr != index[slot])
+			{
+				slot = next_slot(slot);
+			}
+			index[slot] = session;
+		}
+
+		/// @brief Removes a session from the index, moving later entries back so lookups never hit a gap
+		/// @param[in] session The session to remove
+		void erase_from_index(const std::shared_ptr<SessionType> &session)
+		{
+			std::size_t slot = get_home_slot(get_key(session));
+			while ((nullptr != index[slot]) && (index[slot] != session))
+			{
+				slot = next_slot(slot);
+			}
+
+			if (nullptr != index[slot])
+			{
+				index[slot] = nullptr;
+
+				for (std::size_t nextSlot = next_slot(slot); nullptr != index[nextSlot]; nextSlot = next_slot(nextSlot))
+				{
+					const std::size_t homeSlot = get_home_slot(get_key(index[nextSlot]));
+
+					// Move the entry into the gap if the gap lies between its home slot and where it is now
+					if (((nextSlot - homeSlot) & (index.size() - 1)) >= ((nextSlot - slot) & (index.size() - 1)))
+					{
+						index[slot] = std::move(index[nextSlot]);
+						index[nextSlot] = nullptr;
+						slot = nextSlot;
+					}
+				}
+			}
+		}
+
+		/// @brief Re-creates the index with at least the requested number of slots
+		/// @param[in] minimumSlots The minimum number of slots in the new index
+		void rebuild_index(std::size_t minimumSlots)
+		{
+			std::size_t numberOfSlots = 8;
+			while (numberOfSlots < minimumSlots)
+			{
+				numberOfSlots *= 2;
+			}
+
+			index.assign(numberOfSlots, nullptr);
+			for (const auto &session : sessions)
+			{
+				insert_into_index(session);
+			}
+		}
+
+		std::vector<std::shared_ptr<SessionType>> sessions; ///< The sessions in the order they were added
+		std::vector<std::shared_ptr<SessionType>> index; ///< Open addressing hash index of the sessions, the size is always a power of two
+		std::vector<Deadline> deadlines; ///< Min-heap of when sessions are due to be updated
+		std::uint32_t nextSessionTableOrder = 0; ///< The order given to the next session added to the table
+		const bool keyOnParameterGroupNumber; ///< If true, the PGN is part of the key
+	};
+} // namespace isobus
+
+#endif // CAN_TRANSPORT_PROTOCOL_SESSION_TABLE_HPP
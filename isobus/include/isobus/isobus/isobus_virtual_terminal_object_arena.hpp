@@ -0,0 +1,171 @@
+//================================================================================================
+/// @file isobus_virtual_terminal_object_arena.hpp
+///
+/// @brief A monotonic memory arena used to back the VT objects of a working set, so that
+/// parsing an object pool doesn't need a heap allocation for every object and child list.
+/// @author Adrian Del Grosso
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+
+#ifndef ISOBUS_VIRTUAL_TERMINAL_OBJECT_ARENA_HPP
+#define ISOBUS_VIRTUAL_TERMINAL_OBJECT_ARENA_HPP
+
+#include "isobus/utility/thread_synchronization.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace isobus
+{
+	//================================================================================================
+	/// @class VTObjectArena
+	///
+	/// @brief A monotonic buffer that hands out memory from large blocks and never frees individual allocations.
+	/// @details All memory is returned to the heap in one go when the arena is destroyed. Objects allocated with a
+	/// VTObjectArenaAllocator keep the arena alive, so it is destroyed once the working set that owns it and every
+	/// object allocated from it are gone. Memory of objects that are replaced while the arena is alive is not reused.
+	//================================================================================================
+	class VTObjectArena
+	{
+	public:
+		/// @brief Constructs an empty arena, no memory is allocated until the first allocation
+		/// @param[in] blockSize The size of the blocks the arena requests from the heap
+		explicit VTObjectArena(std::size_t blockSize = DEFAULT_BLOCK_SIZE);
+
+		/// @brief Deleted copy constructor, the arena hands out raw pointers into its blocks
+		VTObjectArena(const VTObjectArena &) = delete;
+
+		/// @brief Deleted copy assignment operator, the arena hands out raw pointers into its blocks
+		/// @returns Nothing, this function is deleted
+		VTObjectArena &operator=(const VTObjectArena &) = delete;
+
+		/// @brief Allocates memory from the arena. Requests larger than a quarter of a block get a block of their own.
+		/// @param[in] size The number of bytes to allocate
+		/// @param[in] alignment The alignment of the allocation, must be a power of two
+		/// @returns A pointer to the allocated memory
+		void *allocate(std::size_t size, std::size_t alignment);
+
+		/// @brief Returns the number of allocations served by the arena
+		/// @returns The number of allocations served by the arena
+		std::size_t get_number_of_allocations() const;
+
+		/// @brief Returns the number of blocks the arena requested from the heap
+		/// @returns The number of heap allocations made by the arena
+		std::size_t get_number_of_blocks() const;
+
+		/// @brief Returns the number of bytes handed out by the arena
+		/// @returns The number of bytes handed out by the arena
+		std::size_t get_bytes_used() const;
+
+		/// @brief Returns the total size of the blocks the arena requested from the heap
+		/// @returns The total size of the arena's blocks in bytes
+		std::size_t get_bytes_reserved() const;
+
+		static constexpr std::size_t DEFAULT_BLOCK_SIZE = 16384; ///< The default size of the blocks requested from the heap
+
+	private:
+		std::vector<std::unique_ptr<std::uint8_t[]>> blocks; ///< The blocks requested from the heap
+		mutable Mutex arenaMutex; ///< Protects the blocks and statistics
+		std::size_t blockSize; ///< The size of the blocks requested from the heap
+		std::uint8_t *currentBlock = nullptr; ///< The block allocations are currently served from
+		std::size_t currentBlockOffset = 0; ///< The offset of the next free byte in the current block
+		std::size_t numberOfAllocations = 0; ///< The number of allocations served by the arena
+		std::size_t bytesUsed = 0; ///< The number of bytes handed out by the arena
+		std::size_t bytesReserved = 0; ///< The total size of the blocks requested from the heap
+	};
+
+	//================================================================================================
+	/// @class VTObjectArenaAllocator
+	///
+	/// @brief A standard library allocator that allocates from a VTObjectArena, or from the heap if it has no arena.
+	/// @details Deallocating memory that came from an arena does nothing, the arena frees it when it is destroyed.
+	/// Every copy of the allocator shares ownership of the arena, so containers and shared pointers created with it
+	/// keep their memory valid for as long as they exist.
+	//================================================================================================
+	template<typename T>
+	class VTObjectArenaAllocator
+	{
+	public:
+		using value_type = T; ///< The type of the objects this allocator allocates
+		using propagate_on_container_move_assignment = std::true_type; ///< Moving a container moves its arena along with it
+		using propagate_on_container_swap = std::true_type; ///< Swapping containers swaps their arenas
+
+		/// @brief Constructs an allocator that allocates from the heap
+		VTObjectArenaAllocator() = default;
+
+		/// @brief Constructs an allocator that allocates from an arena
+		/// @param[in] arena The arena to allocate from, or nullptr to allocate from the heap
+		explicit VTObjectArenaAllocator(std::shared_ptr<VTObjectArena> arena) :
+		  arena(std::move(arena))
+		{
+		}
+
+		/// @brief Constructs an allocator for another type that shares the arena of an existing allocator
+		/// @param[in] other The allocator to share the arena of
+		template<typename U>
+		VTObjectArenaAllocator(const VTObjectArenaAllocator<U> &other) :
+		  arena(other.get_arena())
+		{
+		}
+
+		/// @brief Allocates memory for a number of objects
+		/// @param[in] count The number of objects to allocate memory for
+		/// @returns A pointer to the allocated memory
+		T *allocate(std::size_t count)
+		{
+			if (nullptr != arena)
+			{
+				return static_cast<T *>(arena->allocate(count * sizeof(T), alignof(T)));
+			}
+			return static_cast<T *>(::operator new(count * sizeof(T)));
+		}
+
+		/// @brief Frees memory allocated by this allocator, which only does something if it came from the heap
+		/// @param[in] pointer The memory to free
+		void deallocate(T *pointer, std::size_t)
+		{
+			if (nullptr == arena)
+			{
+				::operator delete(pointer);
+			}
+		}
+
+		/// @brief Returns the arena this allocator allocates from
+		/// @returns The arena this allocator allocates from, or nullptr if it allocates from the heap
+		const std::shared_ptr<VTObjectArena> &get_arena() const
+		{
+			return arena;
+		}
+
+	private:
+		std::shared_ptr<VTObjectArena> arena; ///< The arena to allocate from, or nullptr to allocate from the heap
+	};
+
+	/// @brief Compares two arena allocators
+	/// @param[in] lhs The first allocator
+	/// @param[in] rhs The second allocator
+	/// @returns `true` if memory allocated by one can be freed by the other
+	template<typename T, typename U>
+	bool operator==(const VTObjectArenaAllocator<T> &lhs, const VTObjectArenaAllocator<U> &rhs)
+	{
+		return lhs.get_arena() == rhs.get_arena();
+	}
+
+	/// @brief Compares two arena allocators
+	/// @param[in] lhs The first allocator
+	/// @param[in] rhs The second allocator
+	/// @returns `true` if memory allocated by one can't be freed by the other
+	template<typename T, typename U>
+	bool operator!=(const VTObjectArenaAllocator<T> &lhs, const VTObjectArenaAllocator<U> &rhs)
+	{
+		return !(lhs == rhs);
+	}
+} // namespace isobus
+
+#endif // ISOBUS_VIRTUAL_TERMINAL_OBJECT_ARENA_HPP
@@ -0,0 +1,143 @@
+//================================================================================================
+/// @file isobus_virtual_terminal_object_pool_snapshot.hpp
+///
+/// @brief A compact binary index of a parsed VT object pool, that a VT server can store next to
+/// an object pool version so that loading the version later doesn't need to parse the whole pool again.
+/// @author Adrian Del Grosso
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+#ifndef ISOBUS_VIRTUAL_TERMINAL_OBJECT_POOL_SNAPSHOT_HPP
+#define ISOBUS_VIRTUAL_TERMINAL_OBJECT_POOL_SNAPSHOT_HPP
+
+#include "isobus/isobus/isobus_virtual_terminal_objects.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace isobus
+{
+	//================================================================================================
+	/// @class VirtualTerminalObjectPoolSnapshot
+	///
+	/// @brief Reads a snapshot of a parsed object pool, in place, from a block of memory.
+	/// @details A snapshot stores where the final definition of every object is in the stored object pool,
+	/// sorted by object ID, along with a hash of the pool and the result of validating it. Decoding the pixels of
+	/// picture graphics is most of the work of parsing a pool, so the decoded pixels of each picture graphic are stored too.
+	/// Every field is little endian and every position is an offset, so a snapshot can be read straight from a memory mapped file.
+	///
+	/// The layout is a 32 byte header, followed by one 20 byte entry per object, followed by the decoded data:
+	/// | Offset | Size | Header field |
+	/// | --- | --- | --- |
+	/// | 0 | 4 | Magic number "VTPS" |
+	/// | 4 | 2 | Format version |
+	/// | 6 | 2 | Reserved, 0xFFFF |
+	/// | 8 | 4 | Length of the object pool |
+	/// | 12 | 4 | Number of entries |
+	/// | 16 | 8 | FNV-1a hash of the object pool |
+	/// | 24 | 2 | Working set object ID |
+	/// | 26 | 2 | Reserved, 0xFFFF |
+	/// | 28 | 4 | Number of objects that failed validation |
+	///
+	/// Each entry is the object's offset in the pool (4 bytes), its length (4 bytes), the offset of its decoded data
+	/// in the snapshot (4 bytes), the length of its decoded data (4 bytes, 0 if there is none), its ID (2 bytes),
+	/// its type (1 byte) and a reserved byte.
+	//================================================================================================
+	class VirtualTerminalObjectPoolSnapshot
+	{
+	public:
+		/// @brief Where an object is in the object pool a snapshot was created from
+		struct ObjectEntry
+		{
+			std::uint32_t offset; ///< The offset of the object in the object pool
+			std::uint32_t length; ///< The number of bytes the object occupies
+			std::uint32_t decodedDataOffset; ///< The offset of the object's decoded data in the snapshot
+			std::uint32_t decodedDataLength; ///< The length of the object's decoded data, or 0 if it has none
+			std::uint16_t objectID; ///< The ID of the object
+			std::uint8_t objectType; ///< The type of the object
+		};
+
+		/// @brief Constructs a reader for a snapshot. The snapshot isn't copied, so it must outlive the reader.
+		/// @param[in] snapshotData A pointer to the snapshot
+		/// @param[in] snapshotLength The length of the snapshot in bytes
+		VirtualTerminalObjectPoolSnapshot(const std::uint8_t *snapshotData, std::size_t snapshotLength);
+
+		/// @brief Creates a snapshot of an object pool that was parsed successfully
+		/// @param[in] iopFiles The IOP files of the object pool, in the order they were received
+		/// @param[in] objectTree The objects parsed from the IOP files
+		/// @param[in] workingSetID The ID of the working set object of the parsed pool
+		/// @param[in] numberOfInvalidObjects The number of objects that failed validation when the pool was parsed
+		/// @returns The snapshot, or an empty vector if the pool contains an object the snapshot can't locate
+		static std::vector<std::uint8_t> create(const std::vector<std::vector<std::uint8_t>> &iopFiles,
+		                                        const VTObjectTable &objectTree,
+		                                        std::uint16_t workingSetID,
+		                                        std::uint32_t numberOfInvalidObjects);
+
+		/// @brief Returns if the snapshot is well formed and was written in the current format version
+		/// @returns true if the snapshot can be used, otherwise false
+		bool get_is_valid() const;
+
+		/// @brief Checks if the snapshot describes an object pool
+		/// @param[in] iopData The object pool, all of its IOP files one after the other
+		/// @param[in] iopLength The length of the object pool
+		/// @returns true if the snapshot is valid and was created from the exact same object pool
+		bool get_is_snapshot_of(const std::uint8_t *iopData, std::size_t iopLength) const;
+
+		/// @brief Returns the number of objects in the snapshot
+		/// @returns The number of objects in the snapshot, or 0 if it isn't valid
+		std::uint32_t get_number_of_objects() const;
+
+		/// @brief Returns where an object is in the object pool
+		/// @param[in] index The index of the object in the snapshot, objects are sorted by ID
+		/// @returns Where the object is in the object pool
+		ObjectEntry get_object_entry(std::uint32_t index) const;
+
+		/// @brief Returns the decoded data of an object, which for a picture graphic is its pixels, one byte per pixel
+		/// @param[in] entry The object's entry
+		/// @returns A pointer to the object's decoded data in the snapshot, or nullptr if it has none
+		const std::uint8_t *get_decoded_data(const ObjectEntry &entry) const;
+
+		/// @brief Returns the ID of the working set object of the pool
+		/// @returns The ID of the working set object of the pool, or the null object ID if the snapshot isn't valid
+		std::uint16_t get_working_set_id() const;
+
+		/// @brief Returns the number of objects that failed validation when the pool was parsed
+		/// @returns The number of objects that failed validation when the pool was parsed, or 0 if the snapshot isn't valid
+		std::uint32_t get_number_of_invalid_objects() const;
+
+		/// @brief Hashes object pool data the same way a snapshot does
+		/// @param[in] data The data to hash
+		/// @param[in] length The length of the data
+		/// @param[in] hash The hash of the data that came before this data, so that a pool can be hashed one IOP file at a time
+		/// @returns The hash of the data
+		static std::uint64_t hash_object_pool(const std::uint8_t *data, std::size_t length, std::uint64_t hash = HASH_OFFSET_BASIS);
+
+		static constexpr std::uint16_t FORMAT_VERSION = 1; ///< Incremented whenever the format, or how the VT server decodes or validates objects, changes
+		static constexpr std::size_t HEADER_LENGTH = 32; ///< The length of the snapshot header
+		static constexpr std::size_t ENTRY_LENGTH = 20; ///< The length of each object entry
+		static constexpr std::uint64_t HASH_OFFSET_BASIS = 0xCBF29CE484222325; ///< The starting value of the FNV-1a hash
+
+	private:
+		/// @brief Reads a little endian 16 bit value from the snapshot
+		/// @param[in] offset The offset of the value in the snapshot
+		/// @returns The value
+		std::uint16_t read_uint16(std::size_t offset) const;
+
+		/// @brief Reads a little endian 32 bit value from the snapshot
+		/// @param[in] offset The offset of the value in the snapshot
+		/// @returns The value
+		std::uint32_t read_uint32(std::size_t offset) const;
+
+		/// @brief Reads a little endian 64 bit value from the snapshot
+		/// @param[in] offset The offset of the value in the snapshot
+		/// @returns The value
+		std::uint64_t read_uint64(std::size_t offset) const;
+
+		const std::uint8_t *data; ///< The snapshot
+		std::size_t length; ///< The length of the snapshot
+		bool valid = false; ///< Stores if the snapshot is well formed
+	};
+} // namespace isobus
+
+#endif // ISOBUS_VIRTUAL_TERMINAL_OBJECT_POOL_SNAPSHOT_HPP
@@ -10,10 +10,10 @@
 #define ISOBUS_VIRTUAL_TERMINAL_OBJECTS_HPP
 
 #include "isobus/isobus/can_constants.hpp"
+#include "isobus/isobus/isobus_virtual_terminal_object_arena.hpp"
 
 #include <algorithm>
 #include <array>
-#include <map>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -180,6 +180,129 @@ namespace isobus
 		std::array<VTColourVector, VT_COLOUR_TABLE_SIZE> colourTable; ///< Colour table data. Associates VT colour index with RGB value.
 	};
 
+	class VTObject;
+
+	/// @brief A table of the objects in a VT object pool, indexed directly by object ID.
+	/// @details Object IDs are 16 bits, so the table is split into 256 pages of 256 slots each, and a page is
+	/// only allocated once an object is stored in it. Looking up an object is two array accesses instead of a tree walk,
+	/// and doesn't copy the shared pointer. An empty slot and a slot holding a null pointer are the same thing.
+	class VTObjectTable
+	{
+	public:
+		/// @brief An iterator over the objects in the table, in order of object ID. Empty slots are skipped.
+		class ConstIterator
+		{
+		public:
+			/// @brief Constructor for an iterator
+			/// @param[in] table The table to iterate over
+			/// @param[in] index The slot to start at, which is moved forward to the first object at or after it
+			ConstIterator(const VTObjectTable &table, std::uint32_t index);
+
+			/// @brief Returns the object the iterator points to
+			/// @returns The object the iterator points to
+			const std::shared_ptr<VTObject> &operator*() const;
+
+			/// @brief Returns the object the iterator points to
+			/// @returns The object the iterator points to
+			const std::shared_ptr<VTObject> *operator->() const;
+
+			/// @brief Moves the iterator to the next object in the table
+			/// @returns The iterator itself
+			ConstIterator &operator++();
+
+			/// @brief Compares two iterators
+			/// @param[in] other The iterator to compare against
+			/// @returns `true` if both iterators point to the same slot
+			bool operator==(const ConstIterator &other) const;
+
+			/// @brief Compares two iterators
+			/// @param[in] other The iterator to compare against
+			/// @returns `true` if the iterators point to different slots
+			bool operator!=(const ConstIterator &other) const;
+
+		private:
+			/// @brief Moves the index forward until it points to an object or the end of the table
+			void skip_empty_slots();
+
+			const VTObjectTable *table; ///< The table being iterated over
+			std::uint32_t index; ///< The object ID (slot) the iterator points to, or NUMBER_OF_SLOTS at the end
+		};
+
+		/// @brief Constructor for an empty object table
+		VTObjectTable() = default;
+
+		/// @brief Copy constructor, the copy shares the objects with the original
+		/// @param[in] other The table to copy
+		VTObjectTable(const VTObjectTable &other);
+
+		/// @brief Move constructor
+		/// @param[in] other The table to move from
+		VTObjectTable(VTObjectTable &&other) noexcept = default;
+
+		/// @brief Copy assignment operator, the copy shares the objects with the original
+		/// @param[in] other The table to copy
+		/// @returns A reference to this table
+		VTObjectTable &operator=(const VTObjectTable &other);
+
+		/// @brief Move assignment operator
+		/// @param[in] other The table to move from
+		/// @returns A reference to this table
+		VTObjectTable &operator=(VTObjectTable &&other) noexcept = default;
+
+		/// @brief Returns the slot for an object ID so an object can be stored in it, allocating its page if needed
+		/// @param[in] objectID The object ID of the slot
+		/// @returns The slot for the object ID
+		std::shared_ptr<VTObject> &operator[](std::uint16_t objectID);
+
+		/// @brief Returns the object with an ID without taking ownership of it
+		/// @param[in] objectID The object ID to look up
+		/// @returns The object with the ID, or nullptr if there is none or the ID is the null object ID
+		VTObject *get(std::uint16_t objectID) const;
+
+		/// @brief Returns the shared pointer to the object with an ID
+		/// @param[in] objectID The object ID to look up
+		/// @returns The object with the ID, or an empty pointer if there is none or the ID is the null object ID
+		const std::shared_ptr<VTObject> &get_shared(std::uint16_t objectID) const;
+
+		/// @brief Returns if an object with an ID is in the table
+		/// @param[in] objectID The object ID to look up
+		/// @returns `true` if an object with the ID is in the table
+		bool contains(std::uint16_t objectID) const;
+
+		/// @brief Removes the object with an ID from the table, if there is one
+		/// @param[in] objectID The object ID to remove
+		void erase(std::uint16_t objectID);
+
+		/// @brief Removes all objects from the table and frees its pages
+		void clear();
+
+		/// @brief Returns the number of objects in the table. This counts the objects, so don't call it in a loop.
+		/// @returns The number of objects in the table
+		std::size_t size() const;
+
+		/// @brief Returns if the table has no objects
+		/// @returns `true` if the table has no objects
+		bool empty() const;
+
+		/// @brief Returns an iterator to the object with the lowest ID
+		/// @returns An iterator to the object with the lowest ID
+		ConstIterator begin() const;
+
+		/// @brief Returns an iterator past the last object
+		/// @returns An iterator past the last object
+		ConstIterator end() const;
+
+	private:
+		static constexpr std::uint32_t SLOTS_PER_PAGE = 256; ///< The number of objects a page can hold, indexed by the low byte of the ID
+		static constexpr std::uint32_t NUMBER_OF_PAGES = 256; ///< The number of pages, indexed by the high byte of the ID
+		static constexpr std::uint32_t NUMBER_OF_SLOTS = SLOTS_PER_PAGE * NUMBER_OF_PAGES; ///< The number of possible object IDs
+
+		/// @brief A page of the table, holding the objects that share the high byte of their ID
+		using Page = std::array<std::shared_ptr<VTObject>, SLOTS_PER_PAGE>;
+
+		std::array<std::unique_ptr<Page>, NUMBER_OF_PAGES> pages; ///< The pages of the table, nullptr if a page has never been used
+	};
+
 	/// @brief Generic VT object base class
 	class VTObject
 	{
@@ -208,19 +331,19 @@ namespace isobus
 		virtual std::uint32_t get_minumum_object_length() const = 0;
 
 		/// @brief Performs basic error checking on the object and returns if the object is valid
-		/// @param[in] objectPool A map of all objects in the current object pool, keyed by their object ID
+		/// @param[in] objectPool The table of all objects in the current object pool, indexed by object ID
 		/// @returns `true` if the object passed basic error checks
-		virtual bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const = 0;
+		virtual bool get_is_valid(const VTObjectTable &objectPool) const = 0;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
 		/// @param[in] rawAttributeData The raw data to change the attribute to, as decoded in little endian format with unused
 		/// bytes/bits set to zero.
-		/// @param[in] objectPool A map of all objects in the current object pool, keyed by their object ID. Used to validate some object references.
+		/// @param[in] objectPool The table of all objects in the current object pool, indexed by object ID. Used to validate some object references.
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		virtual bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) = 0;
+		virtual bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) = 0;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -334,7 +457,12 @@ namespace isobus
 		/// @param[in] objectID The object ID to search for
 		/// @param[in] objectPool The object pool to search in
 		/// @returns The object with the corresponding ID
-		static std::shared_ptr<VTObject> get_object_by_id(std::uint16_t objectID, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool);
+		static std::shared_ptr<VTObject> get_object_by_id(std::uint16_t objectID, const VTObjectTable &objectPool);
+
+		/// @brief Makes the child and macro lists of this object allocate from an arena instead of the heap.
+		/// Used by working sets to keep all memory of a parsed object pool together.
+		/// @param[in] arena The arena to allocate from, or nullptr to allocate from the heap
+		void set_arena(const std::shared_ptr<VTObjectArena> &arena);
 
 	protected:
 		/// @brief Storage for child object data
@@ -356,8 +484,8 @@ namespace isobus
 			std::int16_t yLocation = 0; ///< Relative Y location of the top left corner of the object
 		};
 
-		std::vector<ChildObjectData> children; ///< List of child objects
-		std::vector<MacroMetadata> macros; ///< List of macros referenced by this object
+		std::vector<ChildObjectData, VTObjectArenaAllocator<ChildObjectData>> children; ///< List of child objects
+		std::vector<MacroMetadata, VTObjectArenaAllocator<MacroMetadata>> macros; ///< List of macros referenced by this object
 		std::uint16_t objectID = NULL_OBJECT_ID; ///< Object identifier. Shall be unique within the object pool.
 		std::uint16_t width = 0; ///< The width of the object. Not always applicable, but often used.
 		std::uint16_t height = 0; ///< The height of the object. Not always applicable, but often used.
@@ -416,7 +544,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating this object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -426,7 +554,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -492,7 +620,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -502,7 +630,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -517,7 +645,7 @@ namespace isobus
 		/// @param[in] newMaskID The object ID of the new soft key mask to associate with this data mask
 		/// @param[in] objectPool The object pool to use when validating the objects affected by setting this attribute
 		/// @returns True if the mask was changed, false if the new ID was not valid and the mask was not changed
-		bool change_soft_key_mask(std::uint16_t newMaskID, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool);
+		bool change_soft_key_mask(std::uint16_t newMaskID, const VTObjectTable &objectPool);
 
 		/// @brief Changes the soft key mask associated to this data mask to a new object ID, but
 		/// does no checking on the validity of the new object ID.
@@ -585,7 +713,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -595,7 +723,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -630,7 +758,7 @@ namespace isobus
 		/// @param[in] newMaskID The object ID of the new soft key mask to associate with this data mask
 		/// @param[in] objectPool The object pool to use when validating the objects affected by setting this attribute
 		/// @returns True if the mask was changed, false if the new ID was not valid and the mask was not changed
-		bool change_soft_key_mask(std::uint16_t newMaskID, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool);
+		bool change_soft_key_mask(std::uint16_t newMaskID, const VTObjectTable &objectPool);
 
 		/// @brief Changes the soft key mask associated to this alarm mask to a new object ID, but
 		/// does no checking on the validity of the new object ID.
@@ -684,7 +812,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -694,7 +822,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -752,7 +880,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -762,7 +890,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -809,7 +937,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -819,7 +947,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -882,7 +1010,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -892,7 +1020,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -941,7 +1069,7 @@ namespace isobus
 		/// @param[in] nameIDToValidate The name's object ID to validate
 		/// @param[in] objectPool The object pool to use when validating the name object
 		/// @returns True if the name ID is valid for this object, otherwise false
-		bool validate_name(std::uint16_t nameIDToValidate, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const;
+		bool validate_name(std::uint16_t nameIDToValidate, const VTObjectTable &objectPool) const;
 
 		static constexpr std::uint32_t MIN_OBJECT_LENGTH = 10; ///< The fewest bytes of IOP data that can represent this object
 
@@ -1001,7 +1129,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -1011,7 +1139,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -1095,7 +1223,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -1105,7 +1233,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -1228,7 +1356,7 @@ namespace isobus
 		/// @brief Returns the value of the variable (if referenced) otherwise the set value
 		/// @param[in] objectPool the object pool to use to look up the variable reference
 		/// @returns The displayed value of the string
-		std::string displayed_value(const std::map<uint16_t, std::shared_ptr<VTObject>> &objectPool) const;
+		std::string displayed_value(const VTObjectTable &objectPool) const;
 
 		/// @brief Returns a copy of the stored string value. Used only when no string
 		/// variable objects are children of this object.
@@ -1283,7 +1411,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -1293,7 +1421,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -1465,7 +1593,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -1475,7 +1603,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -1599,7 +1727,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -1609,7 +1737,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -1638,7 +1766,7 @@ namespace isobus
 		/// @param[in] newListItem The object ID to use as the new list item at the specified index
 		/// @param[in] objectPool The object pool to use to look up the object ID
 		/// @returns True if the operation was successful, otherwise false (perhaps the index is out of bounds?)
-		bool change_list_item(std::uint8_t index, std::uint16_t newListItem, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool);
+		bool change_list_item(std::uint8_t index, std::uint16_t newListItem, const VTObjectTable &objectPool);
 
 	private:
 		static constexpr std::uint32_t MIN_OBJECT_LENGTH = 13; ///< The fewest bytes of IOP data that can represent this object
@@ -1683,7 +1811,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -1693,7 +1821,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -1758,7 +1886,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -1768,7 +1896,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -1816,7 +1944,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -1826,7 +1954,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -1841,7 +1969,7 @@ namespace isobus
 		/// @param[in] newListItem The object ID to use as the new list item at the specified index
 		/// @param[in] objectPool The object pool to use to look up the object ID
 		/// @returns True if the operation was successful, otherwise false (perhaps the index is out of bounds?)
-		bool change_list_item(std::uint8_t index, std::uint16_t newListItem, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool);
+		bool change_list_item(std::uint8_t index, std::uint16_t newListItem, const VTObjectTable &objectPool);
 
 	private:
 		static constexpr std::uint32_t MIN_OBJECT_LENGTH = 12; ///< The fewest bytes of IOP data that can represent this object
@@ -1888,7 +2016,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -1898,7 +2026,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -1981,7 +2109,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -1991,7 +2119,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -2083,7 +2211,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -2093,7 +2221,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -2213,7 +2341,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -2223,7 +2351,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -2340,7 +2468,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -2350,7 +2478,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -2518,7 +2646,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -2528,7 +2656,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -2689,7 +2817,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -2699,7 +2827,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -2879,7 +3007,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -2889,7 +3017,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -3009,7 +3137,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -3019,7 +3147,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -3073,7 +3201,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -3083,7 +3211,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -3190,7 +3318,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -3200,7 +3328,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -3302,7 +3430,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -3312,7 +3440,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -3378,7 +3506,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -3388,7 +3516,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -3460,7 +3588,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -3470,7 +3598,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -3543,7 +3671,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -3553,7 +3681,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -3626,7 +3754,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -3636,7 +3764,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -3694,7 +3822,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -3704,7 +3832,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -3823,7 +3951,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -3833,7 +3961,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -3907,7 +4035,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -3917,7 +4045,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -4017,7 +4145,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -4027,7 +4155,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -4138,7 +4266,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -4148,7 +4276,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -4234,7 +4362,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -4244,7 +4372,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -4317,7 +4445,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -4327,7 +4455,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -4403,7 +4531,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -4413,7 +4541,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -4479,7 +4607,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -4489,7 +4617,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -12,6 +12,7 @@
 #include "isobus/isobus/can_callbacks.hpp"
 #include "isobus/isobus/can_constants.hpp"
 #include "isobus/isobus/can_internal_control_function.hpp"
+#include "isobus/isobus/can_message_data.hpp"
 #include "isobus/isobus/isobus_language_command_interface.hpp"
 #include "isobus/isobus/isobus_virtual_terminal_base.hpp"
 #include "isobus/isobus/isobus_virtual_terminal_server_managed_working_set.hpp"
@@ -272,6 +273,23 @@ namespace isobus
 		/// @param[in] ws the working set which object pool processing is about to be started
 		virtual void transferred_object_pool_parse_start(std::shared_ptr<VirtualTerminalServerManagedWorkingSet> &ws) const;
 
+		/// @brief This function is called after an object pool version was stored with save_version, to let you store
+		/// a snapshot of the parsed pool alongside it. The snapshot lets load_version_snapshot skip most of the parsing
+		/// the next time the version is loaded. By default snapshots aren't stored.
+		/// @note The snapshot should be deleted along with the version in delete_version and delete_all_versions.
+		/// @param[in] snapshot The snapshot of the object pool version, in the format read by VirtualTerminalObjectPoolSnapshot
+		/// @param[in] versionLabel The object pool version the snapshot belongs to
+		/// @param[in] clientNAME The client that stored the object pool version
+		/// @returns True if the snapshot was saved, otherwise false
+		virtual bool save_version_snapshot(const std::vector<std::uint8_t> &snapshot, const std::vector<std::uint8_t> &versionLabel, NAME clientNAME);
+
+		/// @brief This function is called when a stored object pool version is loaded, to get the snapshot that was
+		/// saved with save_version_snapshot. If the snapshot doesn't match the pool returned by load_version, the pool is parsed as usual.
+		/// @param[in] versionLabel The object pool version being loaded
+		/// @param[in] clientNAME The client requesting the object pool
+		/// @returns The snapshot of the object pool version, or an empty vector if there isn't one
+		virtual std::vector<std::uint8_t> load_version_snapshot(const std::vector<std::uint8_t> &versionLabel, NAME clientNAME);
+
 		//-------------- Callbacks/Event driven interface ---------------------
 
 		/// @brief Returns the event dispatcher for repaint events
@@ -524,6 +542,47 @@ namespace isobus
 			AnyOtherError = 32
 		};
 
+		/// @brief Receives object pool transfers from a managed working set straight into its raw IOP data.
+		/// @details The multiplexor is only known once the first packet arrives, so the data after it is always
+		/// written into a buffer that is moved into the working set when it turns out to be an object pool.
+		/// Any other message is processed by the server like a normally received message.
+		/// Object pools are also decoded as they arrive when the working set allows it, so that the objects
+		/// are ready by the time the working set sends the end of object pool message.
+		/// The transport session's own data stays empty, so the sink also tells the working set how much of an object pool has arrived.
+		class ObjectPoolReceiveSink : public CANMessageReceiveSink
+		{
+		public:
+			/// @brief Constructs a sink for one receive session
+			/// @param[in] server The server that is receiving the message
+			/// @param[in] workingSet The working set that is sending the message
+			/// @param[in] source The control function sending the message
+			/// @param[in] destination The control function receiving the message
+			/// @param[in] totalMessageSize The size of the message in bytes, including the multiplexor
+			ObjectPoolReceiveSink(VirtualTerminalServer *server,
+			                      std::shared_ptr<VirtualTerminalServerManagedWorkingSet> workingSet,
+			                      std::shared_ptr<ControlFunction> source,
+			                      std::shared_ptr<ControlFunction> destination,
+			                      std::uint32_t totalMessageSize);
+
+			/// @brief Stores a chunk of the message, splitting off the multiplexor, and decodes the objects it completes
+			/// @param[in] offset The index in the message of the first byte of the chunk
+			/// @param[in] chunk The bytes that were received
+			void write_bytes(std::size_t offset, CANDataSpan chunk) override;
+
+			/// @brief Hands a completed object pool to the working set, or processes any other completed message normally
+			/// @param[in] successful True if the whole message was received
+			void on_session_closed(bool successful) override;
+
+		private:
+			VirtualTerminalServer *server; ///< The server that is receiving the message
+			std::shared_ptr<VirtualTerminalServerManagedWorkingSet> workingSet; ///< The working set that is sending the message
+			std::shared_ptr<ControlFunction> source; ///< The control function sending the message
+			std::shared_ptr<ControlFunction> destination; ///< The control function receiving the message
+			std::vector<std::uint8_t> data; ///< The received message without its multiplexor
+			std::uint8_t multiplexor = 0xFF; ///< The first byte of the message, which identifies the VT function
+			bool incrementalParse = false; ///< True if the object pool is being decoded as it arrives
+		};
+
 		/// @brief Checks to see if the message should be listened to based on
 		/// what the message is, and if the client has sent the proper working set master message
 		/// @param[in] message The CAN message to check
@@ -557,6 +616,19 @@ namespace isobus
 		/// @param[in] parent A context variable to find the relevant VT server class
 		static void process_rx_message(const CANMessage &message, void *parent);
 
+		/// @brief Supplies a sink for multi-frame messages from managed working sets, so object pools are received only once
+		/// @param[in] parameterGroupNumber The PGN of the message that is about to be received
+		/// @param[in] totalMessageSize The size of the message in bytes
+		/// @param[in] source The control function sending the message
+		/// @param[in] destination The control function the message is sent to
+		/// @param[in] parent A context variable to find the relevant VT server class
+		/// @returns A sink for the message, or nullptr if the message should be received normally
+		static std::unique_ptr<CANMessageReceiveSink> get_object_pool_receive_sink(std::uint32_t parameterGroupNumber,
+		                                                                           std::uint32_t totalMessageSize,
+		                                                                           std::shared_ptr<ControlFunction> source,
+		                                                                           std::shared_ptr<ControlFunction> destination,
+		                                                                           void *parent);
+
 		/// @brief Sends a message using the acknowledgement PGN
 		/// @param[in] type The type of acknowledgement to send (Ack, vs Nack, etc)
 		/// @param[in] parameterGroupNumber The PGN to acknowledge
@@ -789,6 +861,7 @@ namespace isobus
 		LanguageCommandInterface languageCommandInterface; ///< The language command interface for the server
 		std::shared_ptr<InternalControlFunction> serverInternalControlFunction; ///< The internal control function for the server
 		std::vector<std::shared_ptr<VirtualTerminalServerManagedWorkingSet>> managedWorkingSetList; ///< The list of managed working sets
+		VirtualTerminalServerWorkerPool objectPoolWorkerPool; ///< Parses and validates the object pools of all working sets, shared so that many pools arriving at once don't each start a thread
 		std::map<std::shared_ptr<VirtualTerminalServerManagedWorkingSet>, bool> managedWorkingSetIopLoadStateMap; ///< A map to hold the IOP load state per session
 		std::shared_ptr<VirtualTerminalServerManagedWorkingSet> activeWorkingSet; ///< The active working set
 		std::uint32_t statusMessageTimestamp_ms = 0; ///< The timestamp of the last status message sent
@@ -10,13 +10,16 @@
 #define ISOBUS_VIRTUAL_TERMINAL_MANAGED_WORKING_SET_HPP
 
 #include <array>
+#include <atomic>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <thread>
 
 #include "isobus/isobus/can_badge.hpp"
 #include "isobus/isobus/can_control_function.hpp"
 #include "isobus/isobus/isobus_virtual_terminal_objects.hpp"
+#include "isobus/isobus/isobus_virtual_terminal_server_worker_pool.hpp"
 #include "isobus/isobus/isobus_virtual_terminal_working_set_base.hpp"
 #include "isobus/utility/event_dispatcher.hpp"
 
@@ -28,6 +31,7 @@ namespace isobus
 	/// @details This class is meant to be used as the basis for a VT server.
 	/// It keeps track of one active object pool.
 	class VirtualTerminalServerManagedWorkingSet : public VirtualTerminalWorkingSetBase
+	  , public std::enable_shared_from_this<VirtualTerminalServerManagedWorkingSet>
 	{
 	public:
 		/// @brief Enumerates the states of the processing thread for the object pool
@@ -40,6 +44,20 @@ namespace isobus
 			Joined ///< We have sent our response to the working set master and are done parsing
 		};
 
+		/// @brief Timing and size information about the last time the object pool was parsed
+		struct ObjectPoolParsingStatistics
+		{
+			std::uint64_t decodeTime_us = 0; ///< Time spent decoding the IOP files into objects
+			std::uint64_t mergeTime_us = 0; ///< Time spent merging the decoded objects into the object tree
+			std::uint64_t validationTime_us = 0; ///< Time spent checking the objects' references to other objects
+			std::uint64_t totalTime_us = 0; ///< Time from the start of parsing until the result was available
+			std::size_t numberOfIopFiles = 0; ///< The number of IOP files that were parsed
+			std::size_t numberOfIncrementallyParsedIopFiles = 0; ///< The number of IOP files that were already decoded while they were being received
+			std::size_t numberOfObjects = 0; ///< The number of objects in the object tree after parsing
+			std::size_t numberOfInvalidObjects = 0; ///< The number of objects that failed validation
+			bool loadedFromSnapshot = false; ///< Stores if the objects were decoded using a snapshot of the pool, which also skips validation
+		};
+
 		/// @brief Default constructor
 		VirtualTerminalServerManagedWorkingSet();
 
@@ -53,9 +71,52 @@ namespace isobus
 		/// @brief Starts a thread to parse the received object pool files
 		void start_parsing_thread();
 
-		/// @brief Joins the parsing thread
+		/// @brief Parses the received object pool files on a shared worker pool.
+		/// @details Each IOP file is decoded into objects by its own job, then the results are merged
+		/// into the object tree in the order the files were received, and finally the objects' references
+		/// are validated in parallel slices. The working set must be owned by a `std::shared_ptr`,
+		/// which the jobs hold on to until parsing is done. If the pool was parsed before, every file is decoded
+		/// again into a new arena, and the previous objects and their memory are released when the files are merged.
+		/// @param[in] workerPool The worker pool to run the parsing jobs on
+		void start_parsing(VirtualTerminalServerWorkerPool &workerPool);
+
+		/// @brief Joins the parsing thread if there is one, and marks a finished parse as handled
 		void join_parsing_thread();
 
+		/// @brief Starts decoding an object pool transfer while it is being received, so that only the IOP files
+		/// that weren't decoded this way are left to decode when parsing starts.
+		/// @details A transfer is only decoded incrementally if every earlier IOP file was too, so that objects
+		/// replace each other in the same order as when all files are parsed at the end of the object pool.
+		/// Transfers after the pool has been parsed for the first time are never decoded incrementally, since the objects are in use.
+		/// @returns true if the transfer will be decoded incrementally, and its chunks should be passed to parse_iop_chunk
+		bool begin_incremental_object_pool_transfer();
+
+		/// @brief Finishes decoding a transfer that was decoded incrementally, and stores its data like add_iop_raw_data does
+		/// @param[in] iopData The IOP file that was transferred
+		void end_incremental_object_pool_transfer(std::vector<std::uint8_t> &&iopData);
+
+		/// @brief Abandons an object pool transfer that was aborted.
+		/// If it was being decoded incrementally, the objects decoded from it are discarded by decoding every IOP file again
+		/// when parsing starts. Otherwise nothing was decoded from it, so the objects already parsed are left alone.
+		void abort_incremental_object_pool_transfer();
+
+		/// @brief Records how much of an object pool transfer has been received, for transfers that are received
+		/// into a sink instead of a transport session's own buffer, so that iop_load_percentage can report on them.
+		/// @details The count is cleared when the transfer ends or is aborted.
+		/// @param[in] bytesReceived The number of bytes of the IOP file received so far, without the multiplexor
+		void set_object_pool_transfer_progress(std::uint32_t bytesReceived);
+
+		/// @brief Sets a snapshot of the object pool, which was stored along with the pool's version, to use the next time the pool is parsed.
+		/// @details If the snapshot matches the pool, its objects are decoded straight from where the snapshot says they are
+		/// and aren't validated again. Otherwise the snapshot is ignored and the whole pool is parsed as usual.
+		/// Only a pool with a single IOP file, which is how a stored version is loaded, is parsed from a snapshot.
+		/// @param[in] snapshot The snapshot of the object pool
+		void set_object_pool_snapshot(std::vector<std::uint8_t> &&snapshot);
+
+		/// @brief Creates a snapshot of the object pool, to be stored along with the pool's version
+		/// @returns A snapshot of all IOP files together, or an empty vector if the pool wasn't parsed successfully
+		std::vector<std::uint8_t> create_object_pool_snapshot();
+
 		/// @brief Returns if any object pools are being managed for this working set master
 		/// @returns true if at least 1 object pool has been received for this working set master, otherwise false
 		bool get_any_object_pools() const;
@@ -65,6 +126,10 @@ namespace isobus
 		/// @returns The state of object pool processing
 		ObjectPoolProcessingThreadState get_object_pool_processing_state();
 
+		/// @brief Returns the per-phase timing of the last time the object pool was parsed
+		/// @returns The per-phase timing of the last time the object pool was parsed
+		ObjectPoolParsingStatistics get_object_pool_parsing_statistics();
+
 		/// @brief Returns the control function that is the working set master
 		/// @returns The control function that is the working set master
 		std::shared_ptr<ControlFunction> get_control_function() const;
@@ -133,23 +198,80 @@ namespace isobus
 		/// @returns returns true if the IOP size is known but the transfer is not finished
 		bool is_object_pool_transfer_in_progress() const;
 
+		static constexpr std::size_t VALIDATION_OBJECTS_PER_JOB = 512; ///< The minimum number of objects each validation job checks
+
 	private:
+		class ObjectPoolFileParser;
+		struct ParsingJobContext;
+
 		/// @brief Sets the object pool processing state to a new value
 		/// @param[in] value The new state of processing the object pool
 		void set_object_pool_processing_state(ObjectPoolProcessingThreadState value);
 
+		/// @brief Discards incrementally decoded objects if an aborted transfer left some behind, and
+		/// returns the index of the first IOP file whose objects haven't been decoded yet
+		/// @param[in] parsedBefore `true` if the object pool was parsed before, in which case every file has to be decoded again
+		/// @returns The index of the first IOP file that has to be decoded
+		std::size_t get_first_iop_file_to_parse(bool parsedBefore);
+
+		/// @brief Discards every decoded object, and gives the objects decoded next a new arena, since an arena
+		/// only frees its memory once every object allocated from it is gone
+		void discard_decoded_objects();
+
 		/// @brief The object pool processing thread will execute this function when it runs
 		void worker_thread_function();
 
+		/// @brief Decodes the object pool from the snapshot set with set_object_pool_snapshot, if there is one.
+		/// The snapshot is only used once, whether it matches the pool or not.
+		/// @param[in] firstFileToParse The index of the first IOP file that has to be decoded
+		/// @param[out] statistics Updated with the number of objects decoded from the snapshot
+		/// @returns true if the whole pool was decoded from the snapshot, otherwise false and the object tree is left empty
+		bool load_object_pool_snapshot(std::size_t firstFileToParse, ObjectPoolParsingStatistics &statistics);
+
+		/// @brief Queues a decoding job for each IOP file that hasn't been decoded yet.
+		/// The last one to finish merges the results, or they are merged right away if there are no files left to decode.
+		/// @param[in] context The state shared by the parsing jobs
+		/// @param[in] workerPool The worker pool to queue the decoding jobs on
+		/// @param[in] firstFileToParse The index of the first IOP file that has to be decoded
+		void decode_object_pool_files(const std::shared_ptr<ParsingJobContext> &context, VirtualTerminalServerWorkerPool &workerPool, std::size_t firstFileToParse);
+
+		/// @brief Merges the objects decoded from each IOP file into the object tree and queues the validation jobs.
+		/// Called by whichever decoding job finishes last.
+		/// @param[in] context The state shared by the parsing jobs
+		/// @param[in] workerPool The worker pool to queue the validation jobs on
+		void merge_decoded_object_pool_files(const std::shared_ptr<ParsingJobContext> &context, VirtualTerminalServerWorkerPool &workerPool);
+
+		/// @brief Records the result of parsing the object pool. Called by whichever validation job finishes last.
+		/// @param[in] context The state shared by the parsing jobs
+		void finish_parsing(const std::shared_ptr<ParsingJobContext> &context);
+
+		/// @brief Checks a range of objects' references to other objects in the object tree
+		/// @param[in] objects The objects to check
+		/// @param[in] begin The index of the first object to check
+		/// @param[in] end One past the index of the last object to check
+		/// @returns The number of objects that failed validation
+		std::size_t validate_objects(const std::vector<VTObject *> &objects, std::size_t begin, std::size_t end) const;
+
+		/// @brief Logs the timing of the last time the object pool was parsed, and warns once if any objects failed validation
+		/// @param[in] statistics The statistics to log
+		static void log_parsing_statistics(const ObjectPoolParsingStatistics &statistics);
+
 		std::unique_ptr<std::thread> objectPoolProcessingThread = nullptr; ///< A thread to process the object pool with, since that can be fairly time consuming.
 		std::shared_ptr<ControlFunction> workingSetControlFunction = nullptr; ///< Stores the control function associated with this working set
 		std::vector<isobus::EventCallbackHandle> callbackHandles; ///< A convenient way to associate callback handles to a working set
 		ObjectPoolProcessingThreadState processingState = ObjectPoolProcessingThreadState::None; ///< Stores the state of processing the object pool
+		ObjectPoolParsingStatistics parsingStatistics; ///< Stores the timing of the last time the object pool was parsed
+		std::vector<std::uint8_t> objectPoolSnapshot; ///< A snapshot of the stored object pool version to parse the pool with, or empty if there isn't one, protected by managedWorkingSetMutex
+		std::atomic<std::uint32_t> objectPoolTransferProgress = { 0 }; ///< The number of bytes received so far of an object pool transfer into a sink
+		std::size_t numberOfIncrementallyParsedFiles = 0; ///< The number of IOP files, from the first one, whose objects were decoded while they were being received
 		std::uint32_t workingSetMaintenanceMessageTimestamp_ms = 0; ///< A timestamp (in ms) to track sending of the maintenance message
 		std::uint32_t auxiliaryInputMaintenanceMessageTimestamp_ms = 0; ///< A timestamp (in ms) to track if/when the working set sent an auxiliary input maintenance message
 		std::uint16_t focusedObject = NULL_OBJECT_ID; ///< Stores the object ID of the currently focused object
 		bool wasLoadedFromNonVolatileMemory = false; ///< Used to tell the server how this object pool was obtained
 		bool workingSetDeletionRequested = false; ///< Used to tell the server to delete this working set
+		bool incrementalTransferActive = false; ///< Set while a transfer is being decoded as it arrives
+		bool discardIncrementallyParsedObjects = false; ///< Set when an aborted transfer left objects behind that have to be discarded
+		bool objectPoolParsedSuccessfully = false; ///< Stores if the last time the object pool was parsed succeeded
 	};
 } // namespace isobus
 
@@ -0,0 +1,76 @@
+//================================================================================================
+/// @file isobus_virtual_terminal_server_worker_pool.hpp
+///
+/// @brief A small pool of worker threads that a VT server shares between all of its working sets,
+/// used to parse and validate uploaded object pools without starting a thread per working set.
+/// @author Adrian Del Grosso
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+#ifndef ISOBUS_VIRTUAL_TERMINAL_SERVER_WORKER_POOL_HPP
+#define ISOBUS_VIRTUAL_TERMINAL_SERVER_WORKER_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace isobus
+{
+	//================================================================================================
+	/// @class VirtualTerminalServerWorkerPool
+	///
+	/// @brief Runs jobs on a fixed number of worker threads, in the order they were submitted.
+	/// @details The threads are started when the first job is submitted, so a server that never receives
+	/// an object pool never starts them. Jobs may submit more jobs. Jobs should not block waiting on other jobs,
+	/// since that could starve the pool, so work that depends on other jobs is best submitted by the last of those jobs to finish.
+	/// On destruction every job that was already submitted is run before the threads are joined.
+	//================================================================================================
+	class VirtualTerminalServerWorkerPool
+	{
+	public:
+		/// @brief Constructs a worker pool
+		/// @param[in] numberOfThreads The number of worker threads to run jobs on, or 0 to pick one based on the hardware
+		explicit VirtualTerminalServerWorkerPool(std::size_t numberOfThreads = 0);
+
+		/// @brief Runs the remaining jobs and joins the worker threads
+		~VirtualTerminalServerWorkerPool();
+
+		/// @brief Deleted copy constructor, the pool owns its threads
+		VirtualTerminalServerWorkerPool(const VirtualTerminalServerWorkerPool &) = delete;
+
+		/// @brief Deleted copy assignment operator, the pool owns its threads
+		/// @returns Nothing, this function is deleted
+		VirtualTerminalServerWorkerPool &operator=(const VirtualTerminalServerWorkerPool &) = delete;
+
+		/// @brief Queues a job to be run by one of the worker threads
+		/// @param[in] job The job to run
+		void submit(std::function<void()> job);
+
+		/// @brief Returns the number of worker threads the pool runs jobs on
+		/// @returns The number of worker threads the pool runs jobs on
+		std::size_t get_number_of_threads() const;
+
+		/// @brief Returns the number of threads a pool uses if none is specified, based on the number of hardware threads
+		/// @returns The default number of worker threads
+		static std::size_t get_default_number_of_threads();
+
+		static constexpr std::size_t MAX_DEFAULT_NUMBER_OF_THREADS = 4; ///< Upper limit of the default number of threads, so the server doesn't starve the rest of the application
+
+	private:
+		/// @brief The worker threads execute this function, which runs jobs until the pool is destroyed
+		void worker_thread_function();
+
+		std::vector<std::thread> workerThreads; ///< The worker threads, empty until the first job is submitted
+		std::deque<std::function<void()>> jobQueue; ///< Jobs waiting for a worker thread
+		std::mutex jobQueueMutex; ///< Protects the job queue, the worker threads and the stop flag
+		std::condition_variable jobQueueCondition; ///< Wakes the worker threads when a job is submitted or the pool is stopped
+		std::size_t numberOfThreads; ///< The number of worker threads to start
+		bool stopRequested = false; ///< Tells the worker threads to exit once the job queue is empty
+	};
+} // namespace isobus
+
+#endif // ISOBUS_VIRTUAL_TERMINAL_SERVER_WORKER_POOL_HPP
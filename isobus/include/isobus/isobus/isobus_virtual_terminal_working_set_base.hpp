@@ -10,9 +10,11 @@
 #ifndef ISOBUS_VIRTUAL_TERMINAL_WORKING_SET_BASE_HPP
 #define ISOBUS_VIRTUAL_TERMINAL_WORKING_SET_BASE_HPP
 
+#include "isobus/isobus/isobus_virtual_terminal_object_pool_snapshot.hpp"
 #include "isobus/isobus/isobus_virtual_terminal_objects.hpp"
 
 #include <mutex>
+#include <vector>
 
 namespace isobus
 {
@@ -27,6 +29,37 @@ namespace isobus
 		/// @returns true if the IOP data was parsed successfully, otherwise false
 		bool parse_iop_into_objects(std::uint8_t *iopData, std::uint32_t iopLength);
 
+		/// @brief Takes a raw block of IOP data and parses it into VT objects, decoding each object
+		/// from where a snapshot of the pool says it is instead of walking the whole pool
+		/// @param[in] snapshot A snapshot created from the same IOP data
+		/// @param[in] iopData A pointer to the raw IOP data
+		/// @param[in] iopLength The length of the raw IOP data
+		/// @returns true if the snapshot matches the IOP data and every object was decoded. On failure the object tree
+		/// may contain some of the objects, so it should be cleared before parsing the IOP data another way.
+		bool parse_iop_into_objects(const VirtualTerminalObjectPoolSnapshot &snapshot, std::uint8_t *iopData, std::uint32_t iopLength);
+
+		/// @brief Starts decoding an IOP file while it is being received, instead of once all of it has arrived.
+		/// @details The file is passed to parse_iop_chunk in order, one chunk at a time. Each object is decoded
+		/// as soon as all of its bytes have arrived, and the bytes of an object that is split across chunks are kept until the rest of it arrives.
+		void begin_incremental_iop_parse();
+
+		/// @brief Decodes the objects of the IOP file being received that a chunk completes
+		/// @param[in] chunk The next bytes of the IOP file
+		/// @param[in] chunkLength The number of bytes in the chunk
+		/// @returns false if an object could not be decoded, in which case the rest of the file is ignored
+		bool parse_iop_chunk(const std::uint8_t *chunk, std::uint32_t chunkLength);
+
+		/// @brief Decodes the objects that are left once the whole IOP file has been received
+		/// @returns true if the whole IOP file was decoded, the same as parse_iop_into_objects would return for it
+		bool end_incremental_iop_parse();
+
+		/// @brief Works out how many bytes the object at the start of some IOP data occupies, without decoding it
+		/// @param[in] iopData A pointer to the start of an object in some IOP data
+		/// @param[in] iopLength The number of bytes of IOP data available
+		/// @returns The size of the object in bytes, a number larger than iopLength if more data is needed to tell,
+		/// or 0 if the object's type isn't supported
+		static std::uint32_t get_iop_object_size(const std::uint8_t *iopData, std::uint32_t iopLength);
+
 		/// @brief Returns a colour from this working set's current colour table, by index
 		/// @param[in] colourIndex The index into the VT's colour table to retrieve
 		/// @returns A colour from this working set's current colour table, by index
@@ -34,7 +67,7 @@ namespace isobus
 
 		/// @brief Returns the working set's object tree
 		/// @returns The working set's object tree
-		const std::map<std::uint16_t, std::shared_ptr<VTObject>> &get_object_tree() const;
+		const VTObjectTable &get_object_tree() const;
 
 		/// @brief Returns a VT object from the object tree by object ID
 		/// @param[in] objectID The object ID to retrieve from the object tree
@@ -49,6 +82,10 @@ namespace isobus
 		/// @param[in] dataToAdd The raw IOP data to add to the working set
 		void add_iop_raw_data(const std::vector<std::uint8_t> &dataToAdd);
 
+		/// @brief Appends raw IOP data to the working set's IOP file data without copying it
+		/// @param[in] dataToAdd The raw IOP data to move into the working set
+		void add_iop_raw_data(std::vector<std::uint8_t> &&dataToAdd);
+
 		/// @brief Returns the number of discrete IOP file chunks that have been added to the object pool
 		/// @returns The number of discrete IOP file chunks that have been added to the object pool
 		std::size_t get_number_iop_files() const;
@@ -62,6 +99,15 @@ namespace isobus
 		/// @returns The object ID of the faulting object if parsing the object pool failed
 		std::uint16_t get_object_pool_faulting_object_id();
 
+		/// @brief Returns the arena that backs the objects parsed from this working set's object pool
+		/// @returns The arena that backs the objects parsed from this working set's object pool
+		const VTObjectArena &get_object_arena() const;
+
+		/// @brief The number of bytes of the next object that must have arrived before an object is decoded incrementally.
+		/// The length checks of a few object types look slightly past the end of the object, so waiting for these bytes
+		/// makes an object decode the same way it would if the whole file was available.
+		static constexpr std::uint32_t INCREMENTAL_PARSE_LOOKAHEAD = 8;
+
 	protected:
 		/// @brief Adds an object to the object tree, and replaces an object
 		/// if there's already one in the tree with the same ID.
@@ -69,6 +115,11 @@ namespace isobus
 		/// @returns true if the object was added or replaced, otherwise false
 		bool add_or_replace_object(std::shared_ptr<VTObject> objectToAdd);
 
+		/// @brief Creates an object whose memory, including its child and macro lists, comes from this working set's arena
+		/// @returns The new object
+		template<typename T>
+		std::shared_ptr<T> create_object();
+
 		/// @brief Parses one object in the remaining object pool data
 		/// @param[in,out] iopData A pointer to some object pool data
 		/// @param[in,out] iopLength The number of bytes remaining in the object pool
@@ -108,10 +159,21 @@ namespace isobus
 		VTColourTable workingSetColourTable; ///< This working set's colour table
 		std::uint32_t iopSize = 0; ///< Total size of the IOP in bytes
 		std::uint32_t transferredIopSize = 0; ///< Total number of IOP bytes transferred
-		std::map<std::uint16_t, std::shared_ptr<VTObject>> vtObjectTree; ///< The C++ object representation (deserialized) of the object pool being managed
+		std::shared_ptr<VTObjectArena> objectArena = std::make_shared<VTObjectArena>(); ///< Backs the memory of the parsed objects, freed once the working set and its objects are gone
+		VTObjectTable vtObjectTree; ///< The C++ object representation (deserialized) of the object pool being managed
 		std::vector<std::vector<std::uint8_t>> iopFilesRawData; ///< Raw IOP File data from the client
 		std::uint16_t workingSetID = NULL_OBJECT_ID; ///< Stores the object ID of the working set object itself
 		std::uint16_t faultingObjectID = NULL_OBJECT_ID; ///< Stores the faulting object ID to send to a client when parsing the pool fails
+
+	private:
+		const std::uint8_t *snapshotPictureGraphicData = nullptr; ///< The pixels of the picture graphic being decoded from a snapshot, or nullptr to decode them from the IOP data
+		std::uint32_t snapshotPictureGraphicDataLength = 0; ///< The number of pixels of the picture graphic being decoded from a snapshot
+		std::vector<std::uint8_t> incrementalParseBuffer; ///< Received bytes of the IOP file being decoded incrementally, from the first object that hasn't been decoded
+		std::size_t incrementalParseOffset = 0; ///< The offset in the buffer of the first object that hasn't been decoded
+		std::uint32_t incrementalParseBytesNeeded = 0; ///< How many bytes from the offset must be buffered before it's worth trying to decode the next object
+		std::uint32_t incrementalParseBytesReceived = 0; ///< The number of bytes of the IOP file received so far
+		bool incrementalParseDeferred = false; ///< Set when the rest of the file can only be decoded once all of it has arrived
+		bool incrementalParseFailed = false; ///< Set when an object of the file could not be decoded
 	};
 } // namespace isobus
 #endif // ISOBUS_VIRTUAL_TERMINAL_WORKING_SET_BASE_HPP
@@ -28,9 +28,12 @@
 #define NMEA2000_FAST_PACKET_PROTOCOL_HPP
 
 #include "isobus/isobus/can_transport_protocol_base.hpp"
+#include "isobus/isobus/can_transport_protocol_session_table.hpp"
 #include "isobus/utility/event_dispatcher.hpp"
 #include "isobus/utility/thread_synchronization.hpp"
 
+#include <array>
+
 namespace isobus
 {
 	/// @brief A protocol that handles the NMEA 2000 fast packet protocol.
@@ -161,10 +164,21 @@ namespace isobus
 		/// @param[in] allow Denotes if messages for non-internal control functions should be parsed by this protocol
 		void allow_any_control_function(bool allow);
 
-		/// @brief Updates all sessions managed by this protocol manager instance.
+		/// @brief Updates the sessions managed by this protocol manager instance that are due.
+		/// @details Transmit sessions are due on every update until all frames are sent,
+		/// partially received messages are dropped once they time out.
 		void update();
 
+		/// @brief Returns how long it is until a session managed by this instance needs to be updated
+		/// @returns The time until the next session is due in milliseconds, zero if one is due now,
+		/// or the max value of std::uint32_t if there are no sessions
+		std::uint32_t get_time_until_next_update() const;
+
 		/// @brief A generic way for a protocol to process a received message
+		/// @details Received messages are reassembled in preallocated slots keyed by source, PGN and sequence counter,
+		/// so frames of consecutive messages from the same source may be interleaved, and frames of a message may
+		/// arrive out of order, as long as they all arrive before the timeout. Frames whose first frame hasn't arrived
+		/// are dropped once no frame of their message arrived for the out of order frame window, instead of the whole timeout.
 		/// @param[in] message A received CAN message
 		void process_message(const CANMessage &message);
 
@@ -189,13 +203,6 @@ namespace isobus
 		/// @returns The sequence number to use for the new session
 		std::uint8_t get_new_sequence_number(NAME name, std::uint32_t parameterGroupNumber) const;
 
-		/// @brief Gets a FP session from the passed in source and destination and PGN combination
-		/// @param[in] parameterGroupNumber The PGN of the session
-		/// @param[in] source The source control function for the session
-		/// @param[in] destination The destination control function for the session
-		/// @returns a matching session, or nullptr if no session matched the supplied parameters
-		std::shared_ptr<FastPacketProtocolSession> get_session(std::uint32_t parameterGroupNumber, std::shared_ptr<ControlFunction> source, std::shared_ptr<ControlFunction> destination);
-
 		/// @brief Checks if a session by the passed in source and destination and PGN combination exists
 		/// @param[in] parameterGroupNumber The PGN of the session
 		/// @param[in] source The source control function for the session
@@ -203,10 +210,26 @@ namespace isobus
 		/// @returns true if a matching session exists, false if not
 		bool has_session(std::uint32_t parameterGroupNumber, std::shared_ptr<ControlFunction> source, std::shared_ptr<ControlFunction> destination);
 
-		/// @brief Update a single session
+		/// @brief Update a single transmit session
 		/// @param[in] session The session to update
 		void update_session(const std::shared_ptr<FastPacketProtocolSession> &session);
 
+		/// @brief Finds the receive slot that is reassembling a message
+		/// @param[in] message A frame of the message
+		/// @param[in] sequenceNumber The sequence counter of the frame
+		/// @returns The index of the matching slot, or NO_RECEIVE_SLOT if no slot matched
+		std::uint8_t find_receive_slot(const CANMessage &message, std::uint8_t sequenceNumber) const;
+
+		/// @brief Claims a free receive slot for a new message, evicting the least recently updated slot if none are free
+		/// @param[in] message A frame of the new message
+		/// @param[in] sequenceNumber The sequence counter of the frame
+		/// @returns The index of the claimed slot
+		std::uint8_t claim_receive_slot(const CANMessage &message, std::uint8_t sequenceNumber);
+
+		/// @brief Returns a receive slot to the free list
+		/// @param[in] slotIndex The index of the slot to release
+		void release_receive_slot(std::uint8_t slotIndex);
+
 		static constexpr std::uint32_t FP_MIN_PARAMETER_GROUP_NUMBER = 0x1F000; ///< Start of PGNs that can be received via Fast Packet
 		static constexpr std::uint32_t FP_MAX_PARAMETER_GROUP_NUMBER = 0x1FFFF; ///< End of PGNs that can be received via Fast Packet
 		static constexpr std::uint32_t FP_TIMEOUT_MS = 750; ///< Protocol timeout in milliseconds
@@ -215,9 +238,40 @@ namespace isobus
 		static constexpr std::uint8_t SEQUENCE_NUMBER_BIT_MASK = 0x07; ///< Bit mask for masking out the sequence number bits
 		static constexpr std::uint8_t SEQUENCE_NUMBER_BIT_OFFSET = 5; ///< The bit offset into the first byte of data to get the seq number
 		static constexpr std::uint8_t PROTOCOL_BYTES_PER_FRAME = 7; ///< The number of payload bytes per frame for all but the first message, which has 6
+		static constexpr std::size_t INITIAL_SESSION_CAPACITY = 16; ///< The number of sessions the session table can hold before it needs to allocate
+		static constexpr std::uint8_t RECEIVE_SLOT_COUNT = 32; ///< The number of messages that can be reassembled at the same time
+		static constexpr std::uint8_t NO_RECEIVE_SLOT = 0xFF; ///< Marks the end of a list of receive slots
+		static constexpr std::uint32_t OUT_OF_ORDER_FRAME_WINDOW_MS = 50; ///< How long frames that arrive before the first frame of their message are kept without a new frame
+
+		/// @brief A preallocated buffer that reassembles one received message
+		struct ReceiveSlot
+		{
+			std::array<std::uint8_t, MAX_PROTOCOL_MESSAGE_LENGTH> data; ///< The payload received so far, frames are stored at their position in the message
+			std::shared_ptr<ControlFunction> source; ///< The control function sending the message
+			std::shared_ptr<ControlFunction> destination; ///< The control function receiving the message, or nullptr for broadcasts
+			std::uint32_t parameterGroupNumber = 0; ///< The PGN of the message
+			std::uint32_t claimTimestamp_ms = 0; ///< When the slot was claimed, used to drop stale out-of-order frames
+			std::uint32_t lastFrameTimestamp_ms = 0; ///< When the last frame was received, used for the timeout
+			std::uint32_t receivedFrames = 0; ///< Bit n is set once frame n of the message was received
+			std::uint8_t messageLength = 0; ///< The length of the message, zero until the first frame was received
+			std::uint8_t sequenceNumber = 0; ///< The sequence counter of the message
+			std::uint8_t sourceAddress = 0; ///< The address the source had when the slot was claimed, which selects the list the slot is in
+			std::uint8_t nextSlot = NO_RECEIVE_SLOT; ///< The next slot of the same source, or the next free slot
+			bool inUse = false; ///< Whether the slot is reassembling a message
+		};
+
+		/// @brief Returns how long a receive slot may go without a new frame before it is released
+		/// @param[in] slot The receive slot
+		/// @returns The timeout of the slot in milliseconds
+		static std::uint32_t get_receive_slot_timeout(const ReceiveSlot &slot);
 
-		std::vector<std::shared_ptr<FastPacketProtocolSession>> activeSessions; ///< A list of all active TP sessions
-		Mutex sessionMutex; ///< A mutex to lock the sessions list in case someone starts a Tx while the stack is processing sessions
+		TransportProtocolSessionTable<FastPacketProtocolSession> activeSessions; ///< All active FP sessions, indexed by source, destination and PGN
+		std::vector<std::shared_ptr<FastPacketProtocolSession>> dueSessions; ///< Scratch list of sessions that are due in the current update
+		std::array<ReceiveSlot, RECEIVE_SLOT_COUNT> receiveSlots; ///< Preallocated slots that received messages are reassembled in
+		std::array<std::uint8_t, 256> firstReceiveSlotBySource; ///< The first slot of each source address, the others are linked through ReceiveSlot::nextSlot
+		std::uint8_t firstFreeReceiveSlot = 0; ///< The first slot of the free list
+		std::uint8_t receiveSlotsInUse = 0; ///< The number of slots that are reassembling a message
+		mutable Mutex sessionMutex; ///< A mutex to lock the sessions list in case someone starts a Tx while the stack is processing sessions
 		std::vector<FastPacketHistory> sessionHistory; ///< Used to keep track of sequence numbers for future sessions
 		std::vector<ParameterGroupNumberCallbackData> parameterGroupNumberCallbacks; ///< A list of all parameter group number callbacks that will be parsed as fast packet messages
 		bool allowAnyControlFunction = false; ///< Denotes if messages for non-internal control functions should be parsed by this protocol
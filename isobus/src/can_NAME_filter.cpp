@@ -96,4 +96,129 @@ namespace isobus
 		return retVal;
 	}
 
+	bool NAMEFilter::get_raw_mask_and_value(std::uint64_t &mask, std::uint64_t &maskedValue) const
+	{
+		std::uint64_t fieldMaximum = 0;
+		std::uint8_t fieldShift = 0;
+		std::uint64_t fieldValue = value;
+		bool retVal = true;
+
+		switch (parameter)
+		{
+			case NAME::NAMEParameters::IdentityNumber:
+			{
+				fieldMaximum = 0x1FFFFF;
+				fieldShift = 0;
+			}
+			break;
+
+			case NAME::NAMEParameters::ManufacturerCode:
+			{
+				fieldMaximum = 0x07FF;
+				fieldShift = 21;
+			}
+			break;
+
+			case NAME::NAMEParameters::EcuInstance:
+			{
+				fieldMaximum = 0x07;
+				fieldShift = 32;
+			}
+			break;
+
+			case NAME::NAMEParameters::FunctionInstance:
+			{
+				fieldMaximum = 0x1F;
+				fieldShift = 35;
+			}
+			break;
+
+			case NAME::NAMEParameters::FunctionCode:
+			{
+				fieldMaximum = 0xFF;
+				fieldShift = 40;
+			}
+			break;
+
+			case NAME::NAMEParameters::DeviceClass:
+			{
+				fieldMaximum = 0x7F;
+				fieldShift = 49;
+			}
+			break;
+
+			case NAME::NAMEParameters::DeviceClassInstance:
+			{
+				fieldMaximum = 0x0F;
+				fieldShift = 56;
+			}
+			break;
+
+			case NAME::NAMEParameters::IndustryGroup:
+			{
+				fieldMaximum = 0x07;
+				fieldShift = 60;
+			}
+			break;
+
+			case NAME::NAMEParameters::ArbitraryAddressCapable:
+			{
+				fieldMaximum = 0x01;
+				fieldShift = 63;
+				fieldValue = (0 != value) ? 1 : 0;
+			}
+			break;
+
+			default:
+			{
+				// Shouldn't be possible, filter will not match.
+				retVal = false;
+			}
+			break;
+		}
+
+		if (fieldValue > fieldMaximum)
+		{
+			// The NAME component can never hold this value
+			retVal = false;
+		}
+		mask = (fieldMaximum << fieldShift);
+		maskedValue = ((fieldValue & fieldMaximum) << fieldShift);
+		return retVal;
+	}
+
+	CompiledNAMEFilter::CompiledNAMEFilter(const std::vector<NAMEFilter> &filters) :
+	  canMatch(!filters.empty())
+	{
+		for (const auto &filter : filters)
+		{
+			std::uint64_t filterMask = 0;
+			std::uint64_t filterValue = 0;
+
+			if ((!filter.get_raw_mask_and_value(filterMask, filterValue)) ||
+			    ((mask & filterMask & maskedValue) != (mask & filterMask & filterValue)))
+			{
+				// Either this filter can never match, or it requires a different value than an earlier filter on the same component
+				canMatch = false;
+			}
+			mask |= filterMask;
+			maskedValue |= filterValue;
+		}
+	}
+
+	std::uint64_t CompiledNAMEFilter::get_mask() const
+	{
+		return mask;
+	}
+
+	std::uint64_t CompiledNAMEFilter::get_value() const
+	{
+		return maskedValue;
+	}
+
+	bool CompiledNAMEFilter::get_can_match() const
+	{
+		return canMatch;
+	}
+
 } // namespace isobus
@@ -8,6 +8,8 @@
 //================================================================================================
 #include "isobus/isobus/can_callbacks.hpp"
 
+#include <algorithm>
+
 namespace isobus
 {
 	ParameterGroupNumberCallbackData::ParameterGroupNumberCallbackData(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parentPointer, std::shared_ptr<InternalControlFunction> internalControlFunction) :
@@ -45,4 +47,170 @@ namespace isobus
 	{
 		return internalControlFunctionFilter;
 	}
+
+	ParameterGroupNumberCallbackTable::ParameterGroupNumberCallbackTable() :
+	  snapshot(std::make_shared<const Snapshot>())
+	{
+	}
+
+	bool ParameterGroupNumberCallbackTable::add_callback(const ParameterGroupNumberCallbackData &callbackData, bool allowDuplicates)
+	{
+		LOCK_GUARD(Mutex, writeMutex);
+		bool retVal = false;
+
+		if (allowDuplicates ||
+		    (registeredCallbacks.end() == std::find(registeredCallbacks.begin(), registeredCallbacks.end(), callbackData)))
+		{
+			registeredCallbacks.push_back(callbackData);
+			rebuild_snapshot();
+			retVal = true;
+		}
+		return retVal;
+	}
+
+	bool ParameterGroupNumberCallbackTable::remove_callback(const ParameterGroupNumberCallbackData &callbackData)
+	{
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+		std::uint64_t removalEpoch;
+#endif
+		{
+			LOCK_GUARD(Mutex, writeMutex);
+			auto callbackLocation = std::find(registeredCallbacks.begin(), registeredCallbacks.end(), callbackData);
+
+			if (registeredCallbacks.end() == callbackLocation)
+			{
+				return false;
+			}
+			registeredCallbacks.erase(callbackLocation);
+			rebuild_snapshot();
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+			removalEpoch = snapshotEpoch;
+#endif
+		}
+
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+		// Dispatches that started after the new snapshot was published can't call the removed callback,
+		// so only the ones that started from an older snapshot, whichever one it was, have to be waited for.
+		// The write mutex isn't held while waiting, so that callbacks in progress can still add or remove callbacks.
+		std::unique_lock<std::mutex> dispatchLock(dispatchMutex);
+
+		set_current_thread_removing(true);
+		dispatchStateChanged.notify_all();
+		dispatchStateChanged.wait(dispatchLock, [this, removalEpoch]() { return !has_dispatch_to_wait_for(removalEpoch); });
+		set_current_thread_removing(false);
+		dispatchStateChanged.notify_all();
+#endif
+		return true;
+	}
+
+	void ParameterGroupNumberCallbackTable::dispatch(const CANMessage &message) const
+	{
+#if defined CAN_STACK_DISABLE_THREADS || defined ARDUINO
+		const std::shared_ptr<const Snapshot> snapshotInUse = snapshot;
+		const Snapshot &currentSnapshot = *snapshotInUse;
+#else
+		const DispatchScope dispatchScope(*this);
+		const Snapshot &currentSnapshot = dispatchScope.get_snapshot();
+#endif
+		const std::uint32_t parameterGroupNumber = message.get_identifier().get_parameter_group_number();
+		auto currentCallback = std::lower_bound(currentSnapshot.begin(),
+		                                        currentSnapshot.end(),
+		                                        parameterGroupNumber,
+		                                        [](const ParameterGroupNumberCallbackData &callbackData, std::uint32_t pgn) {
+			                                        return callbackData.get_parameter_group_number() < pgn;
+		                                        });
+
+		for (; (currentSnapshot.end() != currentCallback) && (parameterGroupNumber == currentCallback->get_parameter_group_number()); currentCallback++)
+		{
+			if (nullptr != currentCallback->get_callback())
+			{
+				currentCallback->get_callback()(message, currentCallback->get_parent());
+			}
+		}
+	}
+
+	std::size_t ParameterGroupNumberCallbackTable::size() const
+	{
+		LOCK_GUARD(Mutex, writeMutex);
+		return registeredCallbacks.size();
+	}
+
+	void ParameterGroupNumberCallbackTable::rebuild_snapshot()
+	{
+		auto newSnapshot = std::make_shared<Snapshot>(registeredCallbacks);
+		std::stable_sort(newSnapshot->begin(), newSnapshot->end(), [](const ParameterGroupNumberCallbackData &first, const ParameterGroupNumberCallbackData &second) {
+			return first.get_parameter_group_number() < second.get_parameter_group_number();
+		});
+#if defined CAN_STACK_DISABLE_THREADS || defined ARDUINO
+		snapshot = std::move(newSnapshot);
+#else
+		const std::lock_guard<std::mutex> dispatchLock(dispatchMutex);
+		snapshot = std::move(newSnapshot);
+		snapshotEpoch++;
+#endif
+	}
+
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+	bool ParameterGroupNumberCallbackTable::has_dispatch_to_wait_for(std::uint64_t removalEpoch) const
+	{
+		const std::thread::id currentThreadID = std::this_thread::get_id();
+
+		for (const DispatchScope *currentScope = dispatchesInProgress; nullptr != currentScope; currentScope = currentScope->next)
+		{
+			if ((currentScope->epoch < removalEpoch) &&
+			    (currentThreadID != currentScope->threadID) &&
+			    (!currentScope->threadIsRemoving))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void ParameterGroupNumberCallbackTable::set_current_thread_removing(bool removing)
+	{
+		const std::thread::id currentThreadID = std::this_thread::get_id();
+
+		for (DispatchScope *currentScope = dispatchesInProgress; nullptr != currentScope; currentScope = currentScope->next)
+		{
+			if (currentThreadID == currentScope->threadID)
+			{
+				currentScope->threadIsRemoving = removing;
+			}
+		}
+	}
+
+	ParameterGroupNumberCallbackTable::DispatchScope::DispatchScope(const ParameterGroupNumberCallbackTable &parentTable) :
+	  table(parentTable),
+	  threadID(std::this_thread::get_id())
+	{
+		const std::lock_guard<std::mutex> dispatchLock(table.dispatchMutex);
+		snapshot = table.snapshot;
+		epoch = table.snapshotEpoch;
+		next = table.dispatchesInProgress;
+		table.dispatchesInProgress = this;
+	}
+
+	ParameterGroupNumberCallbackTable::DispatchScope::~DispatchScope()
+	{
+		{
+			const std::lock_guard<std::mutex> dispatchLock(table.dispatchMutex);
+
+			for (DispatchScope **currentScope = &table.dispatchesInProgress; nullptr != *currentScope; currentScope = &(*currentScope)->next)
+			{
+				if (this == *currentScope)
+				{
+					*currentScope = next;
+					break;
+				}
+			}
+		}
+		table.dispatchStateChanged.notify_all();
+	}
+
+	const ParameterGroupNumberCallbackTable::Snapshot &ParameterGroupNumberCallbackTable::DispatchScope::get_snapshot() const
+	{
+		return *snapshot;
+	}
+#endif
 } // namespace isobus
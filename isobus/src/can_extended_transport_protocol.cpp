@@ -44,6 +44,17 @@ namespace isobus
 		return transferred;
 	}
 
+	std::uint32_t ExtendedTransportProtocolManager::ExtendedTransportProtocolSession::get_goodput() const
+	{
+		std::uint32_t endTime = (0 != endTimestamp_ms) ? endTimestamp_ms : SystemTiming::get_timestamp_ms();
+		std::uint32_t elapsedTime = endTime - startTimestamp_ms;
+		if (0 == elapsedTime)
+		{
+			elapsedTime = 1;
+		}
+		return static_cast<std::uint32_t>((static_cast<std::uint64_t>(get_total_bytes_transferred()) * 1000) / elapsedTime);
+	}
+
 	std::uint8_t ExtendedTransportProtocolManager::ExtendedTransportProtocolSession::get_dpo_number_of_packets_remaining() const
 	{
 		auto packetsSinceDPO = static_cast<std::uint8_t>(get_last_packet_number() - lastAcknowledgedPacketNumber);
@@ -120,6 +131,16 @@ namespace isobus
 		return totalNumberOfPackets;
 	}
 
+	std::uint8_t ExtendedTransportProtocolManager::ExtendedTransportProtocolSession::get_packet_pacing() const
+	{
+		return packetPacing_ms;
+	}
+
+	void ExtendedTransportProtocolManager::ExtendedTransportProtocolSession::set_packet_pacing(std::uint8_t value)
+	{
+		packetPacing_ms = value;
+	}
+
 	ExtendedTransportProtocolManager::ExtendedTransportProtocolManager(const CANMessageFrameCallback &sendCANFrameCallback,
 	                                                                   const CANMessageCallback &canMessageReceivedCallback,
 	                                                                   const CANNetworkConfiguration *configuration) :
@@ -127,6 +148,8 @@ namespace isobus
 	  canMessageReceivedCallback(canMessageReceivedCallback),
 	  configuration(configuration)
 	{
+		activeSessions.reserve(configuration->get_max_number_transport_protocol_sessions());
+		dueSessions.reserve(configuration->get_max_number_transport_protocol_sessions());
 	}
 
 	void ExtendedTransportProtocolManager::process_request_to_send(const std::shared_ptr<ControlFunction> source,
@@ -134,7 +157,7 @@ namespace isobus
 	                                                               std::uint32_t parameterGroupNumber,
 	                                                               std::uint32_t totalMessageSize)
 	{
-		if (activeSessions.size() >= configuration->get_max_number_transport_protocol_sessions())
+		if (get_sessions_count() >= configuration->get_max_number_transport_protocol_sessions())
 		{
 			// TODO: consider using maximum memory instead of maximum number of sessions
 			LOG_WARNING("[ETP]: Replying with abort to Request To Send (RTS) for 0x%05X, configured maximum number of sessions reached.",
@@ -161,19 +184,34 @@ namespace isobus
 			}
 
 			auto newSession = std::make_shared<ExtendedTransportProtocolSession>(ExtendedTransportProtocolSession::Direction::Receive,
-			                                                                     std::unique_ptr<CANMessageData>(new CANMessageDataVector(totalMessageSize)),
+			                                                                     std::unique_ptr<CANMessageData>(new CANMessageDataVector(0)), // Sized by prepare_receive_data
 			                                                                     parameterGroupNumber,
 			                                                                     totalMessageSize,
 			                                                                     source,
 			                                                                     destination,
 			                                                                     nullptr, // No callback
 			                                                                     nullptr);
+			newSession->pipeliningAllowed = configuration->get_extended_transport_protocol_pipelining(source->get_NAME());
 
 			// Request the maximum number of packets per DPO via the CTS message
-			newSession->set_cts_number_of_packet_limit(configuration->get_number_of_packets_per_dpo_message());
+			const std::uint8_t adaptiveInitialWindow = get_adaptive_initial_window(source);
+			if (configuration->get_extended_transport_protocol_adaptive_flow_control() && (0 != adaptiveInitialWindow))
+			{
+				// Start where the last session from this sender left off, adaptive flow control adjusts it from there
+				newSession->set_cts_number_of_packet_limit(adaptiveInitialWindow);
+			}
+			else
+			{
+				newSession->set_cts_number_of_packet_limit(configuration->get_number_of_packets_per_dpo_message());
+			}
+			newSession->startTimestamp_ms = SystemTiming::get_timestamp_ms();
+			prepare_receive_data(newSession);
 
 			newSession->set_state(StateMachineState::SendClearToSend);
-			activeSessions.push_back(newSession);
+			{
+				LOCK_GUARD(Mutex, activeSessionsMutex);
+				activeSessions.insert(newSession);
+			}
 			LOG_DEBUG("[ETP]: New rx session for 0x%05X. Source: %hu, destination: %hu", parameterGroupNumber, source->get_address(), destination->get_address());
 			update_state_machine(newSession);
 		}
@@ -199,6 +237,16 @@ namespace isobus
 				LOG_ERROR("[ETP]: Received a Clear To Send (CTS) message for 0x%05X with a bad sequence number, aborting...", parameterGroupNumber);
 				abort_session(session, ConnectionAbortReason::NumberOfClearToSendPacketsExceedsMessage);
 			}
+			else if (session->pipeliningAllowed &&
+			         (StateMachineState::SendDataTransferPackets == session->state) &&
+			         (0 == session->pendingClearToSendPacketNumber) &&
+			         (0 != packetsToBeSent) &&
+			         ((nextPacketNumber - 1) == (session->get_last_packet_number() + session->get_dpo_number_of_packets_remaining())))
+			{
+				// The receiver already asks for the next window, so it can start as soon as this one is sent
+				session->pendingClearToSendPacketCount = packetsToBeSent;
+				session->pendingClearToSendPacketNumber = nextPacketNumber;
+			}
 			else if (StateMachineState::WaitForClearToSend != session->state)
 			{
 				// The session exists, but we're not in the right state to receive a CTS, so we must abort
@@ -207,15 +255,7 @@ namespace isobus
 			}
 			else
 			{
-				session->set_acknowledged_packet_number(nextPacketNumber - 1);
-				session->set_cts_number_of_packet_limit(packetsToBeSent);
-
-				// If 0 was sent as the packet number, they want us to wait.
-				// Just sit here in this state until we get a non-zero packet count
-				if (0 != packetsToBeSent)
-				{
-					session->set_state(StateMachineState::SendDataPacketOffset);
-				}
+				accept_clear_to_send(session, packetsToBeSent, nextPacketNumber);
 			}
 		}
 		else
@@ -452,7 +492,12 @@ namespace isobus
 				  static_cast<std::size_t>(PROTOCOL_BYTES_PER_FRAME),
 				  static_cast<std::size_t>(session->get_message_length() - currentDataIndex));
 
-				if (bytes_to_copy > 0)
+				if (nullptr != session->get_receive_sink())
+				{
+					// The consumer supplied its own storage, so the data goes straight there
+					session->get_receive_sink()->write_bytes(currentDataIndex, CANDataSpan(message.get_data().data() + 1, bytes_to_copy));
+				}
+				else if (bytes_to_copy > 0)
 				{
 					if (bytes_to_copy <= 4)
 					{
@@ -475,27 +520,58 @@ namespace isobus
 					// Send End of Message Acknowledgement for sessions with specific destination only
 					send_end_of_session_acknowledgement(session);
 
-					// Construct the completed message
-					CANIdentifier identifier(CANIdentifier::Type::Extended,
-					                         session->get_parameter_group_number(),
-					                         CANIdentifier::CANPriority::PriorityDefault6,
-					                         destination->get_address(),
-					                         source->get_address());
-					CANMessage completedMessage(CANMessage::Type::Receive,
-					                            identifier,
-					                            std::move(data),
-					                            source,
-					                            destination,
-					                            0);
-
-					canMessageReceivedCallback(completedMessage);
+					if (nullptr == session->get_receive_sink())
+					{
+						// Construct the completed message
+						CANIdentifier identifier(CANIdentifier::Type::Extended,
+						                         session->get_parameter_group_number(),
+						                         CANIdentifier::CANPriority::PriorityDefault6,
+						                         destination->get_address(),
+						                         source->get_address());
+						CANMessage completedMessage(CANMessage::Type::Receive,
+						                            identifier,
+						                            std::move(data),
+						                            source,
+						                            destination,
+						                            0);
+
+						canMessageReceivedCallback(completedMessage);
+					}
 					close_session(session, true);
 					LOG_DEBUG("[ETP]: Completed rx session for 0x%05X from %hu", session->get_parameter_group_number(), source->get_address());
 				}
 				else if (session->get_dpo_number_of_packets_remaining() == 0)
 				{
-					session->set_state(StateMachineState::SendClearToSend);
-					update_state_machine(session);
+					if (session->pipelinedClearToSendSent)
+					{
+						// The CTS for the next window went out already, so the DPO can follow right away
+						session->pipelinedClearToSendSent = false;
+						session->set_acknowledged_packet_number(session->get_last_packet_number());
+						session->set_state(StateMachineState::WaitForDataPacketOffset);
+					}
+					else
+					{
+						adapt_clear_to_send_window(session);
+						session->set_state(StateMachineState::SendClearToSend);
+						update_state_machine(session);
+					}
+				}
+				else if (session->pipeliningAllowed &&
+				         (!session->pipelinedClearToSendSent) &&
+				         (session->get_dpo_number_of_packets_remaining() <= (session->get_dpo_number_of_packets() / 2)) &&
+				         (session->get_number_of_remaining_packets() > session->get_dpo_number_of_packets_remaining()))
+				{
+					// Half of the window is in, ask for the next one now so the sender doesn't have to wait for our CTS
+					std::uint8_t previousWindow = session->get_cts_number_of_packet_limit();
+					bool previousStall = session->dataStallObserved;
+					adapt_clear_to_send_window(session);
+					session->pipelinedClearToSendSent = send_clear_to_send(session);
+					if (!session->pipelinedClearToSendSent)
+					{
+						// Try again with the next packet
+						session->set_cts_number_of_packet_limit(previousWindow);
+						session->dataStallObserved = previousStall;
+					}
 				}
 			}
 			else
@@ -526,8 +602,9 @@ namespace isobus
 				break;
 
 				default:
-					break;
+					return;
 			}
+			schedule_session_update(message.get_source_control_function(), message.get_destination_control_function());
 		}
 	}
 
@@ -565,23 +642,41 @@ namespace isobus
 		                                                                  destination,
 		                                                                  sessionCompleteCallback,
 		                                                                  parentPointer);
+		session->pipeliningAllowed = configuration->get_extended_transport_protocol_pipelining(destination->get_NAME());
 		session->set_state(StateMachineState::SendRequestToSend);
+		session->startTimestamp_ms = SystemTiming::get_timestamp_ms();
 		LOG_DEBUG("[ETP]: New tx session for 0x%05X. Source: %hu, destination: %hu",
 		          parameterGroupNumber,
 		          source->get_address(),
 		          destination->get_address());
 
-		activeSessions.push_back(session);
+		{
+			LOCK_GUARD(Mutex, activeSessionsMutex);
+			activeSessions.insert(session);
+		}
+
 		update_state_machine(session);
+
+		// Scheduling only after the first frame went out keeps a concurrent update from sending it again
+		LOCK_GUARD(Mutex, activeSessionsMutex);
+		if (session == activeSessions.find(source, destination))
+		{
+			activeSessions.schedule(session, get_session_deadline(session, SystemTiming::get_timestamp_ms()));
+		}
 		return true;
 	}
 
 	void ExtendedTransportProtocolManager::update()
 	{
-		// We use a fancy for loop here to allow us to remove sessions from the list while iterating
-		for (std::size_t i = activeSessions.size(); i > 0; i--)
+		LOCK_GUARD(Mutex, updateMutex);
+		{
+			LOCK_GUARD(Mutex, activeSessionsMutex);
+			activeSessions.take_due_sessions(SystemTiming::get_timestamp_ms(), dueSessions);
+		}
+
+		// The due sessions are in reverse order of when they were added, so closing one doesn't affect the others
+		for (auto &session : dueSessions)
 		{
-			auto session = activeSessions.at(i - 1);
 			if (!session->get_source()->get_address_valid())
 			{
 				LOG_WARNING("[ETP]: Closing active session as the source control function is no longer valid");
@@ -597,6 +692,173 @@ namespace isobus
 				update_state_machine(session);
 			}
 		}
+
+		// Sessions that are still active wait in the deadline queue until they are due again
+		const std::uint32_t now = SystemTiming::get_timestamp_ms();
+		LOCK_GUARD(Mutex, activeSessionsMutex);
+		for (const auto &session : dueSessions)
+		{
+			if (session == activeSessions.find(session->get_source(), session->get_destination()))
+			{
+				activeSessions.schedule(session, get_session_deadline(session, now));
+			}
+		}
+		dueSessions.clear();
+	}
+
+	void ExtendedTransportProtocolManager::set_receive_sink_callback(ReceiveSinkCallback callback, void *parent)
+	{
+		receiveSinkCallback = callback;
+		receiveSinkParent = parent;
+	}
+
+	std::uint32_t ExtendedTransportProtocolManager::get_time_until_next_update() const
+	{
+		LOCK_GUARD(Mutex, activeSessionsMutex);
+		return activeSessions.get_time_until_next_deadline(SystemTiming::get_timestamp_ms());
+	}
+
+	std::uint32_t ExtendedTransportProtocolManager::get_session_deadline(const std::shared_ptr<ExtendedTransportProtocolSession> &session, std::uint32_t now) const
+	{
+		std::uint32_t timeout = 0;
+
+		switch (session->state)
+		{
+			case StateMachineState::WaitForClearToSend:
+			case StateMachineState::WaitForDataPacketOffset:
+			case StateMachineState::WaitForEndOfMessageAcknowledge:
+			{
+				timeout = T2_T3_TIMEOUT_MS;
+			}
+			break;
+
+			case StateMachineState::WaitForDataTransferPacket:
+			{
+				if (configuration->get_extended_transport_protocol_adaptive_flow_control() && (!session->dataStallObserved))
+				{
+					// Adaptive flow control wants to know if the sender stalls, well before it times out
+					timeout = ADAPTIVE_STALL_TIME_MS;
+				}
+				else
+				{
+					timeout = T1_TIMEOUT_MS;
+				}
+			}
+			break;
+
+			case StateMachineState::SendDataTransferPackets:
+			{
+				if (0 != session->get_packet_pacing())
+				{
+					// Paced sessions are due when it's time for their next data packet
+					std::uint32_t timeSinceLastPacket = session->get_time_since_last_update();
+					return (timeSinceLastPacket >= session->get_packet_pacing()) ? now : (now + (session->get_packet_pacing() - timeSinceLastPacket));
+				}
+			}
+			break;
+
+			default:
+				break;
+		}
+
+		if (0 == timeout)
+		{
+			// The session has something to send, so it's due on every update until it's done
+			return now;
+		}
+
+		// Timeouts expire once more than the timeout has passed
+		std::uint32_t timeSinceLastUpdate = session->get_time_since_last_update();
+		return (timeSinceLastUpdate > timeout) ? now : (now + (timeout - timeSinceLastUpdate) + 1);
+	}
+
+	void ExtendedTransportProtocolManager::schedule_session_update(const std::shared_ptr<ControlFunction> &source, const std::shared_ptr<ControlFunction> &destination)
+	{
+		const std::uint32_t now = SystemTiming::get_timestamp_ms();
+		LOCK_GUARD(Mutex, activeSessionsMutex);
+
+		auto session = activeSessions.find(source, destination);
+		if (nullptr != session)
+		{
+			activeSessions.schedule(session, now);
+		}
+		session = activeSessions.find(destination, source);
+		if (nullptr != session)
+		{
+			activeSessions.schedule(session, now);
+		}
+	}
+
+	void ExtendedTransportProtocolManager::set_estimated_busload(float busloadPercent)
+	{
+		estimatedBusload = busloadPercent;
+	}
+
+	void ExtendedTransportProtocolManager::adapt_clear_to_send_window(const std::shared_ptr<ExtendedTransportProtocolSession> &session) const
+	{
+		if (configuration->get_extended_transport_protocol_adaptive_flow_control())
+		{
+			std::uint8_t window = session->get_cts_number_of_packet_limit();
+
+			if (session->dataStallObserved || (estimatedBusload >= ADAPTIVE_HIGH_BUSLOAD_PERCENT))
+			{
+				// The bus or the sender can't keep up, so ask for fewer packets at a time
+				if (window > ADAPTIVE_MINIMUM_WINDOW)
+				{
+					window = std::max(static_cast<std::uint8_t>(window / 2), static_cast<std::uint8_t>(ADAPTIVE_MINIMUM_WINDOW));
+				}
+			}
+			else if (estimatedBusload < ADAPTIVE_LOW_BUSLOAD_PERCENT)
+			{
+				// The last window went through without trouble, so ask for more packets at a time
+				window = (window > (0xFF - ADAPTIVE_WINDOW_INCREMENT)) ? 0xFF : static_cast<std::uint8_t>(window + ADAPTIVE_WINDOW_INCREMENT);
+			}
+			session->dataStallObserved = false;
+			session->set_cts_number_of_packet_limit(window);
+		}
+	}
+
+	void ExtendedTransportProtocolManager::adapt_packet_pacing(const std::shared_ptr<ExtendedTransportProtocolSession> &session, bool retransmitRequested) const
+	{
+		if (configuration->get_extended_transport_protocol_adaptive_flow_control())
+		{
+			std::uint8_t pacing = session->get_packet_pacing();
+
+			if (retransmitRequested || (estimatedBusload >= ADAPTIVE_HIGH_BUSLOAD_PERCENT))
+			{
+				// Packets are getting lost or the bus is busy, so leave more room between our packets
+				pacing = (0 == pacing) ? 1 : std::min(static_cast<std::uint8_t>(pacing * 2), static_cast<std::uint8_t>(ADAPTIVE_MAXIMUM_PACKET_PACING_MS));
+			}
+			else if (estimatedBusload < ADAPTIVE_LOW_BUSLOAD_PERCENT)
+			{
+				pacing = pacing / 2;
+			}
+			session->set_packet_pacing(pacing);
+		}
+	}
+
+	std::uint8_t ExtendedTransportProtocolManager::get_adaptive_initial_window(const std::shared_ptr<ControlFunction> &sender) const
+	{
+		for (const auto &adaptiveInitialWindow : adaptiveInitialWindows)
+		{
+			if (adaptiveInitialWindow.first.lock() == sender)
+			{
+				return adaptiveInitialWindow.second;
+			}
+		}
+		return 0;
+	}
+
+	void ExtendedTransportProtocolManager::set_adaptive_initial_window(const std::shared_ptr<ControlFunction> &sender, std::uint8_t window)
+	{
+		// Forget senders that no longer exist, so the list only grows with the number of peers
+		adaptiveInitialWindows.erase(std::remove_if(adaptiveInitialWindows.begin(),
+		                                            adaptiveInitialWindows.end(),
+		                                            [&sender](const std::pair<std::weak_ptr<ControlFunction>, std::uint8_t> &adaptiveInitialWindow) {
+			                                            return adaptiveInitialWindow.first.expired() || (adaptiveInitialWindow.first.lock() == sender);
+		                                            }),
+		                             adaptiveInitialWindows.end());
+		adaptiveInitialWindows.emplace_back(sender, window);
 	}
 
 	void ExtendedTransportProtocolManager::send_data_transfer_packets(const std::shared_ptr<ExtendedTransportProtocolSession> &session) const
@@ -608,24 +870,20 @@ namespace isobus
 			framesToSend = configuration->get_max_number_of_network_manager_protocol_frames_per_update();
 		}
 
+		if (0 != session->get_packet_pacing())
+		{
+			// Paced sessions send one packet at a time, once enough time has passed since the last one
+			framesToSend = (session->get_time_since_last_update() >= session->get_packet_pacing()) ? std::min(framesToSend, static_cast<std::uint8_t>(1)) : 0;
+		}
+
 		// Try and send packets
 		for (std::uint8_t i = 0; i < framesToSend; i++)
 		{
 			buffer[0] = session->get_last_sequence_number() + 1;
 
 			std::uint32_t dataOffset = session->get_last_packet_number() * PROTOCOL_BYTES_PER_FRAME;
-			for (std::uint8_t j = 0; j < PROTOCOL_BYTES_PER_FRAME; j++)
-			{
-				std::uint32_t index = dataOffset + j;
-				if (index < session->get_message_length())
-				{
-					buffer[1 + j] = session->get_data().get_byte(index);
-				}
-				else
-				{
-					buffer[1 + j] = 0xFF;
-				}
-			}
+			std::size_t bytesCopied = session->get_data().copy_bytes(dataOffset, DataSpan<std::uint8_t>(buffer.data() + 1, PROTOCOL_BYTES_PER_FRAME));
+			std::fill(buffer.begin() + 1 + bytesCopied, buffer.end(), 0xFF);
 
 			if (sendCANFrameCallback(static_cast<std::uint32_t>(CANLibParameterGroupNumber::ExtendedTransportProtocolDataTransfer),
 			                         CANDataSpan(buffer.data(), buffer.size()),
@@ -648,7 +906,41 @@ namespace isobus
 		}
 		else if (session->get_dpo_number_of_packets_remaining() == 0)
 		{
-			session->set_state(StateMachineState::WaitForClearToSend);
+			if (0 != session->pendingClearToSendPacketNumber)
+			{
+				// The CTS for the next window arrived while we were sending this one
+				accept_clear_to_send(session, session->pendingClearToSendPacketCount, session->pendingClearToSendPacketNumber);
+				session->pendingClearToSendPacketNumber = 0;
+			}
+			else
+			{
+				session->set_state(StateMachineState::WaitForClearToSend);
+			}
+		}
+	}
+
+	void ExtendedTransportProtocolManager::accept_clear_to_send(const std::shared_ptr<ExtendedTransportProtocolSession> &session, std::uint8_t packetsToBeSent, std::uint32_t nextPacketNumber) const
+	{
+		// Only adaptive flow control goes back for packets the receiver asks for again, otherwise the next window continues where the last one ended
+		const bool retransmitRequested = configuration->get_extended_transport_protocol_adaptive_flow_control() &&
+		  ((nextPacketNumber - 1) < session->get_last_packet_number());
+		if (retransmitRequested)
+		{
+			// The receiver wants packets we already sent, so continue from where it asked
+			LOG_WARNING("[ETP]: Received a Clear To Send (CTS) message for 0x%05X requesting packets to be sent again, starting from packet %u", session->get_parameter_group_number(), nextPacketNumber);
+			session->set_sequence_number_offset(nextPacketNumber - 1);
+			session->set_last_sequency_number(0);
+		}
+		adapt_packet_pacing(session, retransmitRequested);
+
+		session->set_acknowledged_packet_number(nextPacketNumber - 1);
+		session->set_cts_number_of_packet_limit(packetsToBeSent);
+
+		// If 0 was sent as the packet number, they want us to wait.
+		// Just sit here in this state until we get a non-zero packet count
+		if (0 != packetsToBeSent)
+		{
+			session->set_state(StateMachineState::SendDataPacketOffset);
 		}
 	}
 
@@ -718,6 +1010,11 @@ namespace isobus
 			case StateMachineState::SendDataTransferPackets:
 			{
 				send_data_transfer_packets(session);
+				if (StateMachineState::SendDataPacketOffset == session->state)
+				{
+					// A pipelined CTS was waiting, so the next window can start in this same update
+					update_state_machine(session);
+				}
 			}
 			break;
 
@@ -726,8 +1023,17 @@ namespace isobus
 				if (session->get_time_since_last_update() > T1_TIMEOUT_MS)
 				{
 					LOG_ERROR("[ETP]: Timeout for destination-specific rx session (expected sequential data frame)");
+					if (configuration->get_extended_transport_protocol_adaptive_flow_control())
+					{
+						// Start the sender's next session with a smaller window, this one was too much for it or the bus
+						set_adaptive_initial_window(session->get_source(), std::max(static_cast<std::uint8_t>(session->get_cts_number_of_packet_limit() / 2), static_cast<std::uint8_t>(ADAPTIVE_MINIMUM_WINDOW)));
+					}
 					abort_session(session, ConnectionAbortReason::Timeout);
 				}
+				else if (session->get_time_since_last_update() > ADAPTIVE_STALL_TIME_MS)
+				{
+					session->dataStallObserved = true;
+				}
 			}
 			break;
 
@@ -789,13 +1095,45 @@ namespace isobus
 		                            CANIdentifier::CANPriority::PriorityLowest7);
 	}
 
+	void ExtendedTransportProtocolManager::prepare_receive_data(const std::shared_ptr<ExtendedTransportProtocolSession> &session) const
+	{
+		if (nullptr != receiveSinkCallback)
+		{
+			session->set_receive_sink(receiveSinkCallback(session->get_parameter_group_number(),
+			                                              session->get_message_length(),
+			                                              session->get_source(),
+			                                              session->get_destination(),
+			                                              receiveSinkParent));
+		}
+
+		if (nullptr == session->get_receive_sink())
+		{
+			// Without a sink, the message is reassembled into the session's own buffer
+			static_cast<CANMessageDataVector &>(session->get_data()).resize(session->get_message_length());
+		}
+	}
+
 	void ExtendedTransportProtocolManager::close_session(const std::shared_ptr<ExtendedTransportProtocolSession> &session, bool successful)
 	{
+		session->endTimestamp_ms = SystemTiming::get_timestamp_ms();
+		if (successful)
+		{
+			LOG_DEBUG("[ETP]: Session for 0x%05X transferred %u bytes with a goodput of %u bytes/s",
+			          session->get_parameter_group_number(),
+			          session->get_message_length(),
+			          session->get_goodput());
+
+			if (configuration->get_extended_transport_protocol_adaptive_flow_control() &&
+			    (ExtendedTransportProtocolSession::Direction::Receive == session->get_direction()))
+			{
+				set_adaptive_initial_window(session->get_source(), session->get_cts_number_of_packet_limit());
+			}
+		}
 		session->complete(successful);
-		auto sessionLocation = std::find(activeSessions.begin(), activeSessions.end(), session);
-		if (activeSessions.end() != sessionLocation)
+
+		LOCK_GUARD(Mutex, activeSessionsMutex);
+		if (activeSessions.erase(session))
 		{
-			activeSessions.erase(sessionLocation);
 			LOG_DEBUG("[ETP]: Session Closed");
 		}
 	}
@@ -821,12 +1159,13 @@ namespace isobus
 
 	bool ExtendedTransportProtocolManager::send_clear_to_send(const std::shared_ptr<ExtendedTransportProtocolSession> &session) const
 	{
-		std::uint32_t nextPacketNumber = session->get_last_packet_number() + 1;
+		std::uint32_t packetsStillExpected = session->get_dpo_number_of_packets_remaining();
+		std::uint32_t nextPacketNumber = session->get_last_packet_number() + packetsStillExpected + 1;
 		std::uint8_t packetLimit = session->get_cts_number_of_packet_limit();
 
-		if (packetLimit > session->get_number_of_remaining_packets())
+		if (packetLimit > (session->get_number_of_remaining_packets() - packetsStillExpected))
 		{
-			packetLimit = static_cast<std::uint8_t>(session->get_number_of_remaining_packets());
+			packetLimit = static_cast<std::uint8_t>(session->get_number_of_remaining_packets() - packetsStillExpected);
 		}
 
 		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer{
@@ -844,8 +1183,9 @@ namespace isobus
 		                                   std::static_pointer_cast<InternalControlFunction>(session->get_destination()), // Since we're the receiving side, we are the destination of the session
 		                                   session->get_source(),
 		                                   CANIdentifier::CANPriority::PriorityLowest7);
-		if (retVal)
+		if (retVal && (0 == packetsStillExpected))
 		{
+			// A pipelined CTS is acknowledged once the current window is complete
 			session->set_acknowledged_packet_number(session->get_last_packet_number());
 		}
 		return retVal;
@@ -863,7 +1203,8 @@ namespace isobus
 		{
 			packetsThisSegment = session->get_cts_number_of_packet_limit();
 		}
-		if (packetsThisSegment > configuration->get_number_of_packets_per_dpo_message())
+		if ((packetsThisSegment > configuration->get_number_of_packets_per_dpo_message()) &&
+		    (!configuration->get_extended_transport_protocol_adaptive_flow_control())) // With adaptive flow control, the receiver's CTS sets the pace
 		{
 			LOG_DEBUG("[TP]: Received Request To Send (RTS) with a CTS packet count of %hu, which is greater than the configured maximum of %hu, using the configured maximum instead.",
 			          packetsThisSegment,
@@ -920,22 +1261,26 @@ namespace isobus
 
 	bool ExtendedTransportProtocolManager::has_session(std::shared_ptr<ControlFunction> source, std::shared_ptr<ControlFunction> destination)
 	{
-		return std::any_of(activeSessions.begin(), activeSessions.end(), [&](const std::shared_ptr<ExtendedTransportProtocolSession> &session) {
-			return session->matches(source, destination);
-		});
+		LOCK_GUARD(Mutex, activeSessionsMutex);
+		return nullptr != activeSessions.find(source, destination);
 	}
 
 	std::shared_ptr<ExtendedTransportProtocolManager::ExtendedTransportProtocolSession> ExtendedTransportProtocolManager::get_session(std::shared_ptr<ControlFunction> source,
 	                                                                                                                                  std::shared_ptr<ControlFunction> destination)
 	{
-		auto result = std::find_if(activeSessions.begin(), activeSessions.end(), [&](const std::shared_ptr<ExtendedTransportProtocolSession> &session) {
-			return session->matches(source, destination);
-		});
-		return (activeSessions.end() != result) ? (*result) : nullptr;
+		LOCK_GUARD(Mutex, activeSessionsMutex);
+		return activeSessions.find(source, destination);
+	}
+
+	std::size_t ExtendedTransportProtocolManager::get_sessions_count() const
+	{
+		LOCK_GUARD(Mutex, activeSessionsMutex);
+		return activeSessions.size();
 	}
 
-	const std::vector<std::shared_ptr<ExtendedTransportProtocolManager::ExtendedTransportProtocolSession>> &ExtendedTransportProtocolManager::get_sessions() const
+	std::vector<std::shared_ptr<ExtendedTransportProtocolManager::ExtendedTransportProtocolSession>> ExtendedTransportProtocolManager::get_sessions() const
 	{
-		return activeSessions;
+		LOCK_GUARD(Mutex, activeSessionsMutex);
+		return activeSessions.get_sessions();
 	}
 }
@@ -10,9 +10,26 @@
 #include "isobus/isobus/can_message_data.hpp"
 
 #include <algorithm>
+#include <cstring>
 
 namespace isobus
 {
+	std::size_t CANMessageData::copy_bytes(std::size_t offset, DataSpan<std::uint8_t> destination)
+	{
+		std::size_t bytesToCopy = 0;
+
+		if (offset < size())
+		{
+			bytesToCopy = std::min(destination.size(), size() - offset);
+		}
+
+		for (std::size_t i = 0; i < bytesToCopy; i++)
+		{
+			destination[i] = get_byte(offset + i);
+		}
+		return bytesToCopy;
+	}
+
 	CANMessageDataVector::CANMessageDataVector(std::size_t size)
 	{
 		vector::resize(size);
@@ -38,6 +55,18 @@ namespace isobus
 		return vector::at(index);
 	}
 
+	std::size_t CANMessageDataVector::copy_bytes(std::size_t offset, DataSpan<std::uint8_t> destination)
+	{
+		std::size_t bytesToCopy = 0;
+
+		if (offset < vector::size())
+		{
+			bytesToCopy = std::min(destination.size(), vector::size() - offset);
+			std::memcpy(destination.begin(), vector::data() + offset, bytesToCopy);
+		}
+		return bytesToCopy;
+	}
+
 	void CANMessageDataVector::set_byte(std::size_t index, std::uint8_t value)
 	{
 		vector::at(index) = value;
@@ -69,6 +98,18 @@ namespace isobus
 		return DataSpan::operator[](index);
 	}
 
+	std::size_t CANMessageDataView::copy_bytes(std::size_t offset, DataSpan<std::uint8_t> destination)
+	{
+		std::size_t bytesToCopy = 0;
+
+		if (offset < DataSpan::size())
+		{
+			bytesToCopy = std::min(destination.size(), DataSpan::size() - offset);
+			std::memcpy(destination.begin(), DataSpan::begin() + offset, bytesToCopy);
+		}
+		return bytesToCopy;
+	}
+
 	CANDataSpan CANMessageDataView::data() const
 	{
 		return CANDataSpan(DataSpan::begin(), DataSpan::size());
@@ -113,6 +154,35 @@ namespace isobus
 		return buffer[index - dataOffset];
 	}
 
+	std::size_t CANMessageDataCallback::copy_bytes(std::size_t offset, DataSpan<std::uint8_t> destination)
+	{
+		std::size_t bytesCopied = 0;
+		std::size_t bytesToCopy = 0;
+
+		if (offset < totalSize)
+		{
+			bytesToCopy = std::min(destination.size(), totalSize - offset);
+		}
+
+		while (bytesCopied < bytesToCopy)
+		{
+			const std::size_t index = offset + bytesCopied;
+
+			if ((index >= dataOffset + bufferSize) || (index < dataOffset) || (!initialized))
+			{
+				initialized = true;
+				dataOffset = index;
+				callback(0, dataOffset, std::min(totalSize - dataOffset, bufferSize), buffer.data(), parentPointer);
+			}
+
+			// Copy as much of the current chunk as we can in one go
+			const std::size_t bytesFromChunk = std::min(bytesToCopy - bytesCopied, dataOffset + bufferSize - index);
+			std::memcpy(destination.begin() + bytesCopied, buffer.data() + (index - dataOffset), bytesFromChunk);
+			bytesCopied += bytesFromChunk;
+		}
+		return bytesCopied;
+	}
+
 	std::unique_ptr<CANMessageData> CANMessageDataCallback::copy_if_not_owned(std::unique_ptr<CANMessageData> self) const
 	{
 		// A callback doesn't own it's data, but it does own the callback function, so we can just return itself.
@@ -0,0 +1,194 @@
+//================================================================================================
+/// @file can_message_pool.cpp
+///
+/// @brief A fixed capacity pool of CAN messages used by the network manager to avoid
+/// heap allocations when processing single frame messages.
+/// @author Adrian Del Grosso
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+
+#include "isobus/isobus/can_message_pool.hpp"
+
+#include <functional>
+
+namespace isobus
+{
+	bool CANMessagePool::resize(std::size_t capacity)
+	{
+		LOCK_GUARD(Mutex, poolMutex);
+		bool retVal = false;
+
+		if (freeMessages.size() == storage.size())
+		{
+			freeMessages.clear();
+			storage.clear();
+			storage.shrink_to_fit();
+			storage.reserve(capacity);
+			freeMessages.reserve(capacity);
+
+			for (std::size_t i = 0; i < capacity; i++)
+			{
+				storage.emplace_back(CANMessage::Type::Receive, CANIdentifier(DEFAULT_IDENTIFIER), nullptr, 0, nullptr, nullptr, 0);
+				storage.back().data.reserve(CAN_DATA_LENGTH);
+			}
+			for (auto &message : storage)
+			{
+				freeMessages.push_back(&message);
+			}
+			highWaterMark = 0;
+			overflowCount = 0;
+			retVal = true;
+		}
+		return retVal;
+	}
+
+	CANMessage *CANMessagePool::acquire(CANMessage::Type type,
+	                                    const CANIdentifier &identifier,
+	                                    const std::uint8_t *dataBuffer,
+	                                    std::uint32_t length,
+	                                    std::shared_ptr<ControlFunction> source,
+	                                    std::shared_ptr<ControlFunction> destination,
+	                                    std::uint8_t CANPort)
+	{
+		CANMessage *retVal = nullptr;
+		{
+			LOCK_GUARD(Mutex, poolMutex);
+			if (!freeMessages.empty())
+			{
+				retVal = freeMessages.back();
+				freeMessages.pop_back();
+
+				const std::size_t numberInUse = storage.size() - freeMessages.size();
+				if (numberInUse > highWaterMark)
+				{
+					highWaterMark = numberInUse;
+				}
+			}
+			else
+			{
+				overflowCount++;
+			}
+		}
+
+		if (nullptr != retVal)
+		{
+			retVal->messageType = type;
+			retVal->identifier = identifier;
+			retVal->data.assign(dataBuffer, dataBuffer + length);
+			retVal->source = std::move(source);
+			retVal->destination = std::move(destination);
+			retVal->CANPortIndex = CANPort;
+		}
+		else
+		{
+			retVal = new CANMessage(type, identifier, dataBuffer, length, std::move(source), std::move(destination), CANPort);
+		}
+		return retVal;
+	}
+
+	void CANMessagePool::release(CANMessage *message)
+	{
+		if (nullptr != message)
+		{
+			if (owns(message))
+			{
+				// Drop our references to the control functions so the pool doesn't keep them alive
+				message->source.reset();
+				message->destination.reset();
+				message->data.clear();
+
+				LOCK_GUARD(Mutex, poolMutex);
+				freeMessages.push_back(message);
+			}
+			else
+			{
+				delete message;
+			}
+		}
+	}
+
+	std::size_t CANMessagePool::get_capacity() const
+	{
+		LOCK_GUARD(Mutex, poolMutex);
+		return storage.size();
+	}
+
+	std::size_t CANMessagePool::get_number_in_use() const
+	{
+		LOCK_GUARD(Mutex, poolMutex);
+		return storage.size() - freeMessages.size();
+	}
+
+	std::size_t CANMessagePool::get_high_water_mark() const
+	{
+		LOCK_GUARD(Mutex, poolMutex);
+		return highWaterMark;
+	}
+
+	std::size_t CANMessagePool::get_overflow_count() const
+	{
+		LOCK_GUARD(Mutex, poolMutex);
+		return overflowCount;
+	}
+
+	void CANMessagePool::reset_statistics()
+	{
+		LOCK_GUARD(Mutex, poolMutex);
+		highWaterMark = storage.size() - freeMessages.size();
+		overflowCount = 0;
+	}
+
+	bool CANMessagePool::owns(const CANMessage *message) const
+	{
+		// std::less gives a total order on pointers, even for pointers that are not part of the same array
+		return (!storage.empty()) &&
+		  (!std::less<const CANMessage *>()(message, storage.data())) &&
+		  std::less<const CANMessage *>()(message, storage.data() + storage.size());
+	}
+
+	CANMessageQueue::CANMessageQueue(std::size_t initialCapacity) :
+	  ring((0 != initialCapacity) ? initialCapacity : 1, nullptr)
+	{
+	}
+
+	void CANMessageQueue::push(CANMessage *message)
+	{
+		LOCK_GUARD(Mutex, queueMutex);
+		if (count == ring.size())
+		{
+			// Grow by unrolling the ring into a bigger buffer, this only happens until the queue reaches its working size
+			std::vector<CANMessage *> biggerRing(ring.size() * 2, nullptr);
+			for (std::size_t i = 0; i < count; i++)
+			{
+				biggerRing[i] = ring[(head + i) % ring.size()];
+			}
+			ring.swap(biggerRing);
+			head = 0;
+		}
+		ring[(head + count) % ring.size()] = message;
+		count++;
+	}
+
+	bool CANMessageQueue::pop(CANMessage **message)
+	{
+		LOCK_GUARD(Mutex, queueMutex);
+		bool retVal = false;
+
+		if (0 != count)
+		{
+			*message = ring[head];
+			ring[head] = nullptr;
+			head = (head + 1) % ring.size();
+			count--;
+			retVal = true;
+		}
+		return retVal;
+	}
+
+	std::size_t CANMessageQueue::size() const
+	{
+		LOCK_GUARD(Mutex, queueMutex);
+		return count;
+	}
+} // namespace isobus
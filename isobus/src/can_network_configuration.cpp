@@ -9,6 +9,8 @@
 
 #include "isobus/isobus/can_network_configuration.hpp"
 
+#include <algorithm>
+
 namespace isobus
 {
 	void CANNetworkConfiguration::set_max_number_transport_protocol_sessions(std::uint32_t value)
@@ -67,4 +69,56 @@ namespace isobus
 	{
 		return numberOfPacketsPerCTSMessage;
 	}
+
+	void CANNetworkConfiguration::set_max_number_transport_protocol_transmit_sessions_per_source(std::uint32_t value)
+	{
+		maxNumberTransportProtocolTransmitSessionsPerSource = value;
+	}
+
+	std::uint32_t CANNetworkConfiguration::get_max_number_transport_protocol_transmit_sessions_per_source() const
+	{
+		return maxNumberTransportProtocolTransmitSessionsPerSource;
+	}
+
+	void CANNetworkConfiguration::set_message_pool_capacity(std::uint32_t numberMessages)
+	{
+		messagePoolCapacity = numberMessages;
+	}
+
+	std::uint32_t CANNetworkConfiguration::get_message_pool_capacity() const
+	{
+		return messagePoolCapacity;
+	}
+
+	void CANNetworkConfiguration::set_extended_transport_protocol_adaptive_flow_control(bool enabled)
+	{
+		extendedTransportProtocolAdaptiveFlowControl = enabled;
+	}
+
+	bool CANNetworkConfiguration::get_extended_transport_protocol_adaptive_flow_control() const
+	{
+		return extendedTransportProtocolAdaptiveFlowControl;
+	}
+
+	void CANNetworkConfiguration::add_extended_transport_protocol_pipelining_partner(NAME partnerNAME)
+	{
+		if (!get_extended_transport_protocol_pipelining(partnerNAME))
+		{
+			extendedTransportProtocolPipeliningPartners.push_back(partnerNAME);
+		}
+	}
+
+	void CANNetworkConfiguration::remove_extended_transport_protocol_pipelining_partner(NAME partnerNAME)
+	{
+		auto partner = std::find(extendedTransportProtocolPipeliningPartners.begin(), extendedTransportProtocolPipeliningPartners.end(), partnerNAME);
+		if (extendedTransportProtocolPipeliningPartners.end() != partner)
+		{
+			extendedTransportProtocolPipeliningPartners.erase(partner);
+		}
+	}
+
+	bool CANNetworkConfiguration::get_extended_transport_protocol_pipelining(NAME partnerNAME) const
+	{
+		return extendedTransportProtocolPipeliningPartners.end() != std::find(extendedTransportProtocolPipeliningPartners.begin(), extendedTransportProtocolPipeliningPartners.end(), partnerNAME);
+	}
 }
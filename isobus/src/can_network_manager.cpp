@@ -23,6 +23,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <limits>
 #include <numeric>
 
 namespace isobus
@@ -31,9 +32,21 @@ namespace isobus
 
 	void CANNetworkManager::initialize()
 	{
-		// Clear queues
-		receivedMessageQueue.clear();
-		transmittedMessageQueue.clear();
+		// Clear queues, returning their messages to the pool
+		CANMessage *message = nullptr;
+		while (receivedMessageQueue.pop(&message))
+		{
+			messagePool.release(message);
+		}
+		while (transmittedMessageQueue.pop(&message))
+		{
+			messagePool.release(message);
+		}
+
+		if (messagePool.get_capacity() != configuration.get_message_pool_capacity())
+		{
+			messagePool.resize(configuration.get_message_pool_capacity());
+		}
 		initialized = true;
 	}
 
@@ -52,6 +65,11 @@ namespace isobus
 		LOCK_GUARD(Mutex, controlFunctionsMutex);
 		auto controlFunction = std::make_shared<PartneredControlFunction>(CANPort, NAMEFilters);
 		partneredControlFunctions.push_back(controlFunction);
+		newPartneredControlFunctions.push_back(controlFunction);
+		if (CANPort < CAN_PORT_MAXIMUM)
+		{
+			unboundPartneredControlFunctions[CANPort].push_back(controlFunction);
+		}
 		return controlFunction;
 	}
 
@@ -69,40 +87,46 @@ namespace isobus
 	{
 		LOCK_GUARD(Mutex, controlFunctionsMutex);
 		partneredControlFunctions.erase(std::remove(partneredControlFunctions.begin(), partneredControlFunctions.end(), controlFunction), partneredControlFunctions.end());
+		newPartneredControlFunctions.erase(std::remove(newPartneredControlFunctions.begin(), newPartneredControlFunctions.end(), controlFunction), newPartneredControlFunctions.end());
+		remove_unbound_partner(controlFunction);
 		deactivate_control_function(std::static_pointer_cast<ControlFunction>(controlFunction));
 	}
 
 	void CANNetworkManager::add_global_parameter_group_number_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parent)
 	{
-		LOCK_GUARD(Mutex, globalPGNCallbacksMutex);
-		globalParameterGroupNumberCallbacks.emplace_back(parameterGroupNumber, callback, parent, nullptr);
+		globalParameterGroupNumberCallbacks.add_callback(ParameterGroupNumberCallbackData(parameterGroupNumber, callback, parent, nullptr), true);
 	}
 
 	void CANNetworkManager::remove_global_parameter_group_number_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parent)
 	{
-		LOCK_GUARD(Mutex, globalPGNCallbacksMutex);
-		ParameterGroupNumberCallbackData tempObject(parameterGroupNumber, callback, parent, nullptr);
-		auto callbackLocation = std::find(globalParameterGroupNumberCallbacks.begin(), globalParameterGroupNumberCallbacks.end(), tempObject);
-		if (globalParameterGroupNumberCallbacks.end() != callbackLocation)
-		{
-			globalParameterGroupNumberCallbacks.erase(callbackLocation);
-		}
+		globalParameterGroupNumberCallbacks.remove_callback(ParameterGroupNumberCallbackData(parameterGroupNumber, callback, parent, nullptr));
 	}
 
 	void CANNetworkManager::add_any_control_function_parameter_group_number_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parent)
 	{
-		LOCK_GUARD(Mutex, anyControlFunctionCallbacksMutex);
-		anyControlFunctionParameterGroupNumberCallbacks.emplace_back(parameterGroupNumber, callback, parent, nullptr);
+		anyControlFunctionParameterGroupNumberCallbacks.add_callback(ParameterGroupNumberCallbackData(parameterGroupNumber, callback, parent, nullptr), true);
 	}
 
 	void CANNetworkManager::remove_any_control_function_parameter_group_number_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parent)
 	{
-		ParameterGroupNumberCallbackData tempObject(parameterGroupNumber, callback, parent, nullptr);
-		LOCK_GUARD(Mutex, anyControlFunctionCallbacksMutex);
-		auto callbackLocation = std::find(anyControlFunctionParameterGroupNumberCallbacks.begin(), anyControlFunctionParameterGroupNumberCallbacks.end(), tempObject);
-		if (anyControlFunctionParameterGroupNumberCallbacks.end() != callbackLocation)
+		anyControlFunctionParameterGroupNumberCallbacks.remove_callback(ParameterGroupNumberCallbackData(parameterGroupNumber, callback, parent, nullptr));
+	}
+
+	void CANNetworkManager::add_receive_sink_callback(std::uint32_t parameterGroupNumber, ReceiveSinkCallback callback, void *parent)
+	{
+		LOCK_GUARD(Mutex, receiveSinkCallbacksMutex);
+		receiveSinkCallbacks.push_back({ parameterGroupNumber, callback, parent });
+	}
+
+	void CANNetworkManager::remove_receive_sink_callback(std::uint32_t parameterGroupNumber, ReceiveSinkCallback callback, void *parent)
+	{
+		LOCK_GUARD(Mutex, receiveSinkCallbacksMutex);
+		auto callbackLocation = std::find_if(receiveSinkCallbacks.begin(), receiveSinkCallbacks.end(), [&](const ReceiveSinkCallbackData &data) {
+			return (data.parameterGroupNumber == parameterGroupNumber) && (data.callback == callback) && (data.parent == parent);
+		});
+		if (receiveSinkCallbacks.end() != callbackLocation)
 		{
-			anyControlFunctionParameterGroupNumberCallbacks.erase(callbackLocation);
+			receiveSinkCallbacks.erase(callbackLocation);
 		}
 	}
 
@@ -144,6 +168,22 @@ namespace isobus
 #endif
 	}
 
+	std::uint32_t CANNetworkManager::get_time_until_next_transport_protocol_update() const
+	{
+		std::uint32_t retVal = std::numeric_limits<std::uint32_t>::max();
+
+		for (std::uint32_t i = 0; i < CAN_PORT_MAXIMUM; i++)
+		{
+			if (nullptr != transportProtocols[i])
+			{
+				retVal = std::min(retVal, transportProtocols[i]->get_time_until_next_update());
+				retVal = std::min(retVal, extendedTransportProtocols[i]->get_time_until_next_update());
+				retVal = std::min(retVal, fastPacketProtocol[i]->get_time_until_next_update());
+			}
+		}
+		return retVal;
+	}
+
 	bool CANNetworkManager::send_can_message(std::uint32_t parameterGroupNumber,
 	                                         const std::uint8_t *dataBuffer,
 	                                         std::uint32_t dataLength,
@@ -247,6 +287,10 @@ namespace isobus
 		for (std::uint32_t i = 0; i < CAN_PORT_MAXIMUM; i++)
 		{
 			transportProtocols[i]->update();
+			if (configuration.get_extended_transport_protocol_adaptive_flow_control())
+			{
+				extendedTransportProtocols[i]->set_estimated_busload(get_estimated_busload(static_cast<std::uint8_t>(i)));
+			}
 			extendedTransportProtocols[i]->update();
 			fastPacketProtocol[i]->update();
 		}
@@ -284,21 +328,18 @@ namespace isobus
 	void CANNetworkManager::process_receive_can_message_frame(const CANMessageFrame &rxFrame)
 	{
 		update_control_functions(rxFrame);
-
-		CANIdentifier identifier(rxFrame.identifier);
-		auto message = std::make_shared<CANMessage>(CANMessage::Type::Receive,
-		                                            identifier,
-		                                            rxFrame.data,
-		                                            rxFrame.dataLength,
-		                                            get_control_function(rxFrame.channel, identifier.get_source_address()),
-		                                            get_control_function(rxFrame.channel, identifier.get_destination_address()),
-		                                            rxFrame.channel);
-
 		update_busload(rxFrame.channel, rxFrame.get_number_bits_in_message());
 
 		if (initialized)
 		{
-			receivedMessageQueue.push(std::move(message));
+			CANIdentifier identifier(rxFrame.identifier);
+			receivedMessageQueue.push(messagePool.acquire(CANMessage::Type::Receive,
+			                                              identifier,
+			                                              rxFrame.data,
+			                                              rxFrame.dataLength,
+			                                              get_control_function(rxFrame.channel, identifier.get_source_address()),
+			                                              get_control_function(rxFrame.channel, identifier.get_destination_address()),
+			                                              rxFrame.channel));
 		}
 	}
 
@@ -306,20 +347,18 @@ namespace isobus
 	{
 		update_busload(txFrame.channel, txFrame.get_number_bits_in_message());
 
-		CANIdentifier identifier(txFrame.identifier);
-		auto message = std::make_shared<CANMessage>(CANMessage::Type::Transmit,
-		                                            identifier,
-		                                            txFrame.data,
-		                                            txFrame.dataLength,
-		                                            get_control_function(txFrame.channel, identifier.get_source_address()),
-		                                            get_control_function(txFrame.channel, identifier.get_destination_address()),
-		                                            txFrame.channel);
-
 		if (initialized)
 		{
-			{
-				transmittedMessageQueue.push(message);
-			}
+			CANIdentifier identifier(txFrame.identifier);
+			auto sourceControlFunction = get_control_function(txFrame.channel, identifier.get_source_address());
+			auto destinationControlFunction = get_control_function(txFrame.channel, identifier.get_destination_address());
+			CANMessage *message = messagePool.acquire(CANMessage::Type::Transmit,
+			                                          identifier,
+			                                          txFrame.data,
+			                                          txFrame.dataLength,
+			                                          sourceControlFunction,
+			                                          destinationControlFunction,
+			                                          txFrame.channel);
 
 			// We need to receive manual requests for the address claim PGN.
 			if ((CANIdentifier::Type::Extended == message->get_identifier().get_identifier_type()) &&
@@ -327,14 +366,22 @@ namespace isobus
 			    (3 == message->get_data_length()) &&
 			    (static_cast<std::uint32_t>(CANLibParameterGroupNumber::AddressClaim) == message->get_data_custom_length(0, 24)))
 			{
-				receivedMessageQueue.push(std::move(message));
+				receivedMessageQueue.push(messagePool.acquire(CANMessage::Type::Transmit,
+				                                              identifier,
+				                                              txFrame.data,
+				                                              txFrame.dataLength,
+				                                              sourceControlFunction,
+				                                              destinationControlFunction,
+				                                              txFrame.channel));
 			}
+			transmittedMessageQueue.push(message);
 		}
 	}
 
 	void CANNetworkManager::deactivate_control_function(std::shared_ptr<ControlFunction> controlFunction)
 	{
 		inactiveControlFunctions.remove(controlFunction);
+		controlFunction->inInactiveList = false;
 
 		const auto channelIndex = controlFunction->get_can_port();
 		for (std::uint8_t address = 0; address < NULL_CAN_ADDRESS; address++)
@@ -432,7 +479,10 @@ namespace isobus
 			retVal.insert(retVal.end(), std::make_move_iterator(sessions.begin()), std::make_move_iterator(sessions.end()));
 		}
 
-		retVal.insert(retVal.end(), extendedTransportProtocols[canPortIndex]->get_sessions().begin(), extendedTransportProtocols[canPortIndex]->get_sessions().end());
+		{
+			auto sessions = extendedTransportProtocols[canPortIndex]->get_sessions();
+			retVal.insert(retVal.end(), std::make_move_iterator(sessions.begin()), std::make_move_iterator(sessions.end()));
+		}
 		return retVal;
 	}
 
@@ -452,6 +502,11 @@ namespace isobus
 		return configuration;
 	}
 
+	const CANMessagePool &CANNetworkManager::get_message_pool() const
+	{
+		return messagePool;
+	}
+
 	EventDispatcher<std::shared_ptr<InternalControlFunction>> &CANNetworkManager::get_address_violation_event_dispatcher()
 	{
 		return addressViolationEventDispatcher;
@@ -482,12 +537,10 @@ namespace isobus
 	bool CANNetworkManager::add_protocol_parameter_group_number_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parentPointer)
 	{
 		bool retVal = false;
-		ParameterGroupNumberCallbackData callbackInfo(parameterGroupNumber, callback, parentPointer, nullptr);
-		LOCK_GUARD(Mutex, protocolPGNCallbacksMutex);
-		if ((nullptr != callback) && (protocolPGNCallbacks.end() == find(protocolPGNCallbacks.begin(), protocolPGNCallbacks.end(), callbackInfo)))
+
+		if (nullptr != callback)
 		{
-			protocolPGNCallbacks.push_back(callbackInfo);
-			retVal = true;
+			retVal = protocolPGNCallbacks.add_callback(ParameterGroupNumberCallbackData(parameterGroupNumber, callback, parentPointer, nullptr), false);
 		}
 		return retVal;
 	}
@@ -495,18 +548,10 @@ namespace isobus
 	bool CANNetworkManager::remove_protocol_parameter_group_number_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parentPointer)
 	{
 		bool retVal = false;
-		ParameterGroupNumberCallbackData callbackInfo(parameterGroupNumber, callback, parentPointer, nullptr);
-		LOCK_GUARD(Mutex, protocolPGNCallbacksMutex);
+
 		if (nullptr != callback)
 		{
-			std::list<ParameterGroupNumberCallbackData>::iterator callbackLocation;
-			callbackLocation = find(protocolPGNCallbacks.begin(), protocolPGNCallbacks.end(), callbackInfo);
-
-			if (protocolPGNCallbacks.end() != callbackLocation)
-			{
-				protocolPGNCallbacks.erase(callbackLocation);
-				retVal = true;
-			}
+			retVal = protocolPGNCallbacks.remove_callback(ParameterGroupNumberCallbackData(parameterGroupNumber, callback, parentPointer, nullptr));
 		}
 		return retVal;
 	}
@@ -525,18 +570,13 @@ namespace isobus
 
 		for (std::uint8_t i = 0; i < CAN_PORT_MAXIMUM; i++)
 		{
-			auto receive_message_callback = [this, i](const CANMessage &message) {
-				// TODO: hack port_index for now, once network manager isn't a singleton, this can be removed
-				CANMessage tempMessage(CANMessage::Type::Receive,
-				                       message.get_identifier(),
-				                       message.get_data(),
-				                       message.get_source_control_function(),
-				                       message.get_destination_control_function(),
-				                       i);
+			auto receive_message_callback = [this](const CANMessage &message) {
 				this->protocol_message_callback(message);
 			};
 			transportProtocols.at(i).reset(new TransportProtocolManager(send_frame_callback, receive_message_callback, &configuration));
+			transportProtocols.at(i)->set_receive_sink_callback(get_receive_sink, this);
 			extendedTransportProtocols.at(i).reset(new ExtendedTransportProtocolManager(send_frame_callback, receive_message_callback, &configuration));
+			extendedTransportProtocols.at(i)->set_receive_sink_callback(get_receive_sink, this);
 			fastPacketProtocol.at(i).reset(new FastPacketProtocol(send_frame_callback));
 			heartBeatInterfaces.at(i).reset(new HeartbeatInterface(send_frame_callback));
 		}
@@ -548,10 +588,63 @@ namespace isobus
 		if ((CANPort < CAN_PORT_MAXIMUM) && (address < NULL_CAN_ADDRESS))
 		{
 			controlFunctionTable[CANPort][address] = controlFunction;
+			controlFunctionNAMEIndex[CANPort][desiredName.get_full_name()] = controlFunction;
 		}
 		return controlFunction;
 	}
 
+	std::shared_ptr<ControlFunction> CANNetworkManager::find_control_function_by_NAME(std::uint8_t channelIndex, std::uint64_t NAMEValue)
+	{
+		std::shared_ptr<ControlFunction> retVal = nullptr;
+		auto &NAMEIndex = controlFunctionNAMEIndex[channelIndex];
+		auto indexEntry = NAMEIndex.find(NAMEValue);
+
+		if (NAMEIndex.end() != indexEntry)
+		{
+			retVal = indexEntry->second.lock();
+
+			if (!get_is_indexed_control_function_valid(retVal, channelIndex, NAMEValue))
+			{
+				retVal = nullptr;
+				NAMEIndex.erase(indexEntry);
+			}
+		}
+		return retVal;
+	}
+
+	bool CANNetworkManager::get_is_indexed_control_function_valid(const std::shared_ptr<ControlFunction> &controlFunction, std::uint8_t channelIndex, std::uint64_t NAMEValue) const
+	{
+		bool retVal = false;
+
+		if ((nullptr != controlFunction) &&
+		    (controlFunction->get_can_port() == channelIndex) &&
+		    (controlFunction->get_NAME().get_full_name() == NAMEValue))
+		{
+			const std::uint8_t address = controlFunction->get_address();
+			retVal = controlFunction->inInactiveList ||
+			  ((address < NULL_CAN_ADDRESS) && (controlFunctionTable[channelIndex][address] == controlFunction));
+		}
+		return retVal;
+	}
+
+	void CANNetworkManager::add_inactive_control_function(std::shared_ptr<ControlFunction> controlFunction)
+	{
+		if (!controlFunction->inInactiveList)
+		{
+			controlFunction->inInactiveList = true;
+			inactiveControlFunctions.push_back(std::move(controlFunction));
+		}
+	}
+
+	void CANNetworkManager::remove_unbound_partner(const std::shared_ptr<PartneredControlFunction> &partner)
+	{
+		if (partner->get_can_port() < CAN_PORT_MAXIMUM)
+		{
+			auto &unboundPartners = unboundPartneredControlFunctions[partner->get_can_port()];
+			unboundPartners.erase(std::remove(unboundPartners.begin(), unboundPartners.end(), partner), unboundPartners.end());
+		}
+	}
+
 	void CANNetworkManager::update_address_table(const CANMessage &message)
 	{
 		std::uint8_t channelIndex = message.get_can_port_index();
@@ -568,7 +661,7 @@ namespace isobus
 				// Someone is at that spot in the table, but their address was stolen
 				// Need to evict them from the table and move them to the inactive list
 				targetControlFunction->address = NULL_CAN_ADDRESS;
-				inactiveControlFunctions.push_back(targetControlFunction);
+				add_inactive_control_function(targetControlFunction);
 				LOG_INFO("[NM]: %s CF '%016llx' is evicted from address '%d' on channel '%d', as their address is probably stolen.",
 				         targetControlFunction->get_type_string().c_str(),
 				         targetControlFunction->get_NAME().get_full_name(),
@@ -583,16 +676,20 @@ namespace isobus
 			}
 			else
 			{
-				// Look through all inactive CFs, maybe one of them has freshly claimed the address
-				const auto result = std::find_if(inactiveControlFunctions.cbegin(),
-				                                 inactiveControlFunctions.cend(),
-				                                 [claimedAddress, channelIndex](const std::shared_ptr<ControlFunction> &cf) {
-					                                 return (cf != nullptr) && (cf->get_address() == claimedAddress) && (cf->get_can_port() == channelIndex);
-				                                 });
+				// Maybe an inactive CF has freshly claimed the address, the claim tells us which NAME to look for
+				std::shared_ptr<ControlFunction> claimingControlFunction = nullptr;
+				if (CAN_DATA_LENGTH == message.get_data_length())
+				{
+					claimingControlFunction = find_control_function_by_NAME(channelIndex, message.get_uint64_at(0));
+				}
 
-				if (result != inactiveControlFunctions.end())
+				if ((nullptr != claimingControlFunction) &&
+				    (claimingControlFunction->inInactiveList) &&
+				    (claimingControlFunction->get_address() == claimedAddress))
 				{
-					targetControlFunction = *result;
+					inactiveControlFunctions.remove(claimingControlFunction);
+					claimingControlFunction->inInactiveList = false;
+					targetControlFunction = claimingControlFunction;
 
 					LOG_DEBUG("[NM]: %s CF '%016llx' is now active at address '%d' on channel '%d'.",
 					          targetControlFunction->get_type_string().c_str(),
@@ -660,6 +757,7 @@ namespace isobus
 
 				// ECU has claimed since the last update, add it to the table
 				targetControlFunction = currentInternalControlFunction;
+				controlFunctionNAMEIndex[channelIndex][currentInternalControlFunction->get_NAME().get_full_name()] = currentInternalControlFunction;
 			}
 		}
 	}
@@ -724,40 +822,22 @@ namespace isobus
 			claimedNAME |= (static_cast<std::uint64_t>(rxFrame.data[7]) << 56);
 
 			// Check if the claimed NAME is someone we already know about
-			auto activeResult = std::find_if(controlFunctionTable[rxFrame.channel].begin(),
-			                                 controlFunctionTable[rxFrame.channel].end(),
-			                                 [claimedNAME](const std::shared_ptr<ControlFunction> &cf) {
-				                                 return (nullptr != cf) && (cf->get_NAME().get_full_name() == claimedNAME);
-			                                 });
-			if (activeResult != controlFunctionTable[rxFrame.channel].end())
-			{
-				foundControlFunction = *activeResult;
-			}
-			else
-			{
-				auto inActiveResult = std::find_if(inactiveControlFunctions.begin(),
-				                                   inactiveControlFunctions.end(),
-				                                   [claimedNAME, &rxFrame](const std::shared_ptr<ControlFunction> &cf) {
-					                                   return (cf->get_NAME().get_full_name() == claimedNAME) && (cf->get_can_port() == rxFrame.channel);
-				                                   });
-				if (inActiveResult != inactiveControlFunctions.end())
-				{
-					foundControlFunction = *inActiveResult;
-				}
-			}
+			foundControlFunction = find_control_function_by_NAME(rxFrame.channel, claimedNAME);
 
 			if (nullptr == foundControlFunction)
 			{
-				// If we still haven't found it, it might be a partner. Check the list of partners.
-				for (const auto &partner : partneredControlFunctions)
+				// If we still haven't found it, it might be a partner. Check the partners that haven't found their NAME yet.
+				auto &unboundPartners = unboundPartneredControlFunctions[rxFrame.channel];
+				for (auto partner = unboundPartners.begin(); partner != unboundPartners.end(); partner++)
 				{
-					if ((partner->get_can_port() == rxFrame.channel) &&
-					    (partner->check_matches_name(NAME(claimedNAME))) &&
-					    (0 == partner->get_NAME().get_full_name()))
+					if ((*partner)->check_matches_name(NAME(claimedNAME)) &&
+					    (0 == (*partner)->get_NAME().get_full_name()))
 					{
-						partner->controlFunctionNAME = NAME(claimedNAME);
-						foundControlFunction = partner;
+						(*partner)->controlFunctionNAME = NAME(claimedNAME);
+						foundControlFunction = *partner;
 						controlFunctionTable[rxFrame.channel][claimedAddress] = foundControlFunction;
+						controlFunctionNAMEIndex[rxFrame.channel][claimedNAME] = foundControlFunction;
+						unboundPartners.erase(partner);
 						break;
 					}
 				}
@@ -869,7 +949,8 @@ namespace isobus
 	void CANNetworkManager::update_new_partners()
 	{
 		LOCK_GUARD(Mutex, controlFunctionsMutex);
-		for (const auto &partner : partneredControlFunctions)
+		// Only partners created since the last update need to be matched against the known control functions
+		for (const auto &partner : newPartneredControlFunctions)
 		{
 			if (!partner->initialized)
 			{
@@ -880,6 +961,7 @@ namespace isobus
 					    (partner->get_can_port() == (*currentInactiveControlFunction)->get_can_port()) &&
 					    (ControlFunction::Type::External == (*currentInactiveControlFunction)->get_type()))
 					{
+						(*currentInactiveControlFunction)->inInactiveList = false;
 						inactiveControlFunctions.erase(currentInactiveControlFunction);
 						break;
 					}
@@ -897,6 +979,8 @@ namespace isobus
 						partner->controlFunctionNAME = currentActiveControlFunction->get_NAME();
 						partner->initialized = true;
 						controlFunctionTable[partner->get_can_port()][partner->address] = std::shared_ptr<ControlFunction>(partner);
+						controlFunctionNAMEIndex[partner->get_can_port()][partner->get_NAME().get_full_name()] = partner;
+						remove_unbound_partner(partner);
 						process_control_function_state_change_callback(partner, ControlFunctionState::Online);
 
 						LOG_INFO("[NM]: A partner with name %016llx has claimed address %u on channel %u.",
@@ -909,6 +993,7 @@ namespace isobus
 				partner->initialized = true;
 			}
 		}
+		newPartneredControlFunctions.clear();
 	}
 
 	CANMessageFrame CANNetworkManager::construct_frame(std::uint32_t portIndex,
@@ -984,15 +1069,10 @@ namespace isobus
 
 	void CANNetworkManager::process_any_control_function_pgn_callbacks(const CANMessage &currentMessage)
 	{
-		LOCK_GUARD(Mutex, anyControlFunctionCallbacksMutex);
-		for (const auto &currentCallback : anyControlFunctionParameterGroupNumberCallbacks)
+		if ((nullptr == currentMessage.get_destination_control_function()) ||
+		    (ControlFunction::Type::Internal == currentMessage.get_destination_control_function()->get_type()))
 		{
-			if ((currentCallback.get_parameter_group_number() == currentMessage.get_identifier().get_parameter_group_number()) &&
-			    ((nullptr == currentMessage.get_destination_control_function()) ||
-			     (ControlFunction::Type::Internal == currentMessage.get_destination_control_function()->get_type())))
-			{
-				currentCallback.get_callback()(currentMessage, currentCallback.get_parent());
-			}
+			anyControlFunctionParameterGroupNumberCallbacks.dispatch(currentMessage);
 		}
 	}
 
@@ -1019,14 +1099,38 @@ namespace isobus
 
 	void CANNetworkManager::process_protocol_pgn_callbacks(const CANMessage &currentMessage)
 	{
-		LOCK_GUARD(Mutex, protocolPGNCallbacksMutex);
-		for (const auto &currentCallback : protocolPGNCallbacks)
+		protocolPGNCallbacks.dispatch(currentMessage);
+	}
+
+	std::unique_ptr<CANMessageReceiveSink> CANNetworkManager::get_receive_sink(std::uint32_t parameterGroupNumber,
+	                                                                           std::uint32_t totalMessageSize,
+	                                                                           std::shared_ptr<ControlFunction> source,
+	                                                                           std::shared_ptr<ControlFunction> destination,
+	                                                                           void *parent)
+	{
+		return static_cast<CANNetworkManager *>(parent)->find_receive_sink(parameterGroupNumber, totalMessageSize, source, destination);
+	}
+
+	std::unique_ptr<CANMessageReceiveSink> CANNetworkManager::find_receive_sink(std::uint32_t parameterGroupNumber,
+	                                                                            std::uint32_t totalMessageSize,
+	                                                                            std::shared_ptr<ControlFunction> source,
+	                                                                            std::shared_ptr<ControlFunction> destination)
+	{
+		std::unique_ptr<CANMessageReceiveSink> retVal;
+
+		LOCK_GUARD(Mutex, receiveSinkCallbacksMutex);
+		for (const auto &callbackData : receiveSinkCallbacks)
 		{
-			if (currentCallback.get_parameter_group_number() == currentMessage.get_identifier().get_parameter_group_number())
+			if (callbackData.parameterGroupNumber == parameterGroupNumber)
 			{
-				currentCallback.get_callback()(currentMessage, currentCallback.get_parent());
+				retVal = callbackData.callback(parameterGroupNumber, totalMessageSize, source, destination, callbackData.parent);
+				if (nullptr != retVal)
+				{
+					break;
+				}
 			}
 		}
+		return retVal;
 	}
 
 	void CANNetworkManager::process_can_message_for_global_and_partner_callbacks(const CANMessage &message) const
@@ -1040,43 +1144,24 @@ namespace isobus
 		     ((static_cast<std::uint32_t>(CANLibParameterGroupNumber::ParameterGroupNumberRequest) == message_parameter_group_number) &&
 		      (NULL_CAN_ADDRESS == message.get_identifier().get_source_address()))))
 		{
-			std::vector<ParameterGroupNumberCallbackData> callbacksCopy;
-
-			{
-				LOCK_GUARD(Mutex, globalPGNCallbacksMutex);
-				callbacksCopy = globalParameterGroupNumberCallbacks;
-			}
-
 			// Message destined to global
-			for (const auto &callback : callbacksCopy)
-			{
-				if (message_parameter_group_number == callback.get_parameter_group_number() &&
-				    nullptr != callback.get_callback())
-				{
-					// We have a callback that matches this PGN
-					callback.get_callback()(message, callback.get_parent());
-				}
-			}
+			globalParameterGroupNumberCallbacks.dispatch(message);
 		}
 		else if ((messageDestination != nullptr) && (messageDestination->get_type() == ControlFunction::Type::Internal))
 		{
-			// Message is destined to us
-			for (const auto &partner : partneredControlFunctions)
+			// Message is destined to us, only partners can have callbacks for that
+			if ((nullptr != messageSource) &&
+			    (ControlFunction::Type::Partnered == messageSource->get_type()) &&
+			    (messageSource->get_can_port() == message.get_can_port_index()))
 			{
-				if ((nullptr != partner) &&
-				    (partner->get_can_port() == message.get_can_port_index()) &&
-				    (partner == messageSource))
-				{
-					// Message matches CAN port for a partnered control function
-					partner->dispatch_parameter_group_number_callback(message);
-				}
+				std::static_pointer_cast<PartneredControlFunction>(messageSource)->dispatch_parameter_group_number_callback(message);
 			}
 		}
 	}
 
 	void CANNetworkManager::process_rx_messages()
 	{
-		std::shared_ptr<CANMessage> message = nullptr;
+		CANMessage *message = nullptr;
 
 		// We may miss a message without locking the mutex when checking if empty, but that's okay. It will be picked up on the next iteration
 		while (receivedMessageQueue.pop(&message))
@@ -1095,18 +1180,20 @@ namespace isobus
 
 			// Update Others
 			process_can_message_for_global_and_partner_callbacks(*message);
+			messagePool.release(message);
 		}
 	}
 
 	void CANNetworkManager::process_tx_messages()
 	{
-		std::shared_ptr<CANMessage> message = nullptr;
+		CANMessage *message = nullptr;
 
 		// We may miss a message without locking the mutex when checking if empty, but that's okay. It will be picked up on the next iteration
 		while (transmittedMessageQueue.pop(&message))
 		{
 			// Update listen-only callbacks
 			messageTransmittedEventDispatcher.call(*message);
+			messagePool.release(message);
 		}
 	}
 
@@ -1132,7 +1219,7 @@ namespace isobus
 					auto controlFunction = tableEntry;
 					if (ControlFunction::Type::Internal != controlFunction->get_type())
 					{
-						inactiveControlFunctions.push_back(controlFunction);
+						add_inactive_control_function(controlFunction);
 						LOG_INFO("[NM]: Control function with address %u and NAME %016llx is now offline on channel %u.", controlFunction->get_address(), controlFunction->get_NAME(), channelIndex);
 						tableEntry = nullptr;
 						controlFunction->address = NULL_CAN_ADDRESS;
@@ -20,7 +20,8 @@ namespace isobus
 {
 	PartneredControlFunction::PartneredControlFunction(std::uint8_t CANPort, const std::vector<NAMEFilter> &NAMEFilters) :
 	  ControlFunction(NAME(0), NULL_CAN_ADDRESS, CANPort, Type::Partnered),
-	  NAMEFilterList(NAMEFilters)
+	  NAMEFilterList(NAMEFilters),
+	  compiledNAMEFilter(NAMEFilters)
 	{
 	}
 
@@ -75,88 +76,7 @@ namespace isobus
 
 	bool PartneredControlFunction::check_matches_name(NAME NAMEToCheck) const
 	{
-		std::uint32_t currentFilterValue;
-		NAME::NAMEParameters currentFilterParameter;
-		bool retVal = true;
-
-		if (0 == get_number_name_filters())
-		{
-			retVal = false;
-		}
-
-		for (std::uint32_t i = 0; i < get_number_name_filters(); i++)
-		{
-			get_name_filter_parameter(i, currentFilterParameter, currentFilterValue);
-
-			switch (currentFilterParameter)
-			{
-				case NAME::NAMEParameters::IdentityNumber:
-				{
-					retVal = (currentFilterValue == NAMEToCheck.get_identity_number());
-				}
-				break;
-
-				case NAME::NAMEParameters::ManufacturerCode:
-				{
-					retVal = (currentFilterValue == NAMEToCheck.get_manufacturer_code());
-				}
-				break;
-
-				case NAME::NAMEParameters::EcuInstance:
-				{
-					retVal = (currentFilterValue == NAMEToCheck.get_ecu_instance());
-				}
-				break;
-
-				case NAME::NAMEParameters::FunctionInstance:
-				{
-					retVal = (currentFilterValue == NAMEToCheck.get_function_instance());
-				}
-				break;
-
-				case NAME::NAMEParameters::FunctionCode:
-				{
-					retVal = (currentFilterValue == NAMEToCheck.get_function_code());
-				}
-				break;
-
-				case NAME::NAMEParameters::DeviceClass:
-				{
-					retVal = (currentFilterValue == NAMEToCheck.get_device_class());
-				}
-				break;
-
-				case NAME::NAMEParameters::DeviceClassInstance:
-				{
-					retVal = (currentFilterValue == NAMEToCheck.get_device_class_instance());
-				}
-				break;
-
-				case NAME::NAMEParameters::IndustryGroup:
-				{
-					retVal = (currentFilterValue == NAMEToCheck.get_industry_group());
-				}
-				break;
-
-				case NAME::NAMEParameters::ArbitraryAddressCapable:
-				{
-					retVal = ((0 != currentFilterValue) == NAMEToCheck.get_arbitrary_address_capable());
-				}
-				break;
-
-				default:
-				{
-					retVal = false;
-				}
-				break;
-			}
-
-			if (false == retVal)
-			{
-				break;
-			}
-		}
-		return retVal;
+		return compiledNAMEFilter.check_name_matches(NAMEToCheck);
 	}
 
 	void PartneredControlFunction::dispatch_parameter_group_number_callback(const CANMessage &message)
@@ -20,6 +20,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <limits>
 #include <memory>
 
 namespace isobus
@@ -121,6 +122,66 @@ namespace isobus
 		return totalNumberOfPackets;
 	}
 
+	void TransportProtocolManager::BroadcastPacingStatistics::add_sample(std::uint64_t interFrameTime_us, std::uint64_t targetInterFrameTime_us)
+	{
+		std::uint64_t jitter_us = (interFrameTime_us > targetInterFrameTime_us) ? (interFrameTime_us - targetInterFrameTime_us) : 0;
+
+		std::size_t bucket = 0;
+		while (jitter_us > get_jitter_bucket_upper_bound_us(bucket))
+		{
+			bucket++;
+		}
+		jitterBuckets[bucket]++;
+
+		totalJitter_us += jitter_us;
+		maximumJitter_us = std::max(maximumJitter_us, jitter_us);
+		numberOfSamples++;
+		if (interFrameTime_us > (static_cast<std::uint64_t>(MAX_BAM_FRAME_DELAY_MS) * 1000))
+		{
+			numberOfLateFrames++;
+		}
+	}
+
+	void TransportProtocolManager::BroadcastPacingStatistics::reset()
+	{
+		jitterBuckets.fill(0);
+		totalJitter_us = 0;
+		maximumJitter_us = 0;
+		numberOfSamples = 0;
+		numberOfLateFrames = 0;
+	}
+
+	std::uint32_t TransportProtocolManager::BroadcastPacingStatistics::get_number_of_samples() const
+	{
+		return numberOfSamples;
+	}
+
+	std::uint32_t TransportProtocolManager::BroadcastPacingStatistics::get_jitter_bucket_count(std::size_t bucket) const
+	{
+		return (bucket < NUMBER_OF_JITTER_BUCKETS) ? jitterBuckets[bucket] : 0;
+	}
+
+	std::uint64_t TransportProtocolManager::BroadcastPacingStatistics::get_jitter_bucket_upper_bound_us(std::size_t bucket)
+	{
+		constexpr std::array<std::uint64_t, NUMBER_OF_JITTER_BUCKETS - 1> UPPER_BOUNDS_US = { 100, 250, 500, 1000, 2000, 5000, 10000 };
+		return (bucket < UPPER_BOUNDS_US.size()) ? UPPER_BOUNDS_US[bucket] : std::numeric_limits<std::uint64_t>::max();
+	}
+
+	std::uint64_t TransportProtocolManager::BroadcastPacingStatistics::get_average_jitter_us() const
+	{
+		return (numberOfSamples > 0) ? (totalJitter_us / numberOfSamples) : 0;
+	}
+
+	std::uint64_t TransportProtocolManager::BroadcastPacingStatistics::get_maximum_jitter_us() const
+	{
+		return maximumJitter_us;
+	}
+
+	std::uint32_t TransportProtocolManager::BroadcastPacingStatistics::get_number_of_late_frames() const
+	{
+		return numberOfLateFrames;
+	}
+
 	TransportProtocolManager::TransportProtocolManager(const CANMessageFrameCallback &sendCANFrameCallback,
 	                                                   const CANMessageCallback &canMessageReceivedCallback,
 	                                                   const CANNetworkConfiguration *configuration) :
@@ -128,6 +189,9 @@ namespace isobus
 	  canMessageReceivedCallback(canMessageReceivedCallback),
 	  configuration(configuration)
 	{
+		activeSessions.reserve(configuration->get_max_number_transport_protocol_sessions());
+		dueSessions.reserve(configuration->get_max_number_transport_protocol_sessions());
+		roundRobinSessions.reserve(configuration->get_max_number_transport_protocol_sessions());
 	}
 
 	void TransportProtocolManager::process_broadcast_announce_message(const std::shared_ptr<ControlFunction> source,
@@ -161,7 +225,7 @@ namespace isobus
 			}
 
 			auto newSession = std::make_shared<TransportProtocolSession>(TransportProtocolSession::Direction::Receive,
-			                                                             std::unique_ptr<CANMessageData>(new CANMessageDataVector(totalMessageSize)),
+			                                                             std::unique_ptr<CANMessageData>(new CANMessageDataVector(0)), // Sized once the session is accepted
 			                                                             parameterGroupNumber,
 			                                                             totalMessageSize,
 			                                                             0xFF, // Arbitrary - unused for broadcast
@@ -176,11 +240,12 @@ namespace isobus
 			}
 			else
 			{
+				prepare_receive_data(newSession);
 				newSession->set_state(StateMachineState::WaitForDataTransferPacket);
 
 				{
 					LOCK_GUARD(Mutex, activeSessionsMutex);
-					activeSessions.push_back(newSession);
+					activeSessions.insert(newSession);
 				}
 
 				update_state_machine(newSession);
@@ -221,8 +286,6 @@ namespace isobus
 				}
 			}
 
-			auto data = std::unique_ptr<CANMessageData>(new CANMessageDataVector(totalMessageSize));
-
 			if (clearToSendPacketMax > configuration->get_number_of_packets_per_cts_message())
 			{
 				LOG_DEBUG("[TP]: Received Request To Send (RTS) with a CTS packet count of %hu, which is greater than the configured maximum of %hu, using the configured maximum instead.",
@@ -232,7 +295,7 @@ namespace isobus
 			}
 
 			auto newSession = std::make_shared<TransportProtocolSession>(TransportProtocolSession::Direction::Receive,
-			                                                             std::unique_ptr<CANMessageData>(new CANMessageDataVector(totalMessageSize)),
+			                                                             std::unique_ptr<CANMessageData>(new CANMessageDataVector(0)), // Sized once the session is accepted
 			                                                             parameterGroupNumber,
 			                                                             totalMessageSize,
 			                                                             clearToSendPacketMax,
@@ -248,11 +311,12 @@ namespace isobus
 			}
 			else
 			{
+				prepare_receive_data(newSession);
 				newSession->set_state(StateMachineState::SendClearToSend);
 
 				{
 					LOCK_GUARD(Mutex, activeSessionsMutex);
-					activeSessions.push_back(newSession);
+					activeSessions.insert(newSession);
 				}
 
 				LOG_DEBUG("[TP]: New rx session for 0x%05X. Source: %hu, destination: %hu", parameterGroupNumber, source->get_address(), destination->get_address());
@@ -522,7 +586,12 @@ namespace isobus
 				  static_cast<std::size_t>(PROTOCOL_BYTES_PER_FRAME),
 				  static_cast<std::size_t>(session->get_message_length() - currentDataIndex));
 
-				if (bytes_to_copy > 0)
+				if (nullptr != session->get_receive_sink())
+				{
+					// The consumer supplied its own storage, so the data goes straight there
+					session->get_receive_sink()->write_bytes(currentDataIndex, CANDataSpan(message.get_data().data() + 1, bytes_to_copy));
+				}
+				else if (bytes_to_copy > 0)
 				{
 					if (bytes_to_copy <= 4)
 					{
@@ -548,20 +617,23 @@ namespace isobus
 						send_end_of_session_acknowledgement(session);
 					}
 
-					// Construct the completed message
-					CANIdentifier identifier(CANIdentifier::Type::Extended,
-					                         session->get_parameter_group_number(),
-					                         CANIdentifier::CANPriority::PriorityDefault6,
-					                         session->is_broadcast() ? CANIdentifier::GLOBAL_ADDRESS : destination->get_address(),
-					                         source->get_address());
-					CANMessage completedMessage(CANMessage::Type::Receive,
-					                            identifier,
-					                            std::move(data),
-					                            source,
-					                            destination,
-					                            0);
-
-					canMessageReceivedCallback(completedMessage);
+					if (nullptr == session->get_receive_sink())
+					{
+						// Construct the completed message
+						CANIdentifier identifier(CANIdentifier::Type::Extended,
+						                         session->get_parameter_group_number(),
+						                         CANIdentifier::CANPriority::PriorityDefault6,
+						                         session->is_broadcast() ? CANIdentifier::GLOBAL_ADDRESS : destination->get_address(),
+						                         source->get_address());
+						CANMessage completedMessage(CANMessage::Type::Receive,
+						                            identifier,
+						                            std::move(data),
+						                            source,
+						                            destination,
+						                            0);
+
+						canMessageReceivedCallback(completedMessage);
+					}
 					close_session(session, true);
 					LOG_DEBUG("[TP]: Completed rx session for 0x%05X from %hu", session->get_parameter_group_number(), source->get_address());
 				}
@@ -602,8 +674,9 @@ namespace isobus
 				break;
 
 				default:
-					break;
+					return;
 			}
+			schedule_session_update(message.get_source_control_function(), message.get_destination_control_function());
 		}
 	}
 
@@ -624,6 +697,14 @@ namespace isobus
 		{
 			return false;
 		}
+		else if ((nullptr != destination) &&
+		         (get_number_of_transmit_sessions_from_source(source) >= configuration->get_max_number_transport_protocol_transmit_sessions_per_source()))
+		{
+			LOG_WARNING("[TP]: Unable to start tx session for 0x%05X, source %hu already has the configured maximum number of concurrent tx sessions.",
+			            parameterGroupNumber,
+			            source->get_address());
+			return false;
+		}
 
 		// We can handle this message! If we only have a view of the data, let's clone the data,
 		// so we don't have to worry about it being deleted.
@@ -660,16 +741,30 @@ namespace isobus
 
 		{
 			LOCK_GUARD(Mutex, activeSessionsMutex);
-			activeSessions.push_back(session);
+			activeSessions.insert(session);
 		}
 
 		update_state_machine(session);
+
+		// Scheduling only after the first frame went out keeps a concurrent update from sending it again
+		LOCK_GUARD(Mutex, activeSessionsMutex);
+		if (session == activeSessions.find(source, destination))
+		{
+			activeSessions.schedule(session, get_session_deadline(session, SystemTiming::get_timestamp_ms()));
+		}
 		return true;
 	}
 
 	void TransportProtocolManager::update()
 	{
-		for (auto &session : get_sessions())
+		LOCK_GUARD(Mutex, updateMutex);
+		{
+			LOCK_GUARD(Mutex, activeSessionsMutex);
+			activeSessions.take_due_sessions(SystemTiming::get_timestamp_ms(), dueSessions);
+		}
+
+		// The due sessions are in reverse order of when they were added, so closing one doesn't affect the others
+		for (auto &session : dueSessions)
 		{
 			if (!session->get_source()->get_address_valid())
 			{
@@ -686,19 +781,207 @@ namespace isobus
 				update_state_machine(session);
 			}
 		}
+		send_data_transfer_packets_round_robin();
+
+		// Sessions that are still active wait in the deadline queue until they are due again
+		const std::uint32_t now = SystemTiming::get_timestamp_ms();
+		LOCK_GUARD(Mutex, activeSessionsMutex);
+		for (const auto &session : dueSessions)
+		{
+			if (session == activeSessions.find(session->get_source(), session->get_destination()))
+			{
+				activeSessions.schedule(session, get_session_deadline(session, now));
+			}
+		}
+		dueSessions.clear();
+	}
+
+	void TransportProtocolManager::set_receive_sink_callback(ReceiveSinkCallback callback, void *parent)
+	{
+		receiveSinkCallback = callback;
+		receiveSinkParent = parent;
+	}
+
+	TransportProtocolManager::BroadcastPacingStatistics TransportProtocolManager::get_broadcast_pacing_statistics() const
+	{
+		LOCK_GUARD(Mutex, pacingStatisticsMutex);
+		return pacingStatistics;
+	}
+
+	void TransportProtocolManager::reset_broadcast_pacing_statistics()
+	{
+		LOCK_GUARD(Mutex, pacingStatisticsMutex);
+		pacingStatistics.reset();
+	}
+
+	std::uint32_t TransportProtocolManager::get_time_until_next_update() const
+	{
+		LOCK_GUARD(Mutex, activeSessionsMutex);
+		return activeSessions.get_time_until_next_deadline(SystemTiming::get_timestamp_ms());
 	}
 
-	void TransportProtocolManager::send_data_transfer_packets(const std::shared_ptr<TransportProtocolSession> &session)
+	std::uint32_t TransportProtocolManager::get_session_deadline(const std::shared_ptr<TransportProtocolSession> &session, std::uint32_t now) const
+	{
+		std::uint32_t timeout = 0;
+
+		switch (session->state)
+		{
+			case StateMachineState::WaitForClearToSend:
+			case StateMachineState::WaitForEndOfMessageAcknowledge:
+			{
+				timeout = T2_T3_TIMEOUT_MS;
+			}
+			break;
+
+			case StateMachineState::WaitForDataTransferPacket:
+			{
+				if ((!session->is_broadcast()) && (session->get_cts_number_of_packets_remaining() == session->get_cts_number_of_packets()))
+				{
+					timeout = T2_T3_TIMEOUT_MS;
+				}
+				else
+				{
+					timeout = T1_TIMEOUT_MS;
+				}
+			}
+			break;
+
+			case StateMachineState::SendDataTransferPackets:
+			{
+				if (session->is_broadcast())
+				{
+					// Broadcast sessions are due when their next data frame is scheduled, rounded up to the next millisecond
+					std::uint64_t now_us = SystemTiming::get_timestamp_us();
+					if (now_us >= session->nextBroadcastFrameTimestamp_us)
+					{
+						return now;
+					}
+					return now + static_cast<std::uint32_t>((session->nextBroadcastFrameTimestamp_us - now_us + 999) / 1000);
+				}
+			}
+			break;
+
+			default:
+				break;
+		}
+
+		if (0 == timeout)
+		{
+			// The session has something to send, so it's due on every update until it's done
+			return now;
+		}
+
+		// Timeouts expire once more than the timeout has passed
+		std::uint32_t timeSinceLastUpdate = session->get_time_since_last_update();
+		return (timeSinceLastUpdate > timeout) ? now : (now + (timeout - timeSinceLastUpdate) + 1);
+	}
+
+	void TransportProtocolManager::send_paced_broadcast_data_frame(const std::shared_ptr<TransportProtocolSession> &session)
+	{
+		std::uint64_t now_us = SystemTiming::get_timestamp_us();
+		if (now_us < session->nextBroadcastFrameTimestamp_us)
+		{
+			return;
+		}
+
+		// Each session keeps its own schedule, so concurrent broadcasts on the same channel don't hold each other up
+		std::uint64_t interFrameTime_us = now_us - session->lastBroadcastFrameTimestamp_us;
+		std::uint64_t targetInterFrameTime_us = session->nextBroadcastFrameTimestamp_us - session->lastBroadcastFrameTimestamp_us;
+		std::uint32_t parameterGroupNumber = session->get_parameter_group_number();
+		if (send_data_transfer_packets(session, 1) > 0)
+		{
+			{
+				LOCK_GUARD(Mutex, pacingStatisticsMutex);
+				pacingStatistics.add_sample(interFrameTime_us, targetInterFrameTime_us);
+			}
+
+			if (interFrameTime_us > (static_cast<std::uint64_t>(MAX_BAM_FRAME_DELAY_MS) * 1000))
+			{
+				LOG_WARNING("[TP]: Broadcast tx session for 0x%05X exceeded the maximum time between frames (%u ms)", parameterGroupNumber, static_cast<std::uint32_t>(interFrameTime_us / 1000));
+			}
+
+			// The next frame is scheduled from when this one was actually sent, so a late frame never shortens the gap below the minimum
+			session->lastBroadcastFrameTimestamp_us = now_us;
+			session->nextBroadcastFrameTimestamp_us = now_us + (static_cast<std::uint64_t>(configuration->get_minimum_time_between_transport_protocol_bam_frames()) * 1000);
+		}
+	}
+
+	void TransportProtocolManager::schedule_session_update(const std::shared_ptr<ControlFunction> &source, const std::shared_ptr<ControlFunction> &destination)
+	{
+		LOCK_GUARD(Mutex, activeSessionsMutex);
+		const std::uint32_t now = SystemTiming::get_timestamp_ms();
+
+		auto session = activeSessions.find(source, destination);
+		if (nullptr != session)
+		{
+			activeSessions.schedule(session, now);
+		}
+		session = activeSessions.find(destination, source);
+		if (nullptr != session)
+		{
+			activeSessions.schedule(session, now);
+		}
+	}
+
+	void TransportProtocolManager::send_data_transfer_packets_round_robin()
+	{
+		// The due sessions are in reverse order, while the round robin goes through them in the order they were added
+		roundRobinSessions.clear();
+		for (auto session = dueSessions.rbegin(); session != dueSessions.rend(); session++)
+		{
+			if ((StateMachineState::SendDataTransferPackets == (*session)->state) && (!(*session)->is_broadcast()))
+			{
+				roundRobinSessions.push_back(*session);
+			}
+		}
+
+		if (!roundRobinSessions.empty())
+		{
+			// Start each pass with a different session, so the same session isn't always first in line when the frame budget is low
+			roundRobinOffset = (roundRobinOffset + 1) % roundRobinSessions.size();
+			std::rotate(roundRobinSessions.begin(), roundRobinSessions.begin() + roundRobinOffset, roundRobinSessions.end());
+
+			std::uint8_t framesLeft = configuration->get_max_number_of_network_manager_protocol_frames_per_update();
+			bool anyFrameSent = true;
+			while ((framesLeft > 0) && anyFrameSent)
+			{
+				anyFrameSent = false;
+				for (const auto &session : roundRobinSessions)
+				{
+					if ((framesLeft > 0) && (StateMachineState::SendDataTransferPackets == session->state))
+					{
+						if (send_data_transfer_packets(session, 1) > 0)
+						{
+							framesLeft--;
+							anyFrameSent = true;
+						}
+					}
+				}
+			}
+			roundRobinSessions.clear();
+		}
+	}
+
+	std::size_t TransportProtocolManager::get_number_of_transmit_sessions_from_source(const std::shared_ptr<ControlFunction> &source) const
+	{
+		LOCK_GUARD(Mutex, activeSessionsMutex);
+		return static_cast<std::size_t>(std::count_if(activeSessions.get_sessions().begin(), activeSessions.get_sessions().end(), [&source](const std::shared_ptr<TransportProtocolSession> &session) {
+			return (TransportProtocolSession::Direction::Transmit == session->get_direction()) && (!session->is_broadcast()) && (session->get_source() == source);
+		}));
+	}
+
+	std::uint8_t TransportProtocolManager::send_data_transfer_packets(const std::shared_ptr<TransportProtocolSession> &session, std::uint8_t maxFramesToSend)
 	{
 		std::array<std::uint8_t, CAN_DATA_LENGTH> buffer;
 		std::uint8_t framesToSend = session->get_cts_number_of_packets_remaining();
+		std::uint8_t framesSent = 0;
 		if (session->is_broadcast())
 		{
 			framesToSend = 1;
 		}
-		else if (framesToSend > configuration->get_max_number_of_network_manager_protocol_frames_per_update())
+		else if (framesToSend > maxFramesToSend)
 		{
-			framesToSend = configuration->get_max_number_of_network_manager_protocol_frames_per_update();
+			framesToSend = maxFramesToSend;
 		}
 
 		// Try and send packets
@@ -707,18 +990,8 @@ namespace isobus
 			buffer[0] = session->get_last_sequence_number() + 1;
 
 			std::uint16_t dataOffset = session->get_last_packet_number() * PROTOCOL_BYTES_PER_FRAME;
-			for (std::uint8_t j = 0; j < PROTOCOL_BYTES_PER_FRAME; j++)
-			{
-				std::uint16_t index = dataOffset + j;
-				if (index < session->get_message_length())
-				{
-					buffer[1 + j] = session->get_data().get_byte(index);
-				}
-				else
-				{
-					buffer[1 + j] = 0xFF;
-				}
-			}
+			std::size_t bytesCopied = session->get_data().copy_bytes(dataOffset, DataSpan<std::uint8_t>(buffer.data() + 1, PROTOCOL_BYTES_PER_FRAME));
+			std::fill(buffer.begin() + 1 + bytesCopied, buffer.end(), 0xFF);
 
 			if (sendCANFrameCallback(static_cast<std::uint32_t>(CANLibParameterGroupNumber::TransportProtocolDataTransfer),
 			                         CANDataSpan(buffer.data(), buffer.size()),
@@ -727,6 +1000,7 @@ namespace isobus
 			                         CANIdentifier::CANPriority::PriorityLowest7))
 			{
 				session->set_last_sequency_number(session->get_last_sequence_number() + 1);
+				framesSent++;
 			}
 			else
 			{
@@ -751,6 +1025,7 @@ namespace isobus
 		{
 			session->set_state(StateMachineState::WaitForClearToSend);
 		}
+		return framesSent;
 	}
 
 	void TransportProtocolManager::update_state_machine(std::shared_ptr<TransportProtocolSession> &session)
@@ -765,6 +1040,8 @@ namespace isobus
 				if (send_broadcast_announce_message(session))
 				{
 					session->set_state(StateMachineState::SendDataTransferPackets);
+					session->lastBroadcastFrameTimestamp_us = SystemTiming::get_timestamp_us();
+					session->nextBroadcastFrameTimestamp_us = session->lastBroadcastFrameTimestamp_us + (static_cast<std::uint64_t>(configuration->get_minimum_time_between_transport_protocol_bam_frames()) * 1000);
 				}
 			}
 			break;
@@ -808,13 +1085,11 @@ namespace isobus
 
 			case StateMachineState::SendDataTransferPackets:
 			{
-				if (session->is_broadcast() && (session->get_time_since_last_update() < configuration->get_minimum_time_between_transport_protocol_bam_frames()))
-				{
-					// Need to wait before sending the next data frame of the broadcast session
-				}
-				else
+				// Destination specific sessions send their data frames in send_data_transfer_packets_round_robin.
+				// Broadcast sessions need to wait a while between each data frame.
+				if (session->is_broadcast())
 				{
-					send_data_transfer_packets(session);
+					send_paced_broadcast_data_frame(session);
 				}
 			}
 			break;
@@ -909,15 +1184,31 @@ namespace isobus
 		                            CANIdentifier::CANPriority::PriorityLowest7);
 	}
 
+	void TransportProtocolManager::prepare_receive_data(const std::shared_ptr<TransportProtocolSession> &session) const
+	{
+		if (nullptr != receiveSinkCallback)
+		{
+			session->set_receive_sink(receiveSinkCallback(session->get_parameter_group_number(),
+			                                              session->get_message_length(),
+			                                              session->get_source(),
+			                                              session->get_destination(),
+			                                              receiveSinkParent));
+		}
+
+		if (nullptr == session->get_receive_sink())
+		{
+			// Without a sink, the message is reassembled into the session's own buffer
+			static_cast<CANMessageDataVector &>(session->get_data()).resize(session->get_message_length());
+		}
+	}
+
 	void TransportProtocolManager::close_session(const std::shared_ptr<TransportProtocolSession> &session, bool successful)
 	{
 		session->complete(successful);
 
 		LOCK_GUARD(Mutex, activeSessionsMutex);
-		auto sessionLocation = std::find(activeSessions.begin(), activeSessions.end(), session);
-		if (activeSessions.end() != sessionLocation)
+		if (activeSessions.erase(session))
 		{
-			activeSessions.erase(sessionLocation);
 			LOG_DEBUG("[TP]: Session Closed");
 		}
 	}
@@ -1025,19 +1316,14 @@ namespace isobus
 	bool TransportProtocolManager::has_session(std::shared_ptr<ControlFunction> source, std::shared_ptr<ControlFunction> destination)
 	{
 		LOCK_GUARD(Mutex, activeSessionsMutex);
-		return std::any_of(activeSessions.begin(), activeSessions.end(), [&](const std::shared_ptr<TransportProtocolManager::TransportProtocolSession> &session) {
-			return session->matches(source, destination);
-		});
+		return nullptr != activeSessions.find(source, destination);
 	}
 
 	std::shared_ptr<TransportProtocolManager::TransportProtocolSession> TransportProtocolManager::get_session(std::shared_ptr<ControlFunction> source,
 	                                                                                                          std::shared_ptr<ControlFunction> destination)
 	{
 		LOCK_GUARD(Mutex, activeSessionsMutex);
-		auto result = std::find_if(activeSessions.begin(), activeSessions.end(), [&](const std::shared_ptr<TransportProtocolManager::TransportProtocolSession> &session) {
-			return session->matches(source, destination);
-		});
-		return (activeSessions.end() != result) ? (*result) : nullptr;
+		return activeSessions.find(source, destination);
 	}
 
 	std::size_t TransportProtocolManager::get_sessions_count() const
@@ -1049,6 +1335,6 @@ namespace isobus
 	std::list<std::shared_ptr<TransportProtocolManager::TransportProtocolSession>> TransportProtocolManager::get_sessions() const
 	{
 		LOCK_GUARD(Mutex, activeSessionsMutex);
-		return activeSessions;
+		return std::list<std::shared_ptr<TransportProtocolSession>>(activeSessions.get_sessions().begin(), activeSessions.get_sessions().end());
 	}
 }
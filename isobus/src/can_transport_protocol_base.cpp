@@ -91,8 +91,14 @@ namespace isobus
 		return SystemTiming::get_time_elapsed_ms(timestamp_ms);
 	}
 
-	void TransportProtocolSessionBase::complete(bool success) const
+	void TransportProtocolSessionBase::complete(bool success)
 	{
+		if (nullptr != receiveSink)
+		{
+			receiveSink->on_session_closed(success);
+			receiveSink.reset();
+		}
+
 		if ((nullptr != sessionCompleteCallback) && (Direction::Transmit == direction))
 		{
 			sessionCompleteCallback(get_parameter_group_number(),
@@ -103,4 +109,14 @@ namespace isobus
 			                        parent);
 		}
 	}
+
+	void TransportProtocolSessionBase::set_receive_sink(std::unique_ptr<CANMessageReceiveSink> sink)
+	{
+		receiveSink = std::move(sink);
+	}
+
+	CANMessageReceiveSink *TransportProtocolSessionBase::get_receive_sink() const
+	{
+		return receiveSink.get();
+	}
 }
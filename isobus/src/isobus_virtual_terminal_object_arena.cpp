@@ -0,0 +1,79 @@
+//================================================================================================
+/// @file isobus_virtual_terminal_object_arena.cpp
+///
+/// @brief A monotonic memory arena used to back the VT objects of a working set, so that
+/// parsing an object pool doesn't need a heap allocation for every object and child list.
+/// @author Adrian Del Grosso
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+
+#include "isobus/isobus/isobus_virtual_terminal_object_arena.hpp"
+
+namespace isobus
+{
+	constexpr std::size_t VTObjectArena::DEFAULT_BLOCK_SIZE;
+
+	VTObjectArena::VTObjectArena(std::size_t blockSize) :
+	  blockSize(blockSize)
+	{
+	}
+
+	void *VTObjectArena::allocate(std::size_t size, std::size_t alignment)
+	{
+		LOCK_GUARD(Mutex, arenaMutex);
+		std::size_t alignedOffset = (currentBlockOffset + alignment - 1) & ~(alignment - 1);
+		void *retVal = nullptr;
+
+		if ((nullptr != currentBlock) && (alignedOffset + size <= blockSize))
+		{
+			retVal = currentBlock + alignedOffset;
+			currentBlockOffset = alignedOffset + size;
+		}
+		else if ((size > (blockSize / 4)) || (alignment > alignof(std::max_align_t)))
+		{
+			// Large or over-aligned requests get their own block, so the rest of the current block isn't wasted.
+			// Blocks come from new[], which only guarantees fundamental alignment, so pad the block to align it.
+			std::size_t paddedSize = size + alignment;
+			blocks.emplace_back(new std::uint8_t[paddedSize]);
+			retVal = blocks.back().get();
+			std::align(alignment, size, retVal, paddedSize);
+			bytesReserved += size + alignment;
+		}
+		else
+		{
+			blocks.emplace_back(new std::uint8_t[blockSize]);
+			currentBlock = blocks.back().get();
+			currentBlockOffset = size;
+			retVal = currentBlock;
+			bytesReserved += blockSize;
+		}
+		numberOfAllocations++;
+		bytesUsed += size;
+		return retVal;
+	}
+
+	std::size_t VTObjectArena::get_number_of_allocations() const
+	{
+		LOCK_GUARD(Mutex, arenaMutex);
+		return numberOfAllocations;
+	}
+
+	std::size_t VTObjectArena::get_number_of_blocks() const
+	{
+		LOCK_GUARD(Mutex, arenaMutex);
+		return blocks.size();
+	}
+
+	std::size_t VTObjectArena::get_bytes_used() const
+	{
+		LOCK_GUARD(Mutex, arenaMutex);
+		return bytesUsed;
+	}
+
+	std::size_t VTObjectArena::get_bytes_reserved() const
+	{
+		LOCK_GUARD(Mutex, arenaMutex);
+		return bytesReserved;
+	}
+} // namespace isobus
@@ -0,0 +1,225 @@
+//================================================================================================
+/// @file isobus_virtual_terminal_object_pool_snapshot.cpp
+///
+/// @brief Implements the snapshots of parsed VT object pools that a VT server stores next to object pool versions.
+/// @author Adrian Del Grosso
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+#include "isobus/isobus/isobus_virtual_terminal_object_pool_snapshot.hpp"
+
+#include "isobus/isobus/isobus_virtual_terminal_working_set_base.hpp"
+
+#include <algorithm>
+
+namespace isobus
+{
+	constexpr std::uint16_t VirtualTerminalObjectPoolSnapshot::FORMAT_VERSION;
+	constexpr std::size_t VirtualTerminalObjectPoolSnapshot::HEADER_LENGTH;
+	constexpr std::size_t VirtualTerminalObjectPoolSnapshot::ENTRY_LENGTH;
+	constexpr std::uint64_t VirtualTerminalObjectPoolSnapshot::HASH_OFFSET_BASIS;
+
+	/// @brief The magic number at the start of every snapshot
+	static constexpr std::uint8_t SNAPSHOT_MAGIC[] = { 'V', 'T', 'P', 'S' };
+
+	VirtualTerminalObjectPoolSnapshot::VirtualTerminalObjectPoolSnapshot(const std::uint8_t *snapshotData, std::size_t snapshotLength) :
+	  data(snapshotData),
+	  length(snapshotLength)
+	{
+		if ((nullptr != data) &&
+		    (length >= HEADER_LENGTH) &&
+		    std::equal(std::begin(SNAPSHOT_MAGIC), std::end(SNAPSHOT_MAGIC), data) &&
+		    (FORMAT_VERSION == read_uint16(4)) &&
+		    ((length - HEADER_LENGTH) / ENTRY_LENGTH >= read_uint32(12)))
+		{
+			const std::uint64_t objectPoolLength = read_uint32(8);
+			bool entriesValid = true;
+
+			for (std::uint32_t i = 0; (i < read_uint32(12)) && entriesValid; i++)
+			{
+				const ObjectEntry entry = get_object_entry(i);
+
+				// Entries must be sorted by ID without duplicates, lie entirely within the pool, and have their decoded data within the snapshot
+				entriesValid = (0 != entry.length) &&
+				  ((static_cast<std::uint64_t>(entry.offset) + entry.length) <= objectPoolLength) &&
+				  ((static_cast<std::uint64_t>(entry.decodedDataOffset) + entry.decodedDataLength) <= length) &&
+				  ((0 == i) || (get_object_entry(i - 1).objectID < entry.objectID));
+			}
+			valid = entriesValid;
+		}
+	}
+
+	std::vector<std::uint8_t> VirtualTerminalObjectPoolSnapshot::create(const std::vector<std::vector<std::uint8_t>> &iopFiles,
+	                                                                      const VTObjectTable &objectTree,
+	                                                                      std::uint16_t workingSetID,
+	                                                                      std::uint32_t numberOfInvalidObjects)
+	{
+		std::vector<ObjectEntry> entries;
+		std::uint64_t hash = HASH_OFFSET_BASIS;
+		std::uint64_t fileOffset = 0;
+
+		for (const auto &iopFile : iopFiles)
+		{
+			std::uint32_t offset = 0;
+
+			while (offset < iopFile.size())
+			{
+				const auto remainingLength = static_cast<std::uint32_t>(iopFile.size() - offset);
+				const std::uint32_t objectLength = VirtualTerminalWorkingSetBase::get_iop_object_size(iopFile.data() + offset, remainingLength);
+
+				if ((0 == objectLength) || (objectLength > remainingLength) || (fileOffset + offset + objectLength > UINT32_MAX))
+				{
+					return {};
+				}
+				entries.push_back({ static_cast<std::uint32_t>(fileOffset + offset),
+				                    objectLength,
+				                    0,
+				                    0,
+				                    static_cast<std::uint16_t>(static_cast<std::uint16_t>(iopFile[offset]) | (static_cast<std::uint16_t>(iopFile[offset + 1]) << 8)),
+				                    iopFile[offset + 2] });
+				offset += objectLength;
+			}
+			hash = hash_object_pool(iopFile.data(), iopFile.size(), hash);
+			fileOffset += iopFile.size();
+		}
+
+		// Objects of later files replace earlier ones with the same ID, so only the last definition of each ID is kept
+		std::stable_sort(entries.begin(), entries.end(), [](const ObjectEntry &lhs, const ObjectEntry &rhs) { return lhs.objectID < rhs.objectID; });
+		auto lastDefinition = std::unique(entries.rbegin(), entries.rend(), [](const ObjectEntry &lhs, const ObjectEntry &rhs) { return lhs.objectID == rhs.objectID; });
+		entries.erase(entries.begin(), lastDefinition.base());
+
+		// The decoded pixels of each picture graphic are placed after the entries
+		std::vector<const std::vector<std::uint8_t> *> decodedData;
+		std::uint64_t decodedDataOffset = HEADER_LENGTH + (entries.size() * ENTRY_LENGTH);
+
+		for (auto &entry : entries)
+		{
+			if (static_cast<std::uint8_t>(VirtualTerminalObjectType::PictureGraphic) == entry.objectType)
+			{
+				VTObject *object = objectTree.get(entry.objectID);
+
+				if ((nullptr == object) || (VirtualTerminalObjectType::PictureGraphic != object->get_object_type()))
+				{
+					return {};
+				}
+				const auto &pixels = static_cast<PictureGraphic *>(object)->get_raw_data();
+
+				if (decodedDataOffset + pixels.size() > UINT32_MAX)
+				{
+					return {};
+				}
+				entry.decodedDataOffset = static_cast<std::uint32_t>(decodedDataOffset);
+				entry.decodedDataLength = static_cast<std::uint32_t>(pixels.size());
+				decodedData.push_back(&pixels);
+				decodedDataOffset += pixels.size();
+			}
+		}
+
+		std::vector<std::uint8_t> retVal;
+		retVal.reserve(static_cast<std::size_t>(decodedDataOffset));
+
+		auto append = [&retVal](std::uint64_t value, std::size_t numberOfBytes) {
+			for (std::size_t i = 0; i < numberOfBytes; i++)
+			{
+				retVal.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+			}
+		};
+
+		retVal.insert(retVal.end(), std::begin(SNAPSHOT_MAGIC), std::end(SNAPSHOT_MAGIC));
+		append(FORMAT_VERSION, 2);
+		append(0xFFFF, 2);
+		append(fileOffset, 4);
+		append(entries.size(), 4);
+		append(hash, 8);
+		append(workingSetID, 2);
+		append(0xFFFF, 2);
+		append(numberOfInvalidObjects, 4);
+
+		for (const auto &entry : entries)
+		{
+			append(entry.offset, 4);
+			append(entry.length, 4);
+			append(entry.decodedDataOffset, 4);
+			append(entry.decodedDataLength, 4);
+			append(entry.objectID, 2);
+			append(entry.objectType, 1);
+			append(0xFF, 1);
+		}
+
+		for (const auto pixels : decodedData)
+		{
+			retVal.insert(retVal.end(), pixels->begin(), pixels->end());
+		}
+		return retVal;
+	}
+
+	bool VirtualTerminalObjectPoolSnapshot::get_is_valid() const
+	{
+		return valid;
+	}
+
+	bool VirtualTerminalObjectPoolSnapshot::get_is_snapshot_of(const std::uint8_t *iopData, std::size_t iopLength) const
+	{
+		return valid &&
+		  (nullptr != iopData) &&
+		  (iopLength == read_uint32(8)) &&
+		  (hash_object_pool(iopData, iopLength) == read_uint64(16));
+	}
+
+	std::uint32_t VirtualTerminalObjectPoolSnapshot::get_number_of_objects() const
+	{
+		return valid ? read_uint32(12) : 0;
+	}
+
+	VirtualTerminalObjectPoolSnapshot::ObjectEntry VirtualTerminalObjectPoolSnapshot::get_object_entry(std::uint32_t index) const
+	{
+		const std::size_t entryOffset = HEADER_LENGTH + (static_cast<std::size_t>(index) * ENTRY_LENGTH);
+		return { read_uint32(entryOffset),
+			       read_uint32(entryOffset + 4),
+			       read_uint32(entryOffset + 8),
+			       read_uint32(entryOffset + 12),
+			       read_uint16(entryOffset + 16),
+			       data[entryOffset + 18] };
+	}
+
+	const std::uint8_t *VirtualTerminalObjectPoolSnapshot::get_decoded_data(const ObjectEntry &entry) const
+	{
+		return (valid && (0 != entry.decodedDataLength)) ? (data + entry.decodedDataOffset) : nullptr;
+	}
+
+	std::uint16_t VirtualTerminalObjectPoolSnapshot::get_working_set_id() const
+	{
+		return valid ? read_uint16(24) : 0xFFFF;
+	}
+
+	std::uint32_t VirtualTerminalObjectPoolSnapshot::get_number_of_invalid_objects() const
+	{
+		return valid ? read_uint32(28) : 0;
+	}
+
+	std::uint64_t VirtualTerminalObjectPoolSnapshot::hash_object_pool(const std::uint8_t *data, std::size_t length, std::uint64_t hash)
+	{
+		constexpr std::uint64_t FNV_PRIME = 0x100000001B3;
+
+		for (std::size_t i = 0; i < length; i++)
+		{
+			hash = (hash ^ data[i]) * FNV_PRIME;
+		}
+		return hash;
+	}
+
+	std::uint16_t VirtualTerminalObjectPoolSnapshot::read_uint16(std::size_t offset) const
+	{
+		return static_cast<std::uint16_t>(static_cast<std::uint16_t>(data[offset]) | (static_cast<std::uint16_t>(data[offset + 1]) << 8));
+	}
+
+	std::uint32_t VirtualTerminalObjectPoolSnapshot::read_uint32(std::size_t offset) const
+	{
+		return static_cast<std::uint32_t>(read_uint16(offset)) | (static_cast<std::uint32_t>(read_uint16(offset + 2)) << 16);
+	}
+
+	std::uint64_t VirtualTerminalObjectPoolSnapshot::read_uint64(std::size_t offset) const
+	{
+		return static_cast<std::uint64_t>(read_uint32(offset)) | (static_cast<std::uint64_t>(read_uint32(offset + 4)) << 32);
+	}
+} // namespace isobus
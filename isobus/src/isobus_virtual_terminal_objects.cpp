@@ -80,6 +80,166 @@ namespace isobus
 		colourTable.at(colourIndex) = newColour;
 	}
 
+	VTObjectTable::ConstIterator::ConstIterator(const VTObjectTable &table, std::uint32_t index) :
+	  table(&table),
+	  index(index)
+	{
+		skip_empty_slots();
+	}
+
+	const std::shared_ptr<VTObject> &VTObjectTable::ConstIterator::operator*() const
+	{
+		return (*table->pages[index / SLOTS_PER_PAGE])[index % SLOTS_PER_PAGE];
+	}
+
+	const std::shared_ptr<VTObject> *VTObjectTable::ConstIterator::operator->() const
+	{
+		return &(**this);
+	}
+
+	VTObjectTable::ConstIterator &VTObjectTable::ConstIterator::operator++()
+	{
+		index++;
+		skip_empty_slots();
+		return *this;
+	}
+
+	bool VTObjectTable::ConstIterator::operator==(const ConstIterator &other) const
+	{
+		return (table == other.table) && (index == other.index);
+	}
+
+	bool VTObjectTable::ConstIterator::operator!=(const ConstIterator &other) const
+	{
+		return !(*this == other);
+	}
+
+	void VTObjectTable::ConstIterator::skip_empty_slots()
+	{
+		while (index < NUMBER_OF_SLOTS)
+		{
+			const auto &page = table->pages[index / SLOTS_PER_PAGE];
+
+			if (nullptr == page)
+			{
+				// Skip the whole page, it has never held an object
+				index = ((index / SLOTS_PER_PAGE) + 1) * SLOTS_PER_PAGE;
+			}
+			else if (nullptr == (*page)[index % SLOTS_PER_PAGE])
+			{
+				index++;
+			}
+			else
+			{
+				break;
+			}
+		}
+	}
+
+	VTObjectTable::VTObjectTable(const VTObjectTable &other)
+	{
+		*this = other;
+	}
+
+	VTObjectTable &VTObjectTable::operator=(const VTObjectTable &other)
+	{
+		if (this != &other)
+		{
+			for (std::uint32_t i = 0; i < NUMBER_OF_PAGES; i++)
+			{
+				if (nullptr != other.pages[i])
+				{
+					pages[i].reset(new Page(*other.pages[i]));
+				}
+				else
+				{
+					pages[i].reset();
+				}
+			}
+		}
+		return *this;
+	}
+
+	std::shared_ptr<VTObject> &VTObjectTable::operator[](std::uint16_t objectID)
+	{
+		auto &page = pages[objectID / SLOTS_PER_PAGE];
+
+		if (nullptr == page)
+		{
+			page.reset(new Page());
+		}
+		return (*page)[objectID % SLOTS_PER_PAGE];
+	}
+
+	VTObject *VTObjectTable::get(std::uint16_t objectID) const
+	{
+		return get_shared(objectID).get();
+	}
+
+	const std::shared_ptr<VTObject> &VTObjectTable::get_shared(std::uint16_t objectID) const
+	{
+		static const std::shared_ptr<VTObject> NULL_OBJECT = nullptr;
+		const auto &page = pages[objectID / SLOTS_PER_PAGE];
+
+		if ((NULL_OBJECT_ID == objectID) || (nullptr == page))
+		{
+			return NULL_OBJECT;
+		}
+		return (*page)[objectID % SLOTS_PER_PAGE];
+	}
+
+	bool VTObjectTable::contains(std::uint16_t objectID) const
+	{
+		return nullptr != get(objectID);
+	}
+
+	void VTObjectTable::erase(std::uint16_t objectID)
+	{
+		auto &page = pages[objectID / SLOTS_PER_PAGE];
+
+		if (nullptr != page)
+		{
+			(*page)[objectID % SLOTS_PER_PAGE].reset();
+		}
+	}
+
+	void VTObjectTable::clear()
+	{
+		for (auto &page : pages)
+		{
+			page.reset();
+		}
+	}
+
+	std::size_t VTObjectTable::size() const
+	{
+		std::size_t retVal = 0;
+
+		for (const auto &page : pages)
+		{
+			if (nullptr != page)
+			{
+				retVal += static_cast<std::size_t>(std::count_if(page->begin(), page->end(), [](const std::shared_ptr<VTObject> &object) { return nullptr != object; }));
+			}
+		}
+		return retVal;
+	}
+
+	bool VTObjectTable::empty() const
+	{
+		return begin() == end();
+	}
+
+	VTObjectTable::ConstIterator VTObjectTable::begin() const
+	{
+		return ConstIterator(*this, 0);
+	}
+
+	VTObjectTable::ConstIterator VTObjectTable::end() const
+	{
+		return ConstIterator(*this, NUMBER_OF_SLOTS);
+	}
+
 	std::uint16_t VTObject::get_id() const
 	{
 		return objectID;
@@ -237,19 +397,20 @@ namespace isobus
 		}
 	}
 
-	std::shared_ptr<VTObject> VTObject::get_object_by_id(std::uint16_t objectID, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool)
+	std::shared_ptr<VTObject> VTObject::get_object_by_id(std::uint16_t objectID, const VTObjectTable &objectPool)
 	{
-		std::shared_ptr<VTObject> retVal = nullptr;
+		return objectPool.get_shared(objectID);
+	}
 
-		if ((NULL_OBJECT_ID != objectID) && (objectPool.find(objectID) != objectPool.end()))
-		{
-			auto object = objectPool.at(objectID);
-			if (nullptr != object)
-			{
-				retVal = object;
-			}
-		}
-		return retVal;
+	void VTObject::set_arena(const std::shared_ptr<VTObjectArena> &arena)
+	{
+		decltype(children) arenaChildren{ VTObjectArenaAllocator<ChildObjectData>(arena) };
+		decltype(macros) arenaMacros{ VTObjectArenaAllocator<MacroMetadata>(arena) };
+
+		arenaChildren.assign(children.begin(), children.end());
+		arenaMacros.assign(macros.begin(), macros.end());
+		children = std::move(arenaChildren);
+		macros = std::move(arenaMacros);
 	}
 
 	VTObject::ChildObjectData::ChildObjectData(std::uint16_t objectId,
@@ -271,13 +432,13 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool WorkingSet::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool WorkingSet::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
 		for (const auto &child : children)
 		{
-			auto childObject = get_object_by_id(child.id, objectPool);
+			auto childObject = objectPool.get(child.id);
 			if (nullptr != childObject)
 			{
 				switch (childObject->get_object_type())
@@ -313,7 +474,7 @@ namespace isobus
 		        (NULL_OBJECT_ID != objectID));
 	}
 
-	bool WorkingSet::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool WorkingSet::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -432,14 +593,14 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool DataMask::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool DataMask::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 		std::uint8_t numberOfSoftKeyMasks = 0;
 
 		for (auto &child : children)
 		{
-			auto childObject = get_object_by_id(child.id, objectPool);
+			auto childObject = objectPool.get(child.id);
 			if (nullptr != childObject)
 			{
 				switch (childObject->get_object_type())
@@ -499,7 +660,7 @@ namespace isobus
 		        (NULL_OBJECT_ID != objectID));
 	}
 
-	bool DataMask::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool DataMask::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -574,7 +735,7 @@ namespace isobus
 		return retVal;
 	}
 
-	bool DataMask::change_soft_key_mask(std::uint16_t newMaskID, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool)
+	bool DataMask::change_soft_key_mask(std::uint16_t newMaskID, const VTObjectTable &objectPool)
 	{
 		bool retVal = false;
 
@@ -583,9 +744,8 @@ namespace isobus
 			set_soft_key_mask(newMaskID);
 			retVal = true;
 		}
-		else if ((objectPool.end() != objectPool.find(newMaskID)) &&
-		         (nullptr != objectPool.at(newMaskID)) &&
-		         (VirtualTerminalObjectType::SoftKeyMask == objectPool.at(newMaskID)->get_object_type()))
+		else if ((nullptr != objectPool.get(newMaskID)) &&
+		         (VirtualTerminalObjectType::SoftKeyMask == objectPool.get(newMaskID)->get_object_type()))
 		{
 			set_soft_key_mask(newMaskID);
 			retVal = true;
@@ -614,13 +774,13 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool AlarmMask::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool AlarmMask::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
 		for (auto &child : children)
 		{
-			auto childObject = get_object_by_id(child.id, objectPool);
+			auto childObject = objectPool.get(child.id);
 			if (nullptr != childObject)
 			{
 				switch (childObject->get_object_type())
@@ -668,7 +828,7 @@ namespace isobus
 		        (NULL_OBJECT_ID != objectID));
 	}
 
-	bool AlarmMask::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool AlarmMask::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -805,7 +965,7 @@ namespace isobus
 		signalPriority = value;
 	}
 
-	bool AlarmMask::change_soft_key_mask(std::uint16_t newMaskID, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool)
+	bool AlarmMask::change_soft_key_mask(std::uint16_t newMaskID, const VTObjectTable &objectPool)
 	{
 		bool retVal = false;
 
@@ -814,8 +974,8 @@ namespace isobus
 			set_soft_key_mask(newMaskID);
 			retVal = true;
 		}
-		else if ((nullptr != objectPool.at(newMaskID)) &&
-		         (VirtualTerminalObjectType::SoftKeyMask == objectPool.at(newMaskID)->get_object_type()))
+		else if ((nullptr != objectPool.get(newMaskID)) &&
+		         (VirtualTerminalObjectType::SoftKeyMask == objectPool.get(newMaskID)->get_object_type()))
 		{
 			set_soft_key_mask(newMaskID);
 			retVal = true;
@@ -843,13 +1003,13 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool Container::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool Container::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
 		for (auto &child : children)
 		{
-			auto childObject = get_object_by_id(child.id, objectPool);
+			auto childObject = objectPool.get(child.id);
 			if (nullptr != childObject)
 			{
 				switch (childObject->get_object_type())
@@ -897,7 +1057,7 @@ namespace isobus
 		        (NULL_OBJECT_ID != objectID));
 	}
 
-	bool Container::set_attribute(std::uint8_t, std::uint32_t, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool Container::set_attribute(std::uint8_t, std::uint32_t, const VTObjectTable &, AttributeError &returnedError)
 	{
 		// All attributes are read only
 		returnedError = AttributeError::InvalidAttributeID;
@@ -970,13 +1130,13 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool SoftKeyMask::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool SoftKeyMask::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
 		for (auto &child : children)
 		{
-			auto childObject = get_object_by_id(child.id, objectPool);
+			auto childObject = objectPool.get(child.id);
 			if (nullptr != childObject)
 			{
 				switch (childObject->get_object_type())
@@ -1002,7 +1162,7 @@ namespace isobus
 		        (NULL_OBJECT_ID != objectID));
 	}
 
-	bool SoftKeyMask::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool SoftKeyMask::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -1073,13 +1233,13 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool Key::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool Key::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
 		for (auto &child : children)
 		{
-			auto childObject = get_object_by_id(child.id, objectPool);
+			auto childObject = objectPool.get(child.id);
 			if (nullptr != childObject)
 			{
 				switch (childObject->get_object_type())
@@ -1119,7 +1279,7 @@ namespace isobus
 		        (NULL_OBJECT_ID != objectID));
 	}
 
-	bool Key::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool Key::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -1214,7 +1374,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool KeyGroup::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool KeyGroup::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -1222,7 +1382,7 @@ namespace isobus
 		{
 			for (auto &child : children)
 			{
-				auto childObject = get_object_by_id(child.id, objectPool);
+				auto childObject = objectPool.get(child.id);
 				if (nullptr != childObject)
 				{
 					switch (childObject->get_object_type())
@@ -1236,12 +1396,12 @@ namespace isobus
 
 						case VirtualTerminalObjectType::ObjectPointer:
 						{
-							auto objectPointer = std::static_pointer_cast<ObjectPointer>(childObject);
+							auto objectPointer = static_cast<ObjectPointer *>(childObject);
 
 							if (NULL_OBJECT_ID != objectPointer->get_value())
 							{
-								if ((nullptr != get_object_by_id(objectPointer->get_value(), objectPool)) &&
-								    (VirtualTerminalObjectType::Key == get_object_by_id(objectPointer->get_value(), objectPool)->get_object_type()))
+								if ((nullptr != objectPool.get(objectPointer->get_value())) &&
+								    (VirtualTerminalObjectType::Key == objectPool.get(objectPointer->get_value())->get_object_type()))
 								{
 									// Valid Child Object
 								}
@@ -1279,7 +1439,7 @@ namespace isobus
 		        (NULL_OBJECT_ID != objectID));
 	}
 
-	bool KeyGroup::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool KeyGroup::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -1298,10 +1458,9 @@ namespace isobus
 				{
 					returnedError = AttributeError::InvalidValue;
 
-					if (objectPool.find(objectID) != objectPool.end())
+					if (objectPool.contains(objectID))
 					{
 						auto newName = static_cast<std::uint16_t>(rawAttributeData);
-						auto newNameObject = objectPool.at(newName);
 
 						if (validate_name(newName, objectPool))
 						{
@@ -1411,9 +1570,9 @@ namespace isobus
 		}
 	}
 
-	bool KeyGroup::validate_name(std::uint16_t nameIDToValidate, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool KeyGroup::validate_name(std::uint16_t nameIDToValidate, const VTObjectTable &objectPool) const
 	{
-		auto newNameObject = objectPool.at(nameIDToValidate);
+		auto newNameObject = objectPool.get(nameIDToValidate);
 		bool retVal = false;
 
 		if ((NULL_OBJECT_ID != nameIDToValidate) &&
@@ -1425,7 +1584,7 @@ namespace isobus
 			{
 				if (newNameObject->get_number_children() > 0)
 				{
-					auto label = objectPool.at(std::static_pointer_cast<ObjectPointer>(newNameObject)->get_child_id(0));
+					auto label = objectPool.get(static_cast<ObjectPointer *>(newNameObject)->get_child_id(0));
 
 					if ((nullptr != label) &&
 					    (VirtualTerminalObjectType::OutputString == label->get_object_type()))
@@ -1452,13 +1611,13 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool Button::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool Button::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
 		for (auto &child : children)
 		{
-			auto childObject = get_object_by_id(child.id, objectPool);
+			auto childObject = objectPool.get(child.id);
 			if (nullptr != childObject)
 			{
 				switch (childObject->get_object_type())
@@ -1497,7 +1656,7 @@ namespace isobus
 		        (NULL_OBJECT_ID != objectID));
 	}
 
-	bool Button::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool Button::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -1680,14 +1839,14 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool InputBoolean::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool InputBoolean::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
 		// Verify the variable reference is a number variable or NULL_OBJECT_ID
 		if (NULL_OBJECT_ID != get_variable_reference())
 		{
-			auto variableReference = get_object_by_id(get_variable_reference(), objectPool);
+			auto variableReference = objectPool.get(get_variable_reference());
 
 			if (nullptr != variableReference)
 			{
@@ -1705,7 +1864,7 @@ namespace isobus
 		// Verify that the foreground colour is a font attribute or NULL_OBJECT_ID
 		if (NULL_OBJECT_ID != get_foreground_colour_object_id())
 		{
-			auto foregroundColour = get_object_by_id(get_foreground_colour_object_id(), objectPool);
+			auto foregroundColour = objectPool.get(get_foreground_colour_object_id());
 
 			if (nullptr != foregroundColour)
 			{
@@ -1722,7 +1881,7 @@ namespace isobus
 
 		for (const auto &child : children)
 		{
-			auto childObject = get_object_by_id(child.id, objectPool);
+			auto childObject = objectPool.get(child.id);
 
 			if ((nullptr == childObject) ||
 			    (VirtualTerminalObjectType::Macro != childObject->get_object_type()))
@@ -1734,7 +1893,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool InputBoolean::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool InputBoolean::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -1765,10 +1924,10 @@ namespace isobus
 						set_foreground_colour_object_id(static_cast<std::uint16_t>(rawAttributeData));
 						retVal = true;
 					}
-					else if (objectPool.find(static_cast<std::uint16_t>(rawAttributeData)) != objectPool.end())
+					else if (objectPool.contains(static_cast<std::uint16_t>(rawAttributeData)))
 					{
-						if (nullptr != objectPool.at(static_cast<std::uint16_t>(rawAttributeData)) &&
-						    (VirtualTerminalObjectType::FontAttributes == objectPool.at(static_cast<std::uint16_t>(rawAttributeData))->get_object_type()))
+						if (nullptr != objectPool.get(static_cast<std::uint16_t>(rawAttributeData)) &&
+						    (VirtualTerminalObjectType::FontAttributes == objectPool.get(static_cast<std::uint16_t>(rawAttributeData))->get_object_type()))
 						{
 							set_foreground_colour_object_id(static_cast<std::uint16_t>(rawAttributeData));
 							retVal = true;
@@ -1790,10 +1949,10 @@ namespace isobus
 						set_variable_reference(static_cast<std::uint16_t>(rawAttributeData));
 						retVal = true;
 					}
-					else if (objectPool.find(static_cast<std::uint16_t>(rawAttributeData)) != objectPool.end())
+					else if (objectPool.contains(static_cast<std::uint16_t>(rawAttributeData)))
 					{
-						if (nullptr != objectPool.at(static_cast<std::uint16_t>(rawAttributeData)) &&
-						    (VirtualTerminalObjectType::NumberVariable == objectPool.at(static_cast<std::uint16_t>(rawAttributeData))->get_object_type()))
+						if (nullptr != objectPool.get(static_cast<std::uint16_t>(rawAttributeData)) &&
+						    (VirtualTerminalObjectType::NumberVariable == objectPool.get(static_cast<std::uint16_t>(rawAttributeData))->get_object_type()))
 						{
 							set_variable_reference(static_cast<std::uint16_t>(rawAttributeData));
 							retVal = true;
@@ -1968,13 +2127,13 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool InputString::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool InputString::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
 		if (NULL_OBJECT_ID != get_variable_reference())
 		{
-			auto objectToCheck = get_object_by_id(get_variable_reference(), objectPool);
+			auto objectToCheck = objectPool.get(get_variable_reference());
 
 			if (nullptr != objectToCheck)
 			{
@@ -1991,7 +2150,7 @@ namespace isobus
 
 		if (NULL_OBJECT_ID != get_input_attributes())
 		{
-			auto objectToCheck = get_object_by_id(get_input_attributes(), objectPool);
+			auto objectToCheck = objectPool.get(get_input_attributes());
 
 			if (nullptr != objectToCheck)
 			{
@@ -2008,7 +2167,7 @@ namespace isobus
 
 		if (NULL_OBJECT_ID != get_font_attributes())
 		{
-			auto objectToCheck = get_object_by_id(get_font_attributes(), objectPool);
+			auto objectToCheck = objectPool.get(get_font_attributes());
 
 			if (nullptr != objectToCheck)
 			{
@@ -2025,7 +2184,7 @@ namespace isobus
 
 		for (const auto &child : children)
 		{
-			auto childObject = get_object_by_id(child.id, objectPool);
+			auto childObject = objectPool.get(child.id);
 
 			if ((nullptr == childObject) ||
 			    (VirtualTerminalObjectType::Macro != childObject->get_object_type()))
@@ -2037,7 +2196,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool InputString::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool InputString::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -2068,7 +2227,7 @@ namespace isobus
 
 				case AttributeName::FontAttributes:
 				{
-					auto fontAttributesObject = get_object_by_id(static_cast<std::uint16_t>(rawAttributeData), objectPool);
+					auto fontAttributesObject = objectPool.get(static_cast<std::uint16_t>(rawAttributeData));
 
 					if ((NULL_OBJECT_ID == rawAttributeData) ||
 					    ((nullptr != fontAttributesObject) &&
@@ -2086,7 +2245,7 @@ namespace isobus
 
 				case AttributeName::InputAttributes:
 				{
-					auto inputAttributesObject = get_object_by_id(static_cast<std::uint16_t>(rawAttributeData), objectPool);
+					auto inputAttributesObject = objectPool.get(static_cast<std::uint16_t>(rawAttributeData));
 
 					if ((NULL_OBJECT_ID == rawAttributeData) ||
 					    ((nullptr != inputAttributesObject) &&
@@ -2111,7 +2270,7 @@ namespace isobus
 
 				case AttributeName::VariableReference:
 				{
-					auto variableReferenceObject = get_object_by_id(static_cast<std::uint16_t>(rawAttributeData), objectPool);
+					auto variableReferenceObject = objectPool.get(static_cast<std::uint16_t>(rawAttributeData));
 
 					if ((NULL_OBJECT_ID == rawAttributeData) ||
 					    ((nullptr != variableReferenceObject) &&
@@ -2300,14 +2459,14 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool InputNumber::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool InputNumber::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
 		// Verify the variable reference is a number variable or NULL_OBJECT_ID
 		if (NULL_OBJECT_ID != get_variable_reference())
 		{
-			auto variableReference = get_object_by_id(get_variable_reference(), objectPool);
+			auto variableReference = objectPool.get(get_variable_reference());
 
 			if (nullptr != variableReference)
 			{
@@ -2325,7 +2484,7 @@ namespace isobus
 		// Verify that the font attributes is a font attribute or NULL_OBJECT_ID
 		if (NULL_OBJECT_ID != get_font_attributes())
 		{
-			auto fontAttributes = get_object_by_id(get_font_attributes(), objectPool);
+			auto fontAttributes = objectPool.get(get_font_attributes());
 
 			if (nullptr != fontAttributes)
 			{
@@ -2342,7 +2501,7 @@ namespace isobus
 
 		for (const auto &child : children)
 		{
-			auto childObject = get_object_by_id(child.id, objectPool);
+			auto childObject = objectPool.get(child.id);
 
 			if ((nullptr == childObject) ||
 			    (VirtualTerminalObjectType::Macro != childObject->get_object_type()))
@@ -2354,7 +2513,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool InputNumber::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool InputNumber::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -2385,7 +2544,7 @@ namespace isobus
 
 				case AttributeName::FontAttributes:
 				{
-					auto fontAttributesObject = get_object_by_id(static_cast<std::uint16_t>(rawAttributeData), objectPool);
+					auto fontAttributesObject = objectPool.get(static_cast<std::uint16_t>(rawAttributeData));
 
 					if ((NULL_OBJECT_ID == rawAttributeData) ||
 					    ((nullptr != fontAttributesObject) &&
@@ -2410,7 +2569,7 @@ namespace isobus
 
 				case AttributeName::VariableReference:
 				{
-					auto variableObject = get_object_by_id(static_cast<std::uint16_t>(rawAttributeData), objectPool);
+					auto variableObject = objectPool.get(static_cast<std::uint16_t>(rawAttributeData));
 
 					if ((NULL_OBJECT_ID == rawAttributeData) ||
 					    ((nullptr != variableObject) &&
@@ -2727,13 +2886,13 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool InputList::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool InputList::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
 		for (const auto &child : children)
 		{
-			auto childObject = get_object_by_id(child.id, objectPool);
+			auto childObject = objectPool.get(child.id);
 			if (nullptr != childObject)
 			{
 				switch (childObject->get_object_type())
@@ -2772,7 +2931,7 @@ namespace isobus
 		        (NULL_OBJECT_ID != objectID));
 	}
 
-	bool InputList::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool InputList::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -2796,7 +2955,7 @@ namespace isobus
 
 				case AttributeName::VariableReference:
 				{
-					auto variableObject = get_object_by_id(static_cast<std::uint16_t>(rawAttributeData), objectPool);
+					auto variableObject = objectPool.get(static_cast<std::uint16_t>(rawAttributeData));
 
 					if ((NULL_OBJECT_ID == rawAttributeData) ||
 					    ((nullptr != variableObject) &&
@@ -2922,17 +3081,17 @@ namespace isobus
 		}
 	}
 
-	bool InputList::change_list_item(std::uint8_t index, std::uint16_t newListItem, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool)
+	bool InputList::change_list_item(std::uint8_t index, std::uint16_t newListItem, const VTObjectTable &objectPool)
 	{
 		bool retVal = false;
 
 		if ((index < children.size()) &&
 		    ((NULL_OBJECT_ID == newListItem) ||
-		     (nullptr != get_object_by_id(newListItem, objectPool))))
+		     (nullptr != objectPool.get(newListItem))))
 		{
-			if (nullptr != get_object_by_id(newListItem, objectPool))
+			if (nullptr != objectPool.get(newListItem))
 			{
-				switch (get_object_by_id(newListItem, objectPool)->get_object_type())
+				switch (objectPool.get(newListItem)->get_object_type())
 				{
 					case VirtualTerminalObjectType::WorkingSet:
 					case VirtualTerminalObjectType::Container:
@@ -2983,14 +3142,14 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool OutputString::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool OutputString::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
 		// Verify the variable reference is a number variable or NULL_OBJECT_ID
 		if (NULL_OBJECT_ID != get_variable_reference())
 		{
-			auto variableReference = get_object_by_id(get_variable_reference(), objectPool);
+			auto variableReference = objectPool.get(get_variable_reference());
 
 			if (nullptr != variableReference)
 			{
@@ -3008,7 +3167,7 @@ namespace isobus
 		// Verify that the font attributes is a font attribute or NULL_OBJECT_ID
 		if (NULL_OBJECT_ID != get_font_attributes())
 		{
-			auto fontAttributes = get_object_by_id(get_font_attributes(), objectPool);
+			auto fontAttributes = objectPool.get(get_font_attributes());
 
 			if (nullptr != fontAttributes)
 			{
@@ -3025,7 +3184,7 @@ namespace isobus
 
 		for (const auto &child : children)
 		{
-			auto childObject = get_object_by_id(child.id, objectPool);
+			auto childObject = objectPool.get(child.id);
 
 			if ((nullptr == childObject) ||
 			    (VirtualTerminalObjectType::Macro != childObject->get_object_type()))
@@ -3037,7 +3196,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool OutputString::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool OutputString::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -3068,7 +3227,7 @@ namespace isobus
 
 				case AttributeName::FontAttributes:
 				{
-					auto fontAttributesObject = get_object_by_id(static_cast<std::uint16_t>(rawAttributeData), objectPool);
+					auto fontAttributesObject = objectPool.get(static_cast<std::uint16_t>(rawAttributeData));
 
 					if ((NULL_OBJECT_ID == rawAttributeData) ||
 					    ((nullptr != fontAttributesObject) &&
@@ -3093,7 +3252,7 @@ namespace isobus
 
 				case AttributeName::VariableReference:
 				{
-					auto variableObject = get_object_by_id(static_cast<std::uint16_t>(rawAttributeData), objectPool);
+					auto variableObject = objectPool.get(static_cast<std::uint16_t>(rawAttributeData));
 
 					if ((NULL_OBJECT_ID == rawAttributeData) ||
 					    ((nullptr != variableObject) &&
@@ -3221,15 +3380,15 @@ namespace isobus
 		}
 	}
 
-	std::string StringVTObject::displayed_value(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	std::string StringVTObject::displayed_value(const VTObjectTable &objectPool) const
 	{
 		if (isobus::NULL_OBJECT_ID != get_variable_reference())
 		{
-			auto child = get_object_by_id(get_variable_reference(), objectPool);
+			auto child = objectPool.get(get_variable_reference());
 
 			if ((nullptr != child) && (isobus::VirtualTerminalObjectType::StringVariable == child->get_object_type()))
 			{
-				return std::static_pointer_cast<isobus::StringVariable>(child)->get_value();
+				return static_cast<isobus::StringVariable *>(child)->get_value();
 			}
 		}
 		return get_value();
@@ -3245,14 +3404,14 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool OutputNumber::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool OutputNumber::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
 		// Verify the variable reference is a number variable or NULL_OBJECT_ID
 		if (NULL_OBJECT_ID != get_variable_reference())
 		{
-			auto variableReference = get_object_by_id(get_variable_reference(), objectPool);
+			auto variableReference = objectPool.get(get_variable_reference());
 
 			if (nullptr != variableReference)
 			{
@@ -3270,7 +3429,7 @@ namespace isobus
 		// Verify that the font attributes is a font attribute or NULL_OBJECT_ID
 		if (NULL_OBJECT_ID != get_font_attributes())
 		{
-			auto fontAttributes = get_object_by_id(get_font_attributes(), objectPool);
+			auto fontAttributes = objectPool.get(get_font_attributes());
 
 			if (nullptr != fontAttributes)
 			{
@@ -3287,7 +3446,7 @@ namespace isobus
 
 		for (const auto &child : children)
 		{
-			auto childObject = get_object_by_id(child.id, objectPool);
+			auto childObject = objectPool.get(child.id);
 
 			if ((nullptr == childObject) ||
 			    (VirtualTerminalObjectType::Macro != childObject->get_object_type()))
@@ -3299,7 +3458,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool OutputNumber::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool OutputNumber::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -3330,7 +3489,7 @@ namespace isobus
 
 				case AttributeName::FontAttributes:
 				{
-					auto fontAttributesObject = get_object_by_id(static_cast<std::uint16_t>(rawAttributeData), objectPool);
+					auto fontAttributesObject = objectPool.get(static_cast<std::uint16_t>(rawAttributeData));
 
 					if ((NULL_OBJECT_ID == rawAttributeData) ||
 					    ((nullptr != fontAttributesObject) &&
@@ -3355,7 +3514,7 @@ namespace isobus
 
 				case AttributeName::VariableReference:
 				{
-					auto variableObject = get_object_by_id(static_cast<std::uint16_t>(rawAttributeData), objectPool);
+					auto variableObject = objectPool.get(static_cast<std::uint16_t>(rawAttributeData));
 
 					if ((NULL_OBJECT_ID == rawAttributeData) ||
 					    ((nullptr != variableObject) &&
@@ -3581,14 +3740,14 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool OutputList::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool OutputList::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
 		// Verify the variable reference is a number variable or NULL_OBJECT_ID
 		if (NULL_OBJECT_ID != get_variable_reference())
 		{
-			auto variableReference = get_object_by_id(get_variable_reference(), objectPool);
+			auto variableReference = objectPool.get(get_variable_reference());
 
 			if (nullptr != variableReference)
 			{
@@ -3605,7 +3764,7 @@ namespace isobus
 
 		for (const auto &child : children)
 		{
-			auto childObject = get_object_by_id(child.id, objectPool);
+			auto childObject = objectPool.get(child.id);
 			if (nullptr != childObject)
 			{
 				switch (childObject->get_object_type())
@@ -3652,7 +3811,7 @@ namespace isobus
 		        (NULL_OBJECT_ID != objectID));
 	}
 
-	bool OutputList::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool OutputList::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -3676,7 +3835,7 @@ namespace isobus
 
 				case AttributeName::VariableReference:
 				{
-					auto variableObject = get_object_by_id(static_cast<std::uint16_t>(rawAttributeData), objectPool);
+					auto variableObject = objectPool.get(static_cast<std::uint16_t>(rawAttributeData));
 
 					if ((NULL_OBJECT_ID == rawAttributeData) ||
 					    ((nullptr != variableObject) &&
@@ -3786,14 +3945,14 @@ namespace isobus
 		value = aValue;
 	}
 
-	bool OutputList::change_list_item(std::uint8_t index, std::uint16_t newListItem, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool)
+	bool OutputList::change_list_item(std::uint8_t index, std::uint16_t newListItem, const VTObjectTable &objectPool)
 	{
 		bool retVal = false;
 
 		if ((index < children.size()) &&
 		    ((NULL_OBJECT_ID == newListItem) ||
-		     ((nullptr != get_object_by_id(newListItem, objectPool)) &&
-		      (VirtualTerminalObjectType::NumberVariable == get_object_by_id(newListItem, objectPool)->get_object_type()))))
+		     ((nullptr != objectPool.get(newListItem)) &&
+		      (VirtualTerminalObjectType::NumberVariable == objectPool.get(newListItem)->get_object_type()))))
 		{
 			children.at(index).id = newListItem;
 			retVal = true;
@@ -3806,14 +3965,14 @@ namespace isobus
 		return VirtualTerminalObjectType::OutputLine;
 	}
 
-	bool OutputLine::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool OutputLine::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
 		// Verify the line attributes is a line attribute or NULL_OBJECT_ID
 		if (NULL_OBJECT_ID != get_line_attributes())
 		{
-			auto lineAttributesObject = get_object_by_id(get_line_attributes(), objectPool);
+			auto lineAttributesObject = objectPool.get(get_line_attributes());
 
 			if (nullptr != lineAttributesObject)
 			{
@@ -3830,7 +3989,7 @@ namespace isobus
 
 		for (const auto &child : children)
 		{
-			auto childObject = get_object_by_id(child.id, objectPool);
+			auto childObject = objectPool.get(child.id);
 
 			if ((nullptr == childObject) ||
 			    (VirtualTerminalObjectType::Macro != childObject->get_object_type()))
@@ -3842,7 +4001,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool OutputLine::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool OutputLine::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -3852,7 +4011,7 @@ namespace isobus
 			{
 				case AttributeName::LineAttributes:
 				{
-					auto lineAttributeObject = get_object_by_id(static_cast<std::uint16_t>(rawAttributeData), objectPool);
+					auto lineAttributeObject = objectPool.get(static_cast<std::uint16_t>(rawAttributeData));
 
 					if ((NULL_OBJECT_ID == rawAttributeData) ||
 					    ((nullptr != lineAttributeObject) &&
@@ -3998,14 +4157,14 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool OutputRectangle::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool OutputRectangle::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
 		// Verify the line attributes is a line attribute or NULL_OBJECT_ID
 		if (NULL_OBJECT_ID != get_line_attributes())
 		{
-			auto lineAttributesObject = get_object_by_id(get_line_attributes(), objectPool);
+			auto lineAttributesObject = objectPool.get(get_line_attributes());
 
 			if (nullptr != lineAttributesObject)
 			{
@@ -4023,7 +4182,7 @@ namespace isobus
 		// Verify the fill attributes is a fill attribute or NULL_OBJECT_ID
 		if (NULL_OBJECT_ID != get_fill_attributes())
 		{
-			auto fillAttributesObject = get_object_by_id(get_fill_attributes(), objectPool);
+			auto fillAttributesObject = objectPool.get(get_fill_attributes());
 
 			if (nullptr != fillAttributesObject)
 			{
@@ -4040,7 +4199,7 @@ namespace isobus
 
 		for (const auto &child : children)
 		{
-			auto childObject = get_object_by_id(child.id, objectPool);
+			auto childObject = objectPool.get(child.id);
 
 			if ((nullptr == childObject) ||
 			    (VirtualTerminalObjectType::Macro != childObject->get_object_type()))
@@ -4052,7 +4211,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool OutputRectangle::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool OutputRectangle::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -4062,7 +4221,7 @@ namespace isobus
 			{
 				case AttributeName::LineAttributes:
 				{
-					auto lineAttributeObject = get_object_by_id(static_cast<std::uint16_t>(rawAttributeData), objectPool);
+					auto lineAttributeObject = objectPool.get(static_cast<std::uint16_t>(rawAttributeData));
 
 					if ((NULL_OBJECT_ID == rawAttributeData) ||
 					    ((nullptr != lineAttributeObject) &&
@@ -4101,7 +4260,7 @@ namespace isobus
 
 				case AttributeName::FillAttributes:
 				{
-					auto fillAttributeObject = get_object_by_id(static_cast<std::uint16_t>(rawAttributeData), objectPool);
+					auto fillAttributeObject = objectPool.get(static_cast<std::uint16_t>(rawAttributeData));
 
 					if ((NULL_OBJECT_ID == rawAttributeData) ||
 					    ((nullptr != fillAttributeObject) &&
@@ -4231,14 +4390,14 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool OutputEllipse::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool OutputEllipse::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
 		// Verify the line attributes is a line attribute or NULL_OBJECT_ID
 		if (NULL_OBJECT_ID != get_line_attributes())
 		{
-			auto lineAttributesObject = get_object_by_id(get_line_attributes(), objectPool);
+			auto lineAttributesObject = objectPool.get(get_line_attributes());
 
 			if (nullptr != lineAttributesObject)
 			{
@@ -4256,7 +4415,7 @@ namespace isobus
 		// Verify the fill attributes is a fill attribute or NULL_OBJECT_ID
 		if (NULL_OBJECT_ID != get_fill_attributes())
 		{
-			auto fillAttributesObject = get_object_by_id(get_fill_attributes(), objectPool);
+			auto fillAttributesObject = objectPool.get(get_fill_attributes());
 
 			if (nullptr != fillAttributesObject)
 			{
@@ -4273,7 +4432,7 @@ namespace isobus
 
 		for (const auto &child : children)
 		{
-			auto childObject = get_object_by_id(child.id, objectPool);
+			auto childObject = objectPool.get(child.id);
 
 			if ((nullptr == childObject) ||
 			    (VirtualTerminalObjectType::Macro != childObject->get_object_type()))
@@ -4285,7 +4444,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool OutputEllipse::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool OutputEllipse::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -4295,7 +4454,7 @@ namespace isobus
 			{
 				case AttributeName::LineAttributes:
 				{
-					auto lineAttributeObject = get_object_by_id(static_cast<std::uint16_t>(rawAttributeData), objectPool);
+					auto lineAttributeObject = objectPool.get(static_cast<std::uint16_t>(rawAttributeData));
 
 					if ((NULL_OBJECT_ID == rawAttributeData) ||
 					    ((nullptr != lineAttributeObject) &&
@@ -4355,7 +4514,7 @@ namespace isobus
 
 				case AttributeName::FillAttributes:
 				{
-					auto fillAttributeObject = get_object_by_id(static_cast<std::uint16_t>(rawAttributeData), objectPool);
+					auto fillAttributeObject = objectPool.get(static_cast<std::uint16_t>(rawAttributeData));
 
 					if ((NULL_OBJECT_ID == rawAttributeData) ||
 					    ((nullptr != fillAttributeObject) &&
@@ -4519,14 +4678,14 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool OutputPolygon::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool OutputPolygon::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
 		// Verify the line attributes is a line attribute or NULL_OBJECT_ID
 		if (NULL_OBJECT_ID != get_line_attributes())
 		{
-			auto lineAttributesObject = get_object_by_id(get_line_attributes(), objectPool);
+			auto lineAttributesObject = objectPool.get(get_line_attributes());
 
 			if (nullptr != lineAttributesObject)
 			{
@@ -4544,7 +4703,7 @@ namespace isobus
 		// Verify the fill attributes is a fill attribute or NULL_OBJECT_ID
 		if (NULL_OBJECT_ID != get_fill_attributes())
 		{
-			auto fillAttributesObject = get_object_by_id(get_fill_attributes(), objectPool);
+			auto fillAttributesObject = objectPool.get(get_fill_attributes());
 
 			if (nullptr != fillAttributesObject)
 			{
@@ -4561,7 +4720,7 @@ namespace isobus
 
 		for (const auto &child : children)
 		{
-			auto childObject = get_object_by_id(child.id, objectPool);
+			auto childObject = objectPool.get(child.id);
 
 			if ((nullptr == childObject) ||
 			    (VirtualTerminalObjectType::Macro != childObject->get_object_type()))
@@ -4573,7 +4732,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool OutputPolygon::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool OutputPolygon::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -4597,7 +4756,7 @@ namespace isobus
 
 				case AttributeName::LineAttributes:
 				{
-					auto lineAttributeObject = get_object_by_id(static_cast<std::uint16_t>(rawAttributeData), objectPool);
+					auto lineAttributeObject = objectPool.get(static_cast<std::uint16_t>(rawAttributeData));
 
 					if ((NULL_OBJECT_ID == rawAttributeData) ||
 					    ((nullptr != lineAttributeObject) &&
@@ -4615,7 +4774,7 @@ namespace isobus
 
 				case AttributeName::FillAttributes:
 				{
-					auto fillAttributeObject = get_object_by_id(static_cast<std::uint16_t>(rawAttributeData), objectPool);
+					auto fillAttributeObject = objectPool.get(static_cast<std::uint16_t>(rawAttributeData));
 
 					if ((NULL_OBJECT_ID == rawAttributeData) ||
 					    ((nullptr != fillAttributeObject) &&
@@ -4793,14 +4952,14 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool OutputMeter::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool OutputMeter::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
 		// Verify the variable reference is a number variable or NULL_OBJECT_ID
 		if (NULL_OBJECT_ID != get_variable_reference())
 		{
-			auto variableObject = get_object_by_id(get_variable_reference(), objectPool);
+			auto variableObject = objectPool.get(get_variable_reference());
 
 			if (nullptr != variableObject)
 			{
@@ -4817,7 +4976,7 @@ namespace isobus
 
 		for (const auto &child : children)
 		{
-			auto childObject = get_object_by_id(child.id, objectPool);
+			auto childObject = objectPool.get(child.id);
 
 			if ((nullptr == childObject) ||
 			    (VirtualTerminalObjectType::Macro != childObject->get_object_type()))
@@ -4829,7 +4988,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool OutputMeter::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool OutputMeter::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -4909,7 +5068,7 @@ namespace isobus
 
 				case AttributeName::VariableReference:
 				{
-					auto variableObject = get_object_by_id(static_cast<std::uint16_t>(rawAttributeData), objectPool);
+					auto variableObject = objectPool.get(static_cast<std::uint16_t>(rawAttributeData));
 
 					if ((NULL_OBJECT_ID == rawAttributeData) ||
 					    ((nullptr != variableObject) &&
@@ -5177,14 +5336,14 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool OutputLinearBarGraph::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool OutputLinearBarGraph::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
 		// Verify the variable reference is a number variable or NULL_OBJECT_ID
 		if (NULL_OBJECT_ID != get_variable_reference())
 		{
-			auto variableObject = get_object_by_id(get_variable_reference(), objectPool);
+			auto variableObject = objectPool.get(get_variable_reference());
 
 			if (nullptr != variableObject)
 			{
@@ -5202,7 +5361,7 @@ namespace isobus
 		// Verify the target value variable reference is a number variable or NULL_OBJECT_ID
 		if (NULL_OBJECT_ID != get_target_value_reference())
 		{
-			auto variableObject = get_object_by_id(get_target_value_reference(), objectPool);
+			auto variableObject = objectPool.get(get_target_value_reference());
 
 			if (nullptr != variableObject)
 			{
@@ -5219,7 +5378,7 @@ namespace isobus
 
 		for (const auto &child : children)
 		{
-			auto childObject = get_object_by_id(child.id, objectPool);
+			auto childObject = objectPool.get(child.id);
 
 			if ((nullptr == childObject) ||
 			    (VirtualTerminalObjectType::Macro != childObject->get_object_type()))
@@ -5231,7 +5390,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool OutputLinearBarGraph::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool OutputLinearBarGraph::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -5297,7 +5456,7 @@ namespace isobus
 
 				case AttributeName::VariableReference:
 				{
-					auto variableObject = get_object_by_id(static_cast<std::uint16_t>(rawAttributeData), objectPool);
+					auto variableObject = objectPool.get(static_cast<std::uint16_t>(rawAttributeData));
 
 					if ((NULL_OBJECT_ID == rawAttributeData) ||
 					    ((nullptr != variableObject) &&
@@ -5569,14 +5728,14 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool OutputArchedBarGraph::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool OutputArchedBarGraph::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
 		// Verify the variable reference is a number variable or NULL_OBJECT_ID
 		if (NULL_OBJECT_ID != get_variable_reference())
 		{
-			auto variableObject = get_object_by_id(get_variable_reference(), objectPool);
+			auto variableObject = objectPool.get(get_variable_reference());
 
 			if (nullptr != variableObject)
 			{
@@ -5594,7 +5753,7 @@ namespace isobus
 		// Verify the target value variable reference is a number variable or NULL_OBJECT_ID
 		if (NULL_OBJECT_ID != get_target_value_reference())
 		{
-			auto variableObject = get_object_by_id(get_target_value_reference(), objectPool);
+			auto variableObject = objectPool.get(get_target_value_reference());
 
 			if (nullptr != variableObject)
 			{
@@ -5611,7 +5770,7 @@ namespace isobus
 
 		for (const auto &child : children)
 		{
-			auto childObject = get_object_by_id(child.id, objectPool);
+			auto childObject = objectPool.get(child.id);
 
 			if ((nullptr == childObject) ||
 			    (VirtualTerminalObjectType::Macro != childObject->get_object_type()))
@@ -5623,7 +5782,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool OutputArchedBarGraph::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool OutputArchedBarGraph::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -5703,7 +5862,7 @@ namespace isobus
 
 				case AttributeName::VariableReference:
 				{
-					auto variableObject = get_object_by_id(static_cast<std::uint16_t>(rawAttributeData), objectPool);
+					auto variableObject = objectPool.get(static_cast<std::uint16_t>(rawAttributeData));
 
 					if ((NULL_OBJECT_ID == rawAttributeData) ||
 					    ((nullptr != variableObject) &&
@@ -5995,12 +6154,12 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool PictureGraphic::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &) const
+	bool PictureGraphic::get_is_valid(const VTObjectTable &) const
 	{
 		return true;
 	}
 
-	bool PictureGraphic::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool PictureGraphic::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -6117,13 +6276,7 @@ namespace isobus
 
 	void PictureGraphic::set_raw_data(const std::uint8_t *data, std::uint32_t size)
 	{
-		rawData.clear();
-		rawData.resize(size);
-
-		for (std::uint32_t i = 0; i < size; i++)
-		{
-			rawData[i] = data[i];
-		}
+		rawData.assign(data, data + size);
 	}
 
 	void PictureGraphic::add_raw_data(std::uint8_t dataByte)
@@ -6217,12 +6370,12 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool NumberVariable::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &) const
+	bool NumberVariable::get_is_valid(const VTObjectTable &) const
 	{
 		return true;
 	}
 
-	bool NumberVariable::set_attribute(std::uint8_t, std::uint32_t, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool NumberVariable::set_attribute(std::uint8_t, std::uint32_t, const VTObjectTable &, AttributeError &returnedError)
 	{
 		returnedError = AttributeError::InvalidAttributeID;
 		return false;
@@ -6280,12 +6433,12 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool StringVariable::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &) const
+	bool StringVariable::get_is_valid(const VTObjectTable &) const
 	{
 		return true;
 	}
 
-	bool StringVariable::set_attribute(std::uint8_t, std::uint32_t, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool StringVariable::set_attribute(std::uint8_t, std::uint32_t, const VTObjectTable &, AttributeError &returnedError)
 	{
 		returnedError = AttributeError::InvalidAttributeID;
 		return false;
@@ -6336,12 +6489,12 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool FontAttributes::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &) const
+	bool FontAttributes::get_is_valid(const VTObjectTable &) const
 	{
 		return true;
 	}
 
-	bool FontAttributes::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool FontAttributes::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -6665,12 +6818,12 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool LineAttributes::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &) const
+	bool LineAttributes::get_is_valid(const VTObjectTable &) const
 	{
 		return true;
 	}
 
-	bool LineAttributes::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool LineAttributes::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -6779,14 +6932,14 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool FillAttributes::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool FillAttributes::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		return ((NULL_OBJECT_ID == get_fill_pattern()) ||
-		        ((nullptr != get_object_by_id(get_fill_pattern(), objectPool)) &&
-		         (VirtualTerminalObjectType::PictureGraphic == get_object_by_id(get_fill_pattern(), objectPool)->get_object_type())));
+		        ((nullptr != objectPool.get(get_fill_pattern())) &&
+		         (VirtualTerminalObjectType::PictureGraphic == objectPool.get(get_fill_pattern())->get_object_type())));
 	}
 
-	bool FillAttributes::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool FillAttributes::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -6817,7 +6970,7 @@ namespace isobus
 
 				case AttributeName::FillPattern:
 				{
-					auto fillPictureGraphic = get_object_by_id(static_cast<std::uint16_t>(rawAttributeData), objectPool);
+					auto fillPictureGraphic = objectPool.get(static_cast<std::uint16_t>(rawAttributeData));
 
 					if (NULL_OBJECT_ID == rawAttributeData)
 					{
@@ -6927,12 +7080,12 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool InputAttributes::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &) const
+	bool InputAttributes::get_is_valid(const VTObjectTable &) const
 	{
 		return true;
 	}
 
-	bool InputAttributes::set_attribute(std::uint8_t, std::uint32_t, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool InputAttributes::set_attribute(std::uint8_t, std::uint32_t, const VTObjectTable &, AttributeError &returnedError)
 	{
 		returnedError = AttributeError::InvalidAttributeID;
 		return false;
@@ -7000,12 +7153,12 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool ExtendedInputAttributes::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &) const
+	bool ExtendedInputAttributes::get_is_valid(const VTObjectTable &) const
 	{
 		return true;
 	}
 
-	bool ExtendedInputAttributes::set_attribute(std::uint8_t, std::uint32_t, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool ExtendedInputAttributes::set_attribute(std::uint8_t, std::uint32_t, const VTObjectTable &, AttributeError &returnedError)
 	{
 		returnedError = AttributeError::InvalidAttributeID;
 		return false;
@@ -7073,12 +7226,12 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool ObjectPointer::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool ObjectPointer::get_is_valid(const VTObjectTable &objectPool) const
 	{
-		return ((NULL_OBJECT_ID == value) || (nullptr != get_object_by_id(value, objectPool)));
+		return ((NULL_OBJECT_ID == value) || (nullptr != objectPool.get(value)));
 	}
 
-	bool ObjectPointer::set_attribute(std::uint8_t, std::uint32_t, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool ObjectPointer::set_attribute(std::uint8_t, std::uint32_t, const VTObjectTable &, AttributeError &returnedError)
 	{
 		returnedError = AttributeError::InvalidAttributeID;
 		return false;
@@ -7142,16 +7295,16 @@ namespace isobus
 		return 9;
 	}
 
-	bool ExternalObjectPointer::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool ExternalObjectPointer::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool isDefaultObjectValid = (NULL_OBJECT_ID == get_default_object_id()) ||
-		  (nullptr != objectPool.at(get_default_object_id()));
+		  (nullptr != objectPool.get(get_default_object_id()));
 		bool isExternalNAMEIDValid = (NULL_OBJECT_ID == get_external_reference_name_id()) ||
-		  (nullptr != objectPool.at(get_external_reference_name_id()));
+		  (nullptr != objectPool.get(get_external_reference_name_id()));
 		return (isDefaultObjectValid && isExternalNAMEIDValid);
 	}
 
-	bool ExternalObjectPointer::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool ExternalObjectPointer::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -7162,7 +7315,7 @@ namespace isobus
 				case AttributeName::DefaultObjectID:
 				{
 					if ((NULL_OBJECT_ID == rawAttributeData) ||
-					    (nullptr != get_object_by_id(static_cast<std::uint16_t>(rawAttributeData), objectPool)))
+					    (nullptr != objectPool.get(static_cast<std::uint16_t>(rawAttributeData))))
 					{
 						set_default_object_id(static_cast<std::uint16_t>(rawAttributeData));
 						retVal = true;
@@ -7177,7 +7330,7 @@ namespace isobus
 				case AttributeName::ExternalReferenceNAMEID:
 				{
 					if ((NULL_OBJECT_ID == rawAttributeData) ||
-					    (nullptr != get_object_by_id(static_cast<std::uint16_t>(rawAttributeData), objectPool)))
+					    (nullptr != objectPool.get(static_cast<std::uint16_t>(rawAttributeData))))
 					{
 						set_external_reference_name_id(static_cast<std::uint16_t>(rawAttributeData));
 						retVal = true;
@@ -7326,12 +7479,12 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool Macro::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &) const
+	bool Macro::get_is_valid(const VTObjectTable &) const
 	{
 		return get_are_command_packets_valid();
 	}
 
-	bool Macro::set_attribute(std::uint8_t, std::uint32_t, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool Macro::set_attribute(std::uint8_t, std::uint32_t, const VTObjectTable &, AttributeError &returnedError)
 	{
 		returnedError = AttributeError::InvalidAttributeID;
 		return false;
@@ -7443,12 +7596,12 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool ColourMap::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &) const
+	bool ColourMap::get_is_valid(const VTObjectTable &) const
 	{
 		return true;
 	}
 
-	bool ColourMap::set_attribute(std::uint8_t, std::uint32_t, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool ColourMap::set_attribute(std::uint8_t, std::uint32_t, const VTObjectTable &, AttributeError &returnedError)
 	{
 		returnedError = AttributeError::InvalidAttributeID;
 		return false;
@@ -7538,7 +7691,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool WindowMask::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool WindowMask::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -7546,7 +7699,7 @@ namespace isobus
 		{
 			if (NULL_OBJECT_ID != title)
 			{
-				auto titleObject = get_object_by_id(title, objectPool);
+				auto titleObject = objectPool.get(title);
 
 				if (nullptr != titleObject)
 				{
@@ -7563,8 +7716,8 @@ namespace isobus
 						}
 						else
 						{
-							std::uint16_t titleObjectPointedTo = std::static_pointer_cast<ObjectPointer>(titleObject)->get_child_id(0);
-							auto child = get_object_by_id(titleObjectPointedTo, objectPool);
+							std::uint16_t titleObjectPointedTo = static_cast<ObjectPointer *>(titleObject)->get_child_id(0);
+							auto child = objectPool.get(titleObjectPointedTo);
 
 							if ((nullptr != child) && (VirtualTerminalObjectType::OutputString == child->get_object_type()))
 							{
@@ -7593,7 +7746,7 @@ namespace isobus
 
 			if (NULL_OBJECT_ID != name)
 			{
-				auto nameObject = get_object_by_id(name, objectPool);
+				auto nameObject = objectPool.get(name);
 
 				if (nullptr != nameObject)
 				{
@@ -7610,8 +7763,8 @@ namespace isobus
 						}
 						else
 						{
-							std::uint16_t titleObjectPointedTo = std::static_pointer_cast<ObjectPointer>(nameObject)->get_child_id(0);
-							auto child = get_object_by_id(titleObjectPointedTo, objectPool);
+							std::uint16_t titleObjectPointedTo = static_cast<ObjectPointer *>(nameObject)->get_child_id(0);
+							auto child = objectPool.get(titleObjectPointedTo);
 
 							if ((nullptr != child) && (VirtualTerminalObjectType::OutputString == child->get_object_type()))
 							{
@@ -7640,7 +7793,7 @@ namespace isobus
 
 			if (NULL_OBJECT_ID != icon)
 			{
-				auto nameObject = get_object_by_id(icon, objectPool);
+				auto nameObject = objectPool.get(icon);
 
 				if (nullptr != nameObject)
 				{
@@ -7702,8 +7855,8 @@ namespace isobus
 			{
 				if (2 == get_number_children())
 				{
-					auto outputNum = get_object_by_id(get_child_id(0), objectPool);
-					auto outputString = get_object_by_id(get_child_id(1), objectPool);
+					auto outputNum = objectPool.get(get_child_id(0));
+					auto outputString = objectPool.get(get_child_id(1));
 
 					if ((nullptr == outputNum) ||
 					    (nullptr == outputString) ||
@@ -7725,7 +7878,7 @@ namespace isobus
 			{
 				if (1 == get_number_children())
 				{
-					auto outputNum = get_object_by_id(get_child_id(0), objectPool);
+					auto outputNum = objectPool.get(get_child_id(0));
 
 					if ((nullptr == outputNum) ||
 					    (VirtualTerminalObjectType::OutputNumber != outputNum->get_object_type()))
@@ -7745,7 +7898,7 @@ namespace isobus
 			{
 				if (1 == get_number_children())
 				{
-					auto outputString = get_object_by_id(get_child_id(0), objectPool);
+					auto outputString = objectPool.get(get_child_id(0));
 
 					if ((nullptr == outputString) ||
 					    (VirtualTerminalObjectType::OutputString != outputString->get_object_type()))
@@ -7765,8 +7918,8 @@ namespace isobus
 			{
 				if (2 == get_number_children())
 				{
-					auto inputNum = get_object_by_id(get_child_id(0), objectPool);
-					auto outputString = get_object_by_id(get_child_id(1), objectPool);
+					auto inputNum = objectPool.get(get_child_id(0));
+					auto outputString = objectPool.get(get_child_id(1));
 
 					if ((nullptr == inputNum) ||
 					    (nullptr == outputString) ||
@@ -7788,7 +7941,7 @@ namespace isobus
 			{
 				if (1 == get_number_children())
 				{
-					auto inputNum = get_object_by_id(get_child_id(0), objectPool);
+					auto inputNum = objectPool.get(get_child_id(0));
 
 					if ((nullptr == inputNum) ||
 					    (VirtualTerminalObjectType::InputNumber != inputNum->get_object_type()))
@@ -7808,7 +7961,7 @@ namespace isobus
 			{
 				if (1 == get_number_children())
 				{
-					auto inputStr = get_object_by_id(get_child_id(0), objectPool);
+					auto inputStr = objectPool.get(get_child_id(0));
 
 					if ((nullptr == inputStr) ||
 					    (VirtualTerminalObjectType::InputString != inputStr->get_object_type()))
@@ -7828,7 +7981,7 @@ namespace isobus
 			{
 				if (1 == get_number_children())
 				{
-					auto outputBargraph = get_object_by_id(get_child_id(0), objectPool);
+					auto outputBargraph = objectPool.get(get_child_id(0));
 
 					if ((nullptr == outputBargraph) ||
 					    (VirtualTerminalObjectType::OutputLinearBarGraph != outputBargraph->get_object_type()))
@@ -7848,7 +8001,7 @@ namespace isobus
 			{
 				if (1 == get_number_children())
 				{
-					auto button = get_object_by_id(get_child_id(0), objectPool);
+					auto button = objectPool.get(get_child_id(0));
 
 					if ((nullptr == button) ||
 					    (VirtualTerminalObjectType::Button != button->get_object_type()))
@@ -7868,8 +8021,8 @@ namespace isobus
 			{
 				if (2 == get_number_children())
 				{
-					auto button1 = get_object_by_id(get_child_id(0), objectPool);
-					auto button2 = get_object_by_id(get_child_id(1), objectPool);
+					auto button1 = objectPool.get(get_child_id(0));
+					auto button2 = objectPool.get(get_child_id(1));
 
 					if ((nullptr == button1) ||
 					    (nullptr == button2) ||
@@ -7895,7 +8048,7 @@ namespace isobus
 		return !anyWrongChildType;
 	}
 
-	bool WindowMask::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool WindowMask::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -8059,14 +8212,14 @@ namespace isobus
 		return 6;
 	}
 
-	bool AuxiliaryFunctionType1::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool AuxiliaryFunctionType1::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		// Despite modern VTs not using this object, we still have to validate it.
 		bool anyWrongChildType = false;
 
 		for (const auto &child : children)
 		{
-			auto childObject = get_object_by_id(child.id, objectPool);
+			auto childObject = objectPool.get(child.id);
 
 			if (nullptr != childObject)
 			{
@@ -8100,7 +8253,7 @@ namespace isobus
 		return !anyWrongChildType;
 	}
 
-	bool AuxiliaryFunctionType1::set_attribute(std::uint8_t, std::uint32_t, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool AuxiliaryFunctionType1::set_attribute(std::uint8_t, std::uint32_t, const VTObjectTable &, AttributeError &returnedError)
 	{
 		returnedError = AttributeError::InvalidAttributeID;
 		return false; // All attributes are read only
@@ -8138,13 +8291,13 @@ namespace isobus
 		return 6;
 	}
 
-	bool AuxiliaryFunctionType2::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool AuxiliaryFunctionType2::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
 		for (const auto &child : children)
 		{
-			auto childObject = get_object_by_id(child.id, objectPool);
+			auto childObject = objectPool.get(child.id);
 
 			if (nullptr != childObject)
 			{
@@ -8184,7 +8337,7 @@ namespace isobus
 		return !anyWrongChildType;
 	}
 
-	bool AuxiliaryFunctionType2::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool AuxiliaryFunctionType2::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -8274,13 +8427,13 @@ namespace isobus
 		return 7;
 	}
 
-	bool AuxiliaryInputType1::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool AuxiliaryInputType1::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
 		for (const auto &child : children)
 		{
-			auto childObject = get_object_by_id(child.id, objectPool);
+			auto childObject = objectPool.get(child.id);
 
 			if (nullptr != childObject)
 			{
@@ -8314,7 +8467,7 @@ namespace isobus
 		return !anyWrongChildType;
 	}
 
-	bool AuxiliaryInputType1::set_attribute(std::uint8_t, std::uint32_t, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool AuxiliaryInputType1::set_attribute(std::uint8_t, std::uint32_t, const VTObjectTable &, AttributeError &returnedError)
 	{
 		returnedError = AttributeError::InvalidAttributeID;
 		return false; // All attributes are read only
@@ -8369,13 +8522,13 @@ namespace isobus
 		return 6;
 	}
 
-	bool AuxiliaryInputType2::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool AuxiliaryInputType2::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
 		for (const auto &child : children)
 		{
-			auto childObject = get_object_by_id(child.id, objectPool);
+			auto childObject = objectPool.get(child.id);
 
 			if (nullptr != childObject)
 			{
@@ -8415,7 +8568,7 @@ namespace isobus
 		return !anyWrongChildType;
 	}
 
-	bool AuxiliaryInputType2::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool AuxiliaryInputType2::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -8518,14 +8671,14 @@ namespace isobus
 		return 6;
 	}
 
-	bool AuxiliaryControlDesignatorType2::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool AuxiliaryControlDesignatorType2::get_is_valid(const VTObjectTable &objectPool) const
 	{
-		bool retVal = (((NULL_OBJECT_ID == auxiliaryObjectID) || ((nullptr != get_object_by_id(auxiliaryObjectID, objectPool)))) && (pointerType <= 3));
+		bool retVal = (((NULL_OBJECT_ID == auxiliaryObjectID) || ((nullptr != objectPool.get(auxiliaryObjectID)))) && (pointerType <= 3));
 
 		if (retVal)
 		{
 			// Check the referenced object is valid
-			auto object = get_object_by_id(auxiliaryObjectID, objectPool);
+			auto object = objectPool.get(auxiliaryObjectID);
 
 			if ((VirtualTerminalObjectType::AuxiliaryFunctionType2 == object->get_object_type()) ||
 			    (VirtualTerminalObjectType::AuxiliaryInputType2 == object->get_object_type()))
@@ -8540,7 +8693,7 @@ namespace isobus
 		return retVal;
 	}
 
-	bool AuxiliaryControlDesignatorType2::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool AuxiliaryControlDesignatorType2::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 		returnedError = AttributeError::InvalidAttributeID;
@@ -8548,9 +8701,9 @@ namespace isobus
 		if (static_cast<std::uint8_t>(AttributeName::AuxiliaryObjectID) == attributeID)
 		{
 			if ((NULL_OBJECT_ID == rawAttributeData) ||
-			    ((nullptr != get_object_by_id(static_cast<std::uint16_t>(rawAttributeData), objectPool)) &&
-			     ((VirtualTerminalObjectType::AuxiliaryFunctionType2 == objectPool.at(static_cast<std::uint16_t>(rawAttributeData))->get_object_type()) ||
-			      (VirtualTerminalObjectType::AuxiliaryInputType2 == objectPool.at(static_cast<std::uint16_t>(rawAttributeData))->get_object_type()))))
+			    ((nullptr != objectPool.get(static_cast<std::uint16_t>(rawAttributeData))) &&
+			     ((VirtualTerminalObjectType::AuxiliaryFunctionType2 == objectPool.get(static_cast<std::uint16_t>(rawAttributeData))->get_object_type()) ||
+			      (VirtualTerminalObjectType::AuxiliaryInputType2 == objectPool.get(static_cast<std::uint16_t>(rawAttributeData))->get_object_type()))))
 			{
 				set_auxiliary_object_id(static_cast<std::uint16_t>(rawAttributeData));
 				retVal = true;
@@ -14,6 +14,7 @@
 #include "isobus/utility/system_timing.hpp"
 #include "isobus/utility/to_string.hpp"
 
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
 
@@ -32,6 +33,9 @@ namespace isobus
 			CANNetworkManager::CANNetwork.remove_any_control_function_parameter_group_number_callback(static_cast<std::uint32_t>(CANLibParameterGroupNumber::ECUtoVirtualTerminal),
 			                                                                                          process_rx_message,
 			                                                                                          this);
+			CANNetworkManager::CANNetwork.remove_receive_sink_callback(static_cast<std::uint32_t>(CANLibParameterGroupNumber::ECUtoVirtualTerminal),
+			                                                           get_object_pool_receive_sink,
+			                                                           this);
 		}
 	}
 
@@ -42,6 +46,10 @@ namespace isobus
 			CANNetworkManager::CANNetwork.add_any_control_function_parameter_group_number_callback(static_cast<std::uint32_t>(CANLibParameterGroupNumber::ECUtoVirtualTerminal),
 			                                                                                       process_rx_message,
 			                                                                                       this);
+			CANNetworkManager::CANNetwork.add_receive_sink_callback(static_cast<std::uint32_t>(CANLibParameterGroupNumber::ECUtoVirtualTerminal),
+			                                                        get_object_pool_receive_sink,
+			                                                        this);
+			initialized = true;
 		}
 	}
 
@@ -104,6 +112,21 @@ namespace isobus
 		(void)ws;
 	}
 
+	bool VirtualTerminalServer::save_version_snapshot(const std::vector<std::uint8_t> &snapshot, const std::vector<std::uint8_t> &versionLabel, NAME clientNAME)
+	{
+		(void)snapshot;
+		(void)versionLabel;
+		(void)clientNAME;
+		return false;
+	}
+
+	std::vector<std::uint8_t> VirtualTerminalServer::load_version_snapshot(const std::vector<std::uint8_t> &versionLabel, NAME clientNAME)
+	{
+		(void)versionLabel;
+		(void)clientNAME;
+		return {};
+	}
+
 	std::uint8_t VirtualTerminalServer::get_user_layout_datamask_bg_color() const
 	{
 		LOG_ERROR("[VT Server]: The Get User Layout Datamask background color is not implemented, returning with black");
@@ -274,6 +297,110 @@ namespace isobus
 		return retVal;
 	}
 
+	VirtualTerminalServer::ObjectPoolReceiveSink::ObjectPoolReceiveSink(VirtualTerminalServer *server,
+	                                                                    std::shared_ptr<VirtualTerminalServerManagedWorkingSet> workingSet,
+	                                                                    std::shared_ptr<ControlFunction> source,
+	                                                                    std::shared_ptr<ControlFunction> destination,
+	                                                                    std::uint32_t totalMessageSize) :
+	  server(server),
+	  workingSet(workingSet),
+	  source(source),
+	  destination(destination),
+	  data(totalMessageSize - 1)
+	{
+	}
+
+	void VirtualTerminalServer::ObjectPoolReceiveSink::write_bytes(std::size_t offset, CANDataSpan chunk)
+	{
+		auto chunkStart = chunk.begin();
+		if ((0 == offset) && (0 != chunk.size()))
+		{
+			multiplexor = chunk[0];
+			chunkStart++;
+			offset++;
+
+			if (static_cast<std::uint8_t>(Function::ObjectPoolTransferMessage) == multiplexor)
+			{
+				incrementalParse = workingSet->begin_incremental_object_pool_transfer();
+			}
+		}
+
+		if ((offset > 0) && ((offset - 1) < data.size()))
+		{
+			const std::size_t bytesToCopy = std::min(static_cast<std::size_t>(chunk.end() - chunkStart), data.size() - (offset - 1));
+			std::copy(chunkStart, chunkStart + bytesToCopy, data.begin() + (offset - 1));
+
+			if (incrementalParse)
+			{
+				incrementalParse = workingSet->parse_iop_chunk(chunkStart, static_cast<std::uint32_t>(bytesToCopy));
+			}
+
+			if (static_cast<std::uint8_t>(Function::ObjectPoolTransferMessage) == multiplexor)
+			{
+				workingSet->set_object_pool_transfer_progress(static_cast<std::uint32_t>((offset - 1) + bytesToCopy));
+			}
+		}
+	}
+
+	void VirtualTerminalServer::ObjectPoolReceiveSink::on_session_closed(bool successful)
+	{
+		if (!successful)
+		{
+			if (static_cast<std::uint8_t>(Function::ObjectPoolTransferMessage) == multiplexor)
+			{
+				workingSet->abort_incremental_object_pool_transfer();
+			}
+			return;
+		}
+
+		if (static_cast<std::uint8_t>(Function::ObjectPoolTransferMessage) == multiplexor)
+		{
+			LOG_INFO("[VT Server]: An ecu at address %u transferred %u bytes of object pool data to us.", source->get_address(), static_cast<std::uint32_t>(data.size()));
+			workingSet->end_incremental_object_pool_transfer(std::move(data));
+		}
+		else
+		{
+			// Not an object pool, so put the multiplexor back and process it like any other message
+			data.insert(data.begin(), multiplexor);
+			CANIdentifier identifier(CANIdentifier::Type::Extended,
+			                         static_cast<std::uint32_t>(CANLibParameterGroupNumber::ECUtoVirtualTerminal),
+			                         CANIdentifier::CANPriority::PriorityDefault6,
+			                         destination->get_address(),
+			                         source->get_address());
+			CANMessage completedMessage(CANMessage::Type::Receive,
+			                            identifier,
+			                            std::move(data),
+			                            source,
+			                            destination,
+			                            0);
+			process_rx_message(completedMessage, server);
+		}
+	}
+
+	std::unique_ptr<CANMessageReceiveSink> VirtualTerminalServer::get_object_pool_receive_sink(std::uint32_t parameterGroupNumber,
+	                                                                                           std::uint32_t totalMessageSize,
+	                                                                                           std::shared_ptr<ControlFunction> source,
+	                                                                                           std::shared_ptr<ControlFunction> destination,
+	                                                                                           void *parent)
+	{
+		auto parentServer = static_cast<VirtualTerminalServer *>(parent);
+
+		if ((static_cast<std::uint32_t>(CANLibParameterGroupNumber::ECUtoVirtualTerminal) == parameterGroupNumber) &&
+		    (nullptr != parentServer) &&
+		    (0 != totalMessageSize) &&
+		    (destination == parentServer->serverInternalControlFunction))
+		{
+			for (const auto &cf : parentServer->managedWorkingSetList)
+			{
+				if (cf->get_control_function() == source)
+				{
+					return std::unique_ptr<CANMessageReceiveSink>(new ObjectPoolReceiveSink(parentServer, cf, source, destination, totalMessageSize));
+				}
+			}
+		}
+		return nullptr;
+	}
+
 	void VirtualTerminalServer::process_rx_message(const CANMessage &message, void *parent)
 	{
 		auto parentServer = static_cast<VirtualTerminalServer *>(parent);
@@ -297,10 +424,10 @@ namespace isobus
 							{
 								case Function::ObjectPoolTransferMessage:
 								{
-									auto tempPool = data; // Make a copy of the data (ouch)
-									tempPool.erase(tempPool.begin()); // Strip off the mux byte (double ouch, good thing this is rare)
+									// Pools that were not received into an ObjectPoolReceiveSink end up here
+									std::vector<std::uint8_t> tempPool(data.begin() + 1, data.end()); // Strip off the mux byte
 									LOG_INFO("[VT Server]: An ecu at address %u transferred %u bytes of object pool data to us.", message.get_identifier().get_source_address(), static_cast<std::uint32_t>(tempPool.size()));
-									cf->add_iop_raw_data(tempPool);
+									cf->add_iop_raw_data(std::move(tempPool));
 								}
 								break;
 
@@ -484,7 +611,8 @@ namespace isobus
 									if (!loadedVersion.empty())
 									{
 										cf->set_iop_size(loadedVersion.size());
-										cf->add_iop_raw_data(loadedVersion);
+										cf->add_iop_raw_data(std::move(loadedVersion));
+										cf->set_object_pool_snapshot(parentServer->load_version_snapshot(versionLabel, message.get_source_control_function()->get_NAME()));
 									}
 									else
 									{
@@ -494,9 +622,9 @@ namespace isobus
 
 									if (cf->get_any_object_pools())
 									{
-										cf->start_parsing_thread();
+										cf->start_parsing(parentServer->objectPoolWorkerPool);
 										cf->set_was_object_pool_loaded_from_non_volatile_memory(true, {});
-										LOG_DEBUG("[VT Server]: Starting parsing thread for loaded pool data.");
+										LOG_DEBUG("[VT Server]: Started parsing loaded pool data.");
 									}
 								}
 								break;
@@ -532,6 +660,17 @@ namespace isobus
 											}
 										}
 
+										if (allPoolsSaved)
+										{
+											auto snapshot = cf->create_object_pool_snapshot();
+
+											if ((!snapshot.empty()) &&
+											    parentServer->save_version_snapshot(snapshot, versionLabel, message.get_source_control_function()->get_NAME()))
+											{
+												LOG_DEBUG("[VT Server]: Object pool snapshot for NAME " + nameString.str() + " was stored.");
+											}
+										}
+
 										std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { 0 };
 										buffer[0] = static_cast<std::uint8_t>(Function::StoreVersionCommand);
 										buffer[1] = 0xFF; // Reserved
@@ -595,7 +734,7 @@ namespace isobus
 									if (cf->get_any_object_pools())
 									{
 										parentServer->transferred_object_pool_parse_start(cf);
-										cf->start_parsing_thread();
+										cf->start_parsing(parentServer->objectPoolWorkerPool);
 									}
 									else
 									{
@@ -10,12 +10,67 @@
 
 #include "isobus/isobus/can_network_manager.hpp"
 #include "isobus/isobus/can_stack_logger.hpp"
+#include "isobus/utility/system_timing.hpp"
 #include "isobus/utility/to_string.hpp"
 
+#include <algorithm>
 #include <cstring>
 
 namespace isobus
 {
+	constexpr std::size_t VirtualTerminalServerManagedWorkingSet::VALIDATION_OBJECTS_PER_JOB;
+
+	/// @brief Decodes a single IOP file into its own object tree, so that several files can be decoded at once.
+	/// The objects are allocated from the arena of the working set they'll be merged into.
+	class VirtualTerminalServerManagedWorkingSet::ObjectPoolFileParser : public VirtualTerminalWorkingSetBase
+	{
+	public:
+		/// @brief Constructor for an IOP file parser
+		/// @param[in] arena The arena to allocate the decoded objects from
+		explicit ObjectPoolFileParser(const std::shared_ptr<VTObjectArena> &arena)
+		{
+			objectArena = arena;
+		}
+
+		/// @brief Decodes an IOP file into objects
+		/// @param[in] iopData The IOP file to decode
+		void parse(std::vector<std::uint8_t> &iopData)
+		{
+			success = parse_iop_into_objects(iopData.data(), static_cast<std::uint32_t>(iopData.size()));
+		}
+
+		/// @brief Returns if the IOP file was decoded successfully
+		/// @returns true if every object in the IOP file was decoded, otherwise false
+		bool get_success() const
+		{
+			return success;
+		}
+
+		/// @brief Returns the ID of the working set object in the IOP file
+		/// @returns The ID of the working set object in the IOP file, or NULL_OBJECT_ID if there isn't one
+		std::uint16_t get_working_set_id() const
+		{
+			return workingSetID;
+		}
+
+	private:
+		bool success = false; ///< Stores if the IOP file was decoded successfully
+	};
+
+	/// @brief The state shared by the jobs that parse one working set's object pool
+	struct VirtualTerminalServerManagedWorkingSet::ParsingJobContext
+	{
+		std::vector<std::unique_ptr<ObjectPoolFileParser>> fileParsers; ///< One parser per IOP file, in the order the files were received
+		std::vector<VTObject *> objectsToValidate; ///< The merged objects, split into slices for the validation jobs
+		std::shared_ptr<VTObjectArena> newArena; ///< The arena the files are decoded into when the pool was parsed before, which replaces the working set's arena when they're merged
+		std::atomic<std::size_t> remainingJobs = { 0 }; ///< The number of jobs of the current phase that haven't finished yet
+		std::atomic<std::size_t> invalidObjects = { 0 }; ///< The number of objects that failed validation
+		ObjectPoolParsingStatistics statistics; ///< The timing of each phase
+		std::uint64_t startTimestamp_us = 0; ///< When parsing was started
+		std::uint64_t validationStartTimestamp_us = 0; ///< When the validation jobs were queued
+		bool success = false; ///< Stores if every IOP file was decoded and merged successfully
+	};
+
 	VirtualTerminalServerManagedWorkingSet::VirtualTerminalServerManagedWorkingSet()
 	{
 		LOG_INFO("[WS]: New VT Server Object Created with no associated control function");
@@ -42,14 +97,147 @@ namespace isobus
 		}
 	}
 
+	void VirtualTerminalServerManagedWorkingSet::start_parsing(VirtualTerminalServerWorkerPool &workerPool)
+	{
+		if ((nullptr != objectPoolProcessingThread) || (ObjectPoolProcessingThreadState::Running == get_object_pool_processing_state()))
+		{
+			return;
+		}
+
+		if (iopFilesRawData.empty())
+		{
+			LOG_ERROR("[WS]: Object pool failed to be parsed.");
+			set_object_pool_processing_state(ObjectPoolProcessingThreadState::Fail);
+			return;
+		}
+
+		const bool parsedBefore = (ObjectPoolProcessingThreadState::None != get_object_pool_processing_state());
+		const std::size_t firstFileToParse = get_first_iop_file_to_parse(parsedBefore);
+		set_object_pool_processing_state(ObjectPoolProcessingThreadState::Running);
+		LOG_INFO("[WS]: Beginning parsing of object pool. This pool has " +
+		         isobus::to_string(static_cast<int>(iopFilesRawData.size())) +
+		         " IOP components.");
+
+		auto context = std::make_shared<ParsingJobContext>();
+		if (parsedBefore)
+		{
+			// The objects of the previous parse stay in use until the files are merged, and are then replaced along with their arena,
+			// otherwise every replaced object would stay in the arena until the working set is deleted
+			context->newArena = std::make_shared<VTObjectArena>();
+		}
+		context->startTimestamp_us = SystemTiming::get_timestamp_us();
+		context->statistics.numberOfIopFiles = iopFilesRawData.size();
+		context->statistics.numberOfIncrementallyParsedIopFiles = firstFileToParse;
+
+		bool hasSnapshot = false;
+		{
+			const std::lock_guard<std::mutex> lock(managedWorkingSetMutex);
+			hasSnapshot = !objectPoolSnapshot.empty();
+		}
+
+		if (hasSnapshot)
+		{
+			// Decoding from a snapshot is a single job, which falls back to decoding the files if the snapshot doesn't match
+			auto self = shared_from_this();
+			workerPool.submit([self, context, firstFileToParse, &workerPool]() {
+				if (self->load_object_pool_snapshot(firstFileToParse, context->statistics))
+				{
+					context->statistics.decodeTime_us = SystemTiming::get_time_elapsed_us(context->startTimestamp_us);
+					context->invalidObjects = context->statistics.numberOfInvalidObjects;
+					context->success = true;
+					self->finish_parsing(context);
+				}
+				else
+				{
+					self->decode_object_pool_files(context, workerPool, firstFileToParse);
+				}
+			});
+		}
+		else
+		{
+			decode_object_pool_files(context, workerPool, firstFileToParse);
+		}
+	}
+
 	void VirtualTerminalServerManagedWorkingSet::join_parsing_thread()
 	{
 		if ((nullptr != objectPoolProcessingThread) && (objectPoolProcessingThread->joinable()))
 		{
 			objectPoolProcessingThread->join();
 			objectPoolProcessingThread = nullptr;
-			set_object_pool_processing_state(ObjectPoolProcessingThreadState::Joined);
 		}
+
+		const std::lock_guard<std::mutex> lock(managedWorkingSetMutex);
+		if ((ObjectPoolProcessingThreadState::Success == processingState) ||
+		    (ObjectPoolProcessingThreadState::Fail == processingState))
+		{
+			processingState = ObjectPoolProcessingThreadState::Joined;
+		}
+	}
+
+	bool VirtualTerminalServerManagedWorkingSet::begin_incremental_object_pool_transfer()
+	{
+		bool retVal = false;
+
+		// Once the pool has been parsed its objects are in use, so a later transfer is only decoded when the pool is parsed again
+		if ((numberOfIncrementallyParsedFiles == iopFilesRawData.size()) &&
+		    (!discardIncrementallyParsedObjects) &&
+		    (nullptr == objectPoolProcessingThread) &&
+		    (ObjectPoolProcessingThreadState::None == get_object_pool_processing_state()))
+		{
+			begin_incremental_iop_parse();
+			incrementalTransferActive = true;
+			retVal = true;
+		}
+		return retVal;
+	}
+
+	void VirtualTerminalServerManagedWorkingSet::end_incremental_object_pool_transfer(std::vector<std::uint8_t> &&iopData)
+	{
+		if (incrementalTransferActive && end_incremental_iop_parse() && (numberOfIncrementallyParsedFiles == iopFilesRawData.size()))
+		{
+			numberOfIncrementallyParsedFiles++;
+		}
+		incrementalTransferActive = false;
+		add_iop_raw_data(std::move(iopData));
+		objectPoolTransferProgress = 0;
+	}
+
+	void VirtualTerminalServerManagedWorkingSet::abort_incremental_object_pool_transfer()
+	{
+		if (incrementalTransferActive)
+		{
+			// Drops whatever was buffered, the objects already decoded are discarded when parsing starts
+			begin_incremental_iop_parse();
+			discardIncrementallyParsedObjects = true;
+			incrementalTransferActive = false;
+		}
+		objectPoolTransferProgress = 0;
+	}
+
+	void VirtualTerminalServerManagedWorkingSet::set_object_pool_transfer_progress(std::uint32_t bytesReceived)
+	{
+		objectPoolTransferProgress = bytesReceived;
+	}
+
+	void VirtualTerminalServerManagedWorkingSet::set_object_pool_snapshot(std::vector<std::uint8_t> &&snapshot)
+	{
+		const std::lock_guard<std::mutex> lock(managedWorkingSetMutex);
+		objectPoolSnapshot = std::move(snapshot);
+	}
+
+	std::vector<std::uint8_t> VirtualTerminalServerManagedWorkingSet::create_object_pool_snapshot()
+	{
+		std::size_t numberOfInvalidObjects = 0;
+		{
+			const std::lock_guard<std::mutex> lock(managedWorkingSetMutex);
+			if ((!objectPoolParsedSuccessfully) || (ObjectPoolProcessingThreadState::Running == processingState))
+			{
+				return {};
+			}
+			numberOfInvalidObjects = parsingStatistics.numberOfInvalidObjects;
+		}
+		return VirtualTerminalObjectPoolSnapshot::create(iopFilesRawData, vtObjectTree, workingSetID, static_cast<std::uint32_t>(numberOfInvalidObjects));
 	}
 
 	bool VirtualTerminalServerManagedWorkingSet::get_any_object_pools() const
@@ -63,6 +251,12 @@ namespace isobus
 		return processingState;
 	}
 
+	VirtualTerminalServerManagedWorkingSet::ObjectPoolParsingStatistics VirtualTerminalServerManagedWorkingSet::get_object_pool_parsing_statistics()
+	{
+		const std::lock_guard<std::mutex> lock(managedWorkingSetMutex);
+		return parsingStatistics;
+	}
+
 	std::shared_ptr<ControlFunction> VirtualTerminalServerManagedWorkingSet::get_control_function() const
 	{
 		return workingSetControlFunction;
@@ -148,7 +342,8 @@ namespace isobus
 
 		// if IOP transfer is not completed check if there is an ongoing IOP transfer to us
 		auto sessions = CANNetworkManager::CANNetwork.get_active_transport_protocol_sessions(0);
-		auto currentTransferredIopSize = transferredIopSize;
+		// Transfers into a sink leave the session's data empty, so they report their progress separately
+		auto currentTransferredIopSize = transferredIopSize + objectPoolTransferProgress;
 		for (const auto &session : sessions)
 		{
 			if (session->get_source()->get_address() == get_control_function()->get_address() &&
@@ -173,17 +368,54 @@ namespace isobus
 		processingState = value;
 	}
 
+	std::size_t VirtualTerminalServerManagedWorkingSet::get_first_iop_file_to_parse(bool parsedBefore)
+	{
+		if (parsedBefore)
+		{
+			// The previous parse merged the files after the incrementally decoded ones into the object tree too,
+			// so every file is decoded again from the first one
+			numberOfIncrementallyParsedFiles = 0;
+			discardIncrementallyParsedObjects = false;
+		}
+		else if (discardIncrementallyParsedObjects)
+		{
+			discard_decoded_objects();
+			numberOfIncrementallyParsedFiles = 0;
+			discardIncrementallyParsedObjects = false;
+		}
+		return numberOfIncrementallyParsedFiles;
+	}
+
+	void VirtualTerminalServerManagedWorkingSet::discard_decoded_objects()
+	{
+		vtObjectTree.clear();
+		workingSetID = NULL_OBJECT_ID;
+		objectArena = std::make_shared<VTObjectArena>();
+	}
+
 	void VirtualTerminalServerManagedWorkingSet::worker_thread_function()
 	{
 		if (!iopFilesRawData.empty())
 		{
 			bool lSuccess = true;
+			ObjectPoolParsingStatistics statistics;
+			const std::uint64_t startTimestamp_us = SystemTiming::get_timestamp_us();
+			const bool parsedBefore = (ObjectPoolProcessingThreadState::None != get_object_pool_processing_state());
+			const std::size_t firstFileToParse = get_first_iop_file_to_parse(parsedBefore);
+
+			if (parsedBefore)
+			{
+				// The files are decoded straight into the object tree, so the previous parse's objects can't be kept until they're replaced
+				discard_decoded_objects();
+			}
 
 			set_object_pool_processing_state(ObjectPoolProcessingThreadState::Running);
 			LOG_INFO("[WS]: Beginning parsing of object pool. This pool has " +
 			         isobus::to_string(static_cast<int>(iopFilesRawData.size())) +
 			         " IOP components.");
-			for (std::size_t i = 0; i < iopFilesRawData.size(); i++)
+			const bool loadedFromSnapshot = load_object_pool_snapshot(firstFileToParse, statistics);
+
+			for (std::size_t i = (loadedFromSnapshot ? iopFilesRawData.size() : firstFileToParse); i < iopFilesRawData.size(); i++)
 			{
 				if (!parse_iop_into_objects(iopFilesRawData[i].data(), static_cast<std::uint32_t>(iopFilesRawData[i].size())))
 				{
@@ -191,10 +423,36 @@ namespace isobus
 					break;
 				}
 			}
+			statistics.numberOfIopFiles = iopFilesRawData.size();
+			statistics.numberOfIncrementallyParsedIopFiles = firstFileToParse;
+			statistics.decodeTime_us = SystemTiming::get_time_elapsed_us(startTimestamp_us);
+
+			if (lSuccess && (!loadedFromSnapshot))
+			{
+				const std::uint64_t validationStartTimestamp_us = SystemTiming::get_timestamp_us();
+				std::vector<VTObject *> objects;
+
+				objects.reserve(vtObjectTree.size());
+				for (const auto &object : vtObjectTree)
+				{
+					objects.push_back(object.get());
+				}
+				statistics.numberOfObjects = objects.size();
+				statistics.numberOfInvalidObjects = validate_objects(objects, 0, objects.size());
+				statistics.validationTime_us = SystemTiming::get_time_elapsed_us(validationStartTimestamp_us);
+			}
+			statistics.totalTime_us = SystemTiming::get_time_elapsed_us(startTimestamp_us);
+
+			{
+				const std::lock_guard<std::mutex> lock(managedWorkingSetMutex);
+				parsingStatistics = statistics;
+				objectPoolParsedSuccessfully = lSuccess;
+			}
 
 			if (lSuccess)
 			{
 				LOG_INFO("[WS]: Object pool successfully parsed.");
+				log_parsing_statistics(statistics);
 				set_object_pool_processing_state(ObjectPoolProcessingThreadState::Success);
 			}
 			else
@@ -210,6 +468,225 @@ namespace isobus
 		}
 	}
 
+	bool VirtualTerminalServerManagedWorkingSet::load_object_pool_snapshot(std::size_t firstFileToParse, ObjectPoolParsingStatistics &statistics)
+	{
+		bool retVal = false;
+
+		// The snapshot is set from the CAN stack's thread, so it's taken out under the lock and used only once
+		std::vector<std::uint8_t> snapshotData;
+		{
+			const std::lock_guard<std::mutex> lock(managedWorkingSetMutex);
+			snapshotData.swap(objectPoolSnapshot);
+		}
+
+		if (!snapshotData.empty())
+		{
+			if ((0 == firstFileToParse) && (1 == iopFilesRawData.size()) && vtObjectTree.empty())
+			{
+				const VirtualTerminalObjectPoolSnapshot snapshot(snapshotData.data(), snapshotData.size());
+				retVal = parse_iop_into_objects(snapshot, iopFilesRawData[0].data(), static_cast<std::uint32_t>(iopFilesRawData[0].size()));
+
+				if (retVal)
+				{
+					LOG_INFO("[WS]: Object pool was loaded from a snapshot.");
+					statistics.loadedFromSnapshot = true;
+					statistics.numberOfObjects = vtObjectTree.size();
+					statistics.numberOfInvalidObjects = snapshot.get_number_of_invalid_objects();
+				}
+				else
+				{
+					LOG_WARNING("[WS]: Object pool snapshot does not match the object pool, the whole pool will be parsed instead.");
+					discard_decoded_objects();
+					set_object_pool_faulting_object_id(NULL_OBJECT_ID);
+				}
+			}
+		}
+		return retVal;
+	}
+
+	void VirtualTerminalServerManagedWorkingSet::decode_object_pool_files(const std::shared_ptr<ParsingJobContext> &context, VirtualTerminalServerWorkerPool &workerPool, std::size_t firstFileToParse)
+	{
+		context->remainingJobs = iopFilesRawData.size() - firstFileToParse;
+
+		if (0 == context->remainingJobs)
+		{
+			// Every file was decoded while it was received, so only validation is left
+			merge_decoded_object_pool_files(context, workerPool);
+			return;
+		}
+
+		for (std::size_t i = firstFileToParse; i < iopFilesRawData.size(); i++)
+		{
+			context->fileParsers.emplace_back(new ObjectPoolFileParser((nullptr != context->newArena) ? context->newArena : objectArena));
+		}
+
+		// Decoding an object doesn't depend on any other object, so every file can be decoded at the same time
+		auto self = shared_from_this();
+		for (std::size_t i = 0; i < context->fileParsers.size(); i++)
+		{
+			workerPool.submit([self, context, i, firstFileToParse, &workerPool]() {
+				context->fileParsers.at(i)->parse(self->iopFilesRawData.at(firstFileToParse + i));
+
+				if (1 == context->remainingJobs.fetch_sub(1))
+				{
+					self->merge_decoded_object_pool_files(context, workerPool);
+				}
+			});
+		}
+	}
+
+	void VirtualTerminalServerManagedWorkingSet::merge_decoded_object_pool_files(const std::shared_ptr<ParsingJobContext> &context, VirtualTerminalServerWorkerPool &workerPool)
+	{
+		const std::uint64_t mergeStartTimestamp_us = SystemTiming::get_timestamp_us();
+		bool lSuccess = true;
+
+		context->statistics.decodeTime_us = mergeStartTimestamp_us - context->startTimestamp_us;
+
+		if (nullptr != context->newArena)
+		{
+			// Every file was decoded again, so the objects of the previous parse are replaced as a whole
+			vtObjectTree.clear();
+			workingSetID = NULL_OBJECT_ID;
+			objectArena = std::move(context->newArena);
+		}
+
+		// Merge in the order the files were received, so that later files replace objects of earlier ones like they would if parsed one after the other
+		for (const auto &fileParser : context->fileParsers)
+		{
+			if (!fileParser->get_success())
+			{
+				set_object_pool_faulting_object_id(fileParser->get_object_pool_faulting_object_id());
+				lSuccess = false;
+				break;
+			}
+
+			const std::uint16_t fileWorkingSetID = fileParser->get_working_set_id();
+			if (NULL_OBJECT_ID != fileWorkingSetID)
+			{
+				if ((NULL_OBJECT_ID == workingSetID) || (fileWorkingSetID == workingSetID))
+				{
+					workingSetID = fileWorkingSetID;
+				}
+				else
+				{
+					LOG_ERROR("[WS]: Multiple working set objects are not allowed in the object pool. Faulting object " + isobus::to_string(static_cast<int>(fileWorkingSetID)));
+					set_object_pool_faulting_object_id(fileWorkingSetID);
+					lSuccess = false;
+					break;
+				}
+			}
+
+			for (const auto &object : fileParser->get_object_tree())
+			{
+				add_or_replace_object(object);
+			}
+		}
+		context->fileParsers.clear();
+		context->success = lSuccess;
+		context->statistics.mergeTime_us = SystemTiming::get_time_elapsed_us(mergeStartTimestamp_us);
+
+		if (!lSuccess)
+		{
+			finish_parsing(context);
+			return;
+		}
+
+		context->objectsToValidate.reserve(vtObjectTree.size());
+		for (const auto &object : vtObjectTree)
+		{
+			context->objectsToValidate.push_back(object.get());
+		}
+		context->statistics.numberOfObjects = context->objectsToValidate.size();
+		context->validationStartTimestamp_us = SystemTiming::get_timestamp_us();
+
+		// Validation only reads the object tree, so it can be split into slices that are checked at the same time
+		const std::size_t numberOfObjects = context->objectsToValidate.size();
+		const std::size_t objectsPerJob = std::max(VALIDATION_OBJECTS_PER_JOB, (numberOfObjects + workerPool.get_number_of_threads() - 1) / workerPool.get_number_of_threads());
+		const std::size_t numberOfJobs = (numberOfObjects + objectsPerJob - 1) / objectsPerJob;
+
+		if (0 == numberOfJobs)
+		{
+			finish_parsing(context);
+			return;
+		}
+
+		auto self = shared_from_this();
+		context->remainingJobs = numberOfJobs;
+		for (std::size_t i = 0; i < numberOfJobs; i++)
+		{
+			const std::size_t begin = i * objectsPerJob;
+			const std::size_t end = std::min(numberOfObjects, begin + objectsPerJob);
+
+			workerPool.submit([self, context, begin, end]() {
+				context->invalidObjects += self->validate_objects(context->objectsToValidate, begin, end);
+
+				if (1 == context->remainingJobs.fetch_sub(1))
+				{
+					context->statistics.validationTime_us = SystemTiming::get_time_elapsed_us(context->validationStartTimestamp_us);
+					self->finish_parsing(context);
+				}
+			});
+		}
+	}
+
+	void VirtualTerminalServerManagedWorkingSet::finish_parsing(const std::shared_ptr<ParsingJobContext> &context)
+	{
+		context->statistics.numberOfInvalidObjects = context->invalidObjects;
+		context->statistics.totalTime_us = SystemTiming::get_time_elapsed_us(context->startTimestamp_us);
+
+		{
+			const std::lock_guard<std::mutex> lock(managedWorkingSetMutex);
+			parsingStatistics = context->statistics;
+			objectPoolParsedSuccessfully = context->success;
+		}
+
+		if (context->success)
+		{
+			LOG_INFO("[WS]: Object pool successfully parsed.");
+			log_parsing_statistics(context->statistics);
+			set_object_pool_processing_state(ObjectPoolProcessingThreadState::Success);
+		}
+		else
+		{
+			LOG_ERROR("[WS]: Object pool failed to be parsed.");
+			set_object_pool_processing_state(ObjectPoolProcessingThreadState::Fail);
+		}
+	}
+
+	std::size_t VirtualTerminalServerManagedWorkingSet::validate_objects(const std::vector<VTObject *> &objects, std::size_t begin, std::size_t end) const
+	{
+		std::size_t invalidObjects = 0;
+
+		for (std::size_t i = begin; i < end; i++)
+		{
+			if (!objects[i]->get_is_valid(vtObjectTree))
+			{
+				// Existing pools in the field rely on VTs tolerating some bad references, so this doesn't fail the pool.
+				// Pools can have many of them, so only the total is a warning, see log_parsing_statistics
+				LOG_DEBUG("[WS]: Object " + isobus::to_string(static_cast<int>(objects[i]->get_id())) + " failed validation.");
+				invalidObjects++;
+			}
+		}
+		return invalidObjects;
+	}
+
+	void VirtualTerminalServerManagedWorkingSet::log_parsing_statistics(const ObjectPoolParsingStatistics &statistics)
+	{
+		LOG_INFO("[WS]: Parsed " + isobus::to_string(statistics.numberOfObjects) + " objects from " +
+		         isobus::to_string(statistics.numberOfIopFiles) + " IOP components (" +
+		         isobus::to_string(statistics.numberOfIncrementallyParsedIopFiles) + " decoded while they were received) in " +
+		         isobus::to_string(statistics.totalTime_us) + " us (decode " +
+		         isobus::to_string(statistics.decodeTime_us) + " us, merge " +
+		         isobus::to_string(statistics.mergeTime_us) + " us, validation " +
+		         isobus::to_string(statistics.validationTime_us) + " us), " +
+		         isobus::to_string(statistics.numberOfInvalidObjects) + " objects failed validation.");
+
+		if (0 != statistics.numberOfInvalidObjects)
+		{
+			LOG_WARNING("[WS]: " + isobus::to_string(statistics.numberOfInvalidObjects) + " objects failed validation, enable debug logging to see which ones.");
+		}
+	}
+
 	bool VirtualTerminalServerManagedWorkingSet::is_object_pool_transfer_in_progress() const
 	{
 		return iop_load_percentage() != 0.0f;
@@ -0,0 +1,90 @@
+//================================================================================================
+/// @file isobus_virtual_terminal_server_worker_pool.cpp
+///
+/// @brief Implements a small pool of worker threads that a VT server shares between all of its working sets.
+/// @author Adrian Del Grosso
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+#include "isobus/isobus/isobus_virtual_terminal_server_worker_pool.hpp"
+
+#include <algorithm>
+
+namespace isobus
+{
+	constexpr std::size_t VirtualTerminalServerWorkerPool::MAX_DEFAULT_NUMBER_OF_THREADS;
+
+	VirtualTerminalServerWorkerPool::VirtualTerminalServerWorkerPool(std::size_t numberOfThreads) :
+	  numberOfThreads((0 != numberOfThreads) ? numberOfThreads : get_default_number_of_threads())
+	{
+	}
+
+	VirtualTerminalServerWorkerPool::~VirtualTerminalServerWorkerPool()
+	{
+		{
+			const std::lock_guard<std::mutex> lock(jobQueueMutex);
+			stopRequested = true;
+		}
+		jobQueueCondition.notify_all();
+
+		for (auto &thread : workerThreads)
+		{
+			if (thread.joinable())
+			{
+				thread.join();
+			}
+		}
+	}
+
+	void VirtualTerminalServerWorkerPool::submit(std::function<void()> job)
+	{
+		if (nullptr != job)
+		{
+			{
+				const std::lock_guard<std::mutex> lock(jobQueueMutex);
+				jobQueue.push_back(std::move(job));
+
+				if (workerThreads.empty())
+				{
+					for (std::size_t i = 0; i < numberOfThreads; i++)
+					{
+						workerThreads.emplace_back([this]() { worker_thread_function(); });
+					}
+				}
+			}
+			jobQueueCondition.notify_one();
+		}
+	}
+
+	std::size_t VirtualTerminalServerWorkerPool::get_number_of_threads() const
+	{
+		return numberOfThreads;
+	}
+
+	std::size_t VirtualTerminalServerWorkerPool::get_default_number_of_threads()
+	{
+		// hardware_concurrency may return 0 if it can't tell
+		return std::max<std::size_t>(1, std::min<std::size_t>(std::thread::hardware_concurrency(), MAX_DEFAULT_NUMBER_OF_THREADS));
+	}
+
+	void VirtualTerminalServerWorkerPool::worker_thread_function()
+	{
+		for (;;)
+		{
+			std::function<void()> job;
+			{
+				std::unique_lock<std::mutex> lock(jobQueueMutex);
+				jobQueueCondition.wait(lock, [this]() { return stopRequested || (!jobQueue.empty()); });
+
+				if (jobQueue.empty())
+				{
+					// Only reachable when stopping, and every queued job has been run
+					return;
+				}
+				job = std::move(jobQueue.front());
+				jobQueue.pop_front();
+			}
+			job();
+		}
+	}
+} // namespace isobus
@@ -16,6 +16,8 @@
 
 namespace isobus
 {
+	constexpr std::uint32_t VirtualTerminalWorkingSetBase::INCREMENTAL_PARSE_LOOKAHEAD;
+
 	std::uint16_t VirtualTerminalWorkingSetBase::get_object_pool_faulting_object_id()
 	{
 		std::lock_guard<std::mutex> lock(managedWorkingSetMutex);
@@ -28,6 +30,12 @@ namespace isobus
 		iopFilesRawData.push_back(dataToAdd);
 	}
 
+	void VirtualTerminalWorkingSetBase::add_iop_raw_data(std::vector<std::uint8_t> &&dataToAdd)
+	{
+		transferredIopSize += dataToAdd.size();
+		iopFilesRawData.push_back(std::move(dataToAdd));
+	}
+
 	std::size_t VirtualTerminalWorkingSetBase::get_number_iop_files() const
 	{
 		return iopFilesRawData.size();
@@ -43,11 +51,24 @@ namespace isobus
 		return workingSetColourTable.get_colour(colourIndex);
 	}
 
-	const std::map<std::uint16_t, std::shared_ptr<VTObject>> &VirtualTerminalWorkingSetBase::get_object_tree() const
+	const VTObjectTable &VirtualTerminalWorkingSetBase::get_object_tree() const
 	{
 		return vtObjectTree;
 	}
 
+	const VTObjectArena &VirtualTerminalWorkingSetBase::get_object_arena() const
+	{
+		return *objectArena;
+	}
+
+	template<typename T>
+	std::shared_ptr<T> VirtualTerminalWorkingSetBase::create_object()
+	{
+		auto retVal = std::allocate_shared<T>(VTObjectArenaAllocator<T>(objectArena));
+		retVal->set_arena(objectArena);
+		return retVal;
+	}
+
 	bool VirtualTerminalWorkingSetBase::add_or_replace_object(std::shared_ptr<VTObject> objectToAdd)
 	{
 		bool retVal = false;
@@ -79,7 +100,7 @@ namespace isobus
 					     (get_object_by_id(workingSetID)->get_id() == decodedID)))
 					{
 						workingSetID = decodedID;
-						auto tempObject = std::make_shared<WorkingSet>();
+						auto tempObject = create_object<WorkingSet>();
 
 						if (iopLength >= tempObject->get_minumum_object_length())
 						{
@@ -156,7 +177,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::DataMask:
 				{
-					auto tempObject = std::make_shared<DataMask>();
+					auto tempObject = create_object<DataMask>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -204,7 +225,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::AlarmMask:
 				{
-					auto tempObject = std::make_shared<AlarmMask>();
+					auto tempObject = create_object<AlarmMask>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -275,7 +296,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::Container:
 				{
-					auto tempObject = std::make_shared<Container>();
+					auto tempObject = create_object<Container>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -332,7 +353,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::WindowMask:
 				{
-					auto tempObject = std::make_shared<WindowMask>();
+					auto tempObject = create_object<WindowMask>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -483,7 +504,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::SoftKeyMask:
 				{
-					auto tempObject = std::make_shared<SoftKeyMask>();
+					auto tempObject = create_object<SoftKeyMask>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -530,7 +551,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::Key:
 				{
-					auto tempObject = std::make_shared<Key>();
+					auto tempObject = create_object<Key>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -579,7 +600,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::Button:
 				{
-					auto tempObject = std::make_shared<Button>();
+					auto tempObject = create_object<Button>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -632,7 +653,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::KeyGroup:
 				{
-					auto tempObject = std::make_shared<KeyGroup>();
+					auto tempObject = create_object<KeyGroup>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -690,7 +711,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::InputBoolean:
 				{
-					auto tempObject = std::make_shared<InputBoolean>();
+					auto tempObject = create_object<InputBoolean>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -726,7 +747,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::InputString:
 				{
-					auto tempObject = std::make_shared<InputString>();
+					auto tempObject = create_object<InputString>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -785,7 +806,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::InputNumber:
 				{
-					auto tempObject = std::make_shared<InputNumber>();
+					auto tempObject = create_object<InputNumber>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -854,7 +875,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::InputList:
 				{
-					auto tempObject = std::make_shared<InputList>();
+					auto tempObject = create_object<InputList>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -906,7 +927,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::OutputString:
 				{
-					auto tempObject = std::make_shared<OutputString>();
+					auto tempObject = create_object<OutputString>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -961,7 +982,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::OutputNumber:
 				{
-					auto tempObject = std::make_shared<OutputNumber>();
+					auto tempObject = create_object<OutputNumber>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -1022,7 +1043,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::OutputList:
 				{
-					auto tempObject = std::make_shared<OutputList>();
+					auto tempObject = create_object<OutputList>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -1069,7 +1090,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::OutputLine:
 				{
-					auto tempObject = std::make_shared<OutputLine>();
+					auto tempObject = create_object<OutputLine>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -1111,7 +1132,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::OutputRectangle:
 				{
-					auto tempObject = std::make_shared<OutputRectangle>();
+					auto tempObject = create_object<OutputRectangle>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -1145,7 +1166,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::OutputEllipse:
 				{
-					auto tempObject = std::make_shared<OutputEllipse>();
+					auto tempObject = create_object<OutputEllipse>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -1189,7 +1210,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::OutputPolygon:
 				{
-					auto tempObject = std::make_shared<OutputPolygon>();
+					auto tempObject = create_object<OutputPolygon>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -1248,7 +1269,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::OutputMeter:
 				{
-					auto tempObject = std::make_shared<OutputMeter>();
+					auto tempObject = create_object<OutputMeter>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -1286,7 +1307,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::OutputLinearBarGraph:
 				{
-					auto tempObject = std::make_shared<OutputLinearBarGraph>();
+					auto tempObject = create_object<OutputLinearBarGraph>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -1323,7 +1344,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::OutputArchedBarGraph:
 				{
-					auto tempObject = std::make_shared<OutputArchedBarGraph>();
+					auto tempObject = create_object<OutputArchedBarGraph>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -1374,7 +1395,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::PictureGraphic:
 				{
-					auto tempObject = std::make_shared<PictureGraphic>();
+					auto tempObject = create_object<PictureGraphic>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -1397,7 +1418,28 @@ namespace isobus
 							iopData += 17;
 							iopLength -= 17;
 
-							if (tempObject->get_option(PictureGraphic::Options::RunLengthEncoded))
+							bool snapshotPixelsMatch = true;
+							if (nullptr != snapshotPictureGraphicData)
+							{
+								// The pixels were decoded when the snapshot was created, so they only need to be copied,
+								// as long as there are as many as a full decode would produce
+								if (snapshotPictureGraphicDataLength != (static_cast<std::uint32_t>(tempObject->get_actual_width()) * tempObject->get_actual_height()))
+								{
+									LOG_ERROR("[WS]: Snapshot pixel data doesn't match the dimensions of picture graphic. Object: " + isobus::to_string(static_cast<int>(decodedID)));
+									snapshotPixelsMatch = false;
+								}
+								else if (iopLength >= tempObject->get_number_of_bytes_in_raw_data())
+								{
+									tempObject->set_raw_data(snapshotPictureGraphicData, snapshotPictureGraphicDataLength);
+									iopData += tempObject->get_number_of_bytes_in_raw_data();
+									iopLength -= tempObject->get_number_of_bytes_in_raw_data();
+								}
+								else
+								{
+									LOG_ERROR("[WS]: Not enough IOP data to deserialize picture graphic's pixel data. Object: " + isobus::to_string(static_cast<int>(decodedID)));
+								}
+							}
+							else if (tempObject->get_option(PictureGraphic::Options::RunLengthEncoded))
 							{
 								if (0 != (tempObject->get_number_of_bytes_in_raw_data() % 2))
 								{
@@ -1550,7 +1592,11 @@ namespace isobus
 
 							retVal = parse_object_macro_reference(tempObject, numberOfMacrosToFollow, iopData, iopLength);
 
-							if (tempObject->get_raw_data().size() == (tempObject->get_actual_width() * tempObject->get_actual_height()))
+							if (!snapshotPixelsMatch)
+							{
+								retVal = false;
+							}
+							else if (tempObject->get_raw_data().size() == (tempObject->get_actual_width() * tempObject->get_actual_height()))
 							{
 								retVal = true;
 							}
@@ -1578,7 +1624,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::NumberVariable:
 				{
-					auto tempObject = std::make_shared<NumberVariable>();
+					auto tempObject = create_object<NumberVariable>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -1605,7 +1651,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::StringVariable:
 				{
-					auto tempObject = std::make_shared<StringVariable>();
+					auto tempObject = create_object<StringVariable>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -1648,7 +1694,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::FontAttributes:
 				{
-					auto tempObject = std::make_shared<FontAttributes>();
+					auto tempObject = create_object<FontAttributes>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -1688,7 +1734,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::LineAttributes:
 				{
-					auto tempObject = std::make_shared<LineAttributes>();
+					auto tempObject = create_object<LineAttributes>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -1717,7 +1763,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::FillAttributes:
 				{
-					auto tempObject = std::make_shared<FillAttributes>();
+					auto tempObject = create_object<FillAttributes>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -1754,7 +1800,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::InputAttributes:
 				{
-					auto tempObject = std::make_shared<InputAttributes>();
+					auto tempObject = create_object<InputAttributes>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -1813,7 +1859,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::ExtendedInputAttributes:
 				{
-					auto tempObject = std::make_shared<ExtendedInputAttributes>();
+					auto tempObject = create_object<ExtendedInputAttributes>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -1847,7 +1893,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::ColourMap:
 				{
-					auto tempObject = std::make_shared<ColourMap>();
+					auto tempObject = create_object<ColourMap>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -1894,7 +1940,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::ObjectPointer:
 				{
-					auto tempObject = std::make_shared<ObjectPointer>();
+					auto tempObject = create_object<ObjectPointer>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -1936,7 +1982,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::Macro:
 				{
-					auto tempObject = std::make_shared<Macro>();
+					auto tempObject = create_object<Macro>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -2042,7 +2088,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::AuxiliaryFunctionType1:
 				{
-					auto tempObject = std::make_shared<AuxiliaryFunctionType1>();
+					auto tempObject = create_object<AuxiliaryFunctionType1>();
 
 					LOG_WARNING("[WS]: Deserializing an Aux function type 1 object. This object is parsed and validated but NOT utilized by version 3 or later VTs in making Auxiliary Control Assignments.");
 
@@ -2098,7 +2144,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::AuxiliaryInputType1:
 				{
-					auto tempObject = std::make_shared<AuxiliaryInputType1>();
+					auto tempObject = create_object<AuxiliaryInputType1>();
 
 					LOG_WARNING("[WS]: Deserializing an Aux input type 1 object. This object is parsed and validated but NOT utilized by version 3 or later VTs in making Auxiliary Control Assignments.");
 
@@ -2163,7 +2209,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::AuxiliaryFunctionType2:
 				{
-					auto tempObject = std::make_shared<AuxiliaryFunctionType2>();
+					auto tempObject = create_object<AuxiliaryFunctionType2>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -2224,7 +2270,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::AuxiliaryInputType2:
 				{
-					auto tempObject = std::make_shared<AuxiliaryInputType2>();
+					auto tempObject = create_object<AuxiliaryInputType2>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -2288,7 +2334,7 @@ namespace isobus
 
 				case VirtualTerminalObjectType::AuxiliaryControlDesignatorType2:
 				{
-					auto tempObject = std::make_shared<AuxiliaryControlDesignatorType2>();
+					auto tempObject = create_object<AuxiliaryControlDesignatorType2>();
 
 					if (iopLength >= tempObject->get_minumum_object_length())
 					{
@@ -2336,7 +2382,7 @@ namespace isobus
 
 	std::shared_ptr<VTObject> VirtualTerminalWorkingSetBase::get_object_by_id(std::uint16_t objectID)
 	{
-		return vtObjectTree[objectID];
+		return vtObjectTree.get_shared(objectID);
 	}
 
 	std::shared_ptr<VTObject> VirtualTerminalWorkingSetBase::get_working_set_object()
@@ -2346,17 +2392,7 @@ namespace isobus
 
 	bool VirtualTerminalWorkingSetBase::get_object_id_exists(std::uint16_t objectID)
 	{
-		bool retVal;
-
-		if (vtObjectTree.find(objectID) == vtObjectTree.end())
-		{
-			retVal = false;
-		}
-		else
-		{
-			retVal = (nullptr != vtObjectTree[objectID]);
-		}
-		return retVal;
+		return vtObjectTree.contains(objectID);
 	}
 
 	EventID VirtualTerminalWorkingSetBase::get_event_from_byte(std::uint8_t eventByte)
@@ -2429,6 +2465,469 @@ namespace isobus
 		return retVal;
 	}
 
+	bool VirtualTerminalWorkingSetBase::parse_iop_into_objects(const VirtualTerminalObjectPoolSnapshot &snapshot, std::uint8_t *iopData, std::uint32_t iopLength)
+	{
+		bool retVal = snapshot.get_is_snapshot_of(iopData, iopLength);
+
+		for (std::uint32_t i = 0; retVal && (i < snapshot.get_number_of_objects()); i++)
+		{
+			// Each object is decoded with the rest of the pool after it, exactly as a full parse would see it
+			const VirtualTerminalObjectPoolSnapshot::ObjectEntry entry = snapshot.get_object_entry(i);
+			std::uint32_t remainingLength = iopLength - entry.offset;
+			std::uint8_t *currentIopPointer = iopData + entry.offset;
+
+			snapshotPictureGraphicData = snapshot.get_decoded_data(entry);
+			snapshotPictureGraphicDataLength = entry.decodedDataLength;
+			retVal = parse_next_object(currentIopPointer, remainingLength) &&
+			  ((iopLength - entry.offset - remainingLength) == entry.length);
+		}
+		snapshotPictureGraphicData = nullptr;
+		snapshotPictureGraphicDataLength = 0;
+
+		if (retVal && (snapshot.get_working_set_id() != workingSetID))
+		{
+			retVal = false;
+		}
+		return retVal;
+	}
+
+	void VirtualTerminalWorkingSetBase::begin_incremental_iop_parse()
+	{
+		incrementalParseBuffer.clear();
+		incrementalParseOffset = 0;
+		incrementalParseBytesNeeded = 0;
+		incrementalParseBytesReceived = 0;
+		incrementalParseDeferred = false;
+		incrementalParseFailed = false;
+	}
+
+	bool VirtualTerminalWorkingSetBase::parse_iop_chunk(const std::uint8_t *chunk, std::uint32_t chunkLength)
+	{
+		if (incrementalParseFailed)
+		{
+			return false;
+		}
+
+		incrementalParseBuffer.insert(incrementalParseBuffer.end(), chunk, chunk + chunkLength);
+		incrementalParseBytesReceived += chunkLength;
+
+		auto remainingLength = static_cast<std::uint32_t>(incrementalParseBuffer.size() - incrementalParseOffset);
+
+		if (incrementalParseDeferred || (remainingLength < incrementalParseBytesNeeded))
+		{
+			return true;
+		}
+
+		std::uint8_t *currentIopPointer = incrementalParseBuffer.data() + incrementalParseOffset;
+		incrementalParseBytesNeeded = 0;
+
+		while (remainingLength > 0)
+		{
+			const std::uint32_t objectSize = get_iop_object_size(currentIopPointer, remainingLength);
+
+			if (0 == objectSize)
+			{
+				// Unsupported objects fail the pool, so let the final parse report it the same way a full parse would
+				incrementalParseDeferred = true;
+				break;
+			}
+			else if ((objectSize + INCREMENTAL_PARSE_LOOKAHEAD) > remainingLength)
+			{
+				incrementalParseBytesNeeded = objectSize + INCREMENTAL_PARSE_LOOKAHEAD;
+				break;
+			}
+			else if (!parse_next_object(currentIopPointer, remainingLength))
+			{
+				LOG_ERROR("[WS]: Parsing object pool failed.");
+				incrementalParseFailed = true;
+				incrementalParseBuffer.clear();
+				incrementalParseBuffer.shrink_to_fit();
+				return false;
+			}
+		}
+		incrementalParseOffset = incrementalParseBuffer.size() - remainingLength;
+
+		// Drop the decoded bytes once they make up most of the buffer, so the buffer stays about the size of the largest object
+		if (incrementalParseOffset >= remainingLength)
+		{
+			incrementalParseBuffer.erase(incrementalParseBuffer.begin(), incrementalParseBuffer.begin() + incrementalParseOffset);
+			incrementalParseOffset = 0;
+		}
+		return true;
+	}
+
+	bool VirtualTerminalWorkingSetBase::end_incremental_iop_parse()
+	{
+		bool retVal = false;
+
+		if (!incrementalParseFailed)
+		{
+			const auto remainingLength = static_cast<std::uint32_t>(incrementalParseBuffer.size() - incrementalParseOffset);
+
+			if (remainingLength > 0)
+			{
+				// The rest of the file is available now, so whatever is left is decoded exactly like a full parse
+				retVal = parse_iop_into_objects(incrementalParseBuffer.data() + incrementalParseOffset, remainingLength);
+			}
+			else
+			{
+				retVal = (incrementalParseBytesReceived > 0);
+			}
+		}
+		begin_incremental_iop_parse();
+		incrementalParseBuffer.shrink_to_fit();
+		return retVal;
+	}
+
+	std::uint32_t VirtualTerminalWorkingSetBase::get_iop_object_size(const std::uint8_t *iopData, std::uint32_t iopLength)
+	{
+		constexpr std::uint32_t MAX_PICTURE_GRAPHIC_RAW_DATA_SIZE = 0xFFF00000; // Leaves room to add the rest of the object without overflowing
+
+		// Every step needs some bytes to be available to find out how long the rest of the object is.
+		// If they haven't arrived yet, the number of bytes needed so far is returned, which is more than iopLength.
+		std::uint32_t size = 3;
+
+		auto add_macro_references = [iopData, iopLength, &size](std::uint8_t numberOfMacros) {
+			std::uint_fast8_t i = 0;
+			for (; (i < numberOfMacros) && (size < iopLength); i++)
+			{
+				size += (static_cast<std::uint8_t>(EventID::UseExtendedMacroReference) == iopData[size]) ? 4 : 2;
+			}
+			// Each macro reference that hasn't arrived yet is at least 2 bytes
+			size += 2 * static_cast<std::uint32_t>(numberOfMacros - i);
+		};
+		auto get_uint16 = [iopData](std::uint32_t index) {
+			return static_cast<std::uint16_t>(static_cast<std::uint16_t>(iopData[index]) | (static_cast<std::uint16_t>(iopData[index + 1]) << 8));
+		};
+
+		if (iopLength < size)
+		{
+			return size;
+		}
+
+		switch (static_cast<VirtualTerminalObjectType>(iopData[2]))
+		{
+			case VirtualTerminalObjectType::WorkingSet:
+			{
+				size = 10;
+				if (iopLength >= size)
+				{
+					size += 6 * iopData[7];
+					add_macro_references(iopData[8]);
+					size += 2 * iopData[9];
+				}
+			}
+			break;
+
+			case VirtualTerminalObjectType::DataMask:
+			{
+				size = 8;
+				if (iopLength >= size)
+				{
+					size += 6 * iopData[6];
+					add_macro_references(iopData[7]);
+				}
+			}
+			break;
+
+			case VirtualTerminalObjectType::AlarmMask:
+			case VirtualTerminalObjectType::Container:
+			{
+				size = 10;
+				if (iopLength >= size)
+				{
+					size += 6 * iopData[8];
+					add_macro_references(iopData[9]);
+				}
+			}
+			break;
+
+			case VirtualTerminalObjectType::WindowMask:
+			{
+				size = 17;
+				if (iopLength >= size)
+				{
+					size += (2 * iopData[14]) + (6 * iopData[15]);
+					add_macro_references(iopData[16]);
+				}
+			}
+			break;
+
+			case VirtualTerminalObjectType::SoftKeyMask:
+			{
+				size = 6;
+				if (iopLength >= size)
+				{
+					size += 2 * iopData[4];
+					add_macro_references(iopData[5]);
+				}
+			}
+			break;
+
+			case VirtualTerminalObjectType::Key:
+			{
+				size = 7;
+				if (iopLength >= size)
+				{
+					size += 6 * iopData[5];
+					add_macro_references(iopData[6]);
+				}
+			}
+			break;
+
+			case VirtualTerminalObjectType::Button:
+			{
+				size = 13;
+				if (iopLength >= size)
+				{
+					size += 6 * iopData[11];
+					add_macro_references(iopData[12]);
+				}
+			}
+			break;
+
+			case VirtualTerminalObjectType::KeyGroup:
+			{
+				size = 9;
+				if (iopLength >= size)
+				{
+					size += (2 * iopData[8]) + 1;
+					if (iopLength >= size)
+					{
+						add_macro_references(iopData[size - 1]);
+					}
+				}
+			}
+			break;
+
+			case VirtualTerminalObjectType::InputBoolean:
+			case VirtualTerminalObjectType::OutputNumber:
+			case VirtualTerminalObjectType::InputNumber:
+			case VirtualTerminalObjectType::OutputLine:
+			case VirtualTerminalObjectType::OutputRectangle:
+			case VirtualTerminalObjectType::OutputEllipse:
+			case VirtualTerminalObjectType::OutputMeter:
+			case VirtualTerminalObjectType::OutputLinearBarGraph:
+			case VirtualTerminalObjectType::OutputArchedBarGraph:
+			case VirtualTerminalObjectType::FontAttributes:
+			case VirtualTerminalObjectType::LineAttributes:
+			case VirtualTerminalObjectType::FillAttributes:
+			{
+				// Fixed size attributes, followed by the number of macros and the macro list
+				std::uint32_t indexOfNumberOfMacros = 0;
+				switch (static_cast<VirtualTerminalObjectType>(iopData[2]))
+				{
+					case VirtualTerminalObjectType::InputBoolean:
+						indexOfNumberOfMacros = 12;
+						break;
+					case VirtualTerminalObjectType::OutputNumber:
+						indexOfNumberOfMacros = 28;
+						break;
+					case VirtualTerminalObjectType::InputNumber:
+						indexOfNumberOfMacros = 37;
+						break;
+					case VirtualTerminalObjectType::OutputLine:
+						indexOfNumberOfMacros = 10;
+						break;
+					case VirtualTerminalObjectType::OutputRectangle:
+						indexOfNumberOfMacros = 12;
+						break;
+					case VirtualTerminalObjectType::OutputEllipse:
+						indexOfNumberOfMacros = 14;
+						break;
+					case VirtualTerminalObjectType::OutputMeter:
+						indexOfNumberOfMacros = 20;
+						break;
+					case VirtualTerminalObjectType::OutputLinearBarGraph:
+						indexOfNumberOfMacros = 23;
+						break;
+					case VirtualTerminalObjectType::OutputArchedBarGraph:
+						indexOfNumberOfMacros = 26;
+						break;
+					default:
+						indexOfNumberOfMacros = 7;
+						break;
+				}
+				size = indexOfNumberOfMacros + 1;
+				if (iopLength >= size)
+				{
+					add_macro_references(iopData[indexOfNumberOfMacros]);
+				}
+			}
+			break;
+
+			case VirtualTerminalObjectType::InputString:
+			{
+				size = 17;
+				if (iopLength >= size)
+				{
+					size += iopData[16] + 2;
+					if (iopLength >= size)
+					{
+						add_macro_references(iopData[size - 1]);
+					}
+				}
+			}
+			break;
+
+			case VirtualTerminalObjectType::InputList:
+			{
+				size = 13;
+				if (iopLength >= size)
+				{
+					size += 2 * iopData[10];
+					add_macro_references(iopData[12]);
+				}
+			}
+			break;
+
+			case VirtualTerminalObjectType::OutputList:
+			{
+				size = 12;
+				if (iopLength >= size)
+				{
+					size += 2 * iopData[10];
+					add_macro_references(iopData[11]);
+				}
+			}
+			break;
+
+			case VirtualTerminalObjectType::OutputString:
+			{
+				size = 16;
+				if (iopLength >= size)
+				{
+					size += get_uint16(14) + 1;
+					if (iopLength >= size)
+					{
+						add_macro_references(iopData[size - 1]);
+					}
+				}
+			}
+			break;
+
+			case VirtualTerminalObjectType::OutputPolygon:
+			{
+				size = 14;
+				if (iopLength >= size)
+				{
+					size += 4 * iopData[12];
+					add_macro_references(iopData[13]);
+				}
+			}
+			break;
+
+			case VirtualTerminalObjectType::PictureGraphic:
+			{
+				size = 17;
+				if (iopLength >= size)
+				{
+					const std::uint32_t numberOfBytesInRawData = (static_cast<std::uint32_t>(get_uint16(12)) | (static_cast<std::uint32_t>(get_uint16(14)) << 16));
+					if (numberOfBytesInRawData > MAX_PICTURE_GRAPHIC_RAW_DATA_SIZE)
+					{
+						// Too large to be real, so leave it to the final parse to report
+						return 0;
+					}
+					size += numberOfBytesInRawData;
+					add_macro_references(iopData[16]);
+				}
+			}
+			break;
+
+			case VirtualTerminalObjectType::NumberVariable:
+			{
+				size = 7;
+			}
+			break;
+
+			case VirtualTerminalObjectType::StringVariable:
+			case VirtualTerminalObjectType::ColourMap:
+			case VirtualTerminalObjectType::Macro:
+			{
+				size = 5;
+				if (iopLength >= size)
+				{
+					size += get_uint16(3);
+				}
+			}
+			break;
+
+			case VirtualTerminalObjectType::InputAttributes:
+			{
+				size = 5;
+				if (iopLength >= size)
+				{
+					size += iopData[4] + 1;
+					if (iopLength >= size)
+					{
+						add_macro_references(iopData[size - 1]);
+					}
+				}
+			}
+			break;
+
+			case VirtualTerminalObjectType::ObjectPointer:
+			{
+				size = 5;
+			}
+			break;
+
+			case VirtualTerminalObjectType::ExtendedInputAttributes:
+			{
+				size = 5;
+				if (iopLength >= size)
+				{
+					const std::uint8_t numberOfCodePlanes = iopData[4];
+					std::uint_fast8_t i = 0;
+					for (; (i < numberOfCodePlanes) && (size + 2 <= iopLength); i++)
+					{
+						// Each code plane is its number and number of ranges, followed by 4 bytes per range
+						size += 2 + 4 * static_cast<std::uint32_t>(iopData[size + 1]);
+					}
+					// Each code plane that hasn't arrived yet is at least 2 bytes
+					size += 2 * static_cast<std::uint32_t>(numberOfCodePlanes - i);
+				}
+			}
+			break;
+
+			case VirtualTerminalObjectType::AuxiliaryFunctionType1:
+			case VirtualTerminalObjectType::AuxiliaryFunctionType2:
+			case VirtualTerminalObjectType::AuxiliaryInputType2:
+			{
+				size = 6;
+				if (iopLength >= size)
+				{
+					size += 6 * iopData[5];
+				}
+			}
+			break;
+
+			case VirtualTerminalObjectType::AuxiliaryInputType1:
+			{
+				size = 7;
+				if (iopLength >= size)
+				{
+					size += 6 * iopData[6];
+				}
+			}
+			break;
+
+			case VirtualTerminalObjectType::AuxiliaryControlDesignatorType2:
+			{
+				size = 6;
+			}
+			break;
+
+			default:
+			{
+				// Not decoded at all by parse_next_object, or not a valid object type
+				size = 0;
+			}
+			break;
+		}
+		return size;
+	}
+
 	void VirtualTerminalWorkingSetBase::set_object_pool_faulting_object_id(std::uint16_t value)
 	{
 		const std::lock_guard<std::mutex> lock(managedWorkingSetMutex);
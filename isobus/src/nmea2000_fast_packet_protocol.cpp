@@ -104,8 +104,18 @@ namespace isobus
 	}
 
 	FastPacketProtocol::FastPacketProtocol(const CANMessageFrameCallback &sendCANFrameCallback) :
+	  activeSessions(true),
 	  sendCANFrameCallback(sendCANFrameCallback)
 	{
+		activeSessions.reserve(INITIAL_SESSION_CAPACITY);
+		dueSessions.reserve(INITIAL_SESSION_CAPACITY);
+
+		// All receive slots start out on the free list
+		firstReceiveSlotBySource.fill(NO_RECEIVE_SLOT);
+		for (std::uint8_t i = 0; i < RECEIVE_SLOT_COUNT; i++)
+		{
+			receiveSlots[i].nextSlot = ((i + 1) < RECEIVE_SLOT_COUNT) ? (i + 1) : NO_RECEIVE_SLOT;
+		}
 	}
 
 	void FastPacketProtocol::register_multipacket_message_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parent, std::shared_ptr<InternalControlFunction> internalControlFunction)
@@ -184,17 +194,19 @@ namespace isobus
 		                                                           parentPointer);
 
 		LOCK_GUARD(Mutex, sessionMutex);
-		activeSessions.push_back(session);
+		activeSessions.insert(session);
+		activeSessions.schedule(session, SystemTiming::get_timestamp_ms());
 		return true;
 	}
 
 	void FastPacketProtocol::update()
 	{
 		LOCK_GUARD(Mutex, sessionMutex);
-		// We use a fancy for loop here to allow us to remove sessions from the list while iterating
-		for (std::size_t i = activeSessions.size(); i > 0; i--)
+		activeSessions.take_due_sessions(SystemTiming::get_timestamp_ms(), dueSessions);
+
+		// The due sessions are in reverse order of when they were added, so closing one doesn't affect the others
+		for (const auto &session : dueSessions)
 		{
-			auto session = activeSessions.at(i - 1);
 			if (!session->get_source()->get_address_valid())
 			{
 				LOG_WARNING("[FP]: Closing active session as the source control function is no longer valid");
@@ -205,10 +217,58 @@ namespace isobus
 				LOG_WARNING("[FP]: Closing active session as the destination control function is no longer valid");
 				close_session(session, false);
 			}
-			update_session(session);
+			else
+			{
+				update_session(session);
+			}
+		}
+
+		// Transmit sessions that still have frames to send are due again on the next update
+		const std::uint32_t now = SystemTiming::get_timestamp_ms();
+		for (const auto &session : dueSessions)
+		{
+			if (session == activeSessions.find(session->get_source(), session->get_destination(), session->get_parameter_group_number()))
+			{
+				activeSessions.schedule(session, now);
+			}
+		}
+		dueSessions.clear();
+
+		for (std::uint8_t i = 0; (i < RECEIVE_SLOT_COUNT) && (0 != receiveSlotsInUse); i++)
+		{
+			if (receiveSlots[i].inUse && (SystemTiming::get_time_elapsed_ms(receiveSlots[i].lastFrameTimestamp_ms) > get_receive_slot_timeout(receiveSlots[i])))
+			{
+				if (0 == receiveSlots[i].messageLength)
+				{
+					LOG_DEBUG("[FP]: Dropping frames whose first frame never arrived.");
+				}
+				else
+				{
+					LOG_ERROR("[FP]: Rx session timed out.");
+				}
+				release_receive_slot(i);
+			}
 		}
 	}
 
+	std::uint32_t FastPacketProtocol::get_time_until_next_update() const
+	{
+		LOCK_GUARD(Mutex, sessionMutex);
+		std::uint32_t retVal = activeSessions.get_time_until_next_deadline(SystemTiming::get_timestamp_ms());
+
+		for (const auto &slot : receiveSlots)
+		{
+			if (slot.inUse)
+			{
+				// Received frames reset the timer, so the slot only needs to be checked once the timeout could have expired
+				const std::uint32_t timeout = get_receive_slot_timeout(slot);
+				std::uint32_t timeSinceLastFrame = SystemTiming::get_time_elapsed_ms(slot.lastFrameTimestamp_ms);
+				retVal = std::min(retVal, (timeSinceLastFrame > timeout) ? 0 : (timeout - timeSinceLastFrame + 1));
+			}
+		}
+		return retVal;
+	}
+
 	void FastPacketProtocol::add_session_history(const std::shared_ptr<FastPacketProtocolSession> &session)
 	{
 		if (nullptr != session)
@@ -245,11 +305,7 @@ namespace isobus
 			session->complete(successful);
 			add_session_history(session);
 
-			auto sessionLocation = std::find(activeSessions.begin(), activeSessions.end(), session);
-			if (activeSessions.end() != sessionLocation)
-			{
-				activeSessions.erase(sessionLocation);
-			}
+			activeSessions.erase(session);
 		}
 	}
 
@@ -309,252 +365,257 @@ namespace isobus
 			return;
 		}
 
-		std::shared_ptr<FastPacketProtocolSession> session = get_session(message.get_identifier().get_parameter_group_number(),
-		                                                                 message.get_source_control_function(),
-		                                                                 message.get_destination_control_function());
-		std::uint8_t actualFrameCount = (message.get_uint8_at(0) & FRAME_COUNTER_BIT_MASK);
+		const std::uint8_t frameCounter = (message.get_uint8_at(0) & FRAME_COUNTER_BIT_MASK);
+		const std::uint8_t sequenceNumber = ((message.get_uint8_at(0) >> SEQUENCE_NUMBER_BIT_OFFSET) & SEQUENCE_NUMBER_BIT_MASK);
+		std::unique_ptr<CANMessage> completedMessage;
 
-		if (nullptr != session)
 		{
-			// We have a matching active session
-			if (0 == actualFrameCount)
-			{
-				// This is the beginning of a new message, but we already have a session
-				LOG_ERROR("[FP]: Existing session matched new frame counter, aborting the matching session.");
-				close_session(session, false);
-			}
-			else
-			{
-				// Correct sequence number, copy the data (hybrid optimization)
-				// Convert data type to a vector to allow for manipulation
-				auto &data = static_cast<CANMessageDataVector &>(session->get_data());
+			LOCK_GUARD(Mutex, sessionMutex);
+			std::uint8_t slotIndex = find_receive_slot(message, sequenceNumber);
 
-				// Defensive bounds check to prevent potential buffer overflow
-				if (session->numberOfBytesTransferred >= session->get_message_length())
+			if (0 == frameCounter)
+			{
+				// This is the beginning of a message
+				std::uint8_t messageLength = message.get_uint8_at(1);
+				if (messageLength > MAX_PROTOCOL_MESSAGE_LENGTH)
 				{
-					LOG_ERROR("[FP]: Protocol violation - bytes transferred %u exceeds message length %u",
-					          session->numberOfBytesTransferred,
-					          session->get_message_length());
-					close_session(session, false);
+					LOG_WARNING("[FP]: Ignoring possible new FP session with advertised length > 233.");
 					return;
 				}
-
-				std::size_t bytes_to_copy = std::min(
-				  static_cast<std::size_t>(PROTOCOL_BYTES_PER_FRAME),
-				  static_cast<std::size_t>(session->get_message_length() - session->numberOfBytesTransferred));
-
-				if (bytes_to_copy > 0)
+				else if (messageLength <= CAN_DATA_LENGTH)
 				{
-					if (bytes_to_copy <= 4)
-					{
-						// Use byte-by-byte for small copies (better for tiny data)
-						for (std::size_t i = 0; i < bytes_to_copy; i++)
-						{
-							data[session->numberOfBytesTransferred + i] = message.get_data().data()[1 + i];
-						}
-					}
-					else
-					{
-						// Use memcpy for larger copies (better for bulk data)
-						memcpy(&data[session->numberOfBytesTransferred], message.get_data().data() + 1, bytes_to_copy);
-					}
-					session->add_number_of_bytes_transferred(static_cast<std::uint8_t>(bytes_to_copy));
+					LOG_WARNING("[FP]: Ignoring possible new FP session with advertised length <= 8.");
+					return;
 				}
 
-				if (session->numberOfBytesTransferred >= session->get_message_length())
+				if (NO_RECEIVE_SLOT == slotIndex)
 				{
-					// Complete
-					CANMessage completedMessage(CANMessage::Type::Receive,
-					                            message.get_identifier(),
-					                            std::move(data),
-					                            message.get_source_control_function(),
-					                            message.get_destination_control_function(),
-					                            message.get_can_port_index());
-
-					// Find the appropriate callback and let them know
-					for (const auto &callback : parameterGroupNumberCallbacks)
-					{
-						if ((callback.get_parameter_group_number() == message.get_identifier().get_parameter_group_number()) &&
-						    ((nullptr == callback.get_internal_control_function()) ||
-						     (callback.get_internal_control_function() == message.get_destination_control_function())))
-						{
-							callback.get_callback()(completedMessage, callback.get_parent());
-						}
-					}
-					close_session(session, true);
+					slotIndex = claim_receive_slot(message, sequenceNumber);
 				}
-			}
-		}
-		else
-		{
-			// No matching session. See if we need to start a new session
-			if (0 != actualFrameCount)
-			{
-				// This is the middle of some message that we have no context for.
-				// Ignore the message for now until we receive it with a fresh packet counter.
-				LOG_WARNING("[FP]: Ignoring FP message with PGN %u, no context available. The message may be processed when packet count returns to zero.",
-				            message.get_identifier().get_parameter_group_number());
+				else if (0 != (receiveSlots[slotIndex].receivedFrames & 1))
+				{
+					// This is the beginning of a new message, but we already have one with the same sequence counter
+					LOG_ERROR("[FP]: Existing session matched new frame counter, aborting the matching session.");
+					receiveSlots[slotIndex].receivedFrames = 0;
+				}
+				else if (SystemTiming::get_time_elapsed_ms(receiveSlots[slotIndex].claimTimestamp_ms) > OUT_OF_ORDER_FRAME_WINDOW_MS)
+				{
+					// The frames that arrived early are too old to belong to this message, they're left over from a previous one
+					receiveSlots[slotIndex].receivedFrames = 0;
+				}
+
+				auto &slot = receiveSlots[slotIndex];
+				slot.messageLength = messageLength;
+				std::memcpy(slot.data.data(), message.get_data().data() + 2, PROTOCOL_BYTES_PER_FRAME - 1);
 			}
 			else
 			{
-				// This is the beginning of a new message
-				std::uint8_t messageLength = message.get_uint8_at(1);
-				if (messageLength > MAX_PROTOCOL_MESSAGE_LENGTH)
-				{
-					LOG_WARNING("[FP]: Ignoring possible new FP session with advertised length > 233.");
-					return;
-				}
-				else if (messageLength <= CAN_DATA_LENGTH)
+				if (NO_RECEIVE_SLOT == slotIndex)
 				{
-					LOG_WARNING("[FP]: Ignoring possible new FP session with advertised length <= 8.");
-					return;
+					// A frame that arrived before the first frame of its message, keep it until the rest of the message arrives
+					slotIndex = claim_receive_slot(message, sequenceNumber);
 				}
 
-				// Create a new session
-				session = std::make_shared<FastPacketProtocolSession>(FastPacketProtocolSession::Direction::Receive,
-				                                                      std::unique_ptr<CANMessageData>(new CANMessageDataVector(messageLength)),
-				                                                      message.get_identifier().get_parameter_group_number(),
-				                                                      messageLength,
-				                                                      (message.get_uint8_at(0) & SEQUENCE_NUMBER_BIT_MASK),
-				                                                      message.get_identifier().get_priority(),
-				                                                      message.get_source_control_function(),
-				                                                      message.get_destination_control_function(),
-				                                                      nullptr, // No callback
-				                                                      nullptr);
-
-				// Save the 6 bytes of payload in this first message (hybrid optimization)
-				// Convert data type to a vector to allow for manipulation
-				auto &data = static_cast<CANMessageDataVector &>(session->get_data());
-
-				// Defensive bounds check to prevent potential buffer overflow
-				if (session->numberOfBytesTransferred >= session->get_message_length())
+				auto &slot = receiveSlots[slotIndex];
+				std::size_t dataIndex = (PROTOCOL_BYTES_PER_FRAME - 1) + (static_cast<std::size_t>(frameCounter - 1) * PROTOCOL_BYTES_PER_FRAME);
+
+				// Defensive bounds check to prevent a frame from being placed outside of the message
+				if ((0 != slot.messageLength) && (dataIndex >= slot.messageLength))
 				{
-					LOG_ERROR("[FP]: Protocol violation - bytes transferred %u exceeds message length %u",
-					          session->numberOfBytesTransferred,
-					          session->get_message_length());
-					close_session(session, false);
+					LOG_ERROR("[FP]: Protocol violation - frame %u is beyond message length %u", frameCounter, slot.messageLength);
+					release_receive_slot(slotIndex);
 					return;
 				}
 
-				std::size_t bytes_to_copy = std::min(
-				  static_cast<std::size_t>(PROTOCOL_BYTES_PER_FRAME - 1),
-				  static_cast<std::size_t>(session->get_message_length() - session->numberOfBytesTransferred));
+				std::memcpy(slot.data.data() + dataIndex,
+				            message.get_data().data() + 1,
+				            std::min(static_cast<std::size_t>(PROTOCOL_BYTES_PER_FRAME), slot.data.size() - dataIndex));
+			}
 
-				if (bytes_to_copy > 0)
+			auto &slot = receiveSlots[slotIndex];
+			slot.receivedFrames |= (static_cast<std::uint32_t>(1) << frameCounter);
+			slot.lastFrameTimestamp_ms = SystemTiming::get_timestamp_ms();
+
+			if (0 != slot.messageLength)
+			{
+				// Out of order frames may have arrived first, so the message is complete once every one of its frames was received
+				std::uint8_t numberOfFrames = calculate_number_of_frames(slot.messageLength);
+				std::uint32_t allFrames = (numberOfFrames >= 32) ? 0xFFFFFFFF : ((static_cast<std::uint32_t>(1) << numberOfFrames) - 1);
+				if (allFrames == (slot.receivedFrames & allFrames))
 				{
-					if (bytes_to_copy <= 4)
-					{
-						// Use byte-by-byte for small copies (better for tiny data)
-						for (std::size_t i = 0; i < bytes_to_copy; i++)
-						{
-							data[session->numberOfBytesTransferred + i] = message.get_data().data()[2 + i];
-						}
-					}
-					else
-					{
-						// Use memcpy for larger copies (better for bulk data)
-						memcpy(&data[session->numberOfBytesTransferred], message.get_data().data() + 2, bytes_to_copy);
-					}
-					session->add_number_of_bytes_transferred(static_cast<std::uint8_t>(bytes_to_copy));
+					completedMessage.reset(new CANMessage(CANMessage::Type::Receive,
+					                                      message.get_identifier(),
+					                                      std::vector<std::uint8_t>(slot.data.begin(), slot.data.begin() + slot.messageLength),
+					                                      message.get_source_control_function(),
+					                                      message.get_destination_control_function(),
+					                                      message.get_can_port_index()));
+					release_receive_slot(slotIndex);
 				}
+			}
+		}
 
-				LOCK_GUARD(Mutex, sessionMutex);
-				activeSessions.push_back(session);
+		if (nullptr != completedMessage)
+		{
+			// Find the appropriate callback and let them know
+			for (const auto &callback : parameterGroupNumberCallbacks)
+			{
+				if ((callback.get_parameter_group_number() == message.get_identifier().get_parameter_group_number()) &&
+				    ((nullptr == callback.get_internal_control_function()) ||
+				     (callback.get_internal_control_function() == message.get_destination_control_function())))
+				{
+					callback.get_callback()(*completedMessage, callback.get_parent());
+				}
 			}
 		}
 	}
 
-	void FastPacketProtocol::update_session(const std::shared_ptr<FastPacketProtocolSession> &session)
+	std::uint32_t FastPacketProtocol::get_receive_slot_timeout(const ReceiveSlot &slot)
 	{
-		if (nullptr == session)
+		std::uint32_t retVal = FP_TIMEOUT_MS;
+		if (0 == slot.messageLength)
 		{
-			return;
+			// Frames that arrived before the first frame of their message only wait for it as long as the gap between frames may be
+			retVal = OUT_OF_ORDER_FRAME_WINDOW_MS;
 		}
+		return retVal;
+	}
 
-		if (session->get_direction() == FastPacketProtocolSession::Direction::Receive)
+	std::uint8_t FastPacketProtocol::find_receive_slot(const CANMessage &message, std::uint8_t sequenceNumber) const
+	{
+		std::uint8_t slotIndex = firstReceiveSlotBySource[message.get_identifier().get_source_address()];
+		while (NO_RECEIVE_SLOT != slotIndex)
 		{
-			// We are receiving a message, only need to check for timeouts
-			if (session->get_time_since_last_update() > FP_TIMEOUT_MS)
+			const auto &slot = receiveSlots[slotIndex];
+			if ((slot.parameterGroupNumber == message.get_identifier().get_parameter_group_number()) &&
+			    (slot.sequenceNumber == sequenceNumber) &&
+			    (slot.source == message.get_source_control_function()) &&
+			    (slot.destination == message.get_destination_control_function()))
 			{
-				LOG_ERROR("[FP]: Rx session timed out.");
-				close_session(session, false);
+				break;
 			}
+			slotIndex = slot.nextSlot;
 		}
-		else
+		return slotIndex;
+	}
+
+	std::uint8_t FastPacketProtocol::claim_receive_slot(const CANMessage &message, std::uint8_t sequenceNumber)
+	{
+		if (NO_RECEIVE_SLOT == firstFreeReceiveSlot)
 		{
-			std::array<std::uint8_t, CAN_DATA_LENGTH> buffer;
-			// We are transmitting a message, let's try and send remaining packets
-			for (std::uint8_t i = 0; i < session->get_number_of_remaining_packets(); i++)
+			// Every slot is in use, make room by dropping the message that has gone the longest without a new frame
+			std::uint8_t oldestSlot = 0;
+			for (std::uint8_t i = 1; i < RECEIVE_SLOT_COUNT; i++)
 			{
-				buffer[0] = session->get_last_packet_number();
-				buffer[0] |= (session->sequenceNumber << SEQUENCE_NUMBER_BIT_OFFSET);
-
-				std::uint8_t startIndex = 1;
-				std::uint8_t bytesThisFrame = PROTOCOL_BYTES_PER_FRAME;
-				if (0 == session->get_total_bytes_transferred())
+				if (SystemTiming::get_time_elapsed_ms(receiveSlots[i].lastFrameTimestamp_ms) > SystemTiming::get_time_elapsed_ms(receiveSlots[oldestSlot].lastFrameTimestamp_ms))
 				{
-					// This is the first frame, so we need to send the message length
-					buffer[1] = session->get_message_length();
-					startIndex++;
-					bytesThisFrame--;
+					oldestSlot = i;
 				}
+			}
+			LOG_WARNING("[FP]: All receive slots are in use, dropping the oldest partially received message.");
+			release_receive_slot(oldestSlot);
+		}
 
-				for (std::uint8_t j = 0; j < bytesThisFrame; j++)
-				{
-					std::uint8_t index = static_cast<std::uint8_t>(session->get_total_bytes_transferred()) + j;
-					if (index < session->get_message_length())
-					{
-						buffer[startIndex + j] = session->get_data().get_byte(index);
-					}
-					else
-					{
-						buffer[startIndex + j] = 0xFF;
-					}
-				}
+		std::uint8_t slotIndex = firstFreeReceiveSlot;
+		auto &slot = receiveSlots[slotIndex];
+		firstFreeReceiveSlot = slot.nextSlot;
+
+		slot.source = message.get_source_control_function();
+		slot.destination = message.get_destination_control_function();
+		slot.parameterGroupNumber = message.get_identifier().get_parameter_group_number();
+		slot.sourceAddress = message.get_identifier().get_source_address();
+		slot.claimTimestamp_ms = SystemTiming::get_timestamp_ms();
+		slot.lastFrameTimestamp_ms = slot.claimTimestamp_ms;
+		slot.receivedFrames = 0;
+		slot.messageLength = 0;
+		slot.sequenceNumber = sequenceNumber;
+		slot.inUse = true;
+
+		auto &firstSlotOfSource = firstReceiveSlotBySource[message.get_identifier().get_source_address()];
+		slot.nextSlot = firstSlotOfSource;
+		firstSlotOfSource = slotIndex;
+		receiveSlotsInUse++;
+		return slotIndex;
+	}
 
-				if (sendCANFrameCallback(session->get_parameter_group_number(),
-				                         CANDataSpan(buffer.data(), buffer.size()),
-				                         std::static_pointer_cast<InternalControlFunction>(session->get_source()),
-				                         session->get_destination(),
-				                         session->priority))
-				{
-					session->add_number_of_bytes_transferred(bytesThisFrame);
-				}
-				else
-				{
-					if (session->get_time_since_last_update() > FP_TIMEOUT_MS)
-					{
-						LOG_ERROR("[FP]: Tx session timed out.");
-						close_session(session, false);
-					}
-					break;
-				}
+	void FastPacketProtocol::release_receive_slot(std::uint8_t slotIndex)
+	{
+		auto &slot = receiveSlots[slotIndex];
+
+		// Unlink the slot from the list of its source, which is only as long as the number of messages that source is sending at once
+		std::uint8_t *link = &firstReceiveSlotBySource[slot.sourceAddress];
+		while ((NO_RECEIVE_SLOT != *link) && (slotIndex != *link))
+		{
+			link = &receiveSlots[*link].nextSlot;
+		}
+		if (slotIndex == *link)
+		{
+			*link = slot.nextSlot;
+		}
+
+		slot.source.reset();
+		slot.destination.reset();
+		slot.inUse = false;
+		slot.nextSlot = firstFreeReceiveSlot;
+		firstFreeReceiveSlot = slotIndex;
+		receiveSlotsInUse--;
+	}
+
+	void FastPacketProtocol::update_session(const std::shared_ptr<FastPacketProtocolSession> &session)
+	{
+		if (nullptr == session)
+		{
+			return;
+		}
+
+		std::array<std::uint8_t, CAN_DATA_LENGTH> buffer;
+		// We are transmitting a message, let's try and send remaining packets
+		for (std::uint8_t i = 0; i < session->get_number_of_remaining_packets(); i++)
+		{
+			buffer[0] = session->get_last_packet_number();
+			buffer[0] |= (session->sequenceNumber << SEQUENCE_NUMBER_BIT_OFFSET);
+
+			std::uint8_t startIndex = 1;
+			std::uint8_t bytesThisFrame = PROTOCOL_BYTES_PER_FRAME;
+			if (0 == session->get_total_bytes_transferred())
+			{
+				// This is the first frame, so we need to send the message length
+				buffer[1] = session->get_message_length();
+				startIndex++;
+				bytesThisFrame--;
 			}
 
-			if (session->get_number_of_remaining_packets() == 0)
+			std::size_t bytesCopied = session->get_data().copy_bytes(session->get_total_bytes_transferred(), DataSpan<std::uint8_t>(buffer.data() + startIndex, bytesThisFrame));
+			std::fill(buffer.begin() + startIndex + bytesCopied, buffer.end(), 0xFF);
+
+			if (sendCANFrameCallback(session->get_parameter_group_number(),
+			                         CANDataSpan(buffer.data(), buffer.size()),
+			                         std::static_pointer_cast<InternalControlFunction>(session->get_source()),
+			                         session->get_destination(),
+			                         session->priority))
 			{
-				close_session(session, true);
+				session->add_number_of_bytes_transferred(bytesThisFrame);
+			}
+			else
+			{
+				if (session->get_time_since_last_update() > FP_TIMEOUT_MS)
+				{
+					LOG_ERROR("[FP]: Tx session timed out.");
+					close_session(session, false);
+				}
+				break;
 			}
 		}
-	}
 
-	bool FastPacketProtocol::has_session(std::uint32_t parameterGroupNumber, std::shared_ptr<ControlFunction> source, std::shared_ptr<ControlFunction> destination)
-	{
-		LOCK_GUARD(Mutex, sessionMutex);
-		return std::any_of(activeSessions.begin(), activeSessions.end(), [&](const std::shared_ptr<FastPacketProtocolSession> &session) {
-			return session->matches(source, destination) && (session->get_parameter_group_number() == parameterGroupNumber);
-		});
+		if (session->get_number_of_remaining_packets() == 0)
+		{
+			close_session(session, true);
+		}
 	}
 
-	std::shared_ptr<FastPacketProtocol::FastPacketProtocolSession> FastPacketProtocol::get_session(std::uint32_t parameterGroupNumber,
-	                                                                                               std::shared_ptr<ControlFunction> source,
-	                                                                                               std::shared_ptr<ControlFunction> destination)
+	bool FastPacketProtocol::has_session(std::uint32_t parameterGroupNumber, std::shared_ptr<ControlFunction> source, std::shared_ptr<ControlFunction> destination)
 	{
 		LOCK_GUARD(Mutex, sessionMutex);
-		auto result = std::find_if(activeSessions.begin(), activeSessions.end(), [&](const std::shared_ptr<FastPacketProtocolSession> &session) {
-			return session->matches(source, destination) && (session->get_parameter_group_number() == parameterGroupNumber);
-		});
-		return (activeSessions.end() != result) ? (*result) : nullptr;
+		return nullptr != activeSessions.find(source, destination, parameterGroupNumber);
 	}
 
 } // namespace isobus
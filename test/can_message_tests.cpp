@@ -6,7 +6,9 @@
 #include "isobus/hardware_integration/can_hardware_interface.hpp"
 #include "isobus/hardware_integration/virtual_can_plugin.hpp"
 #include "isobus/isobus/can_message.hpp"
+#include "isobus/isobus/can_message_data.hpp"
 #include "isobus/isobus/can_message_frame.hpp"
+#include "isobus/isobus/can_message_pool.hpp"
 #include "isobus/isobus/can_network_manager.hpp"
 
 using namespace isobus;
@@ -71,3 +73,169 @@ TEST(CAN_MESSAGE_TESTS, DataCorrectnessTest)
 	CANNetworkManager::CANNetwork.remove_global_parameter_group_number_callback(0xE100, callback, nullptr);
 	CANHardwareInterface::stop();
 }
+
+TEST(CAN_MESSAGE_TESTS, MessagePoolReusesMessages)
+{
+	CANMessagePool pool;
+	EXPECT_TRUE(pool.resize(2));
+	EXPECT_EQ(2, pool.get_capacity());
+
+	const std::uint8_t payload[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+	CANMessage *first = pool.acquire(CANMessage::Type::Receive, CANIdentifier(0x18EFFFAA), payload, sizeof(payload), nullptr, nullptr, 1);
+	ASSERT_NE(nullptr, first);
+	EXPECT_EQ(CANMessage::Type::Receive, first->get_type());
+	EXPECT_EQ(0x18EFFFAA, first->get_identifier().get_identifier());
+	EXPECT_EQ(8, first->get_data_length());
+	EXPECT_EQ(0x0807060504030201, first->get_uint64_at(0));
+	EXPECT_EQ(1, first->get_can_port_index());
+	EXPECT_EQ(1, pool.get_number_in_use());
+
+	// Pool can't be resized while messages are in use
+	EXPECT_FALSE(pool.resize(4));
+
+	CANMessage *second = pool.acquire(CANMessage::Type::Transmit, CANIdentifier(0x18EF00AA), payload, 3, nullptr, nullptr, 0);
+	EXPECT_EQ(2, pool.get_high_water_mark());
+	EXPECT_EQ(0, pool.get_overflow_count());
+
+	// Pool is exhausted, so this one ends up on the heap
+	CANMessage *third = pool.acquire(CANMessage::Type::Transmit, CANIdentifier(0x18EF00AA), payload, 8, nullptr, nullptr, 0);
+	ASSERT_NE(nullptr, third);
+	EXPECT_EQ(8, third->get_data_length());
+	EXPECT_EQ(1, pool.get_overflow_count());
+	EXPECT_EQ(2, pool.get_high_water_mark());
+
+	pool.release(third);
+	pool.release(second);
+	pool.release(first);
+	EXPECT_EQ(0, pool.get_number_in_use());
+	EXPECT_EQ(2, pool.get_high_water_mark());
+
+	// Released messages are handed out again
+	CANMessage *reused = pool.acquire(CANMessage::Type::Receive, CANIdentifier(0x18EFFFAB), payload, 2, nullptr, nullptr, 2);
+	EXPECT_TRUE((reused == first) || (reused == second));
+	EXPECT_EQ(2, reused->get_data_length());
+	EXPECT_EQ(0x0201, reused->get_uint16_at(0));
+	pool.release(reused);
+
+	pool.reset_statistics();
+	EXPECT_EQ(0, pool.get_high_water_mark());
+	EXPECT_EQ(0, pool.get_overflow_count());
+}
+
+TEST(CAN_MESSAGE_TESTS, MessageQueueKeepsOrderWhenGrowing)
+{
+	CANMessagePool pool;
+	pool.resize(8);
+	CANMessageQueue queue(2);
+	std::vector<CANMessage *> messages;
+
+	for (std::uint8_t i = 0; i < 8; i++)
+	{
+		messages.push_back(pool.acquire(CANMessage::Type::Receive, CANIdentifier(0x18EFFFAA), &i, 1, nullptr, nullptr, 0));
+		queue.push(messages.back());
+
+		if (3 == i)
+		{
+			// Move the head of the ring so that growing has to unwrap it
+			CANMessage *popped = nullptr;
+			EXPECT_TRUE(queue.pop(&popped));
+			EXPECT_EQ(messages.front(), popped);
+		}
+	}
+	EXPECT_EQ(7, queue.size());
+
+	CANMessage *popped = nullptr;
+	for (std::size_t i = 1; i < messages.size(); i++)
+	{
+		ASSERT_TRUE(queue.pop(&popped));
+		EXPECT_EQ(messages.at(i), popped);
+	}
+	EXPECT_FALSE(queue.pop(&popped));
+
+	for (auto message : messages)
+	{
+		pool.release(message);
+	}
+	EXPECT_EQ(0, pool.get_number_in_use());
+}
+
+TEST(CAN_MESSAGE_TESTS, NetworkManagerUsesMessagePool)
+{
+	CANNetworkManager::CANNetwork.get_configuration().set_message_pool_capacity(16);
+	CANNetworkManager::CANNetwork.initialize();
+	EXPECT_EQ(16, CANNetworkManager::CANNetwork.get_message_pool().get_capacity());
+
+	CANMessageFrame testFrame = {};
+	testFrame.identifier = 0x18EFFFAA;
+	testFrame.isExtendedFrame = true;
+	testFrame.dataLength = 8;
+
+	for (std::uint8_t i = 0; i < 10; i++)
+	{
+		CANNetworkManager::CANNetwork.process_receive_can_message_frame(testFrame);
+	}
+	EXPECT_EQ(10, CANNetworkManager::CANNetwork.get_message_pool().get_number_in_use());
+
+	CANNetworkManager::CANNetwork.update();
+	EXPECT_EQ(0, CANNetworkManager::CANNetwork.get_message_pool().get_number_in_use());
+	EXPECT_GE(CANNetworkManager::CANNetwork.get_message_pool().get_high_water_mark(), 10);
+	EXPECT_EQ(0, CANNetworkManager::CANNetwork.get_message_pool().get_overflow_count());
+
+	// Restore the default for the other tests
+	CANNetworkManager::CANNetwork.get_configuration().set_message_pool_capacity(64);
+	CANNetworkManager::CANNetwork.initialize();
+}
+
+static bool fill_chunk_with_indices(std::uint32_t, std::uint32_t bytesOffset, std::uint32_t numberOfBytesNeeded, std::uint8_t *chunkBuffer, void *parent)
+{
+	for (std::uint32_t i = 0; i < numberOfBytesNeeded; i++)
+	{
+		chunkBuffer[i] = static_cast<std::uint8_t>(bytesOffset + i);
+	}
+	(*static_cast<std::size_t *>(parent))++;
+	return true;
+}
+
+TEST(CAN_MESSAGE_TESTS, MessageDataCopyBytes)
+{
+	std::vector<std::uint8_t> rawData(20);
+	for (std::size_t i = 0; i < rawData.size(); i++)
+	{
+		rawData[i] = static_cast<std::uint8_t>(i);
+	}
+
+	CANMessageDataVector vectorData(rawData);
+	CANMessageDataView viewData(rawData.data(), rawData.size());
+	std::size_t numberOfCallbacks = 0;
+	CANMessageDataCallback callbackData(rawData.size(), fill_chunk_with_indices, &numberOfCallbacks);
+
+	for (CANMessageData *data : std::vector<CANMessageData *>{ &vectorData, &viewData, &callbackData })
+	{
+		std::array<std::uint8_t, 7> buffer;
+		buffer.fill(0xFF);
+
+		EXPECT_EQ(7, data->copy_bytes(3, DataSpan<std::uint8_t>(buffer.data(), buffer.size())));
+		for (std::size_t i = 0; i < buffer.size(); i++)
+		{
+			EXPECT_EQ(3 + i, buffer[i]);
+		}
+
+		// Only the bytes that are left should be copied
+		buffer.fill(0xFF);
+		EXPECT_EQ(2, data->copy_bytes(18, DataSpan<std::uint8_t>(buffer.data(), buffer.size())));
+		EXPECT_EQ(18, buffer[0]);
+		EXPECT_EQ(19, buffer[1]);
+		EXPECT_EQ(0xFF, buffer[2]);
+
+		EXPECT_EQ(0, data->copy_bytes(20, DataSpan<std::uint8_t>(buffer.data(), buffer.size())));
+	}
+
+	// Copying a range that spans two chunks should only request each chunk once
+	numberOfCallbacks = 0;
+	std::array<std::uint8_t, 7> buffer;
+	EXPECT_EQ(7, callbackData.copy_bytes(0, DataSpan<std::uint8_t>(buffer.data(), buffer.size())));
+	EXPECT_EQ(1, numberOfCallbacks);
+	EXPECT_EQ(7, callbackData.copy_bytes(7, DataSpan<std::uint8_t>(buffer.data(), buffer.size())));
+	EXPECT_EQ(2, numberOfCallbacks);
+	EXPECT_EQ(13, buffer[6]);
+}
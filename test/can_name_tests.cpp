@@ -3,6 +3,7 @@
 #include "isobus/isobus/can_NAME_filter.hpp"
 #include "isobus/isobus/can_constants.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
@@ -106,3 +107,73 @@ TEST(CAN_NAME_TESTS, FilterMatches)
 	TestDeviceNAME.set_arbitrary_address_capable(true);
 	EXPECT_TRUE(filterArbitraryAddressCapable.check_name_matches_filter(TestDeviceNAME));
 }
+
+TEST(CAN_NAME_TESTS, CompiledFilterMatches)
+{
+	NAME TestDeviceNAME(0);
+	TestDeviceNAME.set_arbitrary_address_capable(true);
+	TestDeviceNAME.set_industry_group(2);
+	TestDeviceNAME.set_function_code(static_cast<std::uint8_t>(NAME::Function::TaskController));
+	TestDeviceNAME.set_manufacturer_code(69);
+	TestDeviceNAME.set_identity_number(1234);
+
+	const CompiledNAMEFilter emptyFilter(std::vector<NAMEFilter>{});
+	EXPECT_FALSE(emptyFilter.get_can_match());
+	EXPECT_FALSE(emptyFilter.check_name_matches(TestDeviceNAME));
+
+	const CompiledNAMEFilter matchingFilter({ NAMEFilter(NAME::NAMEParameters::FunctionCode, static_cast<std::uint8_t>(NAME::Function::TaskController)),
+	                                          NAMEFilter(NAME::NAMEParameters::ManufacturerCode, 69),
+	                                          NAMEFilter(NAME::NAMEParameters::IndustryGroup, 2),
+	                                          NAMEFilter(NAME::NAMEParameters::ArbitraryAddressCapable, 5) });
+	EXPECT_TRUE(matchingFilter.get_can_match());
+	EXPECT_TRUE(matchingFilter.check_name_matches(TestDeviceNAME));
+	EXPECT_EQ(0, matchingFilter.get_mask() & 0x1FFFFF); // Identity number is not checked
+
+	TestDeviceNAME.set_manufacturer_code(70);
+	EXPECT_FALSE(matchingFilter.check_name_matches(TestDeviceNAME));
+
+	// Two filters that require different values for the same component can never match
+	const CompiledNAMEFilter contradictingFilter({ NAMEFilter(NAME::NAMEParameters::ManufacturerCode, 70),
+	                                               NAMEFilter(NAME::NAMEParameters::ManufacturerCode, 71) });
+	EXPECT_FALSE(contradictingFilter.get_can_match());
+	EXPECT_FALSE(contradictingFilter.check_name_matches(TestDeviceNAME));
+
+	// A value that does not fit in the component can never match
+	const CompiledNAMEFilter outOfRangeFilter({ NAMEFilter(NAME::NAMEParameters::EcuInstance, 8) });
+	EXPECT_FALSE(outOfRangeFilter.get_can_match());
+	TestDeviceNAME.set_full_name(0xFFFFFFFFFFFFFFFF);
+	EXPECT_FALSE(outOfRangeFilter.check_name_matches(TestDeviceNAME));
+}
+
+TEST(CAN_NAME_TESTS, CompiledFilterMatchesPerFieldFilters)
+{
+	std::vector<NAME> candidates;
+	std::uint64_t randomState = 0x9E3779B97F4A7C15ULL;
+	for (std::size_t i = 0; i < 1000; i++)
+	{
+		randomState = (randomState * 6364136223846793005ULL) + 1442695040888963407ULL;
+		NAME candidate(randomState);
+		// Keep the values in a small range so some of the candidates actually match
+		candidate.set_function_code(static_cast<std::uint8_t>(i % 8));
+		candidate.set_function_instance(static_cast<std::uint8_t>(i % 2));
+		candidate.set_industry_group(2);
+		candidates.push_back(candidate);
+	}
+
+	std::size_t numberOfMatches = 0;
+	for (std::uint32_t partner = 0; partner < 32; partner++)
+	{
+		const std::vector<NAMEFilter> filters = { NAMEFilter(NAME::NAMEParameters::IndustryGroup, 2),
+			                                        NAMEFilter(NAME::NAMEParameters::FunctionCode, partner % 8),
+			                                        NAMEFilter(NAME::NAMEParameters::FunctionInstance, partner % 2) };
+		const CompiledNAMEFilter compiledFilter(filters);
+
+		for (const auto &candidate : candidates)
+		{
+			const bool matches = std::all_of(filters.begin(), filters.end(), [&candidate](const NAMEFilter &filter) { return filter.check_name_matches_filter(candidate); });
+			EXPECT_EQ(matches, compiledFilter.check_name_matches(candidate));
+			numberOfMatches += matches ? 1 : 0;
+		}
+	}
+	EXPECT_NE(0, numberOfMatches);
+}
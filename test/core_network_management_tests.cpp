@@ -8,6 +8,7 @@
 #include "isobus/isobus/can_network_manager.hpp"
 #include "isobus/isobus/can_partnered_control_function.hpp"
 
+#include <atomic>
 #include <memory>
 #include <thread>
 
@@ -375,3 +376,254 @@ TEST(CORE_TESTS, SimilarControlFunctions)
 	EXPECT_EQ(TestPartner->get_NAME().get_full_name(), 0xa0000F000425e9f8);
 	CANNetworkManager::CANNetwork.deactivate_control_function(TestPartner);
 }
+
+static isobus::CANMessageFrame create_address_claim_frame(std::uint8_t channel, std::uint8_t address, std::uint64_t fullName)
+{
+	isobus::CANMessageFrame addressClaim = {};
+	addressClaim.channel = channel;
+	addressClaim.identifier = 0x18EEFF00 | address;
+	addressClaim.isExtendedFrame = true;
+	addressClaim.dataLength = 8;
+
+	for (std::uint8_t byteIndex = 0; byteIndex < addressClaim.dataLength; byteIndex++)
+	{
+		addressClaim.data[byteIndex] = static_cast<std::uint8_t>(fullName >> (8 * byteIndex));
+	}
+	return addressClaim;
+}
+
+TEST(CORE_TESTS, ControlFunctionLookupByNAME)
+{
+	wasTestStateCallbackHit = false;
+	testControlFunction.reset();
+	CANNetworkManager::CANNetwork.add_control_function_status_change_callback(test_control_function_state_callback);
+
+	constexpr std::uint64_t INDEXED_NAME = 0x0A1B2C3D4E5F6071ULL;
+	constexpr std::uint8_t FIRST_CHANNEL = 1;
+	constexpr std::uint8_t SECOND_CHANNEL = 2;
+
+	CANNetworkManager::CANNetwork.process_receive_can_message_frame(create_address_claim_frame(FIRST_CHANNEL, 0xA1, INDEXED_NAME));
+	ASSERT_TRUE(wasTestStateCallbackHit);
+	auto firstControlFunction = testControlFunction;
+	ASSERT_NE(nullptr, firstControlFunction);
+	EXPECT_EQ(0xA1, firstControlFunction->get_address());
+
+	// Claiming a new address with the same NAME must move the same control function
+	wasTestStateCallbackHit = false;
+	CANNetworkManager::CANNetwork.process_receive_can_message_frame(create_address_claim_frame(FIRST_CHANNEL, 0xA2, INDEXED_NAME));
+	EXPECT_TRUE(wasTestStateCallbackHit);
+	EXPECT_EQ(firstControlFunction, testControlFunction);
+	EXPECT_EQ(0xA2, firstControlFunction->get_address());
+
+	// The same NAME on another channel is a different control function
+	wasTestStateCallbackHit = false;
+	CANNetworkManager::CANNetwork.process_receive_can_message_frame(create_address_claim_frame(SECOND_CHANNEL, 0xA2, INDEXED_NAME));
+	EXPECT_TRUE(wasTestStateCallbackHit);
+	ASSERT_NE(nullptr, testControlFunction);
+	EXPECT_NE(firstControlFunction, testControlFunction);
+	EXPECT_EQ(SECOND_CHANNEL, testControlFunction->get_can_port());
+	EXPECT_EQ(FIRST_CHANNEL, firstControlFunction->get_can_port());
+	EXPECT_EQ(0xA2, firstControlFunction->get_address());
+
+	CANNetworkManager::CANNetwork.remove_control_function_status_change_callback(test_control_function_state_callback);
+	testControlFunction.reset();
+	wasTestStateCallbackHit = false;
+}
+
+static std::vector<std::uint32_t> dispatchedCallbackOrder;
+static void pgn_table_test_callback_a(const CANMessage &message, void *parent)
+{
+	dispatchedCallbackOrder.push_back(message.get_identifier().get_parameter_group_number() + reinterpret_cast<std::uintptr_t>(parent));
+}
+static void pgn_table_test_callback_b(const CANMessage &message, void *)
+{
+	dispatchedCallbackOrder.push_back(message.get_identifier().get_parameter_group_number() + 1000000);
+}
+
+TEST(CORE_TESTS, ParameterGroupNumberCallbackTableDispatch)
+{
+	ParameterGroupNumberCallbackTable table;
+	EXPECT_EQ(0, table.size());
+
+	EXPECT_TRUE(table.add_callback(ParameterGroupNumberCallbackData(0xFEF1, pgn_table_test_callback_a, nullptr, nullptr), false));
+	EXPECT_TRUE(table.add_callback(ParameterGroupNumberCallbackData(0xE700, pgn_table_test_callback_a, nullptr, nullptr), false));
+	EXPECT_TRUE(table.add_callback(ParameterGroupNumberCallbackData(0xFEF1, pgn_table_test_callback_b, nullptr, nullptr), false));
+	EXPECT_TRUE(table.add_callback(ParameterGroupNumberCallbackData(0xFEF1, pgn_table_test_callback_a, reinterpret_cast<void *>(1), nullptr), false));
+	EXPECT_FALSE(table.add_callback(ParameterGroupNumberCallbackData(0xFEF1, pgn_table_test_callback_b, nullptr, nullptr), false));
+	EXPECT_TRUE(table.add_callback(ParameterGroupNumberCallbackData(0xAC00, nullptr, nullptr, nullptr), true));
+	EXPECT_EQ(5, table.size());
+
+	const std::uint8_t payload[8] = { 0 };
+	CANMessage wheelSpeedMessage(CANMessage::Type::Receive, CANIdentifier(0x18FEF1AA), payload, sizeof(payload), nullptr, nullptr, 0);
+	table.dispatch(wheelSpeedMessage);
+
+	// Only the callbacks for the message's PGN are called, in the order they were added
+	ASSERT_EQ(3, dispatchedCallbackOrder.size());
+	EXPECT_EQ(0xFEF1, dispatchedCallbackOrder.at(0));
+	EXPECT_EQ(0xFEF1 + 1000000, dispatchedCallbackOrder.at(1));
+	EXPECT_EQ(0xFEF1 + 1, dispatchedCallbackOrder.at(2));
+
+	// Null callbacks are skipped, and PGNs without callbacks are ignored
+	dispatchedCallbackOrder.clear();
+	table.dispatch(CANMessage(CANMessage::Type::Receive, CANIdentifier(0x18ACFFAA), payload, sizeof(payload), nullptr, nullptr, 0));
+	table.dispatch(CANMessage(CANMessage::Type::Receive, CANIdentifier(0x18EAFFAA), payload, 3, nullptr, nullptr, 0));
+	EXPECT_TRUE(dispatchedCallbackOrder.empty());
+
+	EXPECT_TRUE(table.remove_callback(ParameterGroupNumberCallbackData(0xFEF1, pgn_table_test_callback_b, nullptr, nullptr)));
+	EXPECT_FALSE(table.remove_callback(ParameterGroupNumberCallbackData(0xFEF1, pgn_table_test_callback_b, nullptr, nullptr)));
+	EXPECT_EQ(4, table.size());
+
+	table.dispatch(wheelSpeedMessage);
+	ASSERT_EQ(2, dispatchedCallbackOrder.size());
+	EXPECT_EQ(0xFEF1, dispatchedCallbackOrder.at(0));
+	EXPECT_EQ(0xFEF1 + 1, dispatchedCallbackOrder.at(1));
+
+	dispatchedCallbackOrder.clear();
+	table.dispatch(CANMessage(CANMessage::Type::Receive, CANIdentifier(0x18E7AABB), payload, sizeof(payload), nullptr, nullptr, 0));
+	ASSERT_EQ(1, dispatchedCallbackOrder.size());
+	EXPECT_EQ(0xE700, dispatchedCallbackOrder.at(0));
+	dispatchedCallbackOrder.clear();
+}
+
+static std::atomic_bool blockingCallbackEntered = { false };
+static std::atomic_bool blockingCallbackReleased = { false };
+static std::atomic_bool blockingCallbackFinished = { false };
+static void pgn_table_test_blocking_callback(const CANMessage &, void *)
+{
+	blockingCallbackEntered = true;
+	while (!blockingCallbackReleased)
+	{
+		std::this_thread::yield();
+	}
+	blockingCallbackFinished = true;
+}
+static void pgn_table_test_removing_callback(const CANMessage &message, void *parent)
+{
+	// Removing itself from within a dispatch must not wait for that same dispatch
+	auto table = static_cast<ParameterGroupNumberCallbackTable *>(parent);
+	EXPECT_TRUE(table->remove_callback(ParameterGroupNumberCallbackData(message.get_identifier().get_parameter_group_number(), pgn_table_test_removing_callback, parent, nullptr)));
+}
+
+TEST(CORE_TESTS, ParameterGroupNumberCallbackTableRemoveWaitsForDispatch)
+{
+	ParameterGroupNumberCallbackTable table;
+	const ParameterGroupNumberCallbackData blockingCallback(0xFEF1, pgn_table_test_blocking_callback, nullptr, nullptr);
+	EXPECT_TRUE(table.add_callback(blockingCallback, false));
+
+	const std::uint8_t payload[8] = { 0 };
+	const CANMessage wheelSpeedMessage(CANMessage::Type::Receive, CANIdentifier(0x18FEF1AA), payload, sizeof(payload), nullptr, nullptr, 0);
+	std::thread dispatchThread([&table, &wheelSpeedMessage]() { table.dispatch(wheelSpeedMessage); });
+
+	while (!blockingCallbackEntered)
+	{
+		std::this_thread::yield();
+	}
+
+	std::atomic_bool removed = { false };
+	bool finishedBeforeRemoved = false;
+	std::thread removeThread([&]() {
+		EXPECT_TRUE(table.remove_callback(blockingCallback));
+		finishedBeforeRemoved = blockingCallbackFinished;
+		removed = true;
+	});
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	EXPECT_FALSE(removed);
+	blockingCallbackReleased = true;
+	dispatchThread.join();
+	removeThread.join();
+	EXPECT_TRUE(removed);
+	EXPECT_TRUE(finishedBeforeRemoved);
+	EXPECT_EQ(0, table.size());
+
+	EXPECT_TRUE(table.add_callback(ParameterGroupNumberCallbackData(0xFEF1, pgn_table_test_removing_callback, &table, nullptr), false));
+	table.dispatch(wheelSpeedMessage);
+	EXPECT_EQ(0, table.size());
+}
+
+struct PgnTableTestGate
+{
+	ParameterGroupNumberCallbackTable *table = nullptr;
+	std::atomic<std::uint32_t> entered = { 0 };
+	std::atomic_bool released = { false };
+	std::atomic_bool finished = { false };
+};
+static void pgn_table_test_gated_callback(const CANMessage &, void *parent)
+{
+	auto gate = static_cast<PgnTableTestGate *>(parent);
+	gate->entered++;
+	while (!gate->released)
+	{
+		std::this_thread::yield();
+	}
+	gate->finished = true;
+}
+static void pgn_table_test_mutually_removing_callback(const CANMessage &message, void *parent)
+{
+	// Wait until both dispatches are in progress, then remove the other dispatch's callback
+	auto gate = static_cast<PgnTableTestGate *>(parent);
+	gate->entered++;
+	while (gate->entered < 2)
+	{
+		std::this_thread::yield();
+	}
+	const std::uint32_t otherParameterGroupNumber = (0xFEF1 == message.get_identifier().get_parameter_group_number()) ? 0xFEF2 : 0xFEF1;
+	EXPECT_TRUE(gate->table->remove_callback(ParameterGroupNumberCallbackData(otherParameterGroupNumber, pgn_table_test_mutually_removing_callback, parent, nullptr)));
+}
+
+TEST(CORE_TESTS, ParameterGroupNumberCallbackTableRemoveWaitsForOlderSnapshots)
+{
+	ParameterGroupNumberCallbackTable table;
+	PgnTableTestGate gate;
+	const ParameterGroupNumberCallbackData blockingCallback(0xFEF1, pgn_table_test_gated_callback, &gate, nullptr);
+	EXPECT_TRUE(table.add_callback(blockingCallback, false));
+
+	const std::uint8_t payload[8] = { 0 };
+	const CANMessage wheelSpeedMessage(CANMessage::Type::Receive, CANIdentifier(0x18FEF1AA), payload, sizeof(payload), nullptr, nullptr, 0);
+	std::thread dispatchThread([&table, &wheelSpeedMessage]() { table.dispatch(wheelSpeedMessage); });
+
+	while (0 == gate.entered)
+	{
+		std::this_thread::yield();
+	}
+
+	// Publish another snapshot, so the dispatch in progress is no longer using the one the removal replaces
+	EXPECT_TRUE(table.add_callback(ParameterGroupNumberCallbackData(0xE700, pgn_table_test_callback_b, nullptr, nullptr), false));
+
+	std::atomic_bool removed = { false };
+	bool finishedBeforeRemoved = false;
+	std::thread removeThread([&]() {
+		EXPECT_TRUE(table.remove_callback(blockingCallback));
+		finishedBeforeRemoved = gate.finished;
+		removed = true;
+	});
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	EXPECT_FALSE(removed);
+	gate.released = true;
+	dispatchThread.join();
+	removeThread.join();
+	EXPECT_TRUE(removed);
+	EXPECT_TRUE(finishedBeforeRemoved);
+	EXPECT_EQ(1, table.size());
+}
+
+TEST(CORE_TESTS, ParameterGroupNumberCallbackTableConcurrentRemovesFromCallbacks)
+{
+	ParameterGroupNumberCallbackTable table;
+	PgnTableTestGate gate;
+	gate.table = &table;
+	EXPECT_TRUE(table.add_callback(ParameterGroupNumberCallbackData(0xFEF1, pgn_table_test_mutually_removing_callback, &gate, nullptr), false));
+	EXPECT_TRUE(table.add_callback(ParameterGroupNumberCallbackData(0xFEF2, pgn_table_test_mutually_removing_callback, &gate, nullptr), false));
+
+	// Each dispatch removes the callback the other one is in, which must not leave them waiting on each other
+	const std::uint8_t payload[8] = { 0 };
+	const CANMessage firstMessage(CANMessage::Type::Receive, CANIdentifier(0x18FEF1AA), payload, sizeof(payload), nullptr, nullptr, 0);
+	const CANMessage secondMessage(CANMessage::Type::Receive, CANIdentifier(0x18FEF2AA), payload, sizeof(payload), nullptr, nullptr, 0);
+	std::thread firstDispatchThread([&table, &firstMessage]() { table.dispatch(firstMessage); });
+	std::thread secondDispatchThread([&table, &secondMessage]() { table.dispatch(secondMessage); });
+	firstDispatchThread.join();
+	secondDispatchThread.join();
+	EXPECT_EQ(2, gate.entered);
+	EXPECT_EQ(0, table.size());
+}
@@ -2,9 +2,11 @@
 
 #include "isobus/utility/event_dispatcher.hpp"
 
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <thread>
+#include <vector>
 
 using namespace isobus;
 
@@ -173,3 +175,55 @@ TEST_F(EventManagerBool, RemoveCallbackWithinCallback)
 	dispatcher.invoke(true);
 	EXPECT_EQ(callbackToBeRemovedExecuted, 1); // Ensure the removed callback did not execute again
 }
+
+// Test that listeners are invoked in the order they were added, and handles stay valid after other removals
+TEST_F(EventManagerBool, ListenerOrderAndHandles)
+{
+	std::vector<int> order;
+	auto first = dispatcher.add_listener([&](bool) { order.push_back(1); });
+	auto second = dispatcher.add_listener([&](bool) { order.push_back(2); });
+	dispatcher.add_listener([&](bool) { order.push_back(3); });
+	EXPECT_NE(first, second);
+
+	dispatcher.invoke(true);
+	EXPECT_EQ(order, std::vector<int>({ 1, 2, 3 }));
+
+	order.clear();
+	dispatcher.remove_listener(second);
+	dispatcher.remove_listener(second); // Removing twice is harmless
+	dispatcher.invoke(true);
+	EXPECT_EQ(order, std::vector<int>({ 1, 3 }));
+
+	dispatcher.clear_listeners();
+	EXPECT_EQ(dispatcher.get_listener_count(), 0);
+	order.clear();
+	dispatcher.invoke(true);
+	EXPECT_TRUE(order.empty());
+}
+
+// Test invoking the event from one thread while another thread adds and removes listeners
+TEST_F(EventManagerBool, ConcurrentInvokeAndModify)
+{
+	std::atomic<int> count(0);
+	dispatcher.add_listener([&count](bool) { count++; });
+
+	std::atomic_bool running(true);
+	std::thread modifier([this, &running]() {
+		while (running)
+		{
+			auto handle = dispatcher.add_listener([](bool) {});
+			dispatcher.remove_listener(handle);
+		}
+	});
+
+	for (int i = 0; i < 10000; i++)
+	{
+		dispatcher.call(true);
+	}
+	running = false;
+	modifier.join();
+
+	// The permanent listener must have seen every invocation
+	EXPECT_EQ(count, 10000);
+	EXPECT_EQ(dispatcher.get_listener_count(), 1);
+}
@@ -4,8 +4,11 @@
 #include "isobus/hardware_integration/virtual_can_plugin.hpp"
 #include "isobus/utility/system_timing.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <future>
+#include <numeric>
 #include <thread>
 
 using namespace isobus;
@@ -116,6 +119,187 @@ TEST(HARDWARE_INTERFACE_TESTS, MessageFrameSentEventListener)
 	CANHardwareInterface::stop();
 }
 
+/// @brief A virtual plugin that only accepts a few frames per batch, to check that the rest are retried in order
+class LimitedBatchPlugin : public VirtualCANPlugin
+{
+public:
+	std::size_t write_frames(DataSpan<const CANMessageFrame> canFrames) override
+	{
+		batchCount++;
+		return VirtualCANPlugin::write_frames(DataSpan<const CANMessageFrame>(canFrames.begin(), std::min<std::size_t>(canFrames.size(), 3)));
+	}
+
+	std::atomic<std::size_t> batchCount = { 0 };
+};
+
+TEST(HARDWARE_INTERFACE_TESTS, TransmitFramesInBatches)
+{
+	auto receiver = std::make_shared<VirtualCANPlugin>();
+	auto sender = std::make_shared<LimitedBatchPlugin>();
+	CANHardwareInterface::set_number_of_can_channels(1);
+	CANHardwareInterface::assign_can_channel_frame_handler(0, sender);
+
+	std::vector<std::uint32_t> transmittedIdentifiers;
+	std::atomic<std::size_t> messageCount = { 0 };
+	auto listener = CANHardwareInterface::get_can_frame_transmitted_event_dispatcher().add_listener([&](const CANMessageFrame &frame) {
+		transmittedIdentifiers.push_back(frame.identifier);
+		messageCount++;
+	});
+	CANHardwareInterface::start();
+
+	CANMessageFrame fakeFrame;
+	memset(&fakeFrame, 0, sizeof(CANMessageFrame));
+	fakeFrame.isExtendedFrame = false;
+	fakeFrame.dataLength = 1;
+	fakeFrame.channel = 0;
+
+	for (std::uint32_t i = 0; i < 10; i++)
+	{
+		fakeFrame.identifier = 0x600 + i;
+		EXPECT_TRUE(isobus::send_can_message_frame_to_hardware(fakeFrame));
+	}
+
+	auto future = std::async(std::launch::async, [&messageCount] { while (messageCount < 10 && CANHardwareInterface::is_running()); });
+	EXPECT_TRUE(future.wait_for(std::chrono::seconds(5)) != std::future_status::timeout);
+	CANHardwareInterface::stop();
+	CANHardwareInterface::get_can_frame_transmitted_event_dispatcher().remove_listener(listener);
+
+	ASSERT_EQ(10, transmittedIdentifiers.size());
+	for (std::uint32_t i = 0; i < 10; i++)
+	{
+		EXPECT_EQ(0x600 + i, transmittedIdentifiers.at(i));
+	}
+	EXPECT_GE(sender->batchCount, 4);
+}
+
+/// @brief A virtual plugin that refuses all frames until it is opened, so that frames can pile up in the transmit queues
+class GatedPlugin : public VirtualCANPlugin
+{
+public:
+	std::size_t write_frames(DataSpan<const CANMessageFrame> canFrames) override
+	{
+		return gateOpen ? VirtualCANPlugin::write_frames(canFrames) : 0;
+	}
+
+	std::atomic_bool gateOpen = { false };
+};
+
+/// @brief Queues frames on a closed channel, then opens it and returns the identifiers in the order they were sent
+/// @param[in] identifiers The extended identifiers to queue, in order
+/// @returns The identifiers in the order they were transmitted
+static std::vector<std::uint32_t> transmit_with_priorities(const std::vector<std::uint32_t> &identifiers)
+{
+	auto receiver = std::make_shared<VirtualCANPlugin>();
+	auto sender = std::make_shared<GatedPlugin>();
+	CANHardwareInterface::set_number_of_can_channels(1);
+	CANHardwareInterface::assign_can_channel_frame_handler(0, sender);
+
+	std::vector<std::uint32_t> transmittedIdentifiers;
+	std::atomic<std::size_t> messageCount = { 0 };
+	auto listener = CANHardwareInterface::get_can_frame_transmitted_event_dispatcher().add_listener([&](const CANMessageFrame &frame) {
+		transmittedIdentifiers.push_back(frame.identifier);
+		messageCount++;
+	});
+	CANHardwareInterface::start();
+	CANHardwareInterface::reset_transmit_queue_statistics(0);
+
+	CANMessageFrame fakeFrame;
+	memset(&fakeFrame, 0, sizeof(CANMessageFrame));
+	fakeFrame.isExtendedFrame = true;
+	fakeFrame.dataLength = 8;
+	fakeFrame.channel = 0;
+
+	for (auto identifier : identifiers)
+	{
+		fakeFrame.identifier = identifier;
+		EXPECT_TRUE(isobus::send_can_message_frame_to_hardware(fakeFrame));
+	}
+
+	auto statistics = CANHardwareInterface::get_transmit_queue_statistics(0);
+	EXPECT_EQ(identifiers.size(), std::accumulate(statistics.queueDepth.begin(), statistics.queueDepth.end(), std::size_t(0)));
+
+	sender->gateOpen = true;
+	const std::size_t numberOfFrames = identifiers.size();
+	auto future = std::async(std::launch::async, [&messageCount, numberOfFrames] { while (messageCount < numberOfFrames && CANHardwareInterface::is_running()); });
+	EXPECT_TRUE(future.wait_for(std::chrono::seconds(5)) != std::future_status::timeout);
+	CANHardwareInterface::stop();
+	CANHardwareInterface::get_can_frame_transmitted_event_dispatcher().remove_listener(listener);
+	return transmittedIdentifiers;
+}
+
+TEST(HARDWARE_INTERFACE_TESTS, TransmitInPriorityOrder)
+{
+	CANHardwareInterface::set_transmit_starvation_limit(0);
+	EXPECT_EQ(0, CANHardwareInterface::get_transmit_starvation_limit());
+
+	// Bulk traffic at priority 7, then normal traffic at priority 6, then a command at priority 3 and an emergency stop at priority 2
+	const std::vector<std::uint32_t> transmitted = transmit_with_priorities({ 0x1CEBFF80, 0x1CEBFF81, 0x1CEBFF82, 0x18FEF180, 0x18FEF181, 0x0CAC0080, 0x08FE0780 });
+	const std::vector<std::uint32_t> expected = { 0x08FE0780, 0x0CAC0080, 0x18FEF180, 0x18FEF181, 0x1CEBFF80, 0x1CEBFF81, 0x1CEBFF82 };
+	EXPECT_EQ(expected, transmitted);
+
+	const auto statistics = CANHardwareInterface::get_transmit_queue_statistics(0);
+	EXPECT_EQ(3, statistics.maxQueueDepth[7]);
+	EXPECT_EQ(2, statistics.maxQueueDepth[6]);
+	EXPECT_EQ(1, statistics.maxQueueDepth[3]);
+	EXPECT_EQ(1, statistics.maxQueueDepth[2]);
+	EXPECT_EQ(0, statistics.maxQueueDepth[0]);
+	EXPECT_EQ(0, statistics.queueDepth[7]);
+	EXPECT_EQ(0, statistics.numberOfStarvationOverrides);
+
+	CANHardwareInterface::reset_transmit_queue_statistics(0);
+	EXPECT_EQ(0, CANHardwareInterface::get_transmit_queue_statistics(0).maxQueueDepth[7]);
+	CANHardwareInterface::set_transmit_starvation_limit(32);
+}
+
+TEST(HARDWARE_INTERFACE_TESTS, TransmitStarvationProtection)
+{
+	CANHardwareInterface::set_transmit_starvation_limit(2);
+
+	const std::vector<std::uint32_t> transmitted = transmit_with_priorities({ 0x0CAC0080, 0x0CAC0081, 0x0CAC0082, 0x0CAC0083, 0x0CAC0084, 0x0CAC0085, 0x1CEBFF80, 0x1CEBFF81 });
+	const std::vector<std::uint32_t> expected = { 0x0CAC0080, 0x0CAC0081, 0x1CEBFF80, 0x0CAC0082, 0x0CAC0083, 0x1CEBFF81, 0x0CAC0084, 0x0CAC0085 };
+	EXPECT_EQ(expected, transmitted);
+	EXPECT_EQ(2, CANHardwareInterface::get_transmit_queue_statistics(0).numberOfStarvationOverrides);
+
+	CANHardwareInterface::set_transmit_starvation_limit(32);
+}
+
+TEST(HARDWARE_INTERFACE_TESTS, LowLatencyModeReceiveStatistics)
+{
+	auto device = std::make_shared<VirtualCANPlugin>();
+	CANHardwareInterface::set_number_of_can_channels(1);
+	CANHardwareInterface::assign_can_channel_frame_handler(0, device);
+	CANHardwareInterface::set_periodic_update_interval(1000);
+	CANHardwareInterface::set_low_latency_mode(true);
+	EXPECT_TRUE(CANHardwareInterface::get_low_latency_mode());
+	CANHardwareInterface::start();
+	CANHardwareInterface::reset_receive_latency_statistics(0);
+
+	// Let the first periodic update pass, so the next frame can only be processed by low latency mode
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+	CANMessageFrame fakeFrame;
+	memset(&fakeFrame, 0, sizeof(CANMessageFrame));
+	fakeFrame.identifier = 0x613;
+	fakeFrame.dataLength = 1;
+	device->write_frame_as_if_received(fakeFrame);
+
+	auto future = std::async(std::launch::async, [] { while ((0 == CANHardwareInterface::get_receive_latency_statistics(0).numberOfFrames) && CANHardwareInterface::is_running()); });
+	EXPECT_TRUE(future.wait_for(std::chrono::milliseconds(500)) != std::future_status::timeout);
+
+	const auto statistics = CANHardwareInterface::get_receive_latency_statistics(0);
+	EXPECT_EQ(1, statistics.numberOfFrames);
+	EXPECT_LT(statistics.maxLatency_us, 500000);
+	EXPECT_EQ(statistics.maxLatency_us, statistics.totalLatency_us);
+	EXPECT_EQ(0, CANHardwareInterface::get_receive_latency_statistics(1).numberOfFrames);
+
+	CANHardwareInterface::reset_receive_latency_statistics(0);
+	EXPECT_EQ(0, CANHardwareInterface::get_receive_latency_statistics(0).numberOfFrames);
+
+	CANHardwareInterface::stop();
+	CANHardwareInterface::set_low_latency_mode(false);
+	CANHardwareInterface::set_periodic_update_interval(4);
+}
+
 TEST(HARDWARE_INTERFACE_TESTS, PeriodicUpdateEventListener)
 {
 	CANHardwareInterface::start();
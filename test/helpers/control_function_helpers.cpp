@@ -145,9 +145,9 @@ namespace test_helpers
 		}
 	};
 
-	std::shared_ptr<isobus::InternalControlFunction> create_mock_internal_control_function(std::uint8_t address)
+	std::shared_ptr<isobus::InternalControlFunction> create_mock_internal_control_function(std::uint8_t address, isobus::NAME name)
 	{
-		return std::make_shared<WrappedInternalControlFunction>(NAME(0), address, 0);
+		return std::make_shared<WrappedInternalControlFunction>(name, address, 0);
 	}
 
 } // namespace test_helpers
@@ -12,7 +12,7 @@ namespace test_helpers
 
 	std::shared_ptr<isobus::ControlFunction> create_mock_control_function(std::uint8_t address);
 
-	std::shared_ptr<isobus::InternalControlFunction> create_mock_internal_control_function(std::uint8_t address);
+	std::shared_ptr<isobus::InternalControlFunction> create_mock_internal_control_function(std::uint8_t address, isobus::NAME name = isobus::NAME(0));
 
 } // namespace test_helpers
 
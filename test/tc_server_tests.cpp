@@ -315,6 +315,12 @@ bool readFrameFilterStatus(VirtualCANPlugin &plugin, CANMessageFrame &frame)
 		EXPECT_TRUE(retVal);
 		retVal = plugin.read_frame(frame);
 	}
+
+	// Responses are sent ahead of lower priority address claims that were queued before them, so filter those out too
+	while (retVal && (0xEE == ((frame.identifier >> 16) & 0xFF)))
+	{
+		retVal = plugin.read_frame(frame);
+	}
 	return retVal;
 }
 
@@ -942,12 +948,6 @@ TEST(TASK_CONTROLLER_SERVER_TESTS, MessageEncoding)
 		server.update();
 		EXPECT_TRUE(readFrameFilterStatus(testPlugin, testFrame));
 
-		if (0xEE == ((testFrame.identifier >> 16) & 0xFF))
-		{
-			// Filter out address violations
-			EXPECT_TRUE(readFrameFilterStatus(testPlugin, testFrame));
-		}
-
 		EXPECT_EQ(0x91, testFrame.data[0]); // Response to activate object pool
 		EXPECT_EQ(0x00, testFrame.data[1]); // No errors
 		EXPECT_EQ(0xFF, testFrame.data[2]); // Parent object
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include "isobus/utility/thread_synchronization.hpp"
+
+#include <array>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace isobus;
+
+TEST(THREAD_SYNCHRONIZATION_TESTS, MultiProducerQueueBasics)
+{
+	LockFreeMultiProducerQueue<std::uint32_t> queue(5);
+	std::uint32_t item = 0;
+
+	EXPECT_EQ(8, queue.max_size()); // Rounded up to a power of two
+	EXPECT_FALSE(queue.peek(item));
+	EXPECT_FALSE(queue.pop());
+
+	for (std::uint32_t i = 0; i < 8; i++)
+	{
+		EXPECT_TRUE(queue.push(i));
+	}
+	EXPECT_TRUE(queue.is_full());
+	EXPECT_FALSE(queue.push(8));
+	EXPECT_EQ(8, queue.size());
+
+	std::array<std::uint32_t, 3> items;
+	EXPECT_EQ(3, queue.peek_batch(items.data(), items.size()));
+	EXPECT_EQ(0, items[0]);
+	EXPECT_EQ(2, items[2]);
+	EXPECT_EQ(2, queue.pop_batch(2));
+	EXPECT_TRUE(queue.peek(item));
+	EXPECT_EQ(2, item);
+
+	// Wrap around the end of the ring
+	EXPECT_TRUE(queue.push(8));
+	EXPECT_TRUE(queue.push(9));
+	EXPECT_FALSE(queue.push(10));
+	EXPECT_EQ(8, queue.pop_batch(100));
+	EXPECT_EQ(0, queue.size());
+
+	EXPECT_TRUE(queue.push(11));
+	queue.clear();
+	EXPECT_FALSE(queue.peek(item));
+}
+
+TEST(THREAD_SYNCHRONIZATION_TESTS, MultiProducerQueueStress)
+{
+	constexpr std::uint32_t NUMBER_OF_PRODUCERS = 8;
+	constexpr std::uint32_t ITEMS_PER_PRODUCER = 10000;
+	LockFreeMultiProducerQueue<std::uint32_t> queue(64);
+
+	std::vector<std::thread> producers;
+	for (std::uint32_t producer = 0; producer < NUMBER_OF_PRODUCERS; producer++)
+	{
+		producers.emplace_back([&queue, producer]() {
+			for (std::uint32_t i = 0; i < ITEMS_PER_PRODUCER; i++)
+			{
+				while (!queue.push((producer << 24) | i))
+				{
+					std::this_thread::yield();
+				}
+			}
+		});
+	}
+
+	// Every item must arrive exactly once, and in order for each producer.
+	// Keep draining the queue until every producer is done, and only check the results once they have been joined.
+	std::array<std::uint32_t, NUMBER_OF_PRODUCERS> nextExpected = { 0 };
+	std::uint32_t numberReceived = 0;
+	std::uint32_t numberOfUnknownItems = 0;
+	std::uint32_t numberOfItemsOutOfOrder = 0;
+	std::array<std::uint32_t, 16> items;
+	while (numberReceived < (NUMBER_OF_PRODUCERS * ITEMS_PER_PRODUCER))
+	{
+		const std::size_t count = queue.peek_batch(items.data(), items.size());
+		for (std::size_t i = 0; i < count; i++)
+		{
+			const std::uint32_t producer = items[i] >> 24;
+			if (producer >= NUMBER_OF_PRODUCERS)
+			{
+				numberOfUnknownItems++;
+			}
+			else
+			{
+				if (nextExpected[producer] != (items[i] & 0xFFFFFF))
+				{
+					numberOfItemsOutOfOrder++;
+				}
+				nextExpected[producer]++;
+			}
+		}
+		EXPECT_EQ(count, queue.pop_batch(count));
+		numberReceived += static_cast<std::uint32_t>(count);
+	}
+
+	for (auto &producer : producers)
+	{
+		producer.join();
+	}
+	EXPECT_EQ(0, numberOfUnknownItems);
+	EXPECT_EQ(0, numberOfItemsOutOfOrder);
+	for (std::uint32_t producer = 0; producer < NUMBER_OF_PRODUCERS; producer++)
+	{
+		EXPECT_EQ(ITEMS_PER_PRODUCER, nextExpected[producer]);
+	}
+	EXPECT_EQ(0, queue.size());
+}
@@ -1,15 +1,21 @@
 #include <gtest/gtest.h>
 
+#include "isobus/isobus/can_extended_transport_protocol.hpp"
 #include "isobus/isobus/can_transport_protocol.hpp"
+#include "isobus/isobus/can_transport_protocol_session_table.hpp"
+#include "isobus/isobus/nmea2000_fast_packet_protocol.hpp"
 #include "isobus/utility/system_timing.hpp"
 
 #include "helpers/control_function_helpers.hpp"
 #include "helpers/messaging_helpers.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <deque>
 #include <future>
+#include <iostream>
+#include <limits>
 #include <thread>
 
 using namespace isobus;
@@ -653,6 +659,113 @@ TEST(TRANSPORT_PROTOCOL_TESTS, BroadcastMessageSending)
 	ASSERT_FALSE(manager.has_session(originator, nullptr));
 }
 
+// Test case for pacing several broadcast messages on the same channel at once
+TEST(TRANSPORT_PROTOCOL_TESTS, ConcurrentBroadcastMessagePacing)
+{
+	constexpr std::array<std::uint8_t, 17> dataToSent = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x11 };
+	constexpr std::size_t NUMBER_OF_SESSIONS = 3;
+	constexpr std::size_t FRAMES_PER_SESSION = 4; // BAM plus three data frames
+
+	std::array<std::shared_ptr<ControlFunction>, NUMBER_OF_SESSIONS> originators;
+	for (std::size_t i = 0; i < NUMBER_OF_SESSIONS; i++)
+	{
+		originators[i] = test_helpers::create_mock_control_function(static_cast<std::uint8_t>(0x01 + i));
+	}
+
+	std::array<std::size_t, NUMBER_OF_SESSIONS> frameCounts = { 0 };
+	std::array<std::uint64_t, NUMBER_OF_SESSIONS> frameTimes_us = { 0 };
+	std::size_t totalFrameCount = 0;
+	auto sendFrameCallback = [&](std::uint32_t,
+	                             CANDataSpan,
+	                             std::shared_ptr<InternalControlFunction> sourceControlFunction,
+	                             std::shared_ptr<ControlFunction>,
+	                             CANIdentifier::CANPriority) {
+		for (std::size_t i = 0; i < NUMBER_OF_SESSIONS; i++)
+		{
+			if (sourceControlFunction == originators[i])
+			{
+				if (frameCounts[i] > 0)
+				{
+					// Each session keeps the minimum time between its own frames, regardless of the other sessions
+					EXPECT_GE(SystemTiming::get_time_elapsed_us(frameTimes_us[i]), 50000);
+				}
+				frameCounts[i]++;
+				frameTimes_us[i] = SystemTiming::get_timestamp_us();
+			}
+		}
+		totalFrameCount++;
+		return true;
+	};
+
+	CANNetworkConfiguration defaultConfiguration;
+	defaultConfiguration.set_max_number_transport_protocol_sessions(NUMBER_OF_SESSIONS);
+	TransportProtocolManager manager(sendFrameCallback, nullptr, &defaultConfiguration);
+
+	// Start the sessions a few milliseconds apart, so their schedules are interleaved
+	for (std::size_t i = 0; i < NUMBER_OF_SESSIONS; i++)
+	{
+		auto data = std::unique_ptr<CANMessageData>(new CANMessageDataView(dataToSent.data(), dataToSent.size()));
+		ASSERT_TRUE(manager.protocol_transmit_message(0xFEEC, data, originators[i], nullptr, nullptr, nullptr));
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+	EXPECT_EQ(manager.get_sessions().size(), NUMBER_OF_SESSIONS);
+
+	// The sessions run side by side, so all of them finish in about the time one of them takes
+	std::uint32_t time = SystemTiming::get_timestamp_ms();
+	while ((totalFrameCount < NUMBER_OF_SESSIONS * FRAMES_PER_SESSION) && (SystemTiming::get_time_elapsed_ms(time) < 3 * 200))
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(manager.get_time_until_next_update() > 0 ? 1 : 0));
+		manager.update();
+	}
+	ASSERT_EQ(totalFrameCount, NUMBER_OF_SESSIONS * FRAMES_PER_SESSION);
+	EXPECT_LT(SystemTiming::get_time_elapsed_ms(time), 3 * 50 + 50);
+	EXPECT_EQ(manager.get_sessions().size(), 0);
+
+	// Every data frame is in the statistics, and none of them came close to the 200ms maximum
+	auto statistics = manager.get_broadcast_pacing_statistics();
+	EXPECT_EQ(statistics.get_number_of_samples(), NUMBER_OF_SESSIONS * (FRAMES_PER_SESSION - 1));
+	EXPECT_EQ(statistics.get_number_of_late_frames(), 0);
+	EXPECT_LT(statistics.get_maximum_jitter_us(), 50000);
+	EXPECT_LE(statistics.get_average_jitter_us(), statistics.get_maximum_jitter_us());
+
+	std::uint32_t samplesInBuckets = 0;
+	for (std::size_t i = 0; i < TransportProtocolManager::BroadcastPacingStatistics::NUMBER_OF_JITTER_BUCKETS; i++)
+	{
+		samplesInBuckets += statistics.get_jitter_bucket_count(i);
+	}
+	EXPECT_EQ(samplesInBuckets, statistics.get_number_of_samples());
+
+	manager.reset_broadcast_pacing_statistics();
+	EXPECT_EQ(manager.get_broadcast_pacing_statistics().get_number_of_samples(), 0);
+}
+
+// Test case for the jitter histogram of the broadcast pacing statistics
+TEST(TRANSPORT_PROTOCOL_TESTS, BroadcastPacingStatisticsHistogram)
+{
+	TransportProtocolManager::BroadcastPacingStatistics statistics;
+
+	statistics.add_sample(50000, 50000); // On time
+	statistics.add_sample(50100, 50000); // 100us late, still in the first bucket
+	statistics.add_sample(50101, 50000); // Just over the first bucket
+	statistics.add_sample(51500, 50000); // 1.5ms late
+	statistics.add_sample(250000, 50000); // Over the maximum time between BAM frames
+
+	EXPECT_EQ(statistics.get_number_of_samples(), 5);
+	EXPECT_EQ(statistics.get_jitter_bucket_count(0), 2);
+	EXPECT_EQ(statistics.get_jitter_bucket_count(1), 1);
+	EXPECT_EQ(statistics.get_jitter_bucket_count(4), 1);
+	EXPECT_EQ(statistics.get_jitter_bucket_count(TransportProtocolManager::BroadcastPacingStatistics::NUMBER_OF_JITTER_BUCKETS - 1), 1);
+	EXPECT_EQ(statistics.get_jitter_bucket_count(TransportProtocolManager::BroadcastPacingStatistics::NUMBER_OF_JITTER_BUCKETS), 0);
+	EXPECT_EQ(statistics.get_maximum_jitter_us(), 200000);
+	EXPECT_EQ(statistics.get_average_jitter_us(), (0 + 100 + 101 + 1500 + 200000) / 5);
+	EXPECT_EQ(statistics.get_number_of_late_frames(), 1);
+
+	statistics.reset();
+	EXPECT_EQ(statistics.get_number_of_samples(), 0);
+	EXPECT_EQ(statistics.get_jitter_bucket_count(0), 0);
+	EXPECT_EQ(statistics.get_maximum_jitter_us(), 0);
+}
+
 // Test case for receiving a destination specific message
 TEST(TRANSPORT_PROTOCOL_TESTS, DestinationSpecificMessageReceiving)
 {
@@ -2123,3 +2236,984 @@ TEST(TRANSPORT_PROTOCOL_TESTS, DestinationSpecificOverwriteSession)
 	// After the transmission is finished, the sessions should be removed as indication that connection is closed
 	ASSERT_FALSE(manager.has_session(originator, receiver));
 }
+
+namespace
+{
+	class MockSession : public TransportProtocolSessionBase
+	{
+	public:
+		MockSession(std::shared_ptr<ControlFunction> source, std::shared_ptr<ControlFunction> destination, std::uint32_t parameterGroupNumber) :
+		  TransportProtocolSessionBase(Direction::Receive,
+		                               std::unique_ptr<CANMessageData>(new CANMessageDataVector(0)),
+		                               parameterGroupNumber,
+		                               0,
+		                               source,
+		                               destination,
+		                               nullptr,
+		                               nullptr)
+		{
+		}
+
+		std::uint32_t get_total_bytes_transferred() const override
+		{
+			return 0;
+		}
+	};
+}
+
+TEST(TRANSPORT_PROTOCOL_TESTS, SessionTableLookup)
+{
+	std::vector<std::shared_ptr<ControlFunction>> controlFunctions;
+	for (std::uint8_t address = 0; address < 6; address++)
+	{
+		controlFunctions.push_back(test_helpers::create_mock_control_function(address));
+	}
+	controlFunctions.push_back(nullptr); // Broadcast destination
+
+	TransportProtocolSessionTable<MockSession> table(true);
+	table.reserve(4);
+	std::vector<std::shared_ptr<MockSession>> expectedSessions;
+
+	// Add and remove sessions in a pseudo random order, and check that the index agrees with a linear search
+	std::uint32_t randomState = 12345;
+	for (std::size_t step = 0; step < 2000; step++)
+	{
+		randomState = (randomState * 1103515245) + 12345;
+		auto source = controlFunctions.at((randomState >> 8) % (controlFunctions.size() - 1));
+		auto destination = controlFunctions.at((randomState >> 12) % controlFunctions.size());
+		std::uint32_t parameterGroupNumber = 0x1F000 + ((randomState >> 16) % 3);
+
+		auto expected = std::find_if(expectedSessions.begin(), expectedSessions.end(), [&](const std::shared_ptr<MockSession> &session) {
+			return (session->get_source() == source) && (session->get_destination() == destination) && (session->get_parameter_group_number() == parameterGroupNumber);
+		});
+		auto found = table.find(source, destination, parameterGroupNumber);
+
+		if (expectedSessions.end() != expected)
+		{
+			ASSERT_EQ(*expected, found);
+			EXPECT_TRUE(table.erase(found));
+			expectedSessions.erase(expected);
+		}
+		else
+		{
+			ASSERT_EQ(nullptr, found);
+			auto session = std::make_shared<MockSession>(source, destination, parameterGroupNumber);
+			table.insert(session);
+			expectedSessions.push_back(session);
+		}
+		ASSERT_EQ(expectedSessions, table.get_sessions());
+	}
+
+	// Without the PGN in the key, any PGN finds the session
+	TransportProtocolSessionTable<MockSession> tableWithoutPGN;
+	auto session = std::make_shared<MockSession>(controlFunctions.at(0), controlFunctions.at(1), 0xEF00);
+	tableWithoutPGN.insert(session);
+	EXPECT_EQ(session, tableWithoutPGN.find(controlFunctions.at(0), controlFunctions.at(1), 0xFE00));
+	EXPECT_EQ(nullptr, tableWithoutPGN.find(controlFunctions.at(1), controlFunctions.at(0)));
+	EXPECT_FALSE(tableWithoutPGN.erase(std::make_shared<MockSession>(controlFunctions.at(0), controlFunctions.at(1), 0xEF00)));
+	EXPECT_TRUE(tableWithoutPGN.erase(session));
+	EXPECT_EQ(0, tableWithoutPGN.size());
+}
+
+TEST(TRANSPORT_PROTOCOL_TESTS, SessionTableDeadlines)
+{
+	TransportProtocolSessionTable<MockSession> table;
+	table.reserve(4);
+	std::vector<std::shared_ptr<MockSession>> sessions;
+	for (std::uint8_t address = 0; address < 4; address++)
+	{
+		sessions.push_back(std::make_shared<MockSession>(test_helpers::create_mock_control_function(address), nullptr, 0xEF00));
+		table.insert(sessions.back());
+	}
+	EXPECT_FALSE(table.has_deadline());
+
+	table.schedule(sessions.at(0), 100);
+	table.schedule(sessions.at(1), 50);
+	table.schedule(sessions.at(2), 100);
+	table.schedule(sessions.at(3), 200);
+	table.schedule(sessions.at(3), 300); // Later than the current deadline, so it's ignored
+	table.schedule(sessions.at(0), 20); // Earlier than the current deadline, so it replaces it
+	ASSERT_TRUE(table.has_deadline());
+	EXPECT_EQ(20, table.get_time_until_next_deadline(0));
+	EXPECT_EQ(0, table.get_time_until_next_deadline(25));
+
+	// Nothing is due before the first deadline
+	std::vector<std::shared_ptr<MockSession>> dueSessions;
+	table.take_due_sessions(19, dueSessions);
+	EXPECT_TRUE(dueSessions.empty());
+
+	// Due sessions come out in the reverse order they were added to the table, and the stale deadline of session 0 is skipped
+	table.take_due_sessions(100, dueSessions);
+	ASSERT_EQ(3, dueSessions.size());
+	EXPECT_EQ(sessions.at(2), dueSessions.at(0));
+	EXPECT_EQ(sessions.at(1), dueSessions.at(1));
+	EXPECT_EQ(sessions.at(0), dueSessions.at(2));
+	dueSessions.clear();
+	table.take_due_sessions(150, dueSessions);
+	EXPECT_TRUE(dueSessions.empty());
+
+	// Removed sessions are never due
+	EXPECT_TRUE(table.erase(sessions.at(3)));
+	table.take_due_sessions(1000, dueSessions);
+	EXPECT_TRUE(dueSessions.empty());
+	EXPECT_FALSE(table.has_deadline());
+	EXPECT_EQ(std::numeric_limits<std::uint32_t>::max(), table.get_time_until_next_deadline(1000));
+
+	// Deadlines keep working when the millisecond timer wraps around
+	table.schedule(sessions.at(0), 0xFFFFFFF0);
+	table.schedule(sessions.at(1), 0x00000010);
+	table.take_due_sessions(0x00000000, dueSessions);
+	ASSERT_EQ(1, dueSessions.size());
+	EXPECT_EQ(sessions.at(0), dueSessions.at(0));
+	EXPECT_EQ(0x10, table.get_time_until_next_deadline(0x00000000));
+}
+
+// Benchmark for three 1785 byte messages from one source to three destinations, sent concurrently and one after the other
+TEST(TRANSPORT_PROTOCOL_TESTS, DestinationSpecificConcurrentTransmit)
+{
+	constexpr std::uint32_t pgnToSend = 0xEF00;
+	constexpr std::size_t NUMBER_OF_DESTINATIONS = 3;
+	std::vector<std::uint8_t> dataToSend(1785);
+	for (std::size_t i = 0; i < dataToSend.size(); i++)
+	{
+		dataToSend[i] = static_cast<std::uint8_t>(i);
+	}
+
+	auto originator = test_helpers::create_mock_internal_control_function(0x01);
+	std::array<std::shared_ptr<InternalControlFunction>, NUMBER_OF_DESTINATIONS> receivers = {
+		test_helpers::create_mock_internal_control_function(0x02),
+		test_helpers::create_mock_internal_control_function(0x03),
+		test_helpers::create_mock_internal_control_function(0x04)
+	};
+
+	std::deque<CANMessage> originatingQueue;
+	std::deque<CANMessage> receivingQueue;
+	std::vector<std::shared_ptr<ControlFunction>> dataFrameDestinations;
+	std::size_t messagesReceived = 0;
+
+	auto receiveMessageCallback = [&](const CANMessage &message) {
+		EXPECT_EQ(message.get_data(), dataToSend);
+		messagesReceived++;
+	};
+	auto sendFrameCallback = [&](std::uint32_t parameterGroupNumber,
+	                             CANDataSpan data,
+	                             std::shared_ptr<InternalControlFunction> sourceControlFunction,
+	                             std::shared_ptr<ControlFunction> destinationControlFunction,
+	                             CANIdentifier::CANPriority priority) {
+		CANMessage message = test_helpers::create_message(static_cast<std::uint8_t>(priority),
+		                                                  parameterGroupNumber,
+		                                                  destinationControlFunction,
+		                                                  sourceControlFunction,
+		                                                  data.begin(),
+		                                                  data.size());
+		if (sourceControlFunction == originator)
+		{
+			if (static_cast<std::uint32_t>(CANLibParameterGroupNumber::TransportProtocolDataTransfer) == parameterGroupNumber)
+			{
+				dataFrameDestinations.push_back(destinationControlFunction);
+			}
+			originatingQueue.push_back(message);
+		}
+		else
+		{
+			receivingQueue.push_back(message);
+		}
+		return true;
+	};
+
+	CANNetworkConfiguration configuration;
+	TransportProtocolManager txManager(sendFrameCallback, nullptr, &configuration);
+	TransportProtocolManager rxManager(sendFrameCallback, receiveMessageCallback, &configuration);
+
+	// Each cycle is one update of both sides, followed by delivering every frame that was sent during that update
+	auto run_cycle = [&]() {
+		txManager.update();
+		rxManager.update();
+		while (!originatingQueue.empty() || !receivingQueue.empty())
+		{
+			if (!originatingQueue.empty())
+			{
+				rxManager.process_message(originatingQueue.front());
+				originatingQueue.pop_front();
+			}
+			if (!receivingQueue.empty())
+			{
+				txManager.process_message(receivingQueue.front());
+				receivingQueue.pop_front();
+			}
+		}
+	};
+	auto start_transfer = [&](const std::shared_ptr<ControlFunction> &destination) {
+		auto data = std::unique_ptr<CANMessageData>(new CANMessageDataView(dataToSend.data(), dataToSend.size()));
+		return txManager.protocol_transmit_message(pgnToSend, data, originator, destination, nullptr, nullptr);
+	};
+
+	// One after the other
+	std::size_t sequentialCycles = 0;
+	for (const auto &receiver : receivers)
+	{
+		ASSERT_TRUE(start_transfer(receiver));
+		while (txManager.has_session(originator, receiver) && (sequentialCycles < 1000))
+		{
+			run_cycle();
+			sequentialCycles++;
+		}
+	}
+	ASSERT_EQ(NUMBER_OF_DESTINATIONS, messagesReceived);
+
+	// All at the same time
+	messagesReceived = 0;
+	std::size_t concurrentCycles = 0;
+	for (const auto &receiver : receivers)
+	{
+		ASSERT_TRUE(start_transfer(receiver));
+	}
+	while ((messagesReceived < NUMBER_OF_DESTINATIONS) && (concurrentCycles < 1000))
+	{
+		run_cycle();
+		concurrentCycles++;
+	}
+	ASSERT_EQ(NUMBER_OF_DESTINATIONS, messagesReceived);
+
+	// Sessions to different destinations run side by side instead of one after the other
+	EXPECT_LT(concurrentCycles * 2, sequentialCycles);
+
+	// With a low frame budget, the concurrent sessions take turns one frame at a time
+	configuration.set_max_number_of_network_manager_protocol_frames_per_update(NUMBER_OF_DESTINATIONS);
+	messagesReceived = 0;
+	for (const auto &receiver : receivers)
+	{
+		ASSERT_TRUE(start_transfer(receiver));
+	}
+	run_cycle(); // Sends the RTS messages and receives the CTS messages
+	dataFrameDestinations.clear();
+	run_cycle();
+	ASSERT_EQ(NUMBER_OF_DESTINATIONS, dataFrameDestinations.size());
+	for (const auto &receiver : receivers)
+	{
+		EXPECT_EQ(1, std::count(dataFrameDestinations.begin(), dataFrameDestinations.end(), receiver));
+	}
+
+	// Limiting the number of concurrent sessions per source rejects the extra session
+	configuration.set_max_number_transport_protocol_transmit_sessions_per_source(NUMBER_OF_DESTINATIONS);
+	auto data = std::unique_ptr<CANMessageData>(new CANMessageDataView(dataToSend.data(), dataToSend.size()));
+	EXPECT_FALSE(txManager.protocol_transmit_message(pgnToSend, data, originator, test_helpers::create_mock_internal_control_function(0x05), nullptr, nullptr));
+}
+
+TEST(TRANSPORT_PROTOCOL_TESTS, ExtendedAdaptiveFlowControl)
+{
+	constexpr std::uint32_t pgnToSend = 0xEF00;
+	std::vector<std::uint8_t> dataToSend(10000);
+	for (std::size_t i = 0; i < dataToSend.size(); i++)
+	{
+		dataToSend[i] = static_cast<std::uint8_t>(i * 3);
+	}
+
+	auto originator = test_helpers::create_mock_internal_control_function(0x01);
+	auto receiver = test_helpers::create_mock_internal_control_function(0x02);
+	auto otherOriginator = test_helpers::create_mock_internal_control_function(0x03);
+
+	std::deque<CANMessage> originatingQueue;
+	std::deque<CANMessage> receivingQueue;
+	std::vector<std::uint8_t> clearToSendWindows;
+	std::size_t dataFramesSent = 0;
+	std::size_t messagesReceived = 0;
+
+	auto receiveMessageCallback = [&](const CANMessage &message) {
+		EXPECT_EQ(message.get_data(), dataToSend);
+		messagesReceived++;
+	};
+	auto sendFrameCallback = [&](std::uint32_t parameterGroupNumber,
+	                             CANDataSpan data,
+	                             std::shared_ptr<InternalControlFunction> sourceControlFunction,
+	                             std::shared_ptr<ControlFunction> destinationControlFunction,
+	                             CANIdentifier::CANPriority priority) {
+		CANMessage message = test_helpers::create_message(static_cast<std::uint8_t>(priority),
+		                                                  parameterGroupNumber,
+		                                                  destinationControlFunction,
+		                                                  sourceControlFunction,
+		                                                  data.begin(),
+		                                                  data.size());
+		if ((sourceControlFunction == originator) || (sourceControlFunction == otherOriginator))
+		{
+			if (static_cast<std::uint32_t>(CANLibParameterGroupNumber::ExtendedTransportProtocolDataTransfer) == parameterGroupNumber)
+			{
+				dataFramesSent++;
+			}
+			originatingQueue.push_back(message);
+		}
+		else
+		{
+			if (static_cast<std::uint8_t>(ExtendedTransportProtocolManager::CLEAR_TO_SEND_MULTIPLEXOR) == data[0])
+			{
+				clearToSendWindows.push_back(data[1]);
+			}
+			receivingQueue.push_back(message);
+		}
+		return true;
+	};
+
+	CANNetworkConfiguration configuration;
+	configuration.set_extended_transport_protocol_adaptive_flow_control(true);
+	ExtendedTransportProtocolManager txManager(sendFrameCallback, nullptr, &configuration);
+	ExtendedTransportProtocolManager rxManager(sendFrameCallback, receiveMessageCallback, &configuration);
+
+	auto run_cycle = [&]() {
+		txManager.update();
+		rxManager.update();
+		while (!originatingQueue.empty() || !receivingQueue.empty())
+		{
+			if (!originatingQueue.empty())
+			{
+				rxManager.process_message(originatingQueue.front());
+				originatingQueue.pop_front();
+			}
+			if (!receivingQueue.empty())
+			{
+				txManager.process_message(receivingQueue.front());
+				receivingQueue.pop_front();
+			}
+		}
+	};
+	auto start_transfer = [&](std::shared_ptr<InternalControlFunction> source) {
+		auto data = std::unique_ptr<CANMessageData>(new CANMessageDataView(dataToSend.data(), dataToSend.size()));
+		EXPECT_TRUE(txManager.protocol_transmit_message(pgnToSend, data, source, receiver, nullptr, nullptr));
+		EXPECT_EQ(1, txManager.get_sessions().size());
+		return txManager.get_sessions().front();
+	};
+	auto run_until_received = [&]() {
+		for (std::size_t cycles = 0; (0 == messagesReceived) && (cycles < 5000); cycles++)
+		{
+			run_cycle();
+		}
+		ASSERT_EQ(1, messagesReceived);
+		messagesReceived = 0;
+	};
+
+	// On a quiet bus, the window starts at the configured number of packets per DPO and grows after every window
+	auto session = start_transfer(originator);
+	run_until_received();
+	ASSERT_GE(clearToSendWindows.size(), 3);
+	EXPECT_EQ(configuration.get_number_of_packets_per_dpo_message(), clearToSendWindows.front());
+	for (std::size_t i = 1; i < clearToSendWindows.size() - 1; i++)
+	{
+		EXPECT_GT(clearToSendWindows[i], clearToSendWindows[i - 1]);
+	}
+	const std::uint8_t largestWindow = *std::max_element(clearToSendWindows.begin(), clearToSendWindows.end());
+	EXPECT_GT(largestWindow, configuration.get_number_of_packets_per_dpo_message());
+	EXPECT_EQ(dataToSend.size(), session->get_total_bytes_transferred());
+	EXPECT_GT(session->get_goodput(), 0);
+
+	// The next session picks up where the last one left off, and shrinks the window on a busy bus
+	clearToSendWindows.clear();
+	rxManager.set_estimated_busload(90.0f);
+	start_transfer(originator);
+	run_until_received();
+	ASSERT_GE(clearToSendWindows.size(), 3);
+	EXPECT_GE(clearToSendWindows.front(), largestWindow);
+	for (std::size_t i = 1; i < clearToSendWindows.size(); i++)
+	{
+		EXPECT_LE(clearToSendWindows[i], clearToSendWindows[i - 1]);
+	}
+	EXPECT_EQ(static_cast<std::uint8_t>(ExtendedTransportProtocolManager::ADAPTIVE_MINIMUM_WINDOW), clearToSendWindows[clearToSendWindows.size() - 2]); // The last CTS only asks for what is left
+
+	// Each sender has its own window, so another sender doesn't start from the one that was shrunk
+	clearToSendWindows.clear();
+	start_transfer(otherOriginator);
+	run_until_received();
+	ASSERT_FALSE(clearToSendWindows.empty());
+	EXPECT_EQ(configuration.get_number_of_packets_per_dpo_message(), clearToSendWindows.front());
+
+	// On a busy bus, the sender paces its data packets instead of sending the whole window at once
+	txManager.set_estimated_busload(90.0f);
+	start_transfer(originator);
+	run_cycle(); // Sends the RTS and receives the CTS
+	run_cycle(); // Sends the DPO
+	dataFramesSent = 0;
+	run_cycle();
+	EXPECT_LE(dataFramesSent, 1);
+	std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	run_cycle();
+	EXPECT_GE(dataFramesSent, 1);
+	EXPECT_LE(dataFramesSent, 2);
+}
+
+TEST(TRANSPORT_PROTOCOL_TESTS, ExtendedPipelinedWindows)
+{
+	constexpr std::uint32_t pgnToSend = 0xEF00;
+	std::vector<std::uint8_t> dataToSend(4000);
+	for (std::size_t i = 0; i < dataToSend.size(); i++)
+	{
+		dataToSend[i] = static_cast<std::uint8_t>(i * 7);
+	}
+
+	auto originator = test_helpers::create_mock_internal_control_function(0x01, NAME(0xA000000000000001));
+	auto receiver = test_helpers::create_mock_internal_control_function(0x02, NAME(0xA000000000000002));
+
+	std::deque<CANMessage> originatingQueue;
+	std::deque<CANMessage> receivingQueue;
+	std::string frameLog; // 'C' for a CTS, 'O' for a DPO and 'D' for a data frame
+	std::size_t messagesReceived = 0;
+
+	auto receiveMessageCallback = [&](const CANMessage &message) {
+		EXPECT_EQ(message.get_data(), dataToSend);
+		messagesReceived++;
+	};
+	auto sendFrameCallback = [&](std::uint32_t parameterGroupNumber,
+	                             CANDataSpan data,
+	                             std::shared_ptr<InternalControlFunction> sourceControlFunction,
+	                             std::shared_ptr<ControlFunction> destinationControlFunction,
+	                             CANIdentifier::CANPriority priority) {
+		CANMessage message = test_helpers::create_message(static_cast<std::uint8_t>(priority),
+		                                                  parameterGroupNumber,
+		                                                  destinationControlFunction,
+		                                                  sourceControlFunction,
+		                                                  data.begin(),
+		                                                  data.size());
+		if (static_cast<std::uint32_t>(CANLibParameterGroupNumber::ExtendedTransportProtocolDataTransfer) == parameterGroupNumber)
+		{
+			frameLog.push_back('D');
+		}
+		else if (static_cast<std::uint8_t>(ExtendedTransportProtocolManager::CLEAR_TO_SEND_MULTIPLEXOR) == data[0])
+		{
+			frameLog.push_back('C');
+		}
+		else if (static_cast<std::uint8_t>(ExtendedTransportProtocolManager::DATA_PACKET_OFFSET_MULTIPLXOR) == data[0])
+		{
+			frameLog.push_back('O');
+		}
+
+		if (sourceControlFunction == originator)
+		{
+			originatingQueue.push_back(message);
+		}
+		else
+		{
+			receivingQueue.push_back(message);
+		}
+		return true;
+	};
+
+	// Send a few frames per update, so the receiver gets to answer while a window is still being sent
+	CANNetworkConfiguration configuration;
+	configuration.set_max_number_of_network_manager_protocol_frames_per_update(4);
+	ExtendedTransportProtocolManager txManager(sendFrameCallback, nullptr, &configuration);
+	ExtendedTransportProtocolManager rxManager(sendFrameCallback, receiveMessageCallback, &configuration);
+
+	auto run_transfer = [&]() {
+		frameLog.clear();
+		messagesReceived = 0;
+		auto data = std::unique_ptr<CANMessageData>(new CANMessageDataView(dataToSend.data(), dataToSend.size()));
+		EXPECT_TRUE(txManager.protocol_transmit_message(pgnToSend, data, originator, receiver, nullptr, nullptr));
+
+		std::size_t cycles = 0;
+		for (; (0 == messagesReceived) && (cycles < 5000); cycles++)
+		{
+			txManager.update();
+			rxManager.update();
+			while (!originatingQueue.empty() || !receivingQueue.empty())
+			{
+				if (!originatingQueue.empty())
+				{
+					rxManager.process_message(originatingQueue.front());
+					originatingQueue.pop_front();
+				}
+				if (!receivingQueue.empty())
+				{
+					txManager.process_message(receivingQueue.front());
+					receivingQueue.pop_front();
+				}
+			}
+		}
+		EXPECT_EQ(1, messagesReceived);
+		EXPECT_EQ(0, txManager.get_sessions().size());
+		EXPECT_EQ(0, rxManager.get_sessions().size());
+		return cycles;
+	};
+
+	const std::size_t numberOfPackets = (dataToSend.size() + 6) / 7;
+	const std::size_t sequentialCycles = run_transfer();
+	EXPECT_EQ(numberOfPackets, static_cast<std::size_t>(std::count(frameLog.begin(), frameLog.end(), 'D')));
+	EXPECT_EQ(std::string::npos, frameLog.find("DCD")); // Without pipelining, each CTS waits for the window to complete
+
+	// Pipelining is only used with the control functions it's allowed for
+	configuration.add_extended_transport_protocol_pipelining_partner(NAME(0xA000000000000003));
+	EXPECT_TRUE(configuration.get_extended_transport_protocol_pipelining(NAME(0xA000000000000003)));
+	EXPECT_FALSE(configuration.get_extended_transport_protocol_pipelining(originator->get_NAME()));
+	EXPECT_EQ(sequentialCycles, run_transfer());
+	EXPECT_EQ(std::string::npos, frameLog.find("DCD"));
+
+	configuration.add_extended_transport_protocol_pipelining_partner(originator->get_NAME());
+	configuration.add_extended_transport_protocol_pipelining_partner(receiver->get_NAME());
+	const std::size_t pipelinedCycles = run_transfer();
+	EXPECT_EQ(numberOfPackets, static_cast<std::size_t>(std::count(frameLog.begin(), frameLog.end(), 'D')));
+	EXPECT_EQ(std::count(frameLog.begin(), frameLog.end(), 'C'), std::count(frameLog.begin(), frameLog.end(), 'O'));
+
+	// Every CTS after the first one is sent in the middle of a window, and every DPO follows the last data frame of the previous window
+	for (std::size_t i = frameLog.find('C', 1); std::string::npos != i; i = frameLog.find('C', i + 1))
+	{
+		ASSERT_LT(i + 1, frameLog.size());
+		EXPECT_EQ('D', frameLog[i - 1]);
+		EXPECT_EQ('D', frameLog[i + 1]);
+	}
+	EXPECT_LT(pipelinedCycles, sequentialCycles);
+
+	configuration.remove_extended_transport_protocol_pipelining_partner(originator->get_NAME());
+	configuration.remove_extended_transport_protocol_pipelining_partner(receiver->get_NAME());
+	EXPECT_FALSE(configuration.get_extended_transport_protocol_pipelining(receiver->get_NAME()));
+	EXPECT_EQ(sequentialCycles, run_transfer());
+}
+
+TEST(TRANSPORT_PROTOCOL_TESTS, UpdateOnlyDueSessions)
+{
+	auto originator = test_helpers::create_mock_control_function(0x01);
+	auto sender = test_helpers::create_mock_internal_control_function(0x02);
+	auto receiver = test_helpers::create_mock_control_function(0x03);
+
+	std::size_t framesSent = 0;
+	auto sendFrameCallback = [&](std::uint32_t,
+	                             CANDataSpan,
+	                             std::shared_ptr<InternalControlFunction>,
+	                             std::shared_ptr<ControlFunction>,
+	                             CANIdentifier::CANPriority) {
+		framesSent++;
+		return true;
+	};
+
+	CANNetworkConfiguration defaultConfiguration;
+	TransportProtocolManager manager(sendFrameCallback, nullptr, &defaultConfiguration);
+	EXPECT_EQ(std::numeric_limits<std::uint32_t>::max(), manager.get_time_until_next_update());
+
+	// A new broadcast rx session is due right away, after that it only needs to be checked when its T1 timer could expire
+	manager.process_message(test_helpers::create_message_broadcast(
+	  7,
+	  0xEC00, // Transport Protocol Connection Management
+	  originator,
+	  {
+	    32, // BAM Mux
+	    17, // Data Length
+	    0, // Data Length MSB
+	    3, // Packet count
+	    0xFF, // Reserved
+	    0xEC, // PGN LSB
+	    0xFE, // PGN middle byte
+	    0x00, // PGN MSB
+	  }));
+	EXPECT_EQ(0, manager.get_time_until_next_update());
+	manager.update();
+	EXPECT_GT(manager.get_time_until_next_update(), TransportProtocolManager::T1_TIMEOUT_MS - 50);
+	EXPECT_LE(manager.get_time_until_next_update(), TransportProtocolManager::T1_TIMEOUT_MS + 1);
+
+	// A tx session sends its RTS right away, after which it waits for the receiver
+	std::vector<std::uint8_t> dataToSend(100);
+	auto data = std::unique_ptr<CANMessageData>(new CANMessageDataView(dataToSend.data(), dataToSend.size()));
+	ASSERT_TRUE(manager.protocol_transmit_message(0xEF00, data, sender, receiver, nullptr, nullptr));
+	EXPECT_EQ(1, framesSent);
+	EXPECT_GT(manager.get_time_until_next_update(), TransportProtocolManager::T1_TIMEOUT_MS - 50); // The BAM session is first in line again
+	EXPECT_LE(manager.get_time_until_next_update(), TransportProtocolManager::T1_TIMEOUT_MS + 1);
+
+	// Frequent updates don't do anything while the sessions are waiting
+	for (std::size_t i = 0; i < 100; i++)
+	{
+		manager.update();
+	}
+	EXPECT_EQ(1, framesSent);
+	EXPECT_TRUE(manager.has_session(originator, nullptr));
+	EXPECT_TRUE(manager.has_session(sender, receiver));
+
+	// The CTS makes the tx session due again, which then sends its data
+	manager.process_message(test_helpers::create_message(
+	  7,
+	  0xEC00, // Transport Protocol Connection Management
+	  sender,
+	  receiver,
+	  {
+	    17, // CTS Mux
+	    15, // Number of packets
+	    1, // Next packet to send
+	    0xFF, // Reserved
+	    0xFF, // Reserved
+	    0x00, // PGN LSB
+	    0xEF, // PGN middle byte
+	    0x00, // PGN MSB
+	  }));
+	EXPECT_EQ(0, manager.get_time_until_next_update());
+	manager.update();
+	EXPECT_EQ(16, framesSent);
+	EXPECT_GT(manager.get_time_until_next_update(), TransportProtocolManager::T1_TIMEOUT_MS - 50);
+}
+
+// A sink that records what a receive session writes into it
+class RecordingReceiveSink : public CANMessageReceiveSink
+{
+public:
+	struct Record
+	{
+		std::vector<std::uint8_t> data;
+		std::size_t sinksCreated = 0;
+		std::size_t writes = 0;
+		std::size_t sessionsClosed = 0;
+		bool successful = false;
+	};
+
+	explicit RecordingReceiveSink(Record &record, std::uint32_t totalMessageSize) :
+	  record(record)
+	{
+		record.data.assign(totalMessageSize, 0);
+		record.sinksCreated++;
+	}
+
+	void write_bytes(std::size_t offset, CANDataSpan chunk) override
+	{
+		ASSERT_LE(offset + chunk.size(), record.data.size());
+		std::copy(chunk.begin(), chunk.end(), record.data.begin() + offset);
+		record.writes++;
+	}
+
+	void on_session_closed(bool successful) override
+	{
+		record.successful = successful;
+		record.sessionsClosed++;
+	}
+
+	static std::unique_ptr<CANMessageReceiveSink> create(std::uint32_t parameterGroupNumber,
+	                                                     std::uint32_t totalMessageSize,
+	                                                     std::shared_ptr<ControlFunction>,
+	                                                     std::shared_ptr<ControlFunction>,
+	                                                     void *parent)
+	{
+		if (0xEF00 != parameterGroupNumber)
+		{
+			return nullptr;
+		}
+		return std::unique_ptr<CANMessageReceiveSink>(new RecordingReceiveSink(*static_cast<Record *>(parent), totalMessageSize));
+	}
+
+private:
+	Record &record;
+};
+
+TEST(TRANSPORT_PROTOCOL_TESTS, ReceiveIntoSink)
+{
+	auto originator = test_helpers::create_mock_internal_control_function(0x01);
+	auto receiver = test_helpers::create_mock_internal_control_function(0x02);
+
+	std::deque<CANMessage> originatingQueue;
+	std::deque<CANMessage> receivingQueue;
+	std::vector<CANMessage> messagesReceived;
+	RecordingReceiveSink::Record record;
+
+	auto receiveMessageCallback = [&](const CANMessage &message) {
+		messagesReceived.push_back(message);
+	};
+	auto sendFrameCallback = [&](std::uint32_t parameterGroupNumber,
+	                             CANDataSpan data,
+	                             std::shared_ptr<InternalControlFunction> sourceControlFunction,
+	                             std::shared_ptr<ControlFunction> destinationControlFunction,
+	                             CANIdentifier::CANPriority priority) {
+		CANMessage message = test_helpers::create_message(static_cast<std::uint8_t>(priority),
+		                                                  parameterGroupNumber,
+		                                                  destinationControlFunction,
+		                                                  sourceControlFunction,
+		                                                  data.begin(),
+		                                                  data.size());
+		if (sourceControlFunction == originator)
+		{
+			originatingQueue.push_back(message);
+		}
+		else
+		{
+			receivingQueue.push_back(message);
+		}
+		return true;
+	};
+
+	CANNetworkConfiguration configuration;
+	TransportProtocolManager txManager(sendFrameCallback, nullptr, &configuration);
+	TransportProtocolManager rxManager(sendFrameCallback, receiveMessageCallback, &configuration);
+	ExtendedTransportProtocolManager txExtendedManager(sendFrameCallback, nullptr, &configuration);
+	ExtendedTransportProtocolManager rxExtendedManager(sendFrameCallback, receiveMessageCallback, &configuration);
+	rxManager.set_receive_sink_callback(RecordingReceiveSink::create, &record);
+	rxExtendedManager.set_receive_sink_callback(RecordingReceiveSink::create, &record);
+
+	auto transfer = [&](std::uint32_t parameterGroupNumber, const std::vector<std::uint8_t> &dataToSend) {
+		bool extended = (dataToSend.size() > TransportProtocolManager::MAX_PROTOCOL_DATA_LENGTH);
+		auto data = std::unique_ptr<CANMessageData>(new CANMessageDataView(dataToSend.data(), dataToSend.size()));
+		if (extended)
+		{
+			ASSERT_TRUE(txExtendedManager.protocol_transmit_message(parameterGroupNumber, data, originator, receiver, nullptr, nullptr));
+		}
+		else
+		{
+			ASSERT_TRUE(txManager.protocol_transmit_message(parameterGroupNumber, data, originator, receiver, nullptr, nullptr));
+		}
+
+		for (std::size_t cycles = 0; cycles < 1000; cycles++)
+		{
+			txManager.update();
+			txExtendedManager.update();
+			rxManager.update();
+			rxExtendedManager.update();
+			while (!originatingQueue.empty() || !receivingQueue.empty())
+			{
+				if (!originatingQueue.empty())
+				{
+					(extended ? rxExtendedManager.process_message(originatingQueue.front()) : rxManager.process_message(originatingQueue.front()));
+					originatingQueue.pop_front();
+				}
+				if (!receivingQueue.empty())
+				{
+					(extended ? txExtendedManager.process_message(receivingQueue.front()) : txManager.process_message(receivingQueue.front()));
+					receivingQueue.pop_front();
+				}
+			}
+			if (!txManager.has_session(originator, receiver) && !txExtendedManager.has_session(originator, receiver))
+			{
+				break;
+			}
+		}
+	};
+
+	std::vector<std::uint8_t> dataToSend(100);
+	for (std::size_t i = 0; i < dataToSend.size(); i++)
+	{
+		dataToSend[i] = static_cast<std::uint8_t>(i);
+	}
+
+	// A TP message for a PGN with a sink is written straight into the sink, and not passed on as a message
+	transfer(0xEF00, dataToSend);
+	EXPECT_EQ(1, record.sinksCreated);
+	EXPECT_EQ(15, record.writes);
+	EXPECT_EQ(1, record.sessionsClosed);
+	EXPECT_TRUE(record.successful);
+	EXPECT_EQ(dataToSend, record.data);
+	EXPECT_TRUE(messagesReceived.empty());
+
+	// Messages the callback doesn't supply a sink for are reassembled as usual
+	transfer(0xEE00, dataToSend);
+	EXPECT_EQ(1, record.sinksCreated);
+	ASSERT_EQ(1, messagesReceived.size());
+	EXPECT_EQ(dataToSend, messagesReceived.front().get_data());
+
+	// The same goes for ETP
+	dataToSend.resize(3000);
+	for (std::size_t i = 0; i < dataToSend.size(); i++)
+	{
+		dataToSend[i] = static_cast<std::uint8_t>(i * 7);
+	}
+	transfer(0xEF00, dataToSend);
+	EXPECT_EQ(2, record.sinksCreated);
+	EXPECT_EQ(2, record.sessionsClosed);
+	EXPECT_TRUE(record.successful);
+	EXPECT_EQ(dataToSend, record.data);
+	EXPECT_EQ(1, messagesReceived.size());
+
+	// A session that is aborted tells its sink it was unsuccessful
+	auto data = std::unique_ptr<CANMessageData>(new CANMessageDataView(dataToSend.data(), 100));
+	ASSERT_TRUE(txManager.protocol_transmit_message(0xEF00, data, originator, receiver, nullptr, nullptr));
+	rxManager.process_message(originatingQueue.front()); // The RTS
+	originatingQueue.clear();
+	EXPECT_EQ(3, record.sinksCreated);
+	rxManager.process_message(test_helpers::create_message(7,
+	                                                       0xEC00, // Transport Protocol Connection Management
+	                                                       receiver,
+	                                                       originator,
+	                                                       {
+	                                                         255, // Abort Mux
+	                                                         0x03, // Timeout
+	                                                         0xFF, // Reserved
+	                                                         0xFF, // Reserved
+	                                                         0xFF, // Reserved
+	                                                         0x00, // PGN LSB
+	                                                         0xEF, // PGN middle byte
+	                                                         0x00, // PGN MSB
+	                                                       }));
+	EXPECT_EQ(3, record.sessionsClosed);
+	EXPECT_FALSE(record.successful);
+	EXPECT_FALSE(rxManager.has_session(originator, receiver));
+}
+
+// Splits a payload into the frames of a fast packet message
+static std::vector<std::array<std::uint8_t, CAN_DATA_LENGTH>> create_fast_packet_frames(std::uint8_t sequenceNumber, const std::vector<std::uint8_t> &payload)
+{
+	std::vector<std::array<std::uint8_t, CAN_DATA_LENGTH>> frames;
+	std::size_t payloadIndex = 0;
+	while (payloadIndex < payload.size())
+	{
+		std::array<std::uint8_t, CAN_DATA_LENGTH> frame;
+		frame.fill(0xFF);
+		frame[0] = static_cast<std::uint8_t>((sequenceNumber << 5) | frames.size());
+		std::size_t frameIndex = 1;
+		if (frames.empty())
+		{
+			frame[frameIndex++] = static_cast<std::uint8_t>(payload.size());
+		}
+		while ((frameIndex < CAN_DATA_LENGTH) && (payloadIndex < payload.size()))
+		{
+			frame[frameIndex++] = payload[payloadIndex++];
+		}
+		frames.push_back(frame);
+	}
+	return frames;
+}
+
+static void store_fast_packet_message(const CANMessage &message, void *parent)
+{
+	static_cast<std::vector<CANMessage> *>(parent)->push_back(message);
+}
+
+TEST(TRANSPORT_PROTOCOL_TESTS, FastPacketInterleavedAndOutOfOrderReceiving)
+{
+	constexpr std::uint32_t pgnToReceive = 0x1F805; // GNSS Position Data
+	auto source = test_helpers::create_mock_control_function(0x10);
+	auto otherSource = test_helpers::create_mock_control_function(0x11);
+
+	std::vector<CANMessage> messagesReceived;
+	FastPacketProtocol protocol([](std::uint32_t, CANDataSpan, std::shared_ptr<InternalControlFunction>, std::shared_ptr<ControlFunction>, CANIdentifier::CANPriority) { return true; });
+	protocol.register_multipacket_message_callback(pgnToReceive, store_fast_packet_message, &messagesReceived);
+
+	std::vector<std::uint8_t> firstPayload(43);
+	std::vector<std::uint8_t> secondPayload(43);
+	for (std::size_t i = 0; i < firstPayload.size(); i++)
+	{
+		firstPayload[i] = static_cast<std::uint8_t>(i);
+		secondPayload[i] = static_cast<std::uint8_t>(0xFF - i);
+	}
+	auto firstFrames = create_fast_packet_frames(1, firstPayload);
+	auto secondFrames = create_fast_packet_frames(2, secondPayload);
+	ASSERT_EQ(7, firstFrames.size());
+
+	auto receive = [&](const std::shared_ptr<ControlFunction> &sender, const std::array<std::uint8_t, CAN_DATA_LENGTH> &frame) {
+		protocol.process_message(test_helpers::create_message_broadcast(3, pgnToReceive, sender, frame.data(), static_cast<std::uint32_t>(frame.size())));
+	};
+
+	// Frames of two consecutive messages from the same source, interleaved with each other
+	for (std::size_t i = 0; i < firstFrames.size(); i++)
+	{
+		receive(source, firstFrames[i]);
+		receive(source, secondFrames[i]);
+	}
+	ASSERT_EQ(2, messagesReceived.size());
+	EXPECT_EQ(firstPayload, messagesReceived[0].get_data());
+	EXPECT_EQ(secondPayload, messagesReceived[1].get_data());
+	EXPECT_EQ(pgnToReceive, messagesReceived[0].get_identifier().get_parameter_group_number());
+	EXPECT_EQ(source, messagesReceived[0].get_source_control_function());
+
+	// Frames that arrive out of order, including before the first frame
+	messagesReceived.clear();
+	std::reverse(firstFrames.begin(), firstFrames.end());
+	for (const auto &frame : firstFrames)
+	{
+		receive(source, frame);
+	}
+	ASSERT_EQ(1, messagesReceived.size());
+	EXPECT_EQ(firstPayload, messagesReceived[0].get_data());
+
+	// The same sequence counter from a different source is a different message
+	messagesReceived.clear();
+	std::reverse(firstFrames.begin(), firstFrames.end());
+	for (std::size_t i = 0; i < firstFrames.size(); i++)
+	{
+		receive(source, firstFrames[i]);
+		if (0 != i)
+		{
+			receive(otherSource, secondFrames[i]);
+		}
+	}
+	ASSERT_EQ(1, messagesReceived.size());
+	EXPECT_EQ(firstPayload, messagesReceived[0].get_data());
+	receive(otherSource, create_fast_packet_frames(1, secondPayload)[0]);
+	EXPECT_EQ(1, messagesReceived.size()); // Sequence counter 1 doesn't match the frames that were sent with 2
+	receive(otherSource, secondFrames[0]);
+	ASSERT_EQ(2, messagesReceived.size());
+	EXPECT_EQ(secondPayload, messagesReceived[1].get_data());
+	EXPECT_EQ(otherSource, messagesReceived[1].get_source_control_function());
+
+	// Repeating the first frame restarts the message
+	messagesReceived.clear();
+	receive(source, firstFrames[0]);
+	receive(source, firstFrames[1]);
+	receive(source, firstFrames[0]);
+	for (std::size_t i = 1; i < firstFrames.size(); i++)
+	{
+		receive(source, firstFrames[i]);
+	}
+	ASSERT_EQ(1, messagesReceived.size());
+	EXPECT_EQ(firstPayload, messagesReceived[0].get_data());
+
+	// Finish the message the other source started with sequence counter 1, so no other message is waiting
+	messagesReceived.clear();
+	auto otherFrames = create_fast_packet_frames(1, secondPayload);
+	for (std::size_t i = 1; i < otherFrames.size(); i++)
+	{
+		receive(otherSource, otherFrames[i]);
+	}
+	ASSERT_EQ(1, messagesReceived.size());
+	EXPECT_EQ(std::numeric_limits<std::uint32_t>::max(), protocol.get_time_until_next_update());
+
+	// Frames whose first frame never arrives are only kept for the gap allowed between frames
+	messagesReceived.clear();
+	for (std::size_t i = 1; i < firstFrames.size(); i++)
+	{
+		receive(source, firstFrames[i]);
+	}
+	EXPECT_LE(protocol.get_time_until_next_update(), 51);
+	std::this_thread::sleep_for(std::chrono::milliseconds(60));
+	EXPECT_EQ(0, protocol.get_time_until_next_update());
+	protocol.update();
+	EXPECT_EQ(std::numeric_limits<std::uint32_t>::max(), protocol.get_time_until_next_update());
+	receive(source, firstFrames[0]);
+	EXPECT_TRUE(messagesReceived.empty());
+
+	// A message that has started waits for the whole timeout
+	EXPECT_GT(protocol.get_time_until_next_update(), 700);
+}
+
+TEST(TRANSPORT_PROTOCOL_TESTS, FastPacketManyInterleavedSources)
+{
+	constexpr std::uint32_t pgnToReceive = 0x1F805; // GNSS Position Data
+	constexpr std::size_t NUMBER_OF_SOURCES = 24;
+	constexpr std::size_t MESSAGES_PER_SOURCE = 200;
+
+	std::vector<std::shared_ptr<ControlFunction>> sources;
+	for (std::size_t i = 0; i < NUMBER_OF_SOURCES; i++)
+	{
+		sources.push_back(test_helpers::create_mock_control_function(static_cast<std::uint8_t>(0x20 + i)));
+	}
+
+	std::vector<CANMessage> messagesReceived;
+	messagesReceived.reserve(NUMBER_OF_SOURCES * MESSAGES_PER_SOURCE);
+	FastPacketProtocol protocol([](std::uint32_t, CANDataSpan, std::shared_ptr<InternalControlFunction>, std::shared_ptr<ControlFunction>, CANIdentifier::CANPriority) { return true; });
+	protocol.register_multipacket_message_callback(pgnToReceive, store_fast_packet_message, &messagesReceived);
+
+	std::vector<std::uint8_t> payload(43);
+	for (std::size_t i = 0; i < payload.size(); i++)
+	{
+		payload[i] = static_cast<std::uint8_t>(i * 5);
+	}
+
+	// Every source sends its messages at the same time, so the frames of all sources are interleaved on the bus
+	std::vector<CANMessage> bus;
+	for (std::size_t message = 0; message < MESSAGES_PER_SOURCE; message++)
+	{
+		auto frames = create_fast_packet_frames(static_cast<std::uint8_t>(message % 8), payload);
+		for (const auto &frame : frames)
+		{
+			for (const auto &source : sources)
+			{
+				bus.push_back(test_helpers::create_message_broadcast(3, pgnToReceive, source, frame.data(), static_cast<std::uint32_t>(frame.size())));
+			}
+		}
+	}
+
+	for (const auto &frame : bus)
+	{
+		protocol.process_message(frame);
+	}
+
+	ASSERT_EQ(NUMBER_OF_SOURCES * MESSAGES_PER_SOURCE, messagesReceived.size());
+	for (const auto &message : messagesReceived)
+	{
+		EXPECT_EQ(payload, message.get_data());
+	}
+}
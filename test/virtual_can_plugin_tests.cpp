@@ -70,3 +70,25 @@ TEST(VIRTUAL_CAN_PLUGIN_TESTS, OtherReceivesMessage)
 	EXPECT_EQ(receiveFrame.data[7], 0x08);
 	EXPECT_EQ(receiveFrame.dataLength, 8);
 }
+
+TEST(VIRTUAL_CAN_PLUGIN_TESTS, ReadFramesDefaultsToSingleFrame)
+{
+	VirtualCANPlugin testPlugin("", true);
+
+	CANMessageFrame sentFrame;
+	sentFrame.identifier = 0x18FFA227;
+	sentFrame.isExtendedFrame = true;
+	sentFrame.dataLength = 1;
+	sentFrame.data[0] = 0x01;
+	testPlugin.write_frame(sentFrame);
+	sentFrame.data[0] = 0x02;
+	testPlugin.write_frame(sentFrame);
+
+	CANMessageFrame receiveFrames[4];
+	DataSpan<CANMessageFrame> span(receiveFrames, 4);
+	EXPECT_EQ(1, testPlugin.read_frames(span));
+	EXPECT_EQ(0x01, receiveFrames[0].data[0]);
+	EXPECT_EQ(1, testPlugin.read_frames(span));
+	EXPECT_EQ(0x02, receiveFrames[0].data[0]);
+	EXPECT_EQ(0, testPlugin.read_frames(DataSpan<CANMessageFrame>(receiveFrames, 0)));
+}
@@ -8,7 +8,15 @@
 //================================================================================================
 #include <gtest/gtest.h>
 
+#include "isobus/isobus/isobus_virtual_terminal_object_pool_snapshot.hpp"
 #include "isobus/isobus/isobus_virtual_terminal_objects.hpp"
+#include "isobus/isobus/isobus_virtual_terminal_server_managed_working_set.hpp"
+#include "isobus/isobus/isobus_virtual_terminal_server_worker_pool.hpp"
+#include "isobus/utility/iop_file_interface.hpp"
+#include "isobus/utility/system_timing.hpp"
+
+#include <atomic>
+#include <thread>
 
 using namespace isobus;
 
@@ -38,7 +46,7 @@ static void run_baseline_tests(VTObject *objectUnderTest)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, WorkingSetTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	VTColourTable colourTable;
 	auto ws = std::make_shared<WorkingSet>();
 
@@ -128,7 +136,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, WorkingSetTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, DataMaskTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	DataMask mask;
 
 	run_baseline_tests(&mask);
@@ -205,7 +213,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, DataMaskTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ContainerTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	Container container;
 
 	run_baseline_tests(&container);
@@ -276,7 +284,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ContainerTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AlarmMaskTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	AlarmMask alarmMask;
 
 	run_baseline_tests(&alarmMask);
@@ -369,7 +377,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AlarmMaskTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, SoftKeyMaskTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	auto softKeyMask = std::make_shared<SoftKeyMask>();
 
 	run_baseline_tests(softKeyMask.get());
@@ -420,7 +428,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, SoftKeyMaskTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, SoftKeyTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	auto softKey = std::make_shared<Key>();
 
 	run_baseline_tests(softKey.get());
@@ -478,7 +486,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, SoftKeyTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ButtonTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	auto button = std::make_shared<Button>();
 
 	run_baseline_tests(button.get());
@@ -566,7 +574,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ButtonTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, KeyGroupTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	auto keyGroup = std::make_shared<KeyGroup>();
 	auto testName = std::make_shared<OutputString>();
 
@@ -660,7 +668,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, KeyGroupTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, InputBooleanTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	auto inputBoolean = std::make_shared<InputBoolean>();
 
 	run_baseline_tests(inputBoolean.get());
@@ -761,7 +769,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, InputBooleanTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, InputStringTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	auto inputString = std::make_shared<InputString>();
 
 	run_baseline_tests(inputString.get());
@@ -887,7 +895,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, InputStringTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, InputNumberTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	auto inputNumber = std::make_shared<InputNumber>();
 
 	run_baseline_tests(inputNumber.get());
@@ -1061,7 +1069,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, InputNumberTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, InputListTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	auto inputList = std::make_shared<InputList>();
 
 	run_baseline_tests(inputList.get());
@@ -1158,7 +1166,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, InputListTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputStringTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	auto outputString = std::make_shared<OutputString>();
 
 	run_baseline_tests(outputString.get());
@@ -1265,7 +1273,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputStringTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputNumberTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	auto outputNumber = std::make_shared<OutputNumber>();
 
 	run_baseline_tests(outputNumber.get());
@@ -1403,7 +1411,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputNumberTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputListTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	auto outputList = std::make_shared<OutputList>();
 
 	run_baseline_tests(outputList.get());
@@ -1516,7 +1524,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputListTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputLineTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	auto outputLine = std::make_shared<OutputLine>();
 
 	run_baseline_tests(outputLine.get());
@@ -1597,7 +1605,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputLineTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputRectangleTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	auto outputRectangle = std::make_shared<OutputRectangle>();
 
 	run_baseline_tests(outputRectangle.get());
@@ -1694,7 +1702,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputRectangleTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputEllipseTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	auto outputEllipse = std::make_shared<OutputEllipse>();
 
 	run_baseline_tests(outputEllipse.get());
@@ -1806,7 +1814,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputEllipseTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputPolygonTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	auto outputPolygon = std::make_shared<OutputPolygon>();
 
 	run_baseline_tests(outputPolygon.get());
@@ -1918,7 +1926,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputPolygonTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputMeterTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	auto outputMeter = std::make_shared<OutputMeter>();
 
 	run_baseline_tests(outputMeter.get());
@@ -2039,7 +2047,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputMeterTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputLinearBarGraphTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	OutputLinearBarGraph outputLinearBarGraph;
 
 	run_baseline_tests(&outputLinearBarGraph);
@@ -2151,7 +2159,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputLinearBarGraphTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputArchedBarGraphTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	OutputArchedBarGraph outputArchedBarGraph;
 
 	run_baseline_tests(&outputArchedBarGraph);
@@ -2273,7 +2281,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputArchedBarGraphTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, PictureGraphicTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	PictureGraphic pictureGraphic;
 
 	run_baseline_tests(&pictureGraphic);
@@ -2365,7 +2373,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, PictureGraphicTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, NumberVariableTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	NumberVariable numberVariable;
 
 	run_baseline_tests(&numberVariable);
@@ -2400,7 +2408,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, NumberVariableTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, StringVariableTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	StringVariable stringVariable;
 
 	run_baseline_tests(&stringVariable);
@@ -2426,7 +2434,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, StringVariableTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, FontAttributesTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	FontAttributes fontAttributes;
 
 	run_baseline_tests(&fontAttributes);
@@ -2543,7 +2551,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, FontAttributesTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, LineAttributesTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	LineAttributes lineAttributes;
 
 	run_baseline_tests(&lineAttributes);
@@ -2590,7 +2598,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, LineAttributesTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, FillAttributesTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	FillAttributes fillAttributes;
 	auto fillPattern = std::make_shared<PictureGraphic>();
 
@@ -2638,7 +2646,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, FillAttributesTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, InputAttributesTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	InputAttributes inputAttributes;
 
 	run_baseline_tests(&inputAttributes);
@@ -2676,7 +2684,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, InputAttributesTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ExtendedInputAttributesTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	ExtendedInputAttributes extendedInputAttributes;
 
 	run_baseline_tests(&extendedInputAttributes);
@@ -2708,7 +2716,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ExtendedInputAttributesTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, MacroTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	Macro macro;
 
 	run_baseline_tests(&macro);
@@ -2749,7 +2757,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, MacroTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ColourMapTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	ColourMap colourMap;
 
 	run_baseline_tests(&colourMap);
@@ -2785,7 +2793,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ColourMapTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, WindowMaskTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	auto windowMask = std::make_shared<WindowMask>();
 
 	run_baseline_tests(windowMask.get());
@@ -2901,7 +2909,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, WindowMaskTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ExternalObjectPointerTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	auto externalObject = std::make_shared<ExternalObjectPointer>();
 
 	run_baseline_tests(externalObject.get());
@@ -2957,7 +2965,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ExternalObjectPointerTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ObjectPointerTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	auto externalObject = std::make_shared<ObjectPointer>();
 
 	run_baseline_tests(externalObject.get());
@@ -2978,7 +2986,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ObjectPointerTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AuxiliaryInputType1Tests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	auto auxiliaryInput = std::make_shared<AuxiliaryInputType1>();
 
 	run_baseline_tests(auxiliaryInput.get());
@@ -3027,7 +3035,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AuxiliaryInputType1Tests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AuxiliaryInputType2Tests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	auto auxiliaryInput = std::make_shared<AuxiliaryInputType2>();
 
 	run_baseline_tests(auxiliaryInput.get());
@@ -3093,7 +3101,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AuxiliaryInputType2Tests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AuxiliaryFunctionType1Tests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	auto auxiliaryFunction = std::make_shared<AuxiliaryFunctionType1>();
 
 	run_baseline_tests(auxiliaryFunction.get());
@@ -3133,7 +3141,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AuxiliaryFunctionType1Tests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AuxiliaryFunctionType2Tests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	auto auxiliaryFunction = std::make_shared<AuxiliaryFunctionType2>();
 
 	run_baseline_tests(auxiliaryFunction.get());
@@ -3194,7 +3202,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AuxiliaryFunctionType2Tests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AuxiliaryControlDesignatorType2Tests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectTable objects;
 	auto auxiliaryControlDesignator = std::make_shared<AuxiliaryControlDesignatorType2>();
 
 	run_baseline_tests(auxiliaryControlDesignator.get());
@@ -3237,3 +3245,594 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AuxiliaryControlDesignatorType2Tests)
 	auxiliaryControlDesignator->get_attribute(static_cast<std::uint8_t>(AuxiliaryControlDesignatorType2::AttributeName::PointerType), testValue);
 	EXPECT_EQ(3, testValue);
 }
+
+TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ObjectTableTests)
+{
+	VTObjectTable objects;
+	EXPECT_TRUE(objects.empty());
+	EXPECT_EQ(0, objects.size());
+	EXPECT_EQ(objects.begin(), objects.end());
+	EXPECT_EQ(nullptr, objects.get(0));
+	EXPECT_EQ(nullptr, objects.get(NULL_OBJECT_ID));
+	EXPECT_FALSE(objects.contains(1000));
+
+	// Objects in different pages, including the first and last usable IDs
+	const std::vector<std::uint16_t> ids = { 0, 255, 256, 1000, 40000, 65534 };
+	for (auto id : ids)
+	{
+		auto object = std::make_shared<Container>();
+		object->set_id(id);
+		objects[id] = object;
+	}
+	EXPECT_FALSE(objects.empty());
+	EXPECT_EQ(ids.size(), objects.size());
+
+	for (auto id : ids)
+	{
+		ASSERT_NE(nullptr, objects.get(id));
+		EXPECT_EQ(id, objects.get(id)->get_id());
+		EXPECT_EQ(objects.get(id), objects.get_shared(id).get());
+		EXPECT_EQ(objects.get(id), VTObject::get_object_by_id(id, objects).get());
+		EXPECT_TRUE(objects.contains(id));
+	}
+	EXPECT_EQ(nullptr, objects.get(1));
+	EXPECT_EQ(nullptr, objects.get(1001));
+	EXPECT_EQ(nullptr, VTObject::get_object_by_id(NULL_OBJECT_ID, objects));
+
+	// Iteration is in ID order and skips empty slots
+	std::vector<std::uint16_t> iteratedIds;
+	for (const auto &object : objects)
+	{
+		iteratedIds.push_back(object->get_id());
+	}
+	EXPECT_EQ(ids, iteratedIds);
+
+	// A null pointer in a slot is the same as no object
+	objects[2000] = nullptr;
+	EXPECT_FALSE(objects.contains(2000));
+	EXPECT_EQ(ids.size(), objects.size());
+
+	// A copy shares the objects, but not the table
+	VTObjectTable copy(objects);
+	objects.erase(1000);
+	EXPECT_FALSE(objects.contains(1000));
+	EXPECT_EQ(ids.size() - 1, objects.size());
+	ASSERT_TRUE(copy.contains(1000));
+	EXPECT_EQ(copy.get(40000), objects.get(40000));
+
+	objects.clear();
+	EXPECT_TRUE(objects.empty());
+	EXPECT_EQ(nullptr, objects.get(40000));
+	EXPECT_EQ(ids.size(), copy.size());
+}
+
+TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ObjectArenaTests)
+{
+	auto arena = std::make_shared<VTObjectArena>(1024);
+	EXPECT_EQ(0, arena->get_number_of_allocations());
+	EXPECT_EQ(0, arena->get_number_of_blocks());
+
+	// Small allocations share a block and respect their alignment
+	auto first = static_cast<std::uint8_t *>(arena->allocate(3, 1));
+	auto second = arena->allocate(8, 8);
+	EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(second) % 8);
+	EXPECT_LT(static_cast<void *>(first), second);
+	EXPECT_EQ(1, arena->get_number_of_blocks());
+	EXPECT_EQ(2, arena->get_number_of_allocations());
+	EXPECT_EQ(11, arena->get_bytes_used());
+
+	// Large allocations that don't fit the current block get their own, so the current block is still used after
+	arena->allocate(2000, 8);
+	EXPECT_EQ(2, arena->get_number_of_blocks());
+	arena->allocate(8, 8);
+	EXPECT_EQ(2, arena->get_number_of_blocks());
+	EXPECT_EQ(4, arena->get_number_of_allocations());
+
+	// An object allocated from the arena keeps it alive
+	std::weak_ptr<VTObjectArena> weakArena = arena;
+	auto object = std::allocate_shared<Container>(VTObjectArenaAllocator<Container>(arena));
+	object->set_id(5);
+	object->add_child(10, 1, 2);
+	object->add_macro({ EventID::OnShow, 20 });
+	object->set_arena(arena);
+	arena.reset();
+	ASSERT_FALSE(weakArena.expired());
+	EXPECT_EQ(5, object->get_id());
+	ASSERT_EQ(1, object->get_number_children());
+	EXPECT_EQ(10, object->get_child_id(0));
+	EXPECT_EQ(1, object->get_child_x(0));
+	EXPECT_EQ(2, object->get_child_y(0));
+	ASSERT_EQ(1, object->get_number_macros());
+	EXPECT_EQ(20, object->get_macro(0).macroID);
+
+	for (std::uint16_t i = 0; i < 100; i++)
+	{
+		object->add_child(100 + i, 0, 0);
+	}
+	EXPECT_EQ(101, object->get_number_children());
+	EXPECT_EQ(199, object->get_child_id(100));
+
+	object.reset();
+	EXPECT_TRUE(weakArena.expired());
+}
+
+TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ServerWorkerPoolTests)
+{
+	std::atomic<std::uint32_t> jobsRun = { 0 };
+	{
+		VirtualTerminalServerWorkerPool workerPool(3);
+		EXPECT_EQ(3, workerPool.get_number_of_threads());
+
+		for (std::uint32_t i = 0; i < 100; i++)
+		{
+			workerPool.submit([&jobsRun, &workerPool]() {
+				jobsRun++;
+				// Jobs can queue more jobs
+				workerPool.submit([&jobsRun]() { jobsRun++; });
+			});
+		}
+		// Every queued job runs before the pool is destroyed
+	}
+	EXPECT_EQ(200, jobsRun);
+
+	EXPECT_GE(VirtualTerminalServerWorkerPool::get_default_number_of_threads(), 1);
+	EXPECT_LE(VirtualTerminalServerWorkerPool::get_default_number_of_threads(), VirtualTerminalServerWorkerPool::MAX_DEFAULT_NUMBER_OF_THREADS);
+}
+
+static VirtualTerminalServerManagedWorkingSet::ObjectPoolProcessingThreadState wait_for_parsing(const std::shared_ptr<VirtualTerminalServerManagedWorkingSet> &workingSet)
+{
+	std::uint32_t startTime = SystemTiming::get_timestamp_ms();
+	while ((VirtualTerminalServerManagedWorkingSet::ObjectPoolProcessingThreadState::Running == workingSet->get_object_pool_processing_state()) &&
+	       (!SystemTiming::time_expired_ms(startTime, 5000)))
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	return workingSet->get_object_pool_processing_state();
+}
+
+TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ParallelObjectPoolParsingTests)
+{
+	// Working set 0 with active mask 1000, and data mask 1000 with background colour 0. Each object has one NULL child.
+	const std::vector<std::uint8_t> firstFile = { 0x00, 0x00, 0x00, 0x00, 0x01, 0xE8, 0x03, 0x01, 0x00, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0xE8, 0x03, 0x01, 0x00, 0xFF, 0xFF, 0x01, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00 };
+	// Replaces data mask 1000 with one with background colour 5, and adds data mask 1001
+	const std::vector<std::uint8_t> secondFile = { 0xE8, 0x03, 0x01, 0x05, 0xFF, 0xFF, 0x01, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0xE9, 0x03, 0x01, 0x00, 0xFF, 0xFF, 0x01, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00 };
+	// A second working set object, 2
+	const std::vector<std::uint8_t> thirdFile = { 0x02, 0x00, 0x00, 0x00, 0x01, 0xE8, 0x03, 0x01, 0x00, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00 };
+	VirtualTerminalServerWorkerPool workerPool(2);
+
+	auto workingSet = std::make_shared<VirtualTerminalServerManagedWorkingSet>();
+	workingSet->add_iop_raw_data(firstFile);
+	workingSet->add_iop_raw_data(secondFile);
+	workingSet->start_parsing(workerPool);
+	ASSERT_EQ(VirtualTerminalServerManagedWorkingSet::ObjectPoolProcessingThreadState::Success, wait_for_parsing(workingSet));
+
+	// Later files replace objects of earlier ones, the same as parsing them one after the other
+	EXPECT_EQ(3, workingSet->get_object_tree().size());
+	ASSERT_NE(nullptr, workingSet->get_working_set_object());
+	EXPECT_EQ(0, workingSet->get_working_set_object()->get_id());
+	ASSERT_NE(nullptr, workingSet->get_object_by_id(1000));
+	EXPECT_EQ(5, workingSet->get_object_by_id(1000)->get_background_color());
+	EXPECT_NE(nullptr, workingSet->get_object_by_id(1001));
+
+	std::size_t invalidObjects = 0;
+	for (const auto &object : workingSet->get_object_tree())
+	{
+		if (!object->get_is_valid(workingSet->get_object_tree()))
+		{
+			invalidObjects++;
+		}
+	}
+
+	auto statistics = workingSet->get_object_pool_parsing_statistics();
+	EXPECT_EQ(2, statistics.numberOfIopFiles);
+	EXPECT_EQ(3, statistics.numberOfObjects);
+	EXPECT_EQ(invalidObjects, statistics.numberOfInvalidObjects);
+	EXPECT_GE(statistics.totalTime_us, statistics.decodeTime_us);
+	EXPECT_GE(statistics.totalTime_us, statistics.validationTime_us);
+
+	workingSet->join_parsing_thread();
+	EXPECT_EQ(VirtualTerminalServerManagedWorkingSet::ObjectPoolProcessingThreadState::Joined, workingSet->get_object_pool_processing_state());
+
+	// Files decoded on different threads still can't define more than one working set object
+	auto badWorkingSet = std::make_shared<VirtualTerminalServerManagedWorkingSet>();
+	badWorkingSet->add_iop_raw_data(firstFile);
+	badWorkingSet->add_iop_raw_data(thirdFile);
+	badWorkingSet->start_parsing(workerPool);
+	ASSERT_EQ(VirtualTerminalServerManagedWorkingSet::ObjectPoolProcessingThreadState::Fail, wait_for_parsing(badWorkingSet));
+	EXPECT_EQ(2, badWorkingSet->get_object_pool_faulting_object_id());
+	badWorkingSet->join_parsing_thread();
+	EXPECT_EQ(VirtualTerminalServerManagedWorkingSet::ObjectPoolProcessingThreadState::Joined, badWorkingSet->get_object_pool_processing_state());
+
+	// A file that can't be decoded fails the pool
+	auto truncatedWorkingSet = std::make_shared<VirtualTerminalServerManagedWorkingSet>();
+	truncatedWorkingSet->add_iop_raw_data(firstFile);
+	truncatedWorkingSet->add_iop_raw_data(std::vector<std::uint8_t>(secondFile.begin(), secondFile.begin() + 20));
+	truncatedWorkingSet->start_parsing(workerPool);
+	EXPECT_EQ(VirtualTerminalServerManagedWorkingSet::ObjectPoolProcessingThreadState::Fail, wait_for_parsing(truncatedWorkingSet));
+}
+
+static std::vector<std::uint8_t> read_example_object_pool(const std::string &pathFromExamples)
+{
+	std::vector<std::uint8_t> retVal = IOPFileInterface::read_iop_file("../../examples/" + pathFromExamples);
+
+	if (retVal.empty())
+	{
+		// Try a different path to mitigate differences between how IDEs run the unit test
+		retVal = IOPFileInterface::read_iop_file("../examples/" + pathFromExamples);
+	}
+	return retVal;
+}
+
+TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, IncrementalObjectPoolParsingTests)
+{
+	for (const std::string path : { "virtual_terminal/version3_object_pool/VT3TestPool.iop", "seeder_example/BasePool.iop" })
+	{
+		std::vector<std::uint8_t> objectPool = read_example_object_pool(path);
+		ASSERT_FALSE(objectPool.empty());
+
+		// Sizing every object without decoding it walks the pool exactly to its end
+		std::uint32_t offset = 0;
+		std::size_t numberOfObjects = 0;
+		while (offset < objectPool.size())
+		{
+			const auto remainingLength = static_cast<std::uint32_t>(objectPool.size() - offset);
+			const std::uint32_t objectSize = VirtualTerminalWorkingSetBase::get_iop_object_size(objectPool.data() + offset, remainingLength);
+			ASSERT_NE(0, objectSize);
+			ASSERT_LE(objectSize, remainingLength);
+			// Any less data than the whole object is reported as not enough
+			EXPECT_GT(VirtualTerminalWorkingSetBase::get_iop_object_size(objectPool.data() + offset, objectSize - 1), objectSize - 1);
+			offset += objectSize;
+			numberOfObjects++;
+		}
+		EXPECT_EQ(objectPool.size(), offset);
+
+		VirtualTerminalServerManagedWorkingSet fullyParsed;
+		std::vector<std::uint8_t> objectPoolCopy = objectPool;
+		ASSERT_TRUE(fullyParsed.parse_iop_into_objects(objectPoolCopy.data(), static_cast<std::uint32_t>(objectPoolCopy.size())));
+
+		// Chunks of any size decode the same objects as parsing the whole pool
+		for (std::uint32_t chunkSize : { 1, 7, 100, 1785 })
+		{
+			VirtualTerminalServerManagedWorkingSet incrementallyParsed;
+			incrementallyParsed.begin_incremental_iop_parse();
+
+			for (std::uint32_t chunkStart = 0; chunkStart < objectPool.size(); chunkStart += chunkSize)
+			{
+				const auto length = std::min(chunkSize, static_cast<std::uint32_t>(objectPool.size() - chunkStart));
+				ASSERT_TRUE(incrementallyParsed.parse_iop_chunk(objectPool.data() + chunkStart, length));
+			}
+			ASSERT_TRUE(incrementallyParsed.end_incremental_iop_parse());
+
+			ASSERT_EQ(fullyParsed.get_object_tree().size(), incrementallyParsed.get_object_tree().size());
+			for (const auto &object : fullyParsed.get_object_tree())
+			{
+				auto otherObject = incrementallyParsed.get_object_by_id(object->get_id());
+				ASSERT_NE(nullptr, otherObject);
+				EXPECT_EQ(object->get_object_type(), otherObject->get_object_type());
+				EXPECT_EQ(object->get_number_children(), otherObject->get_number_children());
+				EXPECT_EQ(object->get_number_macros(), otherObject->get_number_macros());
+			}
+			EXPECT_EQ(fullyParsed.get_working_set_object()->get_id(), incrementallyParsed.get_working_set_object()->get_id());
+		}
+		EXPECT_LE(fullyParsed.get_object_tree().size(), numberOfObjects);
+	}
+
+	// Extended input attributes are sized by walking their code planes
+	const std::vector<std::uint8_t> extendedInputAttributes = {
+		0x34, 0x12, static_cast<std::uint8_t>(VirtualTerminalObjectType::ExtendedInputAttributes), 0x00, 0x02, // Validation type, 2 code planes
+		0x00, 0x01, 0x30, 0x00, 0x39, 0x00, // Code plane 0, 1 range
+		0x01, 0x02, 0x00, 0x00, 0x10, 0x00, 0x20, 0x00, 0x30, 0x00, // Code plane 1, 2 ranges
+		0x35, 0x12, static_cast<std::uint8_t>(VirtualTerminalObjectType::ObjectPointer), 0xFF, 0xFF // The next object
+	};
+	const auto extendedInputAttributesSize = static_cast<std::uint32_t>(extendedInputAttributes.size() - 5);
+	EXPECT_EQ(extendedInputAttributesSize, VirtualTerminalWorkingSetBase::get_iop_object_size(extendedInputAttributes.data(), static_cast<std::uint32_t>(extendedInputAttributes.size())));
+	for (std::uint32_t length = 0; length < extendedInputAttributesSize; length++)
+	{
+		EXPECT_GT(VirtualTerminalWorkingSetBase::get_iop_object_size(extendedInputAttributes.data(), length), length);
+	}
+
+	// A pool that ends in the middle of an object fails, the same as a full parse
+	std::vector<std::uint8_t> objectPool = read_example_object_pool("seeder_example/BasePool.iop");
+	ASSERT_FALSE(objectPool.empty());
+	VirtualTerminalServerManagedWorkingSet truncated;
+	truncated.begin_incremental_iop_parse();
+	EXPECT_TRUE(truncated.parse_iop_chunk(objectPool.data(), static_cast<std::uint32_t>(objectPool.size() - 1)));
+	EXPECT_FALSE(truncated.end_incremental_iop_parse());
+
+	// Nothing received is a failure too
+	truncated.begin_incremental_iop_parse();
+	EXPECT_FALSE(truncated.end_incremental_iop_parse());
+}
+
+TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, IncrementalObjectPoolTransferTests)
+{
+	std::vector<std::uint8_t> objectPool = read_example_object_pool("seeder_example/BasePool.iop");
+	ASSERT_FALSE(objectPool.empty());
+	VirtualTerminalServerWorkerPool workerPool(2);
+
+	// A transfer decoded as it arrives only needs validating once the pool ends
+	auto workingSet = std::make_shared<VirtualTerminalServerManagedWorkingSet>();
+	workingSet->set_iop_size(static_cast<std::uint32_t>(objectPool.size()));
+	ASSERT_TRUE(workingSet->begin_incremental_object_pool_transfer());
+	for (std::size_t i = 0; i < objectPool.size(); i += 1785)
+	{
+		const auto length = static_cast<std::uint32_t>(std::min<std::size_t>(1785, objectPool.size() - i));
+		EXPECT_TRUE(workingSet->parse_iop_chunk(objectPool.data() + i, length));
+
+		// The transfer's progress counts while it is still being received
+		workingSet->set_object_pool_transfer_progress(static_cast<std::uint32_t>(i + length));
+		EXPECT_NEAR(100.0f * (i + length) / objectPool.size(), workingSet->iop_load_percentage(), 0.01f);
+	}
+	workingSet->end_incremental_object_pool_transfer(std::vector<std::uint8_t>(objectPool));
+	EXPECT_EQ(1, workingSet->get_number_iop_files());
+	EXPECT_FLOAT_EQ(100.0f, workingSet->iop_load_percentage());
+	const std::size_t numberOfObjects = workingSet->get_object_tree().size();
+	EXPECT_NE(0, numberOfObjects);
+
+	workingSet->start_parsing(workerPool);
+	ASSERT_EQ(VirtualTerminalServerManagedWorkingSet::ObjectPoolProcessingThreadState::Success, wait_for_parsing(workingSet));
+	auto statistics = workingSet->get_object_pool_parsing_statistics();
+	EXPECT_EQ(1, statistics.numberOfIopFiles);
+	EXPECT_EQ(1, statistics.numberOfIncrementallyParsedIopFiles);
+	EXPECT_EQ(numberOfObjects, statistics.numberOfObjects);
+	workingSet->join_parsing_thread();
+
+	// The objects of a parsed pool are in use, so a later transfer isn't decoded into them as it arrives
+	EXPECT_FALSE(workingSet->begin_incremental_object_pool_transfer());
+
+	// An aborted transfer's objects are discarded, and the files that did arrive are decoded again
+	auto abortedWorkingSet = std::make_shared<VirtualTerminalServerManagedWorkingSet>();
+	ASSERT_TRUE(abortedWorkingSet->begin_incremental_object_pool_transfer());
+	EXPECT_TRUE(abortedWorkingSet->parse_iop_chunk(objectPool.data(), static_cast<std::uint32_t>(objectPool.size() / 2)));
+	EXPECT_NE(0, abortedWorkingSet->get_object_tree().size());
+	abortedWorkingSet->set_iop_size(static_cast<std::uint32_t>(objectPool.size()));
+	abortedWorkingSet->set_object_pool_transfer_progress(static_cast<std::uint32_t>(objectPool.size() / 2));
+	EXPECT_NEAR(50.0f, abortedWorkingSet->iop_load_percentage(), 0.1f);
+	abortedWorkingSet->abort_incremental_object_pool_transfer();
+	EXPECT_FLOAT_EQ(0.0f, abortedWorkingSet->iop_load_percentage());
+	EXPECT_FALSE(abortedWorkingSet->begin_incremental_object_pool_transfer());
+	abortedWorkingSet->add_iop_raw_data(objectPool);
+
+	abortedWorkingSet->start_parsing(workerPool);
+	ASSERT_EQ(VirtualTerminalServerManagedWorkingSet::ObjectPoolProcessingThreadState::Success, wait_for_parsing(abortedWorkingSet));
+	statistics = abortedWorkingSet->get_object_pool_parsing_statistics();
+	EXPECT_EQ(0, statistics.numberOfIncrementallyParsedIopFiles);
+	EXPECT_EQ(numberOfObjects, abortedWorkingSet->get_object_tree().size());
+
+	// The discarded objects' memory isn't kept, the pool takes as much memory as if the aborted transfer never happened
+	EXPECT_EQ(workingSet->get_object_arena().get_bytes_used(), abortedWorkingSet->get_object_arena().get_bytes_used());
+	EXPECT_EQ(workingSet->get_object_arena().get_bytes_reserved(), abortedWorkingSet->get_object_arena().get_bytes_reserved());
+
+	// A transfer to a pool that is in use isn't decoded as it arrives, so aborting it doesn't discard the objects either
+	EXPECT_FALSE(workingSet->begin_incremental_object_pool_transfer());
+	workingSet->abort_incremental_object_pool_transfer();
+	EXPECT_EQ(numberOfObjects, workingSet->get_object_tree().size());
+	workingSet->add_iop_raw_data(objectPool);
+
+	// Parsing a pool again decodes every file into a new arena, so the replaced objects don't pile up in the old one
+	auto reference = std::make_shared<VirtualTerminalServerManagedWorkingSet>();
+	reference->add_iop_raw_data(objectPool);
+	reference->add_iop_raw_data(objectPool);
+	reference->start_parsing(workerPool);
+	ASSERT_EQ(VirtualTerminalServerManagedWorkingSet::ObjectPoolProcessingThreadState::Success, wait_for_parsing(reference));
+
+	for (int i = 0; i < 2; i++)
+	{
+		workingSet->start_parsing(workerPool);
+		ASSERT_EQ(VirtualTerminalServerManagedWorkingSet::ObjectPoolProcessingThreadState::Success, wait_for_parsing(workingSet));
+		EXPECT_EQ(0, workingSet->get_object_pool_parsing_statistics().numberOfIncrementallyParsedIopFiles);
+		EXPECT_EQ(2, workingSet->get_object_pool_parsing_statistics().numberOfIopFiles);
+		EXPECT_EQ(numberOfObjects, workingSet->get_object_tree().size());
+		EXPECT_EQ(reference->get_object_arena().get_bytes_used(), workingSet->get_object_arena().get_bytes_used());
+		workingSet->join_parsing_thread();
+	}
+}
+
+TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ObjectPoolSnapshotTests)
+{
+	for (const std::string path : { "virtual_terminal/version3_object_pool/VT3TestPool.iop", "seeder_example/BasePool.iop" })
+	{
+		std::vector<std::uint8_t> objectPool = read_example_object_pool(path);
+		ASSERT_FALSE(objectPool.empty());
+
+		VirtualTerminalServerManagedWorkingSet fullyParsed;
+		ASSERT_TRUE(fullyParsed.parse_iop_into_objects(objectPool.data(), static_cast<std::uint32_t>(objectPool.size())));
+
+		std::vector<std::uint8_t> snapshotData = VirtualTerminalObjectPoolSnapshot::create({ objectPool }, fullyParsed.get_object_tree(), fullyParsed.get_working_set_object()->get_id(), 3);
+		ASSERT_FALSE(snapshotData.empty());
+
+		VirtualTerminalObjectPoolSnapshot snapshot(snapshotData.data(), snapshotData.size());
+		ASSERT_TRUE(snapshot.get_is_valid());
+		EXPECT_TRUE(snapshot.get_is_snapshot_of(objectPool.data(), objectPool.size()));
+		EXPECT_EQ(fullyParsed.get_object_tree().size(), snapshot.get_number_of_objects());
+		EXPECT_EQ(fullyParsed.get_working_set_object()->get_id(), snapshot.get_working_set_id());
+		EXPECT_EQ(3, snapshot.get_number_of_invalid_objects());
+
+		// Picture graphics carry their decoded pixels, everything else is decoded from the pool
+		std::size_t decodedDataLength = 0;
+		for (std::uint32_t i = 0; i < snapshot.get_number_of_objects(); i++)
+		{
+			const auto entry = snapshot.get_object_entry(i);
+			VTObject *object = fullyParsed.get_object_tree().get(entry.objectID);
+			ASSERT_NE(nullptr, object);
+			EXPECT_EQ(static_cast<std::uint8_t>(object->get_object_type()), entry.objectType);
+
+			if (VirtualTerminalObjectType::PictureGraphic == object->get_object_type())
+			{
+				const auto &pixels = static_cast<PictureGraphic *>(object)->get_raw_data();
+				ASSERT_EQ(pixels.size(), entry.decodedDataLength);
+				EXPECT_TRUE(std::equal(pixels.begin(), pixels.end(), snapshot.get_decoded_data(entry)));
+			}
+			else
+			{
+				EXPECT_EQ(0, entry.decodedDataLength);
+				EXPECT_EQ(nullptr, snapshot.get_decoded_data(entry));
+			}
+			decodedDataLength += entry.decodedDataLength;
+		}
+		EXPECT_EQ(VirtualTerminalObjectPoolSnapshot::HEADER_LENGTH + (snapshot.get_number_of_objects() * VirtualTerminalObjectPoolSnapshot::ENTRY_LENGTH) + decodedDataLength, snapshotData.size());
+
+		// Decoding from the snapshot gives the same objects as a full parse
+		VirtualTerminalServerManagedWorkingSet snapshotParsed;
+		ASSERT_TRUE(snapshotParsed.parse_iop_into_objects(snapshot, objectPool.data(), static_cast<std::uint32_t>(objectPool.size())));
+		ASSERT_EQ(fullyParsed.get_object_tree().size(), snapshotParsed.get_object_tree().size());
+		for (const auto &object : fullyParsed.get_object_tree())
+		{
+			auto otherObject = snapshotParsed.get_object_by_id(object->get_id());
+			ASSERT_NE(nullptr, otherObject);
+			EXPECT_EQ(object->get_object_type(), otherObject->get_object_type());
+			EXPECT_EQ(object->get_number_children(), otherObject->get_number_children());
+			EXPECT_EQ(object->get_number_macros(), otherObject->get_number_macros());
+
+			if (VirtualTerminalObjectType::PictureGraphic == object->get_object_type())
+			{
+				EXPECT_EQ(std::static_pointer_cast<PictureGraphic>(object)->get_raw_data(), std::static_pointer_cast<PictureGraphic>(otherObject)->get_raw_data());
+			}
+		}
+		EXPECT_EQ(fullyParsed.get_working_set_object()->get_id(), snapshotParsed.get_working_set_object()->get_id());
+
+		// The snapshot doesn't match a pool with any other content
+		std::vector<std::uint8_t> modifiedPool = objectPool;
+		modifiedPool.back() ^= 0x01;
+		EXPECT_FALSE(snapshot.get_is_snapshot_of(modifiedPool.data(), modifiedPool.size()));
+		VirtualTerminalServerManagedWorkingSet mismatched;
+		EXPECT_FALSE(mismatched.parse_iop_into_objects(snapshot, modifiedPool.data(), static_cast<std::uint32_t>(modifiedPool.size())));
+		EXPECT_FALSE(snapshot.get_is_snapshot_of(objectPool.data(), objectPool.size() - 1));
+	}
+
+	// Malformed snapshots are rejected
+	std::vector<std::uint8_t> objectPool = read_example_object_pool("seeder_example/BasePool.iop");
+	ASSERT_FALSE(objectPool.empty());
+	VirtualTerminalServerManagedWorkingSet parsedWorkingSet;
+	ASSERT_TRUE(parsedWorkingSet.parse_iop_into_objects(objectPool.data(), static_cast<std::uint32_t>(objectPool.size())));
+	std::vector<std::uint8_t> snapshotData = VirtualTerminalObjectPoolSnapshot::create({ objectPool }, parsedWorkingSet.get_object_tree(), 0, 0);
+	ASSERT_FALSE(snapshotData.empty());
+
+	EXPECT_FALSE(VirtualTerminalObjectPoolSnapshot(nullptr, 0).get_is_valid());
+	EXPECT_FALSE(VirtualTerminalObjectPoolSnapshot(snapshotData.data(), VirtualTerminalObjectPoolSnapshot::HEADER_LENGTH - 1).get_is_valid());
+	EXPECT_FALSE(VirtualTerminalObjectPoolSnapshot(snapshotData.data(), snapshotData.size() - 1).get_is_valid()); // The last picture's pixels are cut off
+	EXPECT_EQ(0, VirtualTerminalObjectPoolSnapshot(snapshotData.data(), snapshotData.size() - 1).get_number_of_objects());
+
+	std::vector<std::uint8_t> badSnapshot = snapshotData;
+	badSnapshot[0] = 'X';
+	EXPECT_FALSE(VirtualTerminalObjectPoolSnapshot(badSnapshot.data(), badSnapshot.size()).get_is_valid());
+	badSnapshot = snapshotData;
+	badSnapshot[4] = VirtualTerminalObjectPoolSnapshot::FORMAT_VERSION + 1;
+	EXPECT_FALSE(VirtualTerminalObjectPoolSnapshot(badSnapshot.data(), badSnapshot.size()).get_is_valid());
+	badSnapshot = snapshotData;
+	badSnapshot[VirtualTerminalObjectPoolSnapshot::HEADER_LENGTH + 3] = 0xFF; // First object's offset is past the end of the pool
+	EXPECT_FALSE(VirtualTerminalObjectPoolSnapshot(badSnapshot.data(), badSnapshot.size()).get_is_valid());
+	badSnapshot = snapshotData;
+	std::copy(snapshotData.begin() + VirtualTerminalObjectPoolSnapshot::HEADER_LENGTH,
+	          snapshotData.begin() + VirtualTerminalObjectPoolSnapshot::HEADER_LENGTH + VirtualTerminalObjectPoolSnapshot::ENTRY_LENGTH,
+	          badSnapshot.begin() + VirtualTerminalObjectPoolSnapshot::HEADER_LENGTH + VirtualTerminalObjectPoolSnapshot::ENTRY_LENGTH); // Duplicate object ID
+	EXPECT_FALSE(VirtualTerminalObjectPoolSnapshot(badSnapshot.data(), badSnapshot.size()).get_is_valid());
+
+	// Pixels that fit in the snapshot but not in their picture graphic are rejected when decoding
+	badSnapshot = snapshotData;
+	const VirtualTerminalObjectPoolSnapshot goodSnapshot(snapshotData.data(), snapshotData.size());
+	bool foundPictureGraphic = false;
+	for (std::uint32_t i = 0; (i < goodSnapshot.get_number_of_objects()) && !foundPictureGraphic; i++)
+	{
+		const auto entry = goodSnapshot.get_object_entry(i);
+		if (0 != entry.decodedDataLength)
+		{
+			const std::uint32_t shorterLength = entry.decodedDataLength - 1;
+			const std::size_t lengthOffset = VirtualTerminalObjectPoolSnapshot::HEADER_LENGTH + (i * VirtualTerminalObjectPoolSnapshot::ENTRY_LENGTH) + 12;
+			for (std::size_t j = 0; j < 4; j++)
+			{
+				badSnapshot[lengthOffset + j] = static_cast<std::uint8_t>(shorterLength >> (8 * j));
+			}
+			foundPictureGraphic = true;
+		}
+	}
+	ASSERT_TRUE(foundPictureGraphic);
+	const VirtualTerminalObjectPoolSnapshot shortPixelsSnapshot(badSnapshot.data(), badSnapshot.size());
+	ASSERT_TRUE(shortPixelsSnapshot.get_is_valid());
+	VirtualTerminalServerManagedWorkingSet shortPixelsParsed;
+	EXPECT_FALSE(shortPixelsParsed.parse_iop_into_objects(shortPixelsSnapshot, objectPool.data(), static_cast<std::uint32_t>(objectPool.size())));
+
+	// A pool with an object that can't be located has no snapshot
+	std::vector<std::uint8_t> unsupportedPool = { 0x01, 0x00, 0xFE, 0x00, 0x00, 0x00, 0x00, 0x00 };
+	EXPECT_TRUE(VirtualTerminalObjectPoolSnapshot::create({ unsupportedPool }, VTObjectTable(), 0, 0).empty());
+
+	// As does a picture graphic that wasn't parsed
+	EXPECT_TRUE(VirtualTerminalObjectPoolSnapshot::create({ objectPool }, VTObjectTable(), 0, 0).empty());
+}
+
+TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ObjectPoolSnapshotAcrossFilesTests)
+{
+	// Two files where the second one replaces an object of the first, which the snapshot must take from the second file
+	const std::vector<std::uint8_t> firstFile = {
+		0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x01, 0x00, 0x00, // Working set 0, active mask 1, 1 child, no macros, no languages
+		0x02, 0x00, 0x00, 0x00, 0x00, 0x00, //   Child object 2 at 0,0
+		0x01, 0x00, 0x01, 0x01, 0xFF, 0xFF, 0x01, 0x00, // Data mask 1, no soft key mask, 1 child, no macros
+		0x02, 0x00, 0x00, 0x00, 0x00, 0x00, //   Child object 2 at 0,0
+		0x02, 0x00, 0x15, 0x01, 0x00, 0x00, 0x00 // Number variable 2, value 1
+	};
+	const std::vector<std::uint8_t> secondFile = {
+		0x02, 0x00, 0x15, 0x02, 0x00, 0x00, 0x00 // Number variable 2, value 2
+	};
+
+	auto workingSet = std::make_shared<VirtualTerminalServerManagedWorkingSet>();
+	workingSet->add_iop_raw_data(firstFile);
+	workingSet->add_iop_raw_data(secondFile);
+	EXPECT_TRUE(workingSet->create_object_pool_snapshot().empty()); // Not parsed yet
+
+	VirtualTerminalServerWorkerPool workerPool(2);
+	workingSet->start_parsing(workerPool);
+	ASSERT_EQ(VirtualTerminalServerManagedWorkingSet::ObjectPoolProcessingThreadState::Success, wait_for_parsing(workingSet));
+	workingSet->join_parsing_thread();
+	std::vector<std::uint8_t> snapshotData = workingSet->create_object_pool_snapshot();
+	ASSERT_FALSE(snapshotData.empty());
+	const std::uint32_t invalidObjects = static_cast<std::uint32_t>(workingSet->get_object_pool_parsing_statistics().numberOfInvalidObjects);
+
+	// A stored version is loaded as one file, with the files appended to each other
+	std::vector<std::uint8_t> storedVersion = firstFile;
+	storedVersion.insert(storedVersion.end(), secondFile.begin(), secondFile.end());
+
+	VirtualTerminalObjectPoolSnapshot snapshot(snapshotData.data(), snapshotData.size());
+	ASSERT_TRUE(snapshot.get_is_snapshot_of(storedVersion.data(), storedVersion.size()));
+	ASSERT_EQ(3, snapshot.get_number_of_objects());
+	EXPECT_EQ(firstFile.size(), snapshot.get_object_entry(2).offset);
+	EXPECT_EQ(invalidObjects, snapshot.get_number_of_invalid_objects());
+
+	// Loading the version with its snapshot skips decoding the pool object by object and validating it
+	auto loadedWorkingSet = std::make_shared<VirtualTerminalServerManagedWorkingSet>();
+	loadedWorkingSet->add_iop_raw_data(storedVersion);
+	loadedWorkingSet->set_object_pool_snapshot(std::vector<std::uint8_t>(snapshotData));
+	loadedWorkingSet->start_parsing(workerPool);
+	ASSERT_EQ(VirtualTerminalServerManagedWorkingSet::ObjectPoolProcessingThreadState::Success, wait_for_parsing(loadedWorkingSet));
+	auto statistics = loadedWorkingSet->get_object_pool_parsing_statistics();
+	EXPECT_TRUE(statistics.loadedFromSnapshot);
+	EXPECT_EQ(3, statistics.numberOfObjects);
+	EXPECT_EQ(invalidObjects, statistics.numberOfInvalidObjects);
+	EXPECT_EQ(2, std::static_pointer_cast<NumberVariable>(loadedWorkingSet->get_object_by_id(2))->get_value());
+	EXPECT_EQ(0, loadedWorkingSet->get_working_set_object()->get_id());
+	loadedWorkingSet->join_parsing_thread();
+
+	// The snapshot can be stored again along with the loaded version
+	EXPECT_EQ(snapshotData, loadedWorkingSet->create_object_pool_snapshot());
+
+	// The parsing thread uses the snapshot too
+	auto threadWorkingSet = std::make_shared<VirtualTerminalServerManagedWorkingSet>();
+	threadWorkingSet->add_iop_raw_data(storedVersion);
+	threadWorkingSet->set_object_pool_snapshot(std::vector<std::uint8_t>(snapshotData));
+	threadWorkingSet->start_parsing_thread();
+	threadWorkingSet->join_parsing_thread();
+	EXPECT_TRUE(threadWorkingSet->get_object_pool_parsing_statistics().loadedFromSnapshot);
+	EXPECT_EQ(3, threadWorkingSet->get_object_tree().size());
+
+	// A snapshot of a different version is ignored and the whole pool is parsed instead
+	std::vector<std::uint8_t> otherVersion = storedVersion;
+	otherVersion.at(otherVersion.size() - 4) = 0x03; // Number variable 2, value 3
+	auto mismatchedWorkingSet = std::make_shared<VirtualTerminalServerManagedWorkingSet>();
+	mismatchedWorkingSet->add_iop_raw_data(otherVersion);
+	mismatchedWorkingSet->set_object_pool_snapshot(std::vector<std::uint8_t>(snapshotData));
+	mismatchedWorkingSet->start_parsing(workerPool);
+	ASSERT_EQ(VirtualTerminalServerManagedWorkingSet::ObjectPoolProcessingThreadState::Success, wait_for_parsing(mismatchedWorkingSet));
+	statistics = mismatchedWorkingSet->get_object_pool_parsing_statistics();
+	EXPECT_FALSE(statistics.loadedFromSnapshot);
+	EXPECT_EQ(3, statistics.numberOfObjects);
+	EXPECT_EQ(3, std::static_pointer_cast<NumberVariable>(mismatchedWorkingSet->get_object_by_id(2))->get_value());
+}
@@ -14,14 +14,18 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
-#include <queue>
-#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace isobus
 {
 	using EventCallbackHandle = std::size_t;
 
 	/// @brief A dispatcher that notifies listeners when an event is invoked.
+	/// @details Listeners are stored contiguously in an immutable list, ordered by when they were added.
+	/// Adding or removing a listener publishes a new copy of the list, while invoking the event only takes
+	/// a reference to the current list, so listeners are called without holding the dispatcher's mutex and invoking never allocates.
+	/// Listeners added or removed while the event is being invoked only take effect on the next invocation.
 	template<typename... E>
 	class EventDispatcher
 	{
@@ -33,18 +37,14 @@ namespace isobus
 		/// @return A unique identifier for the callback, which can be used to remove the listener.
 		EventCallbackHandle add_listener(const Callback &callback)
 		{
+			LOCK_GUARD(Mutex, callbacksMutex);
 			EventCallbackHandle id = nextId;
 			nextId += 1;
 
-			LOCK_GUARD(Mutex, callbacksMutex);
-			if (isExecuting)
-			{
-				modifications.push([this, id, callback]() { callbacks[id] = callback; });
-			}
-			else
-			{
-				callbacks[id] = callback;
-			}
+			// Handles only ever increase, so appending keeps the list sorted by handle
+			std::shared_ptr<ListenerList> updatedListeners = copy_listeners();
+			updatedListeners->emplace_back(id, callback);
+			publish_listeners(std::move(updatedListeners));
 			return id;
 		}
 
@@ -79,16 +79,25 @@ namespace isobus
 
 		/// @brief Remove a callback from the list of listeners.
 		/// @param id The unique identifier of the callback to remove.
-		void remove_listener(EventCallbackHandle id) noexcept
+		void remove_listener(EventCallbackHandle id)
 		{
 			LOCK_GUARD(Mutex, callbacksMutex);
-			if (isExecuting)
-			{
-				modifications.push([this, id]() { callbacks.erase(id); });
-			}
-			else
+			const std::shared_ptr<const ListenerList> currentListeners = load_listeners();
+
+			if (nullptr != currentListeners)
 			{
-				callbacks.erase(id);
+				auto listener = std::lower_bound(currentListeners->begin(), currentListeners->end(), id, [](const Listener &entry, EventCallbackHandle handle) {
+					return entry.first < handle;
+				});
+
+				if ((currentListeners->end() != listener) && (id == listener->first))
+				{
+					std::shared_ptr<ListenerList> updatedListeners = std::make_shared<ListenerList>();
+					updatedListeners->reserve(currentListeners->size() - 1);
+					updatedListeners->insert(updatedListeners->end(), currentListeners->begin(), listener);
+					updatedListeners->insert(updatedListeners->end(), listener + 1, currentListeners->end());
+					publish_listeners(std::move(updatedListeners));
+				}
 			}
 		}
 
@@ -96,22 +105,15 @@ namespace isobus
 		void clear_listeners() noexcept
 		{
 			LOCK_GUARD(Mutex, callbacksMutex);
-			if (isExecuting)
-			{
-				modifications.push([this]() { callbacks.clear(); });
-			}
-			else
-			{
-				callbacks.clear();
-			}
+			publish_listeners(nullptr);
 		}
 
 		/// @brief Get the number of listeners registered to this event.
 		/// @return The number of listeners
 		std::size_t get_listener_count()
 		{
-			LOCK_GUARD(Mutex, callbacksMutex);
-			return callbacks.size();
+			const std::shared_ptr<const ListenerList> currentListeners = load_listeners();
+			return (nullptr != currentListeners) ? currentListeners->size() : 0;
 		}
 
 		/// @brief Call and event with context that is forwarded to all listeners.
@@ -127,37 +129,61 @@ namespace isobus
 		/// @return True if the event was successfully invoked, false otherwise.
 		void call(const E &...args)
 		{
-			{
-				// Set flag to indicate we will be reading the list of callbacks, and
-				// prevent other threads from modifying the list directly during this time
-				LOCK_GUARD(Mutex, callbacksMutex);
-				isExecuting = true;
-			}
+			// Holding on to the list keeps it alive, even if listeners are added or removed while we execute them
+			const std::shared_ptr<const ListenerList> currentListeners = load_listeners();
 
-			// Execute the callbacks
-			for (const auto &callback : callbacks)
+			if (nullptr != currentListeners)
 			{
-				callback.second(args...);
-			}
-
-			{
-				LOCK_GUARD(Mutex, callbacksMutex);
-				isExecuting = false;
-
-				// Apply pending modifications to the callbacks list
-				while (!modifications.empty())
+				for (const auto &listener : *currentListeners)
 				{
-					modifications.front()();
-					modifications.pop();
+					listener.second(args...);
 				}
 			}
 		}
 
 	private:
-		std::unordered_map<EventCallbackHandle, Callback> callbacks; ///< The list of callbacks
-		bool isExecuting = false; ///< Whether the dispatcher is currently executing an event
-		std::queue<std::function<void()>> modifications; ///< The modifications to the callbacks list
-		Mutex callbacksMutex; ///< The mutex to protect the object from (unwanted) concurrent access
+		using Listener = std::pair<EventCallbackHandle, Callback>; ///< A callback along with its handle
+		using ListenerList = std::vector<Listener>; ///< A list of listeners sorted by handle
+
+		/// @brief Gets the current list of listeners
+		/// @return The current list of listeners, or `nullptr` if there are none
+		std::shared_ptr<const ListenerList> load_listeners() const
+		{
+#if defined CAN_STACK_DISABLE_THREADS || defined ARDUINO
+			return listeners;
+#else
+			return std::atomic_load(&listeners);
+#endif
+		}
+
+		/// @brief Makes a modifiable copy of the current list of listeners, call with the mutex held
+		/// @return A copy of the current list of listeners, with room for one more
+		std::shared_ptr<ListenerList> copy_listeners() const
+		{
+			const std::shared_ptr<const ListenerList> currentListeners = load_listeners();
+			std::shared_ptr<ListenerList> retVal = std::make_shared<ListenerList>();
+
+			if (nullptr != currentListeners)
+			{
+				retVal->reserve(currentListeners->size() + 1);
+				retVal->insert(retVal->end(), currentListeners->begin(), currentListeners->end());
+			}
+			return retVal;
+		}
+
+		/// @brief Replaces the current list of listeners, call with the mutex held
+		/// @param updatedListeners The new list of listeners
+		void publish_listeners(std::shared_ptr<const ListenerList> updatedListeners)
+		{
+#if defined CAN_STACK_DISABLE_THREADS || defined ARDUINO
+			listeners = std::move(updatedListeners);
+#else
+			std::atomic_store(&listeners, std::move(updatedListeners));
+#endif
+		}
+
+		std::shared_ptr<const ListenerList> listeners; ///< The current list of listeners, only accessed atomically
+		Mutex callbacksMutex; ///< Serializes changes to the list of listeners
 		EventCallbackHandle nextId = 0; // Counter for generating unique IDs
 	};
 } // namespace isobus
@@ -10,6 +10,8 @@
 #define THREAD_SYNCHRONIZATION_HPP
 
 #if defined CAN_STACK_DISABLE_THREADS || defined ARDUINO
+#include <deque>
+#include <limits>
 #include <queue>
 
 namespace isobus
@@ -40,7 +42,7 @@ public:
 	/// @return Simply returns true, since this version of the queue is not limited in size.
 	bool push(const T &item)
 	{
-		queue.push(item);
+		queue.push_back(item);
 		return true;
 	}
 
@@ -67,10 +69,37 @@ public:
 			return false;
 		}
 
-		queue.pop();
+		queue.pop_front();
 		return true;
 	}
 
+	/// @brief Copy up to a number of items from the front of the queue without removing them.
+	/// @param items The buffer to copy the items to.
+	/// @param maxItems The max number of items to copy.
+	/// @return The number of items that were copied.
+	std::size_t peek_batch(T *items, std::size_t maxItems)
+	{
+		std::size_t count = 0;
+		for (; (count < maxItems) && (count < queue.size()); count++)
+		{
+			items[count] = queue[count];
+		}
+		return count;
+	}
+
+	/// @brief Pop a number of items from the queue.
+	/// @param count The number of items to pop.
+	/// @return The number of items that were popped.
+	std::size_t pop_batch(std::size_t count)
+	{
+		if (count > queue.size())
+		{
+			count = queue.size();
+		}
+		queue.erase(queue.begin(), queue.begin() + count);
+		return count;
+	}
+
 	/// @brief Check if the queue is full.
 	/// @return Always returns false, since this version of the queue is not limited in size.
 	bool is_full() const
@@ -78,20 +107,40 @@ public:
 		return false;
 	}
 
+	/// @brief Get the number of items in the queue.
+	/// @return The number of items in the queue.
+	std::size_t size() const
+	{
+		return queue.size();
+	}
+
+	/// @brief Get the number of items the queue can hold.
+	/// @return The largest possible value, since this version of the queue is not limited in size.
+	std::size_t max_size() const
+	{
+		return std::numeric_limits<std::size_t>::max();
+	}
+
 	/// @brief Clear the queue.
 	void clear()
 	{
-		queue = {};
+		queue.clear();
 	}
 
 private:
-	std::queue<T> queue; ///< The queue
+	std::deque<T> queue; ///< The queue
 };
 
+/// @brief A queue that can be pushed to from multiple threads, since threads are disabled this is a simple queue.
+/// @tparam T The item type for the queue.
+template<typename T>
+using LockFreeMultiProducerQueue = LockFreeQueue<T>;
+
 #else
 
 #include <atomic>
 #include <cassert>
+#include <cstddef>
 #include <mutex>
 #include <vector>
 namespace isobus
@@ -172,6 +221,44 @@ public:
 		return true;
 	}
 
+	/// @brief Copy up to a number of items from the front of the queue without removing them.
+	/// @param items The buffer to copy the items to.
+	/// @param maxItems The max number of items to copy.
+	/// @return The number of items that were copied.
+	std::size_t peek_batch(T *items, std::size_t maxItems)
+	{
+		const auto currentReadIndex = readIndex.load(std::memory_order_relaxed);
+		const auto currentWriteIndex = writeIndex.load(std::memory_order_acquire);
+		std::size_t count = (currentWriteIndex + capacity - currentReadIndex) % capacity;
+
+		if (count > maxItems)
+		{
+			count = maxItems;
+		}
+		for (std::size_t i = 0; i < count; i++)
+		{
+			items[i] = buffer[(currentReadIndex + i) % capacity];
+		}
+		return count;
+	}
+
+	/// @brief Pop a number of items from the queue.
+	/// @param count The number of items to pop.
+	/// @return The number of items that were popped.
+	std::size_t pop_batch(std::size_t count)
+	{
+		const auto currentReadIndex = readIndex.load(std::memory_order_relaxed);
+		const auto currentWriteIndex = writeIndex.load(std::memory_order_acquire);
+		const std::size_t available = (currentWriteIndex + capacity - currentReadIndex) % capacity;
+
+		if (count > available)
+		{
+			count = available;
+		}
+		readIndex.store((currentReadIndex + count) % capacity, std::memory_order_release);
+		return count;
+	}
+
 	/// @brief Check if the queue is full.
 	/// @return True if the queue is full, false if the queue is not full.
 	bool is_full() const
@@ -179,6 +266,22 @@ public:
 		return nextIndex(writeIndex.load(std::memory_order_acquire)) == readIndex.load(std::memory_order_acquire);
 	}
 
+	/// @brief Get the number of items in the queue.
+	/// @return The number of items in the queue.
+	std::size_t size() const
+	{
+		const auto currentWriteIndex = writeIndex.load(std::memory_order_acquire);
+		const auto currentReadIndex = readIndex.load(std::memory_order_acquire);
+		return (currentWriteIndex + capacity - currentReadIndex) % capacity;
+	}
+
+	/// @brief Get the number of items the queue can hold.
+	/// @return The number of items the queue can hold, one slot of the buffer is always kept free.
+	std::size_t max_size() const
+	{
+		return capacity - 1;
+	}
+
 	/// @brief Clear the queue.
 	void clear()
 	{
@@ -201,6 +304,182 @@ private:
 	}
 };
 
+/// @brief A template class for a lock free queue that can be pushed to from multiple threads at once.
+/// @details Only a single thread may consume items (peek, pop and clear). Each slot of the ring carries
+/// a sequence number that tells producers and the consumer whose turn it is to use the slot, so producers
+/// only have to agree on a position with a single compare-and-swap. Items pushed by the same thread are
+/// always consumed in the order they were pushed.
+/// @tparam T The item type for the queue.
+template<typename T>
+class LockFreeMultiProducerQueue
+{
+public:
+	/// @brief Constructor for the lock free multi producer queue.
+	/// @param size The number of items the queue can hold, rounded up to a power of two.
+	explicit LockFreeMultiProducerQueue(std::size_t size) :
+	  capacity(round_up_to_power_of_two(size)),
+	  buffer(capacity)
+	{
+		assert(size > 0 && "The size of the queue must be greater than 0.");
+		for (std::size_t i = 0; i < capacity; i++)
+		{
+			buffer[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	/// @brief Push an item to the queue, can be called from any thread.
+	/// @param item The item to push to the queue.
+	/// @return True if the item was pushed to the queue, false if the queue is full.
+	bool push(const T &item)
+	{
+		Slot *slot;
+		auto position = writePosition.load(std::memory_order_relaxed);
+
+		while (true)
+		{
+			slot = &buffer[position & (capacity - 1)];
+			const auto sequence = slot->sequence.load(std::memory_order_acquire);
+			const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+
+			if (0 == difference)
+			{
+				// The slot is free, try to claim it before another producer does
+				if (writePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (difference < 0)
+			{
+				// The slot still holds an item from the previous lap, so the buffer is full.
+				return false;
+			}
+			else
+			{
+				// Another producer claimed the slot, try again at the latest position.
+				position = writePosition.load(std::memory_order_relaxed);
+			}
+		}
+
+		slot->item = item;
+		slot->sequence.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	/// @brief Peek at the next item in the queue.
+	/// @param item The item to peek at in the queue.
+	/// @return True if the item was peeked at in the queue, false if the queue is empty.
+	bool peek(T &item)
+	{
+		return 1 == peek_batch(&item, 1);
+	}
+
+	/// @brief Pop an item from the queue.
+	/// @return True if the item was popped from the queue, false if the queue is empty.
+	bool pop()
+	{
+		return 1 == pop_batch(1);
+	}
+
+	/// @brief Copy up to a number of items from the front of the queue without removing them.
+	/// @param items The buffer to copy the items to.
+	/// @param maxItems The max number of items to copy.
+	/// @return The number of items that were copied.
+	std::size_t peek_batch(T *items, std::size_t maxItems)
+	{
+		const auto position = readPosition.load(std::memory_order_relaxed);
+		std::size_t count = 0;
+
+		while ((count < maxItems) && is_published(position + count))
+		{
+			items[count] = buffer[(position + count) & (capacity - 1)].item;
+			count++;
+		}
+		return count;
+	}
+
+	/// @brief Pop a number of items from the queue.
+	/// @param count The number of items to pop.
+	/// @return The number of items that were popped.
+	std::size_t pop_batch(std::size_t count)
+	{
+		const auto position = readPosition.load(std::memory_order_relaxed);
+		std::size_t numberPopped = 0;
+
+		while ((numberPopped < count) && is_published(position + numberPopped))
+		{
+			// Hand the slot back to producers for their next lap around the ring
+			buffer[(position + numberPopped) & (capacity - 1)].sequence.store(position + numberPopped + capacity, std::memory_order_release);
+			numberPopped++;
+		}
+		readPosition.store(position + numberPopped, std::memory_order_relaxed);
+		return numberPopped;
+	}
+
+	/// @brief Check if the queue is full.
+	/// @return True if the queue is full, false if the queue is not full.
+	bool is_full() const
+	{
+		return size() >= capacity;
+	}
+
+	/// @brief Get the number of items in the queue.
+	/// @return The number of items in the queue, including items that producers are still writing.
+	std::size_t size() const
+	{
+		return writePosition.load(std::memory_order_acquire) - readPosition.load(std::memory_order_acquire);
+	}
+
+	/// @brief Get the number of items the queue can hold.
+	/// @return The number of items the queue can hold.
+	std::size_t max_size() const
+	{
+		return capacity;
+	}
+
+	/// @brief Clear the queue, must be called from the consuming thread.
+	void clear()
+	{
+		while (0 != pop_batch(capacity))
+		{
+		}
+	}
+
+private:
+	/// @brief A slot in the ring buffer.
+	struct Slot
+	{
+		std::atomic<std::size_t> sequence = { 0 }; ///< Equal to the position for a free slot, or the position + 1 once an item is published.
+		T item; ///< The item stored in the slot.
+	};
+
+	/// @brief Rounds a size up to the next power of two, so positions can wrap around without skipping slots.
+	/// @param size The size to round up.
+	/// @return The smallest power of two that is not smaller than the size, and at least 1.
+	static std::size_t round_up_to_power_of_two(std::size_t size)
+	{
+		std::size_t retVal = 1;
+		while (retVal < size)
+		{
+			retVal <<= 1;
+		}
+		return retVal;
+	}
+
+	/// @brief Checks if the item at a position has been fully written by its producer.
+	/// @param position The position to check.
+	/// @return True if the item at the position can be consumed.
+	bool is_published(std::size_t position) const
+	{
+		return buffer[position & (capacity - 1)].sequence.load(std::memory_order_acquire) == (position + 1);
+	}
+
+	const std::size_t capacity; ///< The capacity of the ring buffer, always a power of two.
+	std::vector<Slot> buffer; ///< The ring buffer.
+	std::atomic<std::size_t> writePosition = { 0 }; ///< The next position producers will claim.
+	std::atomic<std::size_t> readPosition = { 0 }; ///< The next position the consumer will read.
+};
+
 #endif
 
 #include <queue>